@@ -0,0 +1,265 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined __linux__ && !defined __ANDROID__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "allocator.h"
+#include "benchmark.h"
+#include "cpu.h"
+#include "datareader.h"
+#include "net.h"
+
+// non-zero weights, zero ones would be repacked as tiny sparse kernels
+class DataReaderFromConstant : public ncnn::DataReader
+{
+public:
+    virtual int scan(const char* format, void* p) const
+    {
+        return 0;
+    }
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == sizeof(unsigned int))
+        {
+            // fp32 weight tag
+            memset(buf, 0, size);
+            return size;
+        }
+
+        float* ptr = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            ptr[i] = 0.01f;
+        }
+        return size;
+    }
+};
+
+// dTLB load misses of the calling thread and its children
+class TlbMissCounter
+{
+public:
+    TlbMissCounter()
+        : fd(-1)
+    {
+#if defined __linux__ && !defined __ANDROID__
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~TlbMissCounter()
+    {
+#if defined __linux__ && !defined __ANDROID__
+        if (fd != -1)
+            close(fd);
+#endif
+    }
+
+    void start()
+    {
+#if defined __linux__ && !defined __ANDROID__
+        if (fd == -1)
+            return;
+
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop()
+    {
+        long long count = 0;
+#if defined __linux__ && !defined __ANDROID__
+        if (fd == -1)
+            return -1;
+
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count))
+            return -1;
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+static int g_loop_count = 8;
+
+// normal mode runs with the default allocators, the others with huge page allocators of page_size
+static int benchmark(const char* parampath, const char* mode, size_t page_size, int num_threads)
+{
+    ncnn::HugePageAllocator weight_allocator(page_size);
+    ncnn::HugePageAllocator blob_allocator(page_size);
+    ncnn::HugePageAllocator workspace_allocator(page_size);
+
+    const bool hugepage = strcmp(mode, "normal") != 0;
+
+    double time_min = DBL_MAX;
+    double time_avg = 0;
+    long long tlb_misses = 0;
+    size_t weight_hugetlb = 0;
+    size_t weight_madvise = 0;
+    size_t weight_thp = 0;
+    {
+        ncnn::Net net;
+        net.opt.num_threads = num_threads;
+
+        if (hugepage)
+        {
+            net.opt.blob_allocator = &blob_allocator;
+            net.opt.workspace_allocator = &workspace_allocator;
+            net.set_weight_allocator(&weight_allocator);
+        }
+
+        if (net.load_param(parampath) != 0)
+        {
+            fprintf(stderr, "load_param %s failed\n", parampath);
+            return -1;
+        }
+
+        DataReaderFromConstant dr;
+        net.load_model(dr);
+
+        // unmap the loaded weights released after being repacked in lightmode
+        weight_allocator.clear();
+
+        weight_hugetlb = weight_allocator.hugetlb_bytes();
+        weight_madvise = weight_allocator.madvise_bytes();
+        weight_thp = weight_allocator.thp_bytes();
+
+        if (net.input_names().empty() || net.output_names().empty())
+        {
+            fprintf(stderr, "%s has no input or output\n", parampath);
+            return -1;
+        }
+
+        ncnn::Mat in(224, 224, 3);
+        in.fill(0.01f);
+
+        ncnn::Mat out;
+
+        // warm up
+        for (int i = 0; i < 2; i++)
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.input(net.input_names()[0], in);
+            ex.extract(net.output_names()[0], out);
+        }
+
+        TlbMissCounter counter;
+        counter.start();
+
+        for (int i = 0; i < g_loop_count; i++)
+        {
+            double start = ncnn::get_current_time();
+
+            {
+                ncnn::Extractor ex = net.create_extractor();
+                ex.input(net.input_names()[0], in);
+                ex.extract(net.output_names()[0], out);
+            }
+
+            double end = ncnn::get_current_time();
+
+            time_min = std::min(time_min, end - start);
+            time_avg += end - start;
+        }
+
+        tlb_misses = counter.stop();
+
+        out.release();
+    }
+
+    time_avg /= g_loop_count;
+
+    fprintf(stderr, "%20s %7s  min = %8.2f  avg = %8.2f", parampath, mode, time_min, time_avg);
+
+    if (tlb_misses >= 0)
+        fprintf(stderr, "  dtlb misses = %10lld", tlb_misses / g_loop_count);
+    else
+        fprintf(stderr, "  dtlb misses = %10s", "n/a");
+
+    if (hugepage)
+        fprintf(stderr, "  weight MB hugetlb = %6.1f  madvise = %6.1f  thp = %6.1f", weight_hugetlb / 1048576.0, weight_madvise / 1048576.0, weight_thp / 1048576.0);
+
+    fprintf(stderr, "\n");
+
+    return 0;
+}
+
+void show_usage()
+{
+    fprintf(stderr, "Usage: benchhugepage [loop count] [num threads] [model.param ...]\n");
+}
+
+int main(int argc, char** argv)
+{
+    int num_threads = ncnn::get_physical_big_cpu_count();
+    std::vector<std::string> params;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((argv[i][0] == '-' && argv[i][1] == 'h') || strcmp(argv[i], "--help") == 0)
+        {
+            show_usage();
+            return -1;
+        }
+    }
+
+    if (argc >= 2)
+        g_loop_count = std::max(atoi(argv[1]), 1);
+    if (argc >= 3)
+        num_threads = atoi(argv[2]);
+    for (int i = 3; i < argc; i++)
+        params.push_back(argv[i]);
+
+    if (params.empty())
+    {
+        params.push_back("resnet50.param");
+        params.push_back("vgg16.param");
+    }
+
+    ncnn::set_cpu_powersave(2);
+    ncnn::set_omp_dynamic(0);
+    ncnn::set_omp_num_threads(num_threads);
+
+    fprintf(stderr, "loop_count = %d\n", g_loop_count);
+    fprintf(stderr, "num_threads = %d\n", num_threads);
+
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        const char* parampath = params[i].c_str();
+
+        benchmark(parampath, "normal", 0, num_threads);
+        benchmark(parampath, "thp", 0, num_threads);
+        benchmark(parampath, "2mb", 2 * 1024 * 1024, num_threads);
+        benchmark(parampath, "1gb", 1024 * 1024 * 1024, num_threads);
+    }
+
+    return 0;
+}
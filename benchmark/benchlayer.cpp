@@ -0,0 +1,757 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "layer.h"
+#include "mat.h"
+#include "modelbin.h"
+#include "paramdict.h"
+
+// random weights in any requested size, so that the spec needs no weight shapes
+class ModelBinFromRandom : public ncnn::ModelBin
+{
+public:
+    ModelBinFromRandom()
+        : seed(7767517), loaded_count(0)
+    {
+    }
+
+    virtual ncnn::Mat load(int w, int type) const
+    {
+        // type 1 holds bias, scale and variance, keep them positive
+        const float low = type == 1 ? 0.01f : -1.f;
+
+        ncnn::Mat m(w);
+        for (int i = 0; i < w; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            m[i] = low + ((seed >> 8) & 0xffff) / 65536.f * (1.f - low);
+        }
+
+        loaded_count += w;
+        return m;
+    }
+
+    mutable unsigned int seed;
+    mutable size_t loaded_count;
+};
+
+struct LayerSpec
+{
+    std::string line;
+    std::string type;
+    ncnn::ParamDict pd;
+    std::vector<ncnn::Mat> inputs;
+};
+
+struct BenchConfig
+{
+    const char* storage;
+    int elempack;
+    int num_threads;
+};
+
+static int g_loop_count = 10;
+
+static std::vector<int> parse_int_list(const char* s)
+{
+    std::vector<int> values;
+
+    std::string str(s);
+    size_t p = 0;
+    while (p <= str.size())
+    {
+        size_t comma = str.find(',', p);
+        if (comma == std::string::npos)
+            comma = str.size();
+
+        int v = atoi(str.substr(p, comma - p).c_str());
+        if (v > 0)
+            values.push_back(v);
+
+        p = comma + 1;
+    }
+
+    return values;
+}
+
+static std::vector<std::string> parse_string_list(const char* s)
+{
+    std::vector<std::string> values;
+
+    std::string str(s);
+    size_t p = 0;
+    while (p <= str.size())
+    {
+        size_t comma = str.find(',', p);
+        if (comma == std::string::npos)
+            comma = str.size();
+
+        if (comma > p)
+            values.push_back(str.substr(p, comma - p));
+
+        p = comma + 1;
+    }
+
+    return values;
+}
+
+static bool is_float_string(const std::string& s)
+{
+    return s.find('.') != std::string::npos || s.find('e') != std::string::npos || s.find('E') != std::string::npos;
+}
+
+static bool is_number_string(const std::string& s)
+{
+    return !s.empty() && s.find_first_not_of("0123456789+-.eE,") == std::string::npos;
+}
+
+// key=value as in ncnn param, array key is -23300 minus index
+static int parse_param(const std::string& kv, ncnn::ParamDict& pd)
+{
+    size_t eq = kv.find('=');
+    if (eq == std::string::npos)
+        return -1;
+
+    int id = atoi(kv.substr(0, eq).c_str());
+    std::string value = kv.substr(eq + 1);
+
+    if (id <= -23300)
+    {
+        id = -id - 23300;
+
+        // [array size],v,v,...
+        std::vector<std::string> values = parse_string_list(value.c_str());
+        if (values.empty())
+            return -1;
+
+        const int n = (int)values.size() - 1;
+        const bool is_float = is_float_string(value);
+
+        ncnn::Mat m(n);
+        for (int i = 0; i < n; i++)
+        {
+            if (is_float)
+                m[i] = (float)atof(values[i + 1].c_str());
+            else
+                ((int*)m)[i] = atoi(values[i + 1].c_str());
+        }
+
+        pd.set(id, m);
+        return 0;
+    }
+
+    if (!is_number_string(value))
+    {
+        if (value.size() >= 2 && value[0] == '"' && value[value.size() - 1] == '"')
+            value = value.substr(1, value.size() - 2);
+
+        pd.set(id, value);
+        return 0;
+    }
+
+    if (is_float_string(value))
+        pd.set(id, (float)atof(value.c_str()));
+    else
+        pd.set(id, atoi(value.c_str()));
+
+    return 0;
+}
+
+// [w,h,c]
+static int parse_shape(const std::string& s, ncnn::Mat& m)
+{
+    std::vector<int> shape = parse_int_list(s.substr(1, s.size() - 2).c_str());
+
+    switch (shape.size())
+    {
+    case 1:
+        m.create(shape[0]);
+        break;
+    case 2:
+        m.create(shape[0], shape[1]);
+        break;
+    case 3:
+        m.create(shape[0], shape[1], shape[2]);
+        break;
+    case 4:
+        m.create(shape[0], shape[1], shape[2], shape[3]);
+        break;
+    default:
+        return -1;
+    }
+
+    for (int i = 0; i < (int)m.total(); i++)
+    {
+        m[i] = (i % 255) / 127.f - 1.f;
+    }
+
+    return 0;
+}
+
+// one layer per line
+// Convolution 0=64 1=3 4=1 5=1 6=36864 [56,56,64]
+static int read_spec(const char* path, std::vector<LayerSpec>& specs)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    char buf[4096];
+    while (fgets(buf, 4096, fp))
+    {
+        std::string line(buf);
+
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line = line.substr(0, comment);
+
+        std::vector<std::string> tokens;
+        size_t p = 0;
+        while (p < line.size())
+        {
+            size_t b = line.find_first_not_of(" \t\r\n", p);
+            if (b == std::string::npos)
+                break;
+
+            size_t e = line.find_first_of(" \t\r\n", b);
+            if (e == std::string::npos)
+                e = line.size();
+
+            tokens.push_back(line.substr(b, e - b));
+            p = e;
+        }
+
+        if (tokens.empty())
+            continue;
+
+        specs.push_back(LayerSpec());
+        LayerSpec& spec = specs.back();
+        spec.type = tokens[0];
+
+        for (size_t i = 1; i < tokens.size(); i++)
+        {
+            const std::string& t = tokens[i];
+
+            int ret = 0;
+            if (t[0] == '[')
+            {
+                ncnn::Mat m;
+                ret = parse_shape(t, m);
+                spec.inputs.push_back(m);
+            }
+            else
+            {
+                ret = parse_param(t, spec.pd);
+            }
+
+            if (ret != 0)
+            {
+                fprintf(stderr, "unrecognized token %s in %s\n", t.c_str(), buf);
+                fclose(fp);
+                return -1;
+            }
+
+            if (t[0] == '[')
+                spec.line += (spec.line.empty() ? "" : " ") + t;
+        }
+
+        if (spec.inputs.empty())
+        {
+            fprintf(stderr, "no input shape in %s\n", buf);
+            fclose(fp);
+            return -1;
+        }
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+// the layout the net would choose, layers create their pipeline for this one only
+static int resolve_elempack(int elembits, int elemcount, const ncnn::Option& opt, const ncnn::Layer* op)
+{
+    if (!opt.use_packing_layout || !op->support_packing)
+        return 1;
+
+    int elempack = 1;
+    if (elembits == 32)
+    {
+#if NCNN_AVX512
+        if (elemcount % 16 == 0 && ncnn::cpu_support_x86_avx512())
+            elempack = 16;
+        else if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+            elempack = 8;
+        else if (elemcount % 4 == 0)
+            elempack = 4;
+#elif NCNN_AVX
+        if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+            elempack = 8;
+        else if (elemcount % 4 == 0)
+            elempack = 4;
+#elif NCNN_RVV || NCNN_XTHEADVECTOR
+        const int packn = ncnn::cpu_riscv_vlenb() / 4;
+        if (elemcount % packn == 0)
+            elempack = packn;
+#else
+        if (elemcount % 4 == 0)
+            elempack = 4;
+#endif
+    }
+    if (elembits == 16)
+    {
+#if NCNN_ARM82
+        if (elemcount % 8 == 0 && ncnn::cpu_support_arm_asimdhp() && opt.use_fp16_arithmetic && op->support_fp16_storage)
+            elempack = 8;
+        else if (elemcount % 4 == 0)
+            elempack = 4;
+#elif NCNN_RVV || NCNN_XTHEADVECTOR
+        const int packn = ncnn::cpu_riscv_vlenb() / 2;
+        if (elemcount % packn == 0)
+            elempack = packn;
+#else
+        if (elemcount % 4 == 0)
+            elempack = 4;
+#endif
+    }
+    if (elembits == 8)
+    {
+#if NCNN_RVV || NCNN_XTHEADVECTOR
+        const int packn = ncnn::cpu_riscv_vlenb() / 1;
+        if (elemcount % packn == 0)
+            elempack = packn;
+#else
+        if (elemcount % 8 == 0)
+            elempack = 8;
+#endif
+    }
+
+    return elempack;
+}
+
+static ncnn::Option make_option(const BenchConfig& config)
+{
+    ncnn::Option opt;
+    opt.num_threads = config.num_threads;
+    opt.lightmode = true;
+    opt.use_packing_layout = config.elempack != 1;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+    opt.use_bf16_storage = false;
+    opt.use_int8_inference = false;
+    opt.use_int8_storage = false;
+    opt.use_int8_arithmetic = false;
+
+    if (strcmp(config.storage, "fp16") == 0)
+    {
+        opt.use_fp16_packed = true;
+        opt.use_fp16_storage = true;
+        opt.use_fp16_arithmetic = true;
+    }
+    if (strcmp(config.storage, "bf16") == 0)
+    {
+        opt.use_bf16_storage = true;
+    }
+    if (strcmp(config.storage, "int8") == 0)
+    {
+        opt.use_int8_inference = true;
+        opt.use_int8_storage = true;
+        opt.use_int8_arithmetic = true;
+    }
+
+    return opt;
+}
+
+// return -1 if the layer can not take the config
+static int convert_input(const ncnn::Mat& a, ncnn::Mat& b, const BenchConfig& config, const ncnn::Option& opt, const ncnn::Layer* op)
+{
+    ncnn::Mat a16 = a;
+    if (opt.use_fp16_storage && op->support_fp16_storage)
+    {
+        ncnn::cast_float32_to_float16(a, a16, opt);
+    }
+#if NCNN_BF16
+    if (opt.use_bf16_storage && op->support_bf16_storage)
+    {
+        ncnn::cast_float32_to_bfloat16(a, a16, opt);
+    }
+#endif // NCNN_BF16
+
+    int elemcount = 0;
+    if (a16.dims == 1) elemcount = a16.w;
+    if (a16.dims == 2) elemcount = a16.h;
+    if (a16.dims == 3 || a16.dims == 4) elemcount = a16.c;
+
+    if (resolve_elempack(a16.elembits(), elemcount, opt, op) != config.elempack)
+        return -1;
+
+    ncnn::convert_packing(a16, b, config.elempack, opt);
+    return 0;
+}
+
+static size_t mat_bytes(const ncnn::Mat& m)
+{
+    return (size_t)m.w * m.h * m.d * m.c * m.elemsize;
+}
+
+static size_t mat_elements(const ncnn::Mat& m)
+{
+    return (size_t)m.w * m.h * m.d * m.c * m.elempack;
+}
+
+// multiply-add counts as 2 flops, other layers take one flop per output element
+static double estimate_flops(const LayerSpec& spec, const std::vector<ncnn::Mat>& inputs, const std::vector<ncnn::Mat>& outputs)
+{
+    size_t out_elements = 0;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        out_elements += mat_elements(outputs[i]);
+    }
+
+    const std::string& type = spec.type;
+    const int num_output = spec.pd.get(0, 0);
+
+    if (type == "Convolution" || type == "ConvolutionDepthWise" || type == "Convolution1D" || type == "ConvolutionDepthWise1D" || type == "Convolution3D" || type == "ConvolutionDepthWise3D")
+    {
+        const int weight_data_size = spec.pd.get(6, 0);
+        return 2.0 * weight_data_size * (out_elements / std::max(num_output, 1));
+    }
+
+    if (type == "InnerProduct")
+    {
+        const int weight_data_size = spec.pd.get(2, 0);
+        return 2.0 * weight_data_size * (out_elements / std::max(num_output, 1));
+    }
+
+    if (type == "Deconvolution" || type == "DeconvolutionDepthWise" || type == "Deconvolution1D" || type == "DeconvolutionDepthWise1D" || type == "Deconvolution3D" || type == "DeconvolutionDepthWise3D")
+    {
+        const ncnn::Mat& in = inputs[0];
+        const int inch = in.dims == 2 ? in.h : in.c;
+        const int weight_data_size = spec.pd.get(6, 0);
+        return 2.0 * weight_data_size * (mat_elements(in) / std::max(inch, 1));
+    }
+
+    if (type == "MatMul")
+    {
+        const ncnn::Mat& A = inputs[0];
+        return 2.0 * out_elements * A.w;
+    }
+
+    if (type == "Gemm")
+    {
+        const int transA = spec.pd.get(2, 0);
+        const int constantA = spec.pd.get(4, 0);
+        const int K = constantA ? spec.pd.get(9, 0) : (transA ? inputs[0].h : inputs[0].w);
+        return 2.0 * out_elements * K;
+    }
+
+    return (double)out_elements;
+}
+
+static const char* get_memory_level(size_t bytes, int num_threads)
+{
+    const size_t l2 = (size_t)ncnn::get_cpu_level2_cache_size() * num_threads;
+    const size_t l3 = (size_t)ncnn::get_cpu_level3_cache_size();
+
+    if (bytes <= l2)
+        return "L2";
+    if (l3 > 0 && bytes <= l3)
+        return "L3";
+    return "DRAM";
+}
+
+struct CopyTask
+{
+    unsigned char* src;
+    unsigned char* dst;
+    size_t size;
+    int repeat;
+};
+
+static void* copy_worker(void* args)
+{
+    CopyTask* task = (CopyTask*)args;
+
+    for (int i = 0; i < task->repeat; i++)
+    {
+        memcpy(task->dst, task->src, task->size);
+        task->src[i % task->size] = (unsigned char)i;
+    }
+
+    return 0;
+}
+
+// read + write bandwidth of a working set that size, the roof for memory bound layers
+static double measure_bandwidth(size_t bytes, int num_threads)
+{
+    const size_t chunk = std::max(bytes / 2 / num_threads, (size_t)4096);
+    const int repeat = (int)std::max((size_t)64 * 1024 * 1024 / (chunk * 2 * num_threads), (size_t)4);
+
+    std::vector<unsigned char> buf(chunk * 2 * num_threads, 1);
+
+    std::vector<CopyTask> tasks(num_threads);
+    for (int i = 0; i < num_threads; i++)
+    {
+        tasks[i].src = &buf[chunk * 2 * i];
+        tasks[i].dst = &buf[chunk * 2 * i + chunk];
+        tasks[i].size = chunk;
+        tasks[i].repeat = repeat;
+    }
+
+    double best = DBL_MAX;
+    for (int k = 0; k < 3; k++)
+    {
+        double start = ncnn::get_current_time();
+
+        std::vector<ncnn::Thread*> threads(num_threads - 1);
+        for (int i = 1; i < num_threads; i++)
+        {
+            threads[i - 1] = new ncnn::Thread(copy_worker, (void*)&tasks[i]);
+        }
+        copy_worker(&tasks[0]);
+        for (int i = 1; i < num_threads; i++)
+        {
+            threads[i - 1]->join();
+            delete threads[i - 1];
+        }
+
+        double end = ncnn::get_current_time();
+        best = std::min(best, end - start);
+    }
+
+    return (double)chunk * 2 * num_threads * repeat / (best / 1000) / 1e9;
+}
+
+static int benchmark(const LayerSpec& spec, const BenchConfig& config)
+{
+    // int8 only applies to layers with int8_scale_term and vice versa, the weights are quantized at load time
+    const bool int8_spec = spec.pd.get(8, 0) != 0;
+    if ((strcmp(config.storage, "int8") == 0) != int8_spec)
+        return 0;
+
+    ncnn::Layer* op = ncnn::create_layer_cpu(spec.type.c_str());
+    if (!op)
+    {
+        fprintf(stderr, "create_layer_cpu %s failed\n", spec.type.c_str());
+        return -1;
+    }
+
+    ncnn::Option opt = make_option(config);
+
+    op->load_param(spec.pd);
+
+    ModelBinFromRandom mb;
+    op->load_model(mb);
+
+    op->create_pipeline(opt);
+
+    // the layer can not take this storage
+    bool skip = false;
+    if (opt.use_fp16_storage && !op->support_fp16_storage)
+        skip = true;
+    if (opt.use_bf16_storage && !op->support_bf16_storage)
+        skip = true;
+
+    std::vector<ncnn::Mat> inputs(spec.inputs.size());
+    for (size_t i = 0; i < inputs.size() && !skip; i++)
+    {
+        if (convert_input(spec.inputs[i], inputs[i], config, opt, op) != 0)
+            skip = true;
+    }
+
+    if (skip)
+    {
+        op->destroy_pipeline(opt);
+        delete op;
+        return 0;
+    }
+
+    const int top_count = op->one_blob_only ? 1 : std::max((int)op->tops.size(), 1);
+
+    std::vector<ncnn::Mat> outputs;
+    double time_min = DBL_MAX;
+    double time_avg = 0;
+    int ret = 0;
+    for (int i = -2; i < g_loop_count; i++)
+    {
+        // inplace layers run on a fresh copy, the copy is not timed
+        std::vector<ncnn::Mat> blobs(inputs.size());
+        if (op->support_inplace)
+        {
+            for (size_t j = 0; j < inputs.size(); j++)
+            {
+                blobs[j] = inputs[j].clone();
+            }
+        }
+
+        double start = ncnn::get_current_time();
+
+        if (op->support_inplace)
+        {
+            ret = op->one_blob_only ? op->forward_inplace(blobs[0], opt) : op->forward_inplace(blobs, opt);
+            outputs = blobs;
+        }
+        else
+        {
+            outputs.resize(top_count);
+            ret = op->one_blob_only ? op->forward(inputs[0], outputs[0], opt) : op->forward(inputs, outputs, opt);
+        }
+
+        double end = ncnn::get_current_time();
+
+        if (ret != 0)
+            break;
+
+        // two warm up runs
+        if (i < 0)
+            continue;
+
+        time_min = std::min(time_min, end - start);
+        time_avg += end - start;
+    }
+
+    op->destroy_pipeline(opt);
+    delete op;
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "%s %s forward failed %d\n", spec.type.c_str(), spec.line.c_str(), ret);
+        return -1;
+    }
+
+    time_avg /= g_loop_count;
+
+    // timer resolution
+    time_min = std::max(time_min, 0.001);
+
+    const double flops = estimate_flops(spec, spec.inputs, outputs);
+
+    // weights are read once at the storage width
+    size_t bytes = 0;
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        bytes += mat_bytes(inputs[i]);
+    }
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        bytes += mat_bytes(outputs[i]);
+    }
+    const size_t weight_elemsize = opt.use_int8_inference ? 1 : (opt.use_fp16_storage || opt.use_bf16_storage) ? 2 : 4;
+    bytes += mb.loaded_count * weight_elemsize;
+
+    const double gflops = flops / (time_min / 1000) / 1e9;
+    const double gbps = bytes / (time_min / 1000) / 1e9;
+    const double roof_gbps = measure_bandwidth(bytes, config.num_threads);
+
+    fprintf(stderr, "%20s %-24s %4s pack%-2d t%-2d  min = %8.3f  avg = %8.3f  GFLOPS = %8.2f  GB/s = %7.2f  AI = %6.2f  %4s roof GB/s = %7.2f  bw = %3.0f%%\n",
+            spec.type.c_str(), spec.line.c_str(), config.storage, config.elempack, config.num_threads,
+            time_min, time_avg, gflops, gbps, flops / bytes, get_memory_level(bytes, config.num_threads), roof_gbps, gbps / roof_gbps * 100);
+
+    return 0;
+}
+
+void show_usage()
+{
+    fprintf(stderr, "Usage: benchlayer [spec file] [(key=value)...]\n");
+    fprintf(stderr, "  loop=10\n");
+    fprintf(stderr, "  threads=1,2,4\n");
+    fprintf(stderr, "  elempack=1,4,8,16\n");
+    fprintf(stderr, "  storage=fp32,fp16,bf16,int8\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || (argv[1][0] == '-' && argv[1][1] == 'h') || strcmp(argv[1], "--help") == 0)
+    {
+        show_usage();
+        return -1;
+    }
+
+    const char* specpath = argv[1];
+    std::vector<int> threads(1, ncnn::get_physical_big_cpu_count());
+    std::vector<int> elempacks;
+    elempacks.push_back(1);
+    elempacks.push_back(4);
+    elempacks.push_back(8);
+    elempacks.push_back(16);
+    std::vector<std::string> storages;
+    storages.push_back("fp32");
+    storages.push_back("fp16");
+    storages.push_back("bf16");
+    storages.push_back("int8");
+
+    for (int i = 2; i < argc; i++)
+    {
+        // key=value
+        char* kv = argv[i];
+
+        char* eqs = strchr(kv, '=');
+        if (eqs == NULL)
+        {
+            fprintf(stderr, "unrecognized arg %s\n", kv);
+            continue;
+        }
+
+        // split k v
+        eqs[0] = '\0';
+        const char* key = kv;
+        char* value = eqs + 1;
+
+        if (strcmp(key, "loop") == 0)
+            g_loop_count = std::max(atoi(value), 1);
+        if (strcmp(key, "threads") == 0)
+            threads = parse_int_list(value);
+        if (strcmp(key, "elempack") == 0)
+            elempacks = parse_int_list(value);
+        if (strcmp(key, "storage") == 0)
+            storages = parse_string_list(value);
+    }
+
+    std::vector<LayerSpec> specs;
+    if (read_spec(specpath, specs) != 0)
+        return -1;
+
+    ncnn::set_cpu_powersave(2);
+    ncnn::set_omp_dynamic(0);
+
+    fprintf(stderr, "loop = %d\n", g_loop_count);
+    fprintf(stderr, "l2 cache = %d KB\n", ncnn::get_cpu_level2_cache_size() / 1024);
+    fprintf(stderr, "l3 cache = %d KB\n", ncnn::get_cpu_level3_cache_size() / 1024);
+
+    for (size_t i = 0; i < specs.size(); i++)
+    {
+        for (size_t s = 0; s < storages.size(); s++)
+        {
+            for (size_t e = 0; e < elempacks.size(); e++)
+            {
+                for (size_t t = 0; t < threads.size(); t++)
+                {
+                    ncnn::set_omp_num_threads(threads[t]);
+
+                    BenchConfig config;
+                    config.storage = storages[s].c_str();
+                    config.elempack = elempacks[e];
+                    config.num_threads = threads[t];
+
+                    benchmark(specs[i], config);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+# LayerType [param id=value ...] [input shape w,h,c ...]
+# array params follow the ncnn param format, -23300=count,v,v,...
+
+Convolution             0=64 1=3 4=1 5=1 6=36864 [56,56,64]
+Convolution             0=256 1=1 5=1 6=65536 [28,28,256]
+ConvolutionDepthWise    0=128 1=3 4=1 5=1 6=1152 7=128 [56,56,128]
+Convolution             0=64 1=3 4=1 5=1 6=36864 8=2 [56,56,64]
+InnerProduct            0=1000 1=1 2=1024000 [1024]
+Gemm                    [256,128] [512,256]
+Pooling                 0=0 1=3 2=2 [112,112,64]
+ReLU                    [56,56,256]
+BinaryOp                0=0 [56,56,256] [56,56,256]
+Softmax                 0=1 1=1 [1000,64]
+LayerNorm               0=768 1=0.00001 2=1 [768,196]
@@ -0,0 +1,589 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "mat.h"
+
+static int g_loop_count = 20;
+
+#define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255)
+
+// one pixel routine, run through ncnn and through the plain c++ reference on the same input
+class PixelCase
+{
+public:
+    virtual ~PixelCase()
+    {
+    }
+
+    virtual const char* name() const = 0;
+    virtual void run_ncnn() = 0;
+    virtual void run_scalar() = 0;
+    // 0 when both outputs are bit exact
+    virtual int compare() const = 0;
+};
+
+static int compare_bytes(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b)
+{
+    return a == b ? 0 : -1;
+}
+
+static int compare_floats(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    if (a.w != b.w || a.h != b.h || a.c != b.c)
+        return -1;
+
+    for (int q = 0; q < a.c; q++)
+    {
+        if (memcmp(a.channel(q), b.channel(q), a.w * a.h * sizeof(float)) != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+class FromPixelsCase : public PixelCase
+{
+public:
+    FromPixelsCase(const char* _name, int _type, int _inch, int _outch, const int* _map, int _w, int _h)
+        : case_name(_name), type(_type), inch(_inch), outch(_outch), w(_w), h(_h)
+    {
+        for (int q = 0; q < outch; q++)
+            map[q] = _map[q];
+
+        pixels.resize(w * h * inch);
+        for (size_t i = 0; i < pixels.size(); i++)
+            pixels[i] = (unsigned char)(rand() % 256);
+    }
+
+    virtual const char* name() const
+    {
+        return case_name;
+    }
+
+    virtual void run_ncnn()
+    {
+        out = ncnn::Mat::from_pixels(pixels.data(), type, w, h);
+    }
+
+    virtual void run_scalar()
+    {
+        // allocate a new mat each time as from_pixels does
+        ncnn::Mat m(w, h, outch);
+
+        const int size = w * h;
+        for (int q = 0; q < outch; q++)
+        {
+            const unsigned char* p = pixels.data() + map[q];
+            float* ptr = m.channel(q);
+            for (int i = 0; i < size; i++)
+            {
+                ptr[i] = p[0];
+                p += inch;
+            }
+        }
+        ref = m;
+    }
+
+    virtual int compare() const
+    {
+        return compare_floats(out, ref);
+    }
+
+protected:
+    const char* case_name;
+    int type;
+    int inch;
+    int outch;
+    int map[4];
+    int w;
+    int h;
+    std::vector<unsigned char> pixels;
+    ncnn::Mat out;
+    ncnn::Mat ref;
+};
+
+class ToPixelsCase : public PixelCase
+{
+public:
+    ToPixelsCase(const char* _name, int _type, int _inch, int _outch, const int* _map, int _w, int _h)
+        : case_name(_name), type(_type), inch(_inch), outch(_outch), w(_w), h(_h)
+    {
+        // -1 in map fills 255
+        for (int k = 0; k < outch; k++)
+            map[k] = _map[k];
+
+        m.create(w, h, inch);
+        for (int q = 0; q < inch; q++)
+        {
+            float* ptr = m.channel(q);
+            for (int i = 0; i < w * h; i++)
+                ptr[i] = (float)(rand() % 300 - 20) + (rand() % 100) * 0.01f;
+        }
+
+        out.resize(w * h * outch);
+        ref.resize(w * h * outch);
+    }
+
+    virtual const char* name() const
+    {
+        return case_name;
+    }
+
+    virtual void run_ncnn()
+    {
+        m.to_pixels(out.data(), type);
+    }
+
+    virtual void run_scalar()
+    {
+        const int size = w * h;
+        for (int k = 0; k < outch; k++)
+        {
+            unsigned char* p = ref.data() + k;
+            if (map[k] == -1)
+            {
+                for (int i = 0; i < size; i++)
+                {
+                    p[0] = 255;
+                    p += outch;
+                }
+                continue;
+            }
+
+            const float* ptr = m.channel(map[k]);
+            for (int i = 0; i < size; i++)
+            {
+                p[0] = SATURATE_CAST_UCHAR(ptr[i]);
+                p += outch;
+            }
+        }
+    }
+
+    virtual int compare() const
+    {
+        return compare_bytes(out, ref);
+    }
+
+protected:
+    const char* case_name;
+    int type;
+    int inch;
+    int outch;
+    int map[4];
+    int w;
+    int h;
+    ncnn::Mat m;
+    std::vector<unsigned char> out;
+    std::vector<unsigned char> ref;
+};
+
+class ResizeBilinearC3Case : public PixelCase
+{
+public:
+    ResizeBilinearC3Case(int _srcw, int _srch, int _w, int _h)
+        : srcw(_srcw), srch(_srch), w(_w), h(_h)
+    {
+        sprintf(case_name, "resize_bilinear_c3 %dx%d", w, h);
+
+        src.resize(srcw * srch * 3);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = (unsigned char)(rand() % 256);
+
+        out.resize(w * h * 3);
+        ref.resize(w * h * 3);
+    }
+
+    virtual const char* name() const
+    {
+        return case_name;
+    }
+
+    virtual void run_ncnn()
+    {
+        ncnn::resize_bilinear_c3(src.data(), srcw, srch, out.data(), w, h);
+    }
+
+    // fixed point bilinear with the same coefficients as ncnn, one pixel at a time
+    virtual void run_scalar()
+    {
+        const int INTER_RESIZE_COEF_SCALE = 1 << 11;
+        const double scale_x = (double)srcw / w;
+        const double scale_y = (double)srch / h;
+
+        std::vector<int> xofs(w);
+        std::vector<short> ialpha(w * 2);
+        for (int dx = 0; dx < w; dx++)
+        {
+            float fx = (float)((dx + 0.5) * scale_x - 0.5);
+            int sx = (int)floor(fx);
+            fx -= sx;
+            if (sx < 0)
+            {
+                sx = 0;
+                fx = 0.f;
+            }
+            if (sx >= srcw - 1)
+            {
+                sx = srcw - 2;
+                fx = 1.f;
+            }
+            xofs[dx] = sx * 3;
+            ialpha[dx * 2] = saturate_cast_short((1.f - fx) * INTER_RESIZE_COEF_SCALE);
+            ialpha[dx * 2 + 1] = saturate_cast_short(fx * INTER_RESIZE_COEF_SCALE);
+        }
+
+        for (int dy = 0; dy < h; dy++)
+        {
+            float fy = (float)((dy + 0.5) * scale_y - 0.5);
+            int sy = (int)floor(fy);
+            fy -= sy;
+            if (sy < 0)
+            {
+                sy = 0;
+                fy = 0.f;
+            }
+            if (sy >= srch - 1)
+            {
+                sy = srch - 2;
+                fy = 1.f;
+            }
+            const short b0 = saturate_cast_short((1.f - fy) * INTER_RESIZE_COEF_SCALE);
+            const short b1 = saturate_cast_short(fy * INTER_RESIZE_COEF_SCALE);
+
+            const unsigned char* S0 = src.data() + srcw * 3 * sy;
+            const unsigned char* S1 = S0 + srcw * 3;
+            unsigned char* D = ref.data() + w * 3 * dy;
+            for (int dx = 0; dx < w; dx++)
+            {
+                const short a0 = ialpha[dx * 2];
+                const short a1 = ialpha[dx * 2 + 1];
+                for (int c = 0; c < 3; c++)
+                {
+                    const int sx = xofs[dx] + c;
+                    short r0 = (short)((S0[sx] * a0 + S0[sx + 3] * a1) >> 4);
+                    short r1 = (short)((S1[sx] * a0 + S1[sx + 3] * a1) >> 4);
+                    D[dx * 3 + c] = (unsigned char)(((short)((b0 * r0) >> 16) + (short)((b1 * r1) >> 16) + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    virtual int compare() const
+    {
+        return compare_bytes(out, ref);
+    }
+
+protected:
+    static short saturate_cast_short(float X)
+    {
+        return (short)::std::min(::std::max((int)(X + (X >= 0.f ? 0.5f : -0.5f)), SHRT_MIN), SHRT_MAX);
+    }
+
+    char case_name[64];
+    int srcw;
+    int srch;
+    int w;
+    int h;
+    std::vector<unsigned char> src;
+    std::vector<unsigned char> out;
+    std::vector<unsigned char> ref;
+};
+
+#if NCNN_PIXEL_AFFINE
+class WarpAffineBilinearC3Case : public PixelCase
+{
+public:
+    WarpAffineBilinearC3Case(int _w, int _h)
+        : w(_w), h(_h)
+    {
+        src.resize(w * h * 3);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = (unsigned char)(rand() % 256);
+
+        // shrink and rotate around the center so that every sample lands inside
+        ncnn::get_rotation_matrix(10.f, 0.75f, w / 2.f, h / 2.f, tm);
+
+        out.resize(w * h * 3);
+        ref.resize(w * h * 3);
+    }
+
+    virtual const char* name() const
+    {
+        return "warpaffine_bilinear_c3";
+    }
+
+    virtual void run_ncnn()
+    {
+        ncnn::warpaffine_bilinear_c3(src.data(), w, h, out.data(), w, h, tm);
+    }
+
+    virtual void run_scalar()
+    {
+        std::vector<int> adelta(w);
+        std::vector<int> bdelta(w);
+        for (int x = 0; x < w; x++)
+        {
+            adelta[x] = saturate_cast_int(tm[0] * x * (1 << 10));
+            bdelta[x] = saturate_cast_int(tm[3] * x * (1 << 10));
+        }
+
+        for (int y = 0; y < h; y++)
+        {
+            const int X0 = saturate_cast_int((tm[1] * y + tm[2]) * (1 << 10));
+            const int Y0 = saturate_cast_int((tm[4] * y + tm[5]) * (1 << 10));
+
+            unsigned char* D = ref.data() + w * 3 * y;
+            for (int x = 0; x < w; x++)
+            {
+                const int X = X0 + adelta[x];
+                const int Y = Y0 + bdelta[x];
+                const int sx = X >> 10;
+                const int sy = Y >> 10;
+                const int fx = X & ((1 << 10) - 1);
+                const int fy = Y & ((1 << 10) - 1);
+
+                const unsigned char* a0 = src.data() + w * 3 * sy + sx * 3;
+                const unsigned char* a1 = a0 + 3;
+                const unsigned char* b0 = a0 + w * 3;
+                const unsigned char* b1 = b0 + 3;
+
+                for (int c = 0; c < 3; c++)
+                {
+                    unsigned short ra = (unsigned short)((a0[c] * ((1 << 10) - fx) + a1[c] * fx) >> 5);
+                    unsigned short rb = (unsigned short)((b0[c] * ((1 << 10) - fx) + b1[c] * fx) >> 5);
+                    D[x * 3 + c] = (unsigned char)((ra * ((1 << 10) - fy) + rb * fy) >> 15);
+                }
+            }
+        }
+    }
+
+    virtual int compare() const
+    {
+        return compare_bytes(out, ref);
+    }
+
+protected:
+    static int saturate_cast_int(float X)
+    {
+        return (int)::std::min(::std::max((int)(X + (X >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX);
+    }
+
+    int w;
+    int h;
+    float tm[6];
+    std::vector<unsigned char> src;
+    std::vector<unsigned char> out;
+    std::vector<unsigned char> ref;
+};
+
+#endif // NCNN_PIXEL_AFFINE
+
+#if NCNN_PIXEL_ROTATE
+class RotateC3Case : public PixelCase
+{
+public:
+    RotateC3Case(int _type, int _srcw, int _srch)
+        : type(_type), srcw(_srcw), srch(_srch)
+    {
+        sprintf(case_name, "kanna_rotate_c3 type %d", type);
+
+        w = type <= 4 ? srcw : srch;
+        h = type <= 4 ? srch : srcw;
+
+        src.resize(srcw * srch * 3);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = (unsigned char)(rand() % 256);
+
+        out.resize(w * h * 3);
+        ref.resize(w * h * 3);
+    }
+
+    virtual const char* name() const
+    {
+        return case_name;
+    }
+
+    virtual void run_ncnn()
+    {
+        ncnn::kanna_rotate_c3(src.data(), srcw, srch, out.data(), w, h, type);
+    }
+
+    virtual void run_scalar()
+    {
+        for (int sy = 0; sy < srch; sy++)
+        {
+            const unsigned char* S = src.data() + srcw * 3 * sy;
+            for (int sx = 0; sx < srcw; sx++)
+            {
+                int dx = sx;
+                int dy = sy;
+                switch (type)
+                {
+                case 2:
+                    dx = w - 1 - sx;
+                    break;
+                case 3:
+                    dx = w - 1 - sx;
+                    dy = h - 1 - sy;
+                    break;
+                case 4:
+                    dy = h - 1 - sy;
+                    break;
+                case 5:
+                    dx = sy;
+                    dy = sx;
+                    break;
+                case 6:
+                    dx = w - 1 - sy;
+                    dy = sx;
+                    break;
+                case 7:
+                    dx = w - 1 - sy;
+                    dy = h - 1 - sx;
+                    break;
+                case 8:
+                    dx = sy;
+                    dy = h - 1 - sx;
+                    break;
+                }
+
+                unsigned char* D = ref.data() + (w * dy + dx) * 3;
+                D[0] = S[sx * 3];
+                D[1] = S[sx * 3 + 1];
+                D[2] = S[sx * 3 + 2];
+            }
+        }
+    }
+
+    virtual int compare() const
+    {
+        return compare_bytes(out, ref);
+    }
+
+protected:
+    char case_name[64];
+    int type;
+    int srcw;
+    int srch;
+    int w;
+    int h;
+    std::vector<unsigned char> src;
+    std::vector<unsigned char> out;
+    std::vector<unsigned char> ref;
+};
+
+#endif // NCNN_PIXEL_ROTATE
+
+static double time_min(PixelCase* pc, bool use_ncnn)
+{
+    // warm up
+    use_ncnn ? pc->run_ncnn() : pc->run_scalar();
+
+    double time_min = DBL_MAX;
+    for (int i = 0; i < g_loop_count; i++)
+    {
+        double start = ncnn::get_current_time();
+
+        use_ncnn ? pc->run_ncnn() : pc->run_scalar();
+
+        double end = ncnn::get_current_time();
+
+        time_min = std::min(time_min, end - start);
+    }
+
+    return time_min;
+}
+
+static int benchmark(PixelCase* pc)
+{
+    const double ncnn_ms = time_min(pc, true);
+    const double scalar_ms = time_min(pc, false);
+
+    const int ret = pc->compare();
+
+    fprintf(stderr, "%32s  ncnn = %8.3f  scalar = %8.3f  speedup = %6.2fx  %s\n", pc->name(), ncnn_ms, scalar_ms, scalar_ms / ncnn_ms, ret == 0 ? "exact" : "MISMATCH");
+
+    return ret;
+}
+
+void show_usage()
+{
+    fprintf(stderr, "Usage: benchmatpixel [w] [h] [loop count]\n");
+}
+
+int main(int argc, char** argv)
+{
+    int w = 1920;
+    int h = 1080;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if ((argv[i][0] == '-' && argv[i][1] == 'h') || strcmp(argv[i], "--help") == 0)
+        {
+            show_usage();
+            return -1;
+        }
+    }
+
+    if (argc >= 2)
+        w = std::max(atoi(argv[1]), 2);
+    if (argc >= 3)
+        h = std::max(atoi(argv[2]), 2);
+    if (argc >= 4)
+        g_loop_count = std::max(atoi(argv[3]), 1);
+
+    fprintf(stderr, "w = %d  h = %d  loop_count = %d\n", w, h, g_loop_count);
+    fprintf(stderr, "cpu_support_x86_avx2 = %d\n", ncnn::cpu_support_x86_avx2() ? 1 : 0);
+    fprintf(stderr, "cpu_support_x86_avx512 = %d\n", ncnn::cpu_support_x86_avx512() ? 1 : 0);
+
+    srand(7767517);
+
+    const int map_rgb[4] = {0, 1, 2, 3};
+    const int map_bgr[3] = {2, 1, 0};
+    const int map_rgba2rgb_out[4] = {0, 1, 2, -1};
+    const int map_bgr2rgb_out[3] = {2, 1, 0};
+
+    std::vector<PixelCase*> cases;
+    cases.push_back(new FromPixelsCase("from_pixels GRAY", ncnn::Mat::PIXEL_GRAY, 1, 1, map_rgb, w, h));
+    cases.push_back(new FromPixelsCase("from_pixels RGB", ncnn::Mat::PIXEL_RGB, 3, 3, map_rgb, w, h));
+    cases.push_back(new FromPixelsCase("from_pixels RGB2BGR", ncnn::Mat::PIXEL_RGB2BGR, 3, 3, map_bgr, w, h));
+    cases.push_back(new FromPixelsCase("from_pixels RGBA", ncnn::Mat::PIXEL_RGBA, 4, 4, map_rgb, w, h));
+    cases.push_back(new FromPixelsCase("from_pixels RGBA2RGB", ncnn::Mat::PIXEL_RGBA2RGB, 4, 3, map_rgb, w, h));
+    cases.push_back(new ToPixelsCase("to_pixels GRAY", ncnn::Mat::PIXEL_GRAY, 1, 1, map_rgb, w, h));
+    cases.push_back(new ToPixelsCase("to_pixels RGB", ncnn::Mat::PIXEL_RGB, 3, 3, map_rgb, w, h));
+    cases.push_back(new ToPixelsCase("to_pixels BGR2RGB", ncnn::Mat::PIXEL_BGR2RGB, 3, 3, map_bgr2rgb_out, w, h));
+    cases.push_back(new ToPixelsCase("to_pixels RGBA", ncnn::Mat::PIXEL_RGBA, 4, 4, map_rgb, w, h));
+    cases.push_back(new ToPixelsCase("to_pixels RGB2RGBA", ncnn::Mat::PIXEL_RGB2RGBA, 3, 4, map_rgba2rgb_out, w, h));
+    cases.push_back(new ResizeBilinearC3Case(w, h, w / 2, h / 2));
+    cases.push_back(new ResizeBilinearC3Case(w, h, w * 3 / 2, h * 3 / 2));
+#if NCNN_PIXEL_AFFINE
+    cases.push_back(new WarpAffineBilinearC3Case(w, h));
+#endif // NCNN_PIXEL_AFFINE
+#if NCNN_PIXEL_ROTATE
+    for (int type = 2; type <= 8; type++)
+    {
+        cases.push_back(new RotateC3Case(type, w, h));
+    }
+#endif // NCNN_PIXEL_ROTATE
+
+    int ret = 0;
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        ret |= benchmark(cases[i]);
+        delete cases[i];
+    }
+
+    return ret == 0 ? 0 : -1;
+}
@@ -2,9 +2,15 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <float.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#ifdef __APPLE__
+#include <sys/resource.h>
+#endif
+
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #endif
@@ -16,6 +22,8 @@
 #include "gpu.h"
 
 #ifndef NCNN_SIMPLESTL
+#include <algorithm>
+#include <string>
 #include <vector>
 #endif
 
@@ -36,6 +44,60 @@ public:
 static int g_warmup_loop_count = 8;
 static int g_loop_count = 4;
 static bool g_enable_cooling_down = true;
+static std::vector<int> g_instances(1, 1);
+
+// track the high-water mark of bytes in use
+// only used in an untimed pass after the timed loop, so the lock never skews latency
+class StatAllocator : public ncnn::Allocator
+{
+public:
+    StatAllocator(ncnn::Allocator* _allocator)
+        : allocator(_allocator), used_bytes(0), peak_bytes(0)
+    {
+    }
+
+    virtual void* fastMalloc(size_t size)
+    {
+        // keep the size in front of the returned pointer
+        unsigned char* ptr = (unsigned char*)allocator->fastMalloc(size + NCNN_MALLOC_ALIGN);
+        if (!ptr)
+            return 0;
+
+        *(size_t*)ptr = size;
+
+        lock.lock();
+        used_bytes += size;
+        peak_bytes = std::max(peak_bytes, used_bytes);
+        lock.unlock();
+
+        return ptr + NCNN_MALLOC_ALIGN;
+    }
+
+    virtual void fastFree(void* ptr)
+    {
+        if (!ptr)
+            return;
+
+        unsigned char* p = (unsigned char*)ptr - NCNN_MALLOC_ALIGN;
+
+        lock.lock();
+        used_bytes -= *(size_t*)p;
+        lock.unlock();
+
+        allocator->fastFree(p);
+    }
+
+    size_t peak() const
+    {
+        return peak_bytes;
+    }
+
+private:
+    ncnn::Allocator* allocator;
+    ncnn::Mutex lock;
+    size_t used_bytes;
+    size_t peak_bytes;
+};
 
 static ncnn::UnlockedPoolAllocator g_blob_pool_allocator;
 static ncnn::PoolAllocator g_workspace_pool_allocator;
@@ -46,6 +108,141 @@ static ncnn::VkAllocator* g_blob_vkallocator = 0;
 static ncnn::VkAllocator* g_staging_vkallocator = 0;
 #endif // NCNN_VULKAN
 
+struct BenchResult
+{
+    std::string name;
+    int instances;
+    int num_threads;
+    int loop_count;
+
+    // latency in ms
+    double time_min;
+    double time_max;
+    double time_avg;
+    double time_p50;
+    double time_p90;
+    double time_p99;
+
+    // inferences per second of all instances
+    double fps;
+
+    // cold start in ms
+    double load_param_time;
+    double load_model_time;
+    double first_time;
+
+    double peak_rss_kb;
+    double blob_peak_bytes;
+    double workspace_peak_bytes;
+};
+
+static std::vector<BenchResult> g_results;
+
+static void reset_peak_rss()
+{
+#if defined __linux__ && !defined __EMSCRIPTEN__
+    // reset VmHWM to the current rss
+    FILE* fp = fopen("/proc/self/clear_refs", "wb");
+    if (fp)
+    {
+        fprintf(fp, "5");
+        fclose(fp);
+    }
+#endif
+}
+
+static double get_peak_rss_kb()
+{
+    double peak_rss_kb = 0;
+#if defined __linux__ && !defined __EMSCRIPTEN__
+    FILE* fp = fopen("/proc/self/status", "rb");
+    if (fp)
+    {
+        char line[256];
+        while (fgets(line, 256, fp))
+        {
+            long kb = 0;
+            if (sscanf(line, "VmHWM: %ld kB", &kb) == 1)
+            {
+                peak_rss_kb = (double)kb;
+                break;
+            }
+        }
+        fclose(fp);
+    }
+#elif defined __APPLE__
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        peak_rss_kb = usage.ru_maxrss / 1024.0;
+#endif
+    return peak_rss_kb;
+}
+
+static int compare_time(const void* a, const void* b)
+{
+    const double ta = *(const double*)a;
+    const double tb = *(const double*)b;
+    return ta < tb ? -1 : ta > tb ? 1 : 0;
+}
+
+// nearest rank on sorted times
+static double percentile(const std::vector<double>& sorted_times, double p)
+{
+    int n = (int)sorted_times.size();
+    int i = (int)ceil(p * n) - 1;
+    i = std::min(std::max(i, 0), n - 1);
+    return sorted_times[i];
+}
+
+static void run_once(const ncnn::Net& net, const std::vector<ncnn::Mat>& inputs, ncnn::Allocator* blob_allocator, ncnn::Allocator* workspace_allocator)
+{
+    const std::vector<const char*>& input_names = net.input_names();
+    const std::vector<const char*>& output_names = net.output_names();
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_blob_allocator(blob_allocator);
+    ex.set_workspace_allocator(workspace_allocator);
+
+    for (size_t j = 0; j < input_names.size(); ++j)
+    {
+        ncnn::Mat in = inputs[j];
+        ex.input(input_names[j], in);
+    }
+
+    for (size_t j = 0; j < output_names.size(); ++j)
+    {
+        ncnn::Mat out;
+        ex.extract(output_names[j], out);
+    }
+}
+
+struct InstanceContext
+{
+    const ncnn::Net* net;
+    const std::vector<ncnn::Mat>* inputs;
+    ncnn::Allocator* blob_allocator;
+    ncnn::Allocator* workspace_allocator;
+    std::vector<double> times;
+};
+
+static void* run_instance(void* args)
+{
+    InstanceContext* ctx = (InstanceContext*)args;
+
+    for (int i = 0; i < g_loop_count; i++)
+    {
+        double start = ncnn::get_current_time();
+
+        run_once(*ctx->net, *ctx->inputs, ctx->blob_allocator, ctx->workspace_allocator);
+
+        double end = ncnn::get_current_time();
+
+        ctx->times.push_back(end - start);
+    }
+
+    return 0;
+}
+
 void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncnn::Option& opt, bool fixed_path = true)
 {
     // Skip if int8 model name and using GPU
@@ -67,6 +264,13 @@ void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncn
     }
 #endif // NCNN_VULKAN
 
+    reset_peak_rss();
+
+    BenchResult result;
+    result.name = comment;
+    result.num_threads = opt.num_threads;
+    result.loop_count = g_loop_count;
+
     ncnn::Net net;
 
     net.opt = opt;
@@ -84,6 +288,8 @@ void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncn
 #define MODEL_DIR ""
 #endif
 
+    double load_param_start = ncnn::get_current_time();
+
     if (fixed_path)
     {
         char parampath[256];
@@ -95,17 +301,17 @@ void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncn
         net.load_param(comment);
     }
 
+    double load_model_start = ncnn::get_current_time();
+
     DataReaderFromEmpty dr;
     net.load_model(dr);
 
-    const std::vector<const char*>& input_names = net.input_names();
-    const std::vector<const char*>& output_names = net.output_names();
+    double load_model_end = ncnn::get_current_time();
 
-    if (g_enable_cooling_down)
-    {
-        // sleep 10 seconds for cooling down SOC  :(
-        ncnn::sleep(10 * 1000);
-    }
+    result.load_param_time = load_model_start - load_param_start;
+    result.load_model_time = load_model_end - load_model_start;
+
+    const std::vector<const char*>& input_names = net.input_names();
 
     if (input_names.size() > _in.size())
     {
@@ -120,57 +326,152 @@ void benchmark(const char* comment, const std::vector<ncnn::Mat>& _in, const ncn
         in.fill(0.01f);
     }
 
+    // first inference after loading
+    {
+        double start = ncnn::get_current_time();
+
+        run_once(net, _in, &g_blob_pool_allocator, &g_workspace_pool_allocator);
+
+        double end = ncnn::get_current_time();
+
+        result.first_time = end - start;
+    }
+
+    if (g_enable_cooling_down)
+    {
+        // sleep 10 seconds for cooling down SOC  :(
+        ncnn::sleep(10 * 1000);
+    }
+
     // warm up
-    for (int i = 0; i < g_warmup_loop_count; i++)
+    for (int i = 1; i < g_warmup_loop_count; i++)
+    {
+        run_once(net, _in, &g_blob_pool_allocator, &g_workspace_pool_allocator);
+    }
+
+    for (size_t k = 0; k < g_instances.size(); k++)
     {
-        ncnn::Extractor ex = net.create_extractor();
-        for (size_t j = 0; j < input_names.size(); ++j)
+        const int instances = g_instances[k];
+
+        if (opt.use_vulkan_compute && instances > 1)
         {
-            ncnn::Mat in = _in[j];
-            ex.input(input_names[j], in);
+            fprintf(stderr, "%20s  skipped (concurrent instances+GPU not supported)\n", comment);
+            continue;
         }
 
-        for (size_t j = 0; j < output_names.size(); ++j)
+        // the first instance takes the global allocators, others get their own
+        std::vector<ncnn::UnlockedPoolAllocator*> blob_pool_allocators;
+        std::vector<ncnn::PoolAllocator*> workspace_pool_allocators;
+
+        std::vector<InstanceContext> contexts(instances);
+        for (int i = 0; i < instances; i++)
         {
-            ncnn::Mat out;
-            ex.extract(output_names[j], out);
-        }
-    }
+            contexts[i].net = &net;
+            contexts[i].inputs = &_in;
 
-    double time_min = DBL_MAX;
-    double time_max = -DBL_MAX;
-    double time_avg = 0;
+            if (i == 0)
+            {
+                contexts[i].blob_allocator = &g_blob_pool_allocator;
+                contexts[i].workspace_allocator = &g_workspace_pool_allocator;
+                continue;
+            }
+
+            ncnn::UnlockedPoolAllocator* blob_pool_allocator = new ncnn::UnlockedPoolAllocator;
+            ncnn::PoolAllocator* workspace_pool_allocator = new ncnn::PoolAllocator;
+            blob_pool_allocator->set_size_compare_ratio(0.f);
+            workspace_pool_allocator->set_size_compare_ratio(0.f);
+            blob_pool_allocators.push_back(blob_pool_allocator);
+            workspace_pool_allocators.push_back(workspace_pool_allocator);
+
+            contexts[i].blob_allocator = blob_pool_allocator;
+            contexts[i].workspace_allocator = workspace_pool_allocator;
+
+            // warm up the new pools
+            run_once(net, _in, blob_pool_allocator, workspace_pool_allocator);
+        }
 
-    for (int i = 0; i < g_loop_count; i++)
-    {
         double start = ncnn::get_current_time();
+
+        if (instances == 1)
+        {
+            run_instance(&contexts[0]);
+        }
+        else
         {
-            ncnn::Extractor ex = net.create_extractor();
-            for (size_t j = 0; j < input_names.size(); ++j)
+            std::vector<ncnn::Thread*> threads(instances);
+            for (int i = 0; i < instances; i++)
             {
-                ncnn::Mat in = _in[j];
-                ex.input(input_names[j], in);
+                threads[i] = new ncnn::Thread(run_instance, (void*)&contexts[i]);
             }
-
-            for (size_t j = 0; j < output_names.size(); ++j)
+            for (int i = 0; i < instances; i++)
             {
-                ncnn::Mat out;
-                ex.extract(output_names[j], out);
+                threads[i]->join();
+                delete threads[i];
             }
         }
 
         double end = ncnn::get_current_time();
 
-        double time = end - start;
+        std::vector<double> times;
+        for (int i = 0; i < instances; i++)
+        {
+            times.insert(times.end(), contexts[i].times.begin(), contexts[i].times.end());
+        }
 
-        time_min = std::min(time_min, time);
-        time_max = std::max(time_max, time);
-        time_avg += time;
-    }
+        if (times.empty())
+            continue;
 
-    time_avg /= g_loop_count;
+        qsort(&times[0], times.size(), sizeof(double), compare_time);
 
-    fprintf(stderr, "%20s  min = %7.2f  max = %7.2f  avg = %7.2f\n", comment, time_min, time_max, time_avg);
+        result.instances = instances;
+        result.time_min = times[0];
+        result.time_max = times[times.size() - 1];
+        result.time_avg = 0;
+        for (size_t i = 0; i < times.size(); i++)
+        {
+            result.time_avg += times[i];
+        }
+        result.time_avg /= times.size();
+        result.time_p50 = percentile(times, 0.50);
+        result.time_p90 = percentile(times, 0.90);
+        result.time_p99 = percentile(times, 0.99);
+        result.fps = times.size() * 1000 / (end - start);
+
+        result.peak_rss_kb = get_peak_rss_kb();
+
+        // untimed pass for the blob and workspace peaks of each instance
+        result.blob_peak_bytes = 0;
+        result.workspace_peak_bytes = 0;
+        for (int i = 0; i < instances; i++)
+        {
+            StatAllocator blob_allocator(contexts[i].blob_allocator);
+            StatAllocator workspace_allocator(contexts[i].workspace_allocator);
+
+            run_once(net, _in, &blob_allocator, &workspace_allocator);
+
+            result.blob_peak_bytes += (double)blob_allocator.peak();
+            result.workspace_peak_bytes += (double)workspace_allocator.peak();
+        }
+
+        for (size_t i = 0; i < blob_pool_allocators.size(); i++)
+        {
+            delete blob_pool_allocators[i];
+            delete workspace_pool_allocators[i];
+        }
+
+        if (g_instances.size() == 1 && instances == 1)
+        {
+            fprintf(stderr, "%20s  min = %7.2f  max = %7.2f  avg = %7.2f  p50 = %7.2f  p90 = %7.2f  p99 = %7.2f\n", comment,
+                    result.time_min, result.time_max, result.time_avg, result.time_p50, result.time_p90, result.time_p99);
+        }
+        else
+        {
+            fprintf(stderr, "%20s  min = %7.2f  max = %7.2f  avg = %7.2f  p50 = %7.2f  p90 = %7.2f  p99 = %7.2f  instances = %2d  fps = %7.2f\n", comment,
+                    result.time_min, result.time_max, result.time_avg, result.time_p50, result.time_p90, result.time_p99, instances, result.fps);
+        }
+
+        g_results.push_back(result);
+    }
 }
 
 void benchmark(const char* comment, const ncnn::Mat& _in, const ncnn::Option& opt, bool fixed_path = true)
@@ -180,11 +481,317 @@ void benchmark(const char* comment, const ncnn::Mat& _in, const ncnn::Option& op
     return benchmark(comment, inputs, opt, fixed_path);
 }
 
+struct ResultField
+{
+    const char* key;
+    double value;
+};
+
+static const int result_field_count = 16;
+
+static void get_result_fields(const BenchResult& r, ResultField* fields)
+{
+    const ResultField f[result_field_count] = {
+        {"instances", (double)r.instances},
+        {"num_threads", (double)r.num_threads},
+        {"loop_count", (double)r.loop_count},
+        {"min", r.time_min},
+        {"max", r.time_max},
+        {"avg", r.time_avg},
+        {"p50", r.time_p50},
+        {"p90", r.time_p90},
+        {"p99", r.time_p99},
+        {"fps", r.fps},
+        {"load_param", r.load_param_time},
+        {"load_model", r.load_model_time},
+        {"first_inference", r.first_time},
+        {"peak_rss_kb", r.peak_rss_kb},
+        {"blob_peak_bytes", r.blob_peak_bytes},
+        {"workspace_peak_bytes", r.workspace_peak_bytes},
+    };
+
+    memcpy(fields, f, sizeof(f));
+}
+
+static void set_result_field(BenchResult& r, const char* key, const char* value)
+{
+    if (strcmp(key, "name") == 0)
+    {
+        r.name = value;
+        return;
+    }
+
+    double v = atof(value);
+    if (strcmp(key, "instances") == 0)
+        r.instances = (int)v;
+    if (strcmp(key, "num_threads") == 0)
+        r.num_threads = (int)v;
+    if (strcmp(key, "loop_count") == 0)
+        r.loop_count = (int)v;
+    if (strcmp(key, "min") == 0)
+        r.time_min = v;
+    if (strcmp(key, "max") == 0)
+        r.time_max = v;
+    if (strcmp(key, "avg") == 0)
+        r.time_avg = v;
+    if (strcmp(key, "p50") == 0)
+        r.time_p50 = v;
+    if (strcmp(key, "p90") == 0)
+        r.time_p90 = v;
+    if (strcmp(key, "p99") == 0)
+        r.time_p99 = v;
+    if (strcmp(key, "fps") == 0)
+        r.fps = v;
+    if (strcmp(key, "load_param") == 0)
+        r.load_param_time = v;
+    if (strcmp(key, "load_model") == 0)
+        r.load_model_time = v;
+    if (strcmp(key, "first_inference") == 0)
+        r.first_time = v;
+    if (strcmp(key, "peak_rss_kb") == 0)
+        r.peak_rss_kb = v;
+    if (strcmp(key, "blob_peak_bytes") == 0)
+        r.blob_peak_bytes = v;
+    if (strcmp(key, "workspace_peak_bytes") == 0)
+        r.workspace_peak_bytes = v;
+}
+
+// one result object per line
+static int write_results_json(const char* path, const std::vector<BenchResult>& results)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    fprintf(fp, "[\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        ResultField fields[result_field_count];
+        get_result_fields(results[i], fields);
+
+        fprintf(fp, "  {\"name\": \"%s\"", results[i].name.c_str());
+        for (int j = 0; j < result_field_count; j++)
+        {
+            fprintf(fp, ", \"%s\": %.10g", fields[j].key, fields[j].value);
+        }
+        fprintf(fp, i + 1 == results.size() ? "}\n" : "},\n");
+    }
+    fprintf(fp, "]\n");
+
+    fclose(fp);
+    return 0;
+}
+
+static int write_results_csv(const char* path, const std::vector<BenchResult>& results)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    ResultField fields[result_field_count];
+    get_result_fields(BenchResult(), fields);
+
+    fprintf(fp, "name");
+    for (int j = 0; j < result_field_count; j++)
+    {
+        fprintf(fp, ",%s", fields[j].key);
+    }
+    fprintf(fp, "\n");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        get_result_fields(results[i], fields);
+
+        fprintf(fp, "%s", results[i].name.c_str());
+        for (int j = 0; j < result_field_count; j++)
+        {
+            fprintf(fp, ",%.10g", fields[j].value);
+        }
+        fprintf(fp, "\n");
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+// strip blanks and quotes around s in place
+static char* trim_value(char* s)
+{
+    while (*s && strchr(" \t\r\n\"", *s))
+        s++;
+
+    size_t len = strlen(s);
+    while (len > 0 && strchr(" \t\r\n\"", s[len - 1]))
+        s[--len] = '\0';
+
+    return s;
+}
+
+// read the json or csv written above
+static int read_results(const char* path, std::vector<BenchResult>& results)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    char csv_keys[4096] = "";
+    std::vector<char*> keys;
+
+    char line[4096];
+    while (fgets(line, 4096, fp))
+    {
+        char* s = trim_value(line);
+        if (s[0] == '\0' || strcmp(s, "[") == 0 || strcmp(s, "]") == 0)
+            continue;
+
+        BenchResult r = BenchResult();
+
+        if (s[0] == '{')
+        {
+            // {"key": value, ...}
+            char* end = strrchr(s, '}');
+            if (end)
+                *end = '\0';
+
+            char* p = s + 1;
+            while (p)
+            {
+                char* comma = strchr(p, ',');
+                if (comma)
+                    *comma = '\0';
+
+                char* colon = strchr(p, ':');
+                if (colon)
+                {
+                    *colon = '\0';
+                    set_result_field(r, trim_value(p), trim_value(colon + 1));
+                }
+
+                p = comma ? comma + 1 : 0;
+            }
+        }
+        else
+        {
+            if (keys.empty())
+            {
+                // the header line, keep the key strings alive for the following rows
+                strcpy(csv_keys, s);
+
+                char* p = csv_keys;
+                while (p)
+                {
+                    char* comma = strchr(p, ',');
+                    if (comma)
+                        *comma = '\0';
+
+                    keys.push_back(trim_value(p));
+
+                    p = comma ? comma + 1 : 0;
+                }
+                continue;
+            }
+
+            char* p = s;
+            for (size_t j = 0; p && j < keys.size(); j++)
+            {
+                char* comma = strchr(p, ',');
+                if (comma)
+                    *comma = '\0';
+
+                set_result_field(r, keys[j], trim_value(p));
+
+                p = comma ? comma + 1 : 0;
+            }
+        }
+
+        results.push_back(r);
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+// time and memory, lower is better
+static bool is_regression(double base, double current, double threshold, double* change)
+{
+    *change = base == 0 ? 0 : (current - base) / base * 100;
+
+    return *change > threshold;
+}
+
+// return 1 if any regression
+static int compare_results(const char* base_path, const char* current_path, double threshold)
+{
+    std::vector<BenchResult> base_results;
+    std::vector<BenchResult> current_results;
+    if (read_results(base_path, base_results) != 0 || read_results(current_path, current_results) != 0)
+        return -1;
+
+    fprintf(stderr, "threshold = %.2f%%\n", threshold);
+    fprintf(stderr, "%20s  %9s  %8s  %8s  %8s  %8s  %8s  %8s  %8s\n", "name", "instances", "avg", "change", "p99", "change", "peak MB", "change", "");
+
+    int regression_count = 0;
+    for (size_t i = 0; i < current_results.size(); i++)
+    {
+        const BenchResult& cur = current_results[i];
+
+        const BenchResult* base = 0;
+        for (size_t j = 0; j < base_results.size(); j++)
+        {
+            if (base_results[j].name == cur.name && base_results[j].instances == cur.instances)
+            {
+                base = &base_results[j];
+                break;
+            }
+        }
+
+        if (!base)
+        {
+            fprintf(stderr, "%20s  %9d  %8.2f  %8s\n", cur.name.c_str(), cur.instances, cur.time_avg, "new");
+            continue;
+        }
+
+        const double base_peak = base->blob_peak_bytes + base->workspace_peak_bytes;
+        const double cur_peak = cur.blob_peak_bytes + cur.workspace_peak_bytes;
+
+        double avg_change;
+        double p99_change;
+        double peak_change;
+        bool regression = false;
+        regression |= is_regression(base->time_avg, cur.time_avg, threshold, &avg_change);
+        regression |= is_regression(base->time_p99, cur.time_p99, threshold, &p99_change);
+        regression |= is_regression(base_peak, cur_peak, threshold, &peak_change);
+
+        fprintf(stderr, "%20s  %9d  %8.2f  %+7.1f%%  %8.2f  %+7.1f%%  %8.2f  %+7.1f%%  %s\n", cur.name.c_str(), cur.instances,
+                cur.time_avg, avg_change, cur.time_p99, p99_change, cur_peak / 1024 / 1024, peak_change, regression ? "REGRESSION" : "");
+
+        if (regression)
+            regression_count++;
+    }
+
+    fprintf(stderr, "%d regression(s)\n", regression_count);
+
+    return regression_count > 0 ? 1 : 0;
+}
+
 void show_usage()
 {
     fprintf(stderr, "Usage: benchncnn [loop count] [num threads] [powersave] [gpu device] [cooling down] [(key=value)...]\n");
     fprintf(stderr, "  param=model.param\n");
     fprintf(stderr, "  shape=[227,227,3],...\n");
+    fprintf(stderr, "  instances=1,2,4\n");
+    fprintf(stderr, "  json=result.json\n");
+    fprintf(stderr, "  csv=result.csv\n");
+    fprintf(stderr, "       benchncnn compare [base result] [current result] [threshold percent]\n");
 }
 
 static std::vector<ncnn::Mat> parse_shape_list(char* s)
@@ -249,6 +856,23 @@ static std::vector<ncnn::Mat> parse_shape_list(char* s)
     return mats;
 }
 
+static std::vector<int> parse_int_list(char* s)
+{
+    std::vector<int> values;
+
+    char* pch = strtok(s, ",");
+    while (pch != NULL)
+    {
+        int v = atoi(pch);
+        if (v > 0)
+            values.push_back(v);
+
+        pch = strtok(NULL, ",");
+    }
+
+    return values;
+}
+
 int main(int argc, char** argv)
 {
     int loop_count = 4;
@@ -258,6 +882,8 @@ int main(int argc, char** argv)
     int cooling_down = 1;
     char* model = 0;
     std::vector<ncnn::Mat> inputs;
+    const char* json_path = 0;
+    const char* csv_path = 0;
 
     for (int i = 1; i < argc; i++)
     {
@@ -274,6 +900,12 @@ int main(int argc, char** argv)
         }
     }
 
+    if (argc >= 4 && strcmp(argv[1], "compare") == 0)
+    {
+        double threshold = argc >= 5 ? atof(argv[4]) : 5.0;
+        return compare_results(argv[2], argv[3], threshold);
+    }
+
     if (argc >= 2)
     {
         loop_count = atoi(argv[1]);
@@ -316,6 +948,18 @@ int main(int argc, char** argv)
             model = value;
         if (strcmp(key, "shape") == 0)
             inputs = parse_shape_list(value);
+        if (strcmp(key, "instances") == 0)
+            g_instances = parse_int_list(value);
+        if (strcmp(key, "json") == 0)
+            json_path = value;
+        if (strcmp(key, "csv") == 0)
+            csv_path = value;
+    }
+
+    if (g_instances.empty())
+    {
+        fprintf(stderr, "instances empty!\n");
+        return -1;
     }
 
     if (model && inputs.empty())
@@ -384,6 +1028,15 @@ int main(int argc, char** argv)
     fprintf(stderr, "powersave = %d\n", ncnn::get_cpu_powersave());
     fprintf(stderr, "gpu_device = %d\n", gpu_device);
     fprintf(stderr, "cooling_down = %d\n", (int)g_enable_cooling_down);
+    if (g_instances.size() > 1 || g_instances[0] > 1)
+    {
+        fprintf(stderr, "instances =");
+        for (size_t i = 0; i < g_instances.size(); i++)
+        {
+            fprintf(stderr, " %d", g_instances[i]);
+        }
+        fprintf(stderr, "\n");
+    }
 
     if (model != 0)
     {
@@ -470,5 +1123,10 @@ int main(int argc, char** argv)
     delete g_staging_vkallocator;
 #endif // NCNN_VULKAN
 
+    if (json_path)
+        write_results_json(json_path, g_results);
+    if (csv_path)
+        write_results_csv(csv_path, g_results);
+
     return 0;
 }
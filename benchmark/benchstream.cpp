@@ -0,0 +1,247 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <algorithm>
+#include <functional>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "benchmark.h"
+#include "cpu.h"
+#include "datareader.h"
+#include "net.h"
+#include "streampipeline.h"
+
+class DataReaderFromEmpty : public ncnn::DataReader
+{
+public:
+    virtual int scan(const char* format, void* p) const
+    {
+        return 0;
+    }
+    virtual size_t read(void* buf, size_t size) const
+    {
+        memset(buf, 0, size);
+        return size;
+    }
+};
+
+struct StreamContext
+{
+    const char* input_name;
+    int frame_w;
+    int frame_h;
+    int target_w;
+    int target_h;
+};
+
+struct StreamFrame
+{
+    int top1;
+};
+
+// synthetic frame source, stands for decoding
+static void decode_frame(int frame_index, int frame_w, int frame_h, std::vector<unsigned char>& pixels)
+{
+    pixels.resize(frame_w * frame_h * 3);
+    for (int y = 0; y < frame_h; y++)
+    {
+        unsigned char* p = &pixels[y * frame_w * 3];
+        for (int x = 0; x < frame_w; x++)
+        {
+            p[0] = (unsigned char)(x + frame_index);
+            p[1] = (unsigned char)(y + frame_index);
+            p[2] = (unsigned char)(x ^ y);
+            p += 3;
+        }
+    }
+}
+
+static int preprocess(int frame_index, void* /*frame*/, ncnn::Extractor& ex, void* userdata)
+{
+    const StreamContext* ctx = (const StreamContext*)userdata;
+
+    std::vector<unsigned char> pixels;
+    decode_frame(frame_index, ctx->frame_w, ctx->frame_h, pixels);
+
+    ncnn::Mat in = ncnn::Mat::from_pixels_resize(&pixels[0], ncnn::Mat::PIXEL_RGB2BGR, ctx->frame_w, ctx->frame_h, ctx->target_w, ctx->target_h);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    const float norm_vals[3] = {1 / 58.f, 1 / 57.f, 1 / 57.f};
+    in.substract_mean_normalize(mean_vals, norm_vals);
+
+    return ex.input(ctx->input_name, in);
+}
+
+static int postprocess(int /*frame_index*/, void* frame, const std::vector<ncnn::Mat>& outputs, void* /*userdata*/)
+{
+    // rank the scores as a stand-in for decoding and nms
+    const ncnn::Mat out = outputs[0].reshape(outputs[0].w * outputs[0].h * outputs[0].d * outputs[0].c);
+
+    std::vector<std::pair<float, int> > scores(out.w);
+    for (int i = 0; i < out.w; i++)
+    {
+        scores[i] = std::make_pair(out[i], i);
+    }
+    std::sort(scores.begin(), scores.end(), std::greater<std::pair<float, int> >());
+
+    StreamFrame* f = (StreamFrame*)frame;
+    f->top1 = scores.empty() ? -1 : scores[0].second;
+
+    return 0;
+}
+
+static int run_sequential(const ncnn::Net& net, const char* output_name, StreamContext* ctx, std::vector<StreamFrame>& frames)
+{
+    for (int i = 0; i < (int)frames.size(); i++)
+    {
+        ncnn::Extractor ex = net.create_extractor();
+
+        int ret = preprocess(i, &frames[i], ex, ctx);
+        if (ret != 0)
+            return ret;
+
+        std::vector<ncnn::Mat> outputs(1);
+        ret = ex.extract(output_name, outputs[0]);
+        if (ret != 0)
+            return ret;
+
+        ret = postprocess(i, &frames[i], outputs, ctx);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int run_pipeline(const ncnn::Net& net, const char* output_name, StreamContext* ctx, std::vector<StreamFrame>& frames, int preprocess_workers, int inference_workers, int postprocess_workers, int queue_size)
+{
+    ncnn::StreamPipeline pipeline(&net, preprocess, postprocess, ctx);
+
+    std::vector<const char*> output_names(1, output_name);
+    pipeline.set_outputs(output_names);
+    pipeline.set_workers(preprocess_workers, inference_workers, postprocess_workers);
+    pipeline.set_queue_size(queue_size);
+
+    for (int i = 0; i < (int)frames.size(); i++)
+    {
+        if (pipeline.submit(&frames[i]) < 0)
+            return -1;
+    }
+
+    return pipeline.finish();
+}
+
+void show_usage()
+{
+    fprintf(stderr, "Usage: benchstream [model.param] [w] [h] [frame count] [num threads] [preprocess workers] [inference workers] [postprocess workers] [queue size]\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* parampath = "squeezenet.param";
+    int target_w = 227;
+    int target_h = 227;
+    int frame_count = 64;
+    int num_threads = ncnn::get_physical_big_cpu_count();
+    int preprocess_workers = 1;
+    int inference_workers = 1;
+    int postprocess_workers = 1;
+    int queue_size = 2;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (argv[i][0] == '-' && argv[i][1] == 'h')
+        {
+            show_usage();
+            return -1;
+        }
+
+        if (strcmp(argv[i], "--help") == 0)
+        {
+            show_usage();
+            return -1;
+        }
+    }
+
+    if (argc >= 2)
+        parampath = argv[1];
+    if (argc >= 3)
+        target_w = atoi(argv[2]);
+    if (argc >= 4)
+        target_h = atoi(argv[3]);
+    if (argc >= 5)
+        frame_count = atoi(argv[4]);
+    if (argc >= 6)
+        num_threads = atoi(argv[5]);
+    if (argc >= 7)
+        preprocess_workers = atoi(argv[6]);
+    if (argc >= 8)
+        inference_workers = atoi(argv[7]);
+    if (argc >= 9)
+        postprocess_workers = atoi(argv[8]);
+    if (argc >= 10)
+        queue_size = atoi(argv[9]);
+
+    ncnn::Net net;
+    net.opt.num_threads = num_threads;
+
+    if (net.load_param(parampath) != 0)
+    {
+        fprintf(stderr, "load_param %s failed\n", parampath);
+        return -1;
+    }
+
+    DataReaderFromEmpty dr;
+    net.load_model(dr);
+
+    if (net.input_names().empty() || net.output_names().empty())
+    {
+        fprintf(stderr, "%s has no input or output\n", parampath);
+        return -1;
+    }
+
+    StreamContext ctx;
+    ctx.input_name = net.input_names()[0];
+    ctx.frame_w = 640;
+    ctx.frame_h = 360;
+    ctx.target_w = target_w;
+    ctx.target_h = target_h;
+
+    const char* output_name = net.output_names()[0];
+
+    std::vector<StreamFrame> frames(frame_count);
+
+    fprintf(stderr, "frames = %d  num_threads = %d  workers = %d,%d,%d  queue_size = %d\n", frame_count, num_threads, preprocess_workers, inference_workers, postprocess_workers, queue_size);
+
+    // warm up
+    {
+        std::vector<StreamFrame> warmup_frames(4);
+        run_sequential(net, output_name, &ctx, warmup_frames);
+    }
+
+    double start = ncnn::get_current_time();
+    int ret = run_sequential(net, output_name, &ctx, frames);
+    double sequential_time = ncnn::get_current_time() - start;
+    if (ret != 0)
+    {
+        fprintf(stderr, "sequential run failed %d\n", ret);
+        return -1;
+    }
+
+    start = ncnn::get_current_time();
+    ret = run_pipeline(net, output_name, &ctx, frames, preprocess_workers, inference_workers, postprocess_workers, queue_size);
+    double pipeline_time = ncnn::get_current_time() - start;
+    if (ret != 0)
+    {
+        fprintf(stderr, "pipeline run failed %d\n", ret);
+        return -1;
+    }
+
+    fprintf(stderr, "%20s  %8.2f ms  %7.2f fps\n", "sequential", sequential_time, frame_count * 1000 / sequential_time);
+    fprintf(stderr, "%20s  %8.2f ms  %7.2f fps\n", "pipeline", pipeline_time, frame_count * 1000 / pipeline_time);
+
+    return 0;
+}
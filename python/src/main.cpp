@@ -6,6 +6,11 @@
 #include <pybind11/numpy.h>
 #include <pybind11/functional.h>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+
 #include <cpu.h>
 #include <gpu.h>
 #include <net.h>
@@ -103,6 +108,86 @@ LayerFactoryDefine(7);
 LayerFactoryDefine(8);
 LayerFactoryDefine(9);
 
+// the net local pool allocator is detached in Extractor::extract already
+// copy the output from user blob allocator that python may release earlier than the mat
+// and the output without refcount, a view of an input that may wrap a numpy array
+static Mat detach_blob_allocator(const Mat& feat)
+{
+    if (feat.allocator || (feat.data && !feat.refcount))
+        return feat.clone();
+
+    return feat;
+}
+
+#if NCNN_STRING
+static std::vector<std::vector<Mat> > extract_many(const Net& net, const std::vector<std::map<std::string, Mat> >& inputs, const std::vector<std::string>& outputs, int num_workers)
+{
+    const int count = (int)inputs.size();
+
+    std::vector<std::vector<Mat> > results(count, std::vector<Mat>(outputs.size()));
+    std::vector<int> rets(count, 0);
+
+    if (num_workers <= 0)
+        num_workers = get_physical_big_cpu_count();
+    num_workers = std::max(std::min(num_workers, count), 1);
+
+    {
+        py::gil_scoped_release release;
+
+        std::atomic<int> next(0);
+
+        auto worker = [&]() {
+            for (int i = next++; i < count; i = next++)
+            {
+                // one extractor per input, intermediate blobs are not shared across inputs
+                Extractor ex = net.create_extractor();
+
+                int ret = 0;
+                for (std::map<std::string, Mat>::const_iterator it = inputs[i].begin(); it != inputs[i].end() && ret == 0; it++)
+                {
+                    ret = ex.input(it->first.c_str(), it->second);
+                }
+
+                for (size_t j = 0; j < outputs.size() && ret == 0; j++)
+                {
+                    ret = ex.extract(outputs[j].c_str(), results[i][j]);
+                }
+
+                rets[i] = ret;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < num_workers; t++)
+        {
+            threads.push_back(std::thread(worker));
+        }
+        worker();
+        for (size_t t = 0; t < threads.size(); t++)
+        {
+            threads[t].join();
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (rets[i] != 0)
+        {
+            std::stringstream ss;
+            ss << "extract_many failed at input " << i << " with " << rets[i];
+            pybind11::pybind11_fail(ss.str());
+        }
+
+        for (size_t j = 0; j < outputs.size(); j++)
+        {
+            results[i][j] = detach_blob_allocator(results[i][j]);
+        }
+    }
+
+    return results;
+}
+#endif // NCNN_STRING
+
 PYBIND11_MODULE(ncnn, m)
 {
     auto atexit = py::module_::import("atexit");
@@ -203,7 +288,12 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("use_packing_layout", &Option::use_packing_layout)
     .def_readwrite("use_shader_pack8", &Option::use_shader_pack8)
     .def_readwrite("use_subgroup_ops", &Option::use_subgroup_ops)
-    .def_readwrite("use_tensor_storage", &Option::use_tensor_storage);
+    .def_readwrite("use_tensor_storage", &Option::use_tensor_storage)
+    .def_readwrite("use_parallel_create_pipeline", &Option::use_parallel_create_pipeline)
+    .def_readwrite("use_adaptive_thread_count", &Option::use_adaptive_thread_count)
+    .def_readwrite("use_memory_accounting", &Option::use_memory_accounting)
+    .def_readwrite("use_zero_copy_concat", &Option::use_zero_copy_concat)
+    .def_readwrite("use_blob_view", &Option::use_blob_view);
 
     py::class_<Mat> mat(m, "Mat", py::buffer_protocol());
     mat.def(py::init<>())
@@ -250,6 +340,27 @@ PYBIND11_MODULE(ncnn, m)
 
     .def(py::init([](py::buffer const b) {
         py::buffer_info info = b.request();
+
+        // non C-contiguous buffer is referenced through a contiguous copy and cloned afterwards
+        bool contiguous = true;
+        py::ssize_t stride = info.itemsize;
+        for (py::ssize_t i = info.ndim - 1; i >= 0; i--)
+        {
+            if (info.shape[i] != 1 && info.strides[i] != stride)
+                contiguous = false;
+            stride *= info.shape[i];
+        }
+
+        py::object contiguous_array;
+        if (!contiguous)
+        {
+            py::array a = py::array::ensure(b, py::array::c_style);
+            if (!a)
+                pybind11::pybind11_fail("convert non-contiguous buffer to ncnn.Mat failed");
+            info = a.request();
+            contiguous_array = a;
+        }
+
         if (info.ndim > 4)
         {
             std::stringstream ss;
@@ -286,9 +397,14 @@ PYBIND11_MODULE(ncnn, m)
             // so we set the cstep as numpy's cstep
             v->cstep = (int)info.shape[3] * (int)info.shape[2] * (int)info.shape[1];
         }
+
+        if (!contiguous)
+        {
+            *v = v->clone();
+        }
         return std::unique_ptr<Mat>(v);
     }),
-    py::arg("array"))
+    py::arg("array"), py::keep_alive<1, 2>()) // mat references the buffer memory without copy, keep the buffer alive
     .def_buffer([](Mat& m) -> py::buffer_info {
         return to_buffer_info(m);
     })
@@ -843,24 +959,36 @@ PYBIND11_MODULE(ncnn, m)
     .def("set_num_threads", &Extractor::set_num_threads, py::arg("num_threads"))
     .def("set_blob_allocator", &Extractor::set_blob_allocator, py::arg("allocator"))
     .def("set_workspace_allocator", &Extractor::set_workspace_allocator, py::arg("allocator"))
+    .def("blob_bytes", &Extractor::blob_bytes)
+    .def("peak_blob_bytes", &Extractor::peak_blob_bytes)
+    .def("workspace_bytes", &Extractor::workspace_bytes)
+    .def("peak_workspace_bytes", &Extractor::peak_workspace_bytes)
 #if NCNN_STRING
-    .def("input", (int (Extractor::*)(const char*, const Mat&)) & Extractor::input, py::arg("blob_name"), py::arg("in"))
-    .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0)
+    .def("input", (int (Extractor::*)(const char*, const Mat&)) & Extractor::input, py::arg("blob_name"), py::arg("in"), py::call_guard<py::gil_scoped_release>())
+    .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
     .def(
     "extract", [](Extractor& ex, const char* blob_name, int type) {
         ncnn::Mat feat;
-        int ret = ex.extract(blob_name, feat, type);
-        return py::make_tuple(ret, feat.clone());
+        int ret;
+        {
+            py::gil_scoped_release release;
+            ret = ex.extract(blob_name, feat, type);
+        }
+        return py::make_tuple(ret, detach_blob_allocator(feat));
     },
     py::arg("blob_name"), py::arg("type") = 0)
 #endif
-    .def("input", (int (Extractor::*)(int, const Mat&)) & Extractor::input)
-    .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0)
+    .def("input", (int (Extractor::*)(int, const Mat&)) & Extractor::input, py::call_guard<py::gil_scoped_release>())
+    .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
     .def(
     "extract", [](Extractor& ex, int blob_index, int type) {
         ncnn::Mat feat;
-        int ret = ex.extract(blob_index, feat, type);
-        return py::make_tuple(ret, feat.clone());
+        int ret;
+        {
+            py::gil_scoped_release release;
+            ret = ex.extract(blob_index, feat, type);
+        }
+        return py::make_tuple(ret, detach_blob_allocator(feat));
     },
     py::arg("blob_index"), py::arg("type") = 0);
 
@@ -907,6 +1035,8 @@ PYBIND11_MODULE(ncnn, m)
     .def("set_vulkan_device", (void (Net::*)(const VulkanDevice*)) & Net::set_vulkan_device, py::arg("vkdev"))
     .def("vulkan_device", &Net::vulkan_device, py::return_value_policy::reference_internal)
 #endif // NCNN_VULKAN
+    .def("weight_bytes", &Net::weight_bytes)
+    .def("layer_weight_bytes", &Net::layer_weight_bytes, py::arg("layer_index"))
 
 #if NCNN_STRING
     .def(
@@ -940,30 +1070,36 @@ PYBIND11_MODULE(ncnn, m)
         return net.register_custom_layer(index, lf.creator_func, lf.destroyer_func);
     },
     py::arg("index"), py::arg("creator"), py::arg("destroyer"))
+    // python datareader and custom layer overrides acquire the gil again when called back
 #if NCNN_STRING
-    .def("load_param", (int (Net::*)(const DataReader&)) & Net::load_param, py::arg("dr"))
+    .def("load_param", (int (Net::*)(const DataReader&)) & Net::load_param, py::arg("dr"), py::call_guard<py::gil_scoped_release>())
 #endif // NCNN_STRING
-    .def("load_param_bin", (int (Net::*)(const DataReader&)) & Net::load_param_bin, py::arg("dr"))
-    .def("load_model", (int (Net::*)(const DataReader&)) & Net::load_model, py::arg("dr"))
+    .def("load_param_bin", (int (Net::*)(const DataReader&)) & Net::load_param_bin, py::arg("dr"), py::call_guard<py::gil_scoped_release>())
+    .def("load_model", (int (Net::*)(const DataReader&)) & Net::load_model, py::arg("dr"), py::call_guard<py::gil_scoped_release>())
 
 #if NCNN_STDIO
 #if NCNN_STRING
-    .def("load_param", (int (Net::*)(const char*)) & Net::load_param, py::arg("protopath"))
-    .def("load_param_mem", (int (Net::*)(const char*)) & Net::load_param_mem, py::arg("mem"))
+    .def("load_param", (int (Net::*)(const char*)) & Net::load_param, py::arg("protopath"), py::call_guard<py::gil_scoped_release>())
+    .def("load_param_mem", (int (Net::*)(const char*)) & Net::load_param_mem, py::arg("mem"), py::call_guard<py::gil_scoped_release>())
 #endif // NCNN_STRING
-    .def("load_param_bin", (int (Net::*)(const char*)) & Net::load_param_bin, py::arg("protopath"))
-    .def("load_model", (int (Net::*)(const char*)) & Net::load_model, py::arg("modelpath"))
+    .def("load_param_bin", (int (Net::*)(const char*)) & Net::load_param_bin, py::arg("protopath"), py::call_guard<py::gil_scoped_release>())
+    .def("load_model", (int (Net::*)(const char*)) & Net::load_model, py::arg("modelpath"), py::call_guard<py::gil_scoped_release>())
     .def(
     "load_model_mem", [](Net& net, const char* mem) {
         const unsigned char* _mem = (const unsigned char*)mem;
         DataReaderFromMemoryCopy dr(_mem);
         net.load_model(dr);
     },
-    py::arg("mem"))
+    py::arg("mem"), py::call_guard<py::gil_scoped_release>())
 #endif // NCNN_STDIO
 
     .def("clear", &Net::clear)
     .def("create_extractor", &Net::create_extractor, py::keep_alive<0, 1>()) //net should be kept alive until retuned ex is freed by gc
+#if NCNN_STRING
+    .def("extract_many", &extract_many, py::arg("inputs"), py::arg("outputs"), py::arg("num_workers") = 0,
+         "run each dict of input blob name to mat through its own extractor on num_workers threads, "
+         "return the list of output mats for each input, 0 for physical big cpu count")
+#endif // NCNN_STRING
 
     .def("input_indexes", &Net::input_indexes, py::return_value_policy::reference)
     .def("output_indexes", &Net::output_indexes, py::return_value_policy::reference)
@@ -999,6 +1135,9 @@ PYBIND11_MODULE(ncnn, m)
     m.def("get_omp_thread_num", &get_omp_thread_num);
     m.def("get_kmp_blocktime", &get_kmp_blocktime);
     m.def("set_kmp_blocktime", &set_kmp_blocktime, py::arg("time_ms"));
+    m.def("get_thread_work_threshold", &get_thread_work_threshold);
+    m.def("set_thread_work_threshold", &set_thread_work_threshold, py::arg("threshold"));
+    m.def("calibrate_thread_work_threshold", &calibrate_thread_work_threshold, py::arg("num_threads"));
 
     m.def("copy_make_border", &copy_make_border,
           py::arg("src"), py::arg("dst"),
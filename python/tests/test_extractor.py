@@ -1,6 +1,9 @@
 # Copyright 2021 Tencent
 # SPDX-License-Identifier: BSD-3-Clause
 
+import gc
+
+import numpy as np
 import pytest
 
 import ncnn
@@ -73,3 +76,30 @@ def test_extractor_index():
 
     # not use with sentence, call clear manually to ensure ex destruct before net
     ex.clear()
+
+
+def test_extractor_input_view():
+    dr = ncnn.DataReaderFromEmpty()
+
+    net = ncnn.Net()
+    net.load_param("tests/test.param")
+    net.load_model(dr)
+
+    array = np.random.rand(3, 227, 227).astype(np.float32)
+    array_ref = array.copy()
+
+    in_mat = ncnn.Mat(array)
+    with net.create_extractor() as ex:
+        ex.input("data", in_mat)
+
+        # the input blob references the numpy memory without refcount
+        ret, out_mat = ex.extract("data")
+        assert ret == 0
+
+    # the extracted view must outlive the input and its numpy array
+    del in_mat
+    del array
+    gc.collect()
+    np.random.rand(3, 227, 227).astype(np.float32)
+
+    assert np.array_equal(np.array(out_mat), array_ref)
@@ -283,6 +283,20 @@ def test_numpy():
     array2[0] = 100
     assert array[0] == 100
 
+    # mat keeps the referenced array alive
+    mat = ncnn.Mat(np.arange(12, dtype=np.float32).reshape(3, 4))
+    array = mat.numpy()
+    del mat
+    assert array[2, 3] == 11
+
+    # non-contiguous array is copied
+    array = np.arange(24, dtype=np.float32).reshape(4, 6)
+    mat = ncnn.Mat(array[:, ::2])
+    assert mat.w == 3 and mat.h == 4
+    assert (mat.numpy() == array[:, ::2]).all()
+    array[0, 0] = 100
+    assert mat.numpy()[0, 0] == 0
+
 def test_fill():
     mat = ncnn.Mat(1)
     mat.fill(1.0)
@@ -157,3 +157,26 @@ def test_vulkan_device_vkdev():
     vkdev = ncnn.get_gpu_device(0)
     net.set_vulkan_device(vkdev)
     assert net.vulkan_device() is not None
+
+
+def test_net_extract_many():
+    dr = ncnn.DataReaderFromEmpty()
+
+    with ncnn.Net() as net:
+        net.opt.num_threads = 1
+        ret = net.load_param("tests/test.param")
+        net.load_model(dr)
+        assert ret == 0
+
+        inputs = [{"data": ncnn.Mat((227, 227, 3))} for i in range(5)]
+        results = net.extract_many(inputs, ["conv0_fwd", "output"], num_workers=2)
+        assert len(results) == 5
+        for outputs in results:
+            assert len(outputs) == 2
+            assert outputs[0].dims == 3 and outputs[0].w == 225 and outputs[0].c == 3
+            assert outputs[1].dims == 1 and outputs[1].w == 1
+
+        with pytest.raises(RuntimeError):
+            net.extract_many([{"data": ncnn.Mat((227, 227, 3))}], ["not_exist"])
+
+        net.clear()
@@ -10,6 +10,23 @@
 #include <android/hardware_buffer.h>
 #endif // __ANDROID_API__ >= 26
 
+#if defined __linux__
+#include <stdio.h>
+#include <sys/mman.h>
+#endif
+
+#if defined __linux__ && defined MAP_HUGETLB
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+#endif
+
 namespace ncnn {
 
 Allocator::~Allocator()
@@ -346,6 +363,326 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+enum
+{
+    HUGEPAGE_BACKING_FALLBACK = 0,
+    HUGEPAGE_BACKING_HUGETLB = 1,
+    HUGEPAGE_BACKING_MADVISE = 2
+};
+
+struct HugePageBlock
+{
+    void* ptr;
+    size_t size;
+    int backing;
+};
+
+class HugePageAllocatorPrivate
+{
+public:
+    void* map(size_t size, int* backing) const;
+    void unmap(const HugePageBlock& b) const;
+
+    size_t page_size;
+    size_t size_threshold;
+
+    Mutex lock;
+    std::list<HugePageBlock> budgets;
+    std::list<HugePageBlock> payouts;
+};
+
+// transparent huge pages are 2MB on x86 and arm64 with 4KB base pages
+static const size_t thp_size = 2 * 1024 * 1024;
+
+void* HugePageAllocatorPrivate::map(size_t size, int* backing) const
+{
+#if defined __linux__
+#if defined MAP_HUGETLB
+    // explicit huge pages waste at most half of the last page
+    if (page_size && size * 2 >= page_size)
+    {
+        const int page_flag = page_size >= 1024 * 1024 * 1024 ? MAP_HUGE_1GB : MAP_HUGE_2MB;
+
+        void* ptr = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_flag, -1, 0);
+        if (ptr != MAP_FAILED)
+        {
+            *backing = HUGEPAGE_BACKING_HUGETLB;
+            return ptr;
+        }
+    }
+#endif // MAP_HUGETLB
+
+    // over map and trim to a huge page boundary so that every 2MB range can be collapsed
+    unsigned char* p = (unsigned char*)mmap(0, size + thp_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        return 0;
+
+    unsigned char* ptr = alignPtr(p, (int)thp_size);
+    if (ptr != p)
+        munmap(p, ptr - p);
+    if (ptr + size != p + size + thp_size)
+        munmap(ptr + size, p + size + thp_size - (ptr + size));
+
+#if defined MADV_HUGEPAGE
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+
+    *backing = HUGEPAGE_BACKING_MADVISE;
+    return ptr;
+#else
+    (void)size;
+    (void)backing;
+    return 0;
+#endif
+}
+
+void HugePageAllocatorPrivate::unmap(const HugePageBlock& b) const
+{
+    if (b.backing == HUGEPAGE_BACKING_FALLBACK)
+    {
+        ncnn::fastFree(b.ptr);
+        return;
+    }
+
+#if defined __linux__
+    munmap(b.ptr, b.size);
+#endif
+}
+
+HugePageAllocator::HugePageAllocator(size_t page_size)
+    : Allocator(), d(new HugePageAllocatorPrivate)
+{
+    d->page_size = page_size;
+    d->size_threshold = 1024 * 1024;
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+    clear();
+
+    if (!d->payouts.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! huge page allocator destroyed too early");
+#if NCNN_STDIO
+        std::list<HugePageBlock>::iterator it = d->payouts.begin();
+        for (; it != d->payouts.end(); ++it)
+        {
+            NCNN_LOGE("%p still in use", it->ptr);
+        }
+#endif
+    }
+
+    delete d;
+}
+
+HugePageAllocator::HugePageAllocator(const HugePageAllocator&)
+    : d(0)
+{
+}
+
+HugePageAllocator& HugePageAllocator::operator=(const HugePageAllocator&)
+{
+    return *this;
+}
+
+void HugePageAllocator::set_size_threshold(size_t threshold)
+{
+    d->size_threshold = threshold;
+}
+
+void HugePageAllocator::clear()
+{
+    MutexLockGuard guard(d->lock);
+
+    std::list<HugePageBlock>::iterator it = d->budgets.begin();
+    for (; it != d->budgets.end(); ++it)
+    {
+        d->unmap(*it);
+    }
+    d->budgets.clear();
+}
+
+size_t HugePageAllocator::hugetlb_bytes() const
+{
+    MutexLockGuard guard(d->lock);
+
+    size_t bytes = 0;
+    std::list<HugePageBlock>::const_iterator it = d->payouts.begin();
+    for (; it != d->payouts.end(); ++it)
+    {
+        if (it->backing == HUGEPAGE_BACKING_HUGETLB)
+            bytes += it->size;
+    }
+
+    return bytes;
+}
+
+size_t HugePageAllocator::madvise_bytes() const
+{
+    MutexLockGuard guard(d->lock);
+
+    size_t bytes = 0;
+    std::list<HugePageBlock>::const_iterator it = d->payouts.begin();
+    for (; it != d->payouts.end(); ++it)
+    {
+        if (it->backing == HUGEPAGE_BACKING_MADVISE)
+            bytes += it->size;
+    }
+
+    return bytes;
+}
+
+size_t HugePageAllocator::thp_bytes() const
+{
+#if defined __linux__ && NCNN_STDIO
+    std::vector<std::pair<size_t, size_t> > ranges;
+    {
+        MutexLockGuard guard(d->lock);
+
+        std::list<HugePageBlock>::const_iterator it = d->payouts.begin();
+        for (; it != d->payouts.end(); ++it)
+        {
+            if (it->backing == HUGEPAGE_BACKING_MADVISE)
+                ranges.push_back(std::make_pair((size_t)it->ptr, (size_t)it->ptr + it->size));
+        }
+    }
+
+    if (ranges.empty())
+        return 0;
+
+    FILE* fp = fopen("/proc/self/smaps", "rb");
+    if (!fp)
+        return 0;
+
+    // the kernel may merge our mapping with its neighbors, count the overlapping part only
+    size_t bytes = 0;
+    size_t overlap = 0;
+    char line[256];
+    while (fgets(line, 256, fp))
+    {
+        unsigned long start = 0;
+        unsigned long end = 0;
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2)
+        {
+            overlap = 0;
+            for (size_t i = 0; i < ranges.size(); i++)
+            {
+                size_t lo = std::max((size_t)start, ranges[i].first);
+                size_t hi = std::min((size_t)end, ranges[i].second);
+                if (hi > lo)
+                    overlap += hi - lo;
+            }
+            continue;
+        }
+
+        unsigned long anon_huge_kb = 0;
+        if (overlap && sscanf(line, "AnonHugePages: %lu kB", &anon_huge_kb) == 1)
+        {
+            bytes += std::min((size_t)anon_huge_kb * 1024, overlap);
+        }
+    }
+
+    fclose(fp);
+
+    return bytes;
+#else
+    return 0;
+#endif
+}
+
+size_t HugePageAllocator::fallback_bytes() const
+{
+    MutexLockGuard guard(d->lock);
+
+    size_t bytes = 0;
+    std::list<HugePageBlock>::const_iterator it = d->payouts.begin();
+    for (; it != d->payouts.end(); ++it)
+    {
+        if (it->backing == HUGEPAGE_BACKING_FALLBACK)
+            bytes += it->size;
+    }
+
+    return bytes;
+}
+
+void* HugePageAllocator::fastMalloc(size_t size)
+{
+    HugePageBlock b;
+    b.ptr = 0;
+    b.size = size;
+    b.backing = HUGEPAGE_BACKING_FALLBACK;
+
+    if (size >= d->size_threshold)
+    {
+        // whole pages, large enough for the overread of simd loads
+        const size_t align = d->page_size && (size + NCNN_MALLOC_OVERREAD) * 2 >= d->page_size ? d->page_size : thp_size;
+        const size_t mapsize = (size + NCNN_MALLOC_OVERREAD + align - 1) / align * align;
+
+        {
+            MutexLockGuard guard(d->lock);
+
+            // find free budget of the same page count, up to twice the size
+            std::list<HugePageBlock>::iterator it = d->budgets.begin();
+            for (; it != d->budgets.end(); ++it)
+            {
+                if (it->size >= mapsize && it->size / 2 <= mapsize)
+                {
+                    HugePageBlock budget = *it;
+
+                    d->budgets.erase(it);
+
+                    d->payouts.push_back(budget);
+
+                    return budget.ptr;
+                }
+            }
+        }
+
+        b.size = mapsize;
+        b.ptr = d->map(mapsize, &b.backing);
+    }
+
+    if (!b.ptr)
+    {
+        b.size = size;
+        b.backing = HUGEPAGE_BACKING_FALLBACK;
+        b.ptr = ncnn::fastMalloc(size);
+    }
+
+    MutexLockGuard guard(d->lock);
+
+    d->payouts.push_back(b);
+
+    return b.ptr;
+}
+
+void HugePageAllocator::fastFree(void* ptr)
+{
+    MutexLockGuard guard(d->lock);
+
+    std::list<HugePageBlock>::iterator it = d->payouts.begin();
+    for (; it != d->payouts.end(); ++it)
+    {
+        if (it->ptr == ptr)
+        {
+            HugePageBlock b = *it;
+
+            d->payouts.erase(it);
+
+            // small blocks are not worth keeping
+            if (b.backing == HUGEPAGE_BACKING_FALLBACK)
+                d->unmap(b);
+            else
+                d->budgets.push_back(b);
+
+            return;
+        }
+    }
+
+    NCNN_LOGE("FATAL ERROR! huge page allocator get wild %p", ptr);
+    ncnn::fastFree(ptr);
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
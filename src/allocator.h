@@ -205,6 +205,49 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+class HugePageAllocatorPrivate;
+class NCNN_EXPORT HugePageAllocator : public Allocator
+{
+public:
+    // map large allocations with explicit huge pages of page_size, 2MB or 1GB
+    // fallback to madvise(MADV_HUGEPAGE) on normal pages when the hugetlb pool can not serve it
+    // page_size 0 always takes the madvise way
+    // linux only, other platforms get ncnn::fastMalloc
+    HugePageAllocator(size_t page_size = 2 * 1024 * 1024);
+    ~HugePageAllocator();
+
+    // allocations smaller than threshold go to ncnn::fastMalloc
+    // default threshold = 1MB
+    void set_size_threshold(size_t threshold);
+
+    // unmap all budgets immediately
+    // budgets freed while creating pipelines are kept until clear
+    void clear();
+
+    // bytes currently mapped with explicit huge pages
+    size_t hugetlb_bytes() const;
+
+    // bytes currently mapped with madvise(MADV_HUGEPAGE)
+    size_t madvise_bytes() const;
+
+    // part of madvise_bytes() actually backed by transparent huge pages
+    // read from AnonHugePages in /proc/self/smaps, 0 if unavailable
+    size_t thp_bytes() const;
+
+    // bytes currently served by ncnn::fastMalloc
+    size_t fallback_bytes() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    HugePageAllocator(const HugePageAllocator&);
+    HugePageAllocator& operator=(const HugePageAllocator&);
+
+private:
+    HugePageAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
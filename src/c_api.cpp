@@ -194,6 +194,16 @@ void ncnn_option_set_use_vulkan_compute(ncnn_option_t opt, int use_vulkan_comput
 #endif
 }
 
+int ncnn_option_get_use_memory_accounting(const ncnn_option_t opt)
+{
+    return ((const Option*)opt)->use_memory_accounting;
+}
+
+void ncnn_option_set_use_memory_accounting(ncnn_option_t opt, int use_memory_accounting)
+{
+    ((Option*)opt)->use_memory_accounting = use_memory_accounting;
+}
+
 /* mat api */
 ncnn_mat_t ncnn_mat_create()
 {
@@ -1371,6 +1381,16 @@ int ncnn_net_get_output_index(const ncnn_net_t net, int i)
     return ((Net*)net->pthis)->output_indexes()[i];
 }
 
+size_t ncnn_net_get_weight_bytes(const ncnn_net_t net)
+{
+    return ((Net*)net->pthis)->weight_bytes();
+}
+
+size_t ncnn_net_get_layer_weight_bytes(const ncnn_net_t net, int layer_index)
+{
+    return ((Net*)net->pthis)->layer_weight_bytes(layer_index);
+}
+
 /* extractor api */
 ncnn_extractor_t ncnn_extractor_create(ncnn_net_t net)
 {
@@ -1418,6 +1438,26 @@ int ncnn_extractor_extract_index(ncnn_extractor_t ex, int index, ncnn_mat_t* mat
     return ret;
 }
 
+size_t ncnn_extractor_get_blob_bytes(const ncnn_extractor_t ex)
+{
+    return ((const Extractor*)ex)->blob_bytes();
+}
+
+size_t ncnn_extractor_get_peak_blob_bytes(const ncnn_extractor_t ex)
+{
+    return ((const Extractor*)ex)->peak_blob_bytes();
+}
+
+size_t ncnn_extractor_get_workspace_bytes(const ncnn_extractor_t ex)
+{
+    return ((const Extractor*)ex)->workspace_bytes();
+}
+
+size_t ncnn_extractor_get_peak_workspace_bytes(const ncnn_extractor_t ex)
+{
+    return ((const Extractor*)ex)->peak_workspace_bytes();
+}
+
 void ncnn_copy_make_border(const ncnn_mat_t src, ncnn_mat_t dst, int top, int bottom, int left, int right, int type, float v, const ncnn_option_t opt)
 {
     const Option _opt = opt ? *((const Option*)opt) : Option();
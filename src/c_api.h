@@ -49,6 +49,9 @@ NCNN_EXPORT void ncnn_option_set_workspace_allocator(ncnn_option_t opt, ncnn_all
 NCNN_EXPORT int ncnn_option_get_use_vulkan_compute(const ncnn_option_t opt);
 NCNN_EXPORT void ncnn_option_set_use_vulkan_compute(ncnn_option_t opt, int use_vulkan_compute);
 
+NCNN_EXPORT int ncnn_option_get_use_memory_accounting(const ncnn_option_t opt);
+NCNN_EXPORT void ncnn_option_set_use_memory_accounting(ncnn_option_t opt, int use_memory_accounting);
+
 /* mat api */
 typedef struct __ncnn_mat_t* ncnn_mat_t;
 
@@ -304,6 +307,9 @@ NCNN_EXPORT const char* ncnn_net_get_output_name(const ncnn_net_t net, int i);
 NCNN_EXPORT int ncnn_net_get_input_index(const ncnn_net_t net, int i);
 NCNN_EXPORT int ncnn_net_get_output_index(const ncnn_net_t net, int i);
 
+NCNN_EXPORT size_t ncnn_net_get_weight_bytes(const ncnn_net_t net);
+NCNN_EXPORT size_t ncnn_net_get_layer_weight_bytes(const ncnn_net_t net, int layer_index);
+
 /* extractor api */
 typedef struct __ncnn_extractor_t* ncnn_extractor_t;
 
@@ -319,6 +325,11 @@ NCNN_EXPORT int ncnn_extractor_extract(ncnn_extractor_t ex, const char* name, nc
 NCNN_EXPORT int ncnn_extractor_input_index(ncnn_extractor_t ex, int index, const ncnn_mat_t mat);
 NCNN_EXPORT int ncnn_extractor_extract_index(ncnn_extractor_t ex, int index, ncnn_mat_t* mat);
 
+NCNN_EXPORT size_t ncnn_extractor_get_blob_bytes(const ncnn_extractor_t ex);
+NCNN_EXPORT size_t ncnn_extractor_get_peak_blob_bytes(const ncnn_extractor_t ex);
+NCNN_EXPORT size_t ncnn_extractor_get_workspace_bytes(const ncnn_extractor_t ex);
+NCNN_EXPORT size_t ncnn_extractor_get_peak_workspace_bytes(const ncnn_extractor_t ex);
+
 /* mat process api */
 #define NCNN_BORDER_CONSTANT    0
 #define NCNN_BORDER_REPLICATE   1
@@ -3,6 +3,7 @@
 
 #include "cpu.h"
 
+#include "benchmark.h"
 #include "platform.h"
 
 #include <limits.h>
@@ -3226,6 +3227,79 @@ void set_kmp_blocktime(int time_ms)
 #endif
 }
 
+static int g_thread_work_threshold = 65536;
+
+int get_thread_work_threshold()
+{
+    return g_thread_work_threshold;
+}
+
+void set_thread_work_threshold(int threshold)
+{
+    g_thread_work_threshold = std::max(threshold, 1);
+}
+
+int calibrate_thread_work_threshold(int num_threads)
+{
+#ifdef _OPENMP
+    if (num_threads <= 1)
+        return g_thread_work_threshold;
+
+    // single thread streaming speed, 4MB in and out
+    const int size = 1024 * 1024;
+    std::vector<float> buf(size, 1.f);
+
+    double stream_time = 1e30;
+    for (int r = 0; r < 5; r++)
+    {
+        double start = get_current_time();
+
+        float* p = &buf[0];
+        for (int i = 0; i < size; i++)
+        {
+            p[i] = p[i] * 0.5f + 0.5f;
+        }
+
+        double end = get_current_time();
+        stream_time = std::min(stream_time, end - start);
+    }
+
+    const double bytes_per_ms = size * sizeof(float) * 2 / std::max(stream_time, 0.001);
+
+    // fork-join of a parallel region with almost no work
+    std::vector<float> dummy(num_threads * 16, 0.f);
+
+    double fork_time = 1e30;
+    for (int r = 0; r < 5; r++)
+    {
+        const int loop = 100;
+
+        double start = get_current_time();
+
+        for (int l = 0; l < loop; l++)
+        {
+            #pragma omp parallel for num_threads(num_threads)
+            for (int i = 0; i < num_threads; i++)
+            {
+                dummy[i * 16] += 1.f;
+            }
+        }
+
+        double end = get_current_time();
+        fork_time = std::min(fork_time, (end - start) / loop);
+    }
+
+    // the bytes one thread streams while the others are woken up
+    const double threshold = fork_time * bytes_per_ms;
+
+    g_thread_work_threshold = (int)std::min(std::max(threshold, 4096.0), 64.0 * 1024 * 1024);
+#else
+    (void)num_threads;
+#endif
+
+    return g_thread_work_threshold;
+}
+
 static ncnn::ThreadLocalStorage tls_flush_denormals;
 
 int get_flush_denormals()
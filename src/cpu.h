@@ -163,6 +163,15 @@ NCNN_EXPORT int get_omp_thread_num();
 NCNN_EXPORT int get_kmp_blocktime();
 NCNN_EXPORT void set_kmp_blocktime(int time_ms);
 
+// bytes of work one more thread should get to pay off waking it up
+// used by opt.use_adaptive_thread_count, default 65536
+NCNN_EXPORT int get_thread_work_threshold();
+NCNN_EXPORT void set_thread_work_threshold(int threshold);
+
+// measure the fork-join cost of num_threads threads against memory streaming on this machine
+// set and return the threshold, call once at startup
+NCNN_EXPORT int calibrate_thread_work_threshold(int num_threads);
+
 // need to flush denormals on Intel Chipset.
 // Other architectures such as ARM can be added as needed.
 // 0 = DAZ OFF, FTZ OFF
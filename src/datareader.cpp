@@ -7,6 +7,150 @@
 
 namespace ncnn {
 
+#if NCNN_STRING
+static inline bool is_scan_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// hand-written scanner for the scanf subset used by param parsing
+// literal characters, whitespace, %d, %Ns and %N[set] or %N[^set] with one conversion
+// locale independent and never looks beyond the token, unlike sscanf which strlen the whole buffer
+// return 1 and set nconsumed if the whole format matched
+// return 0 if not matched, return -1 if the format is not supported
+static int scan_memory(const char* mem, const char* format, void* p, int* nconsumed)
+{
+    const char* s = mem;
+    const char* f = format;
+
+    int nscan = 0;
+    *nconsumed = 0;
+
+    while (*f)
+    {
+        if (is_scan_space(*f))
+        {
+            while (is_scan_space(*s))
+                s++;
+            f++;
+            continue;
+        }
+
+        if (*f != '%')
+        {
+            if (*s != *f)
+                return 0;
+            s++;
+            f++;
+            continue;
+        }
+
+        f++;
+
+        if (nscan == 1)
+            return -1;
+
+        int width = 0;
+        while (*f >= '0' && *f <= '9')
+        {
+            width = width * 10 + (*f - '0');
+            f++;
+        }
+
+        if (*f == 'd')
+        {
+            f++;
+
+            while (is_scan_space(*s))
+                s++;
+
+            const char* send = width > 0 ? s + width : 0;
+
+            bool negative = *s == '-';
+            if (*s == '+' || *s == '-')
+                s++;
+
+            const char* digits = s;
+            unsigned int v = 0;
+            while ((!send || s < send) && *s >= '0' && *s <= '9')
+            {
+                v = v * 10 + (*s - '0');
+                s++;
+            }
+
+            if (s == digits)
+                return 0;
+
+            *(int*)p = negative ? (int)(0u - v) : (int)v;
+            nscan = 1;
+        }
+        else if (*f == 's')
+        {
+            f++;
+
+            while (is_scan_space(*s))
+                s++;
+
+            char* outptr = (char*)p;
+            int n = 0;
+            while (*s && !is_scan_space(*s) && (width == 0 || n < width))
+            {
+                outptr[n++] = *s++;
+            }
+
+            if (n == 0)
+                return 0;
+
+            outptr[n] = '\0';
+            nscan = 1;
+        }
+        else if (*f == '[')
+        {
+            f++;
+
+            bool invert = *f == '^';
+            if (invert)
+                f++;
+
+            // the set is terminated by the first ] after the first set character
+            const char* set = f;
+            if (*f == ']')
+                f++;
+            while (*f && *f != ']')
+                f++;
+            if (*f != ']')
+                return -1;
+            const char* setend = f;
+            f++;
+
+            char* outptr = (char*)p;
+            int n = 0;
+            while (*s && (width == 0 || n < width))
+            {
+                bool in_set = memchr(set, *s, setend - set) != 0;
+                if (in_set == invert)
+                    break;
+
+                outptr[n++] = *s++;
+            }
+
+            if (n == 0)
+                return 0;
+
+            outptr[n] = '\0';
+            nscan = 1;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    *nconsumed = (int)(s - mem);
+    return nscan;
+}
+#endif // NCNN_STRING
+
 DataReader::DataReader()
 {
 }
@@ -109,13 +253,20 @@ DataReaderFromMemory& DataReaderFromMemory::operator=(const DataReaderFromMemory
 #if NCNN_STRING
 int DataReaderFromMemory::scan(const char* format, void* p) const
 {
+    int nconsumed = 0;
+    int nscan = scan_memory((const char*)d->mem, format, p, &nconsumed);
+    if (nscan != -1)
+    {
+        d->mem += nconsumed;
+        return nconsumed > 0 ? nscan : 0;
+    }
+
     size_t fmtlen = strlen(format);
 
     char* format_with_n = new char[fmtlen + 4];
     sprintf(format_with_n, "%s%%n", format);
 
-    int nconsumed = 0;
-    int nscan = sscanf((const char*)d->mem, format_with_n, p, &nconsumed);
+    nscan = sscanf((const char*)d->mem, format_with_n, p, &nconsumed);
     d->mem += nconsumed;
 
     delete[] format_with_n;
@@ -181,16 +332,22 @@ int DataReaderFromAndroidAsset::scan(const char* format, void* p) const
         d->mem += pos;
     }
 
-    int fmtlen = strlen(format);
+    int nconsumed = 0;
+    int nscan = scan_memory((const char*)d->mem, format, p, &nconsumed);
+    if (nscan == -1)
+    {
+        int fmtlen = strlen(format);
+
+        char* format_with_n = new char[fmtlen + 3];
+        sprintf(format_with_n, "%s%%n", format);
 
-    char* format_with_n = new char[fmtlen + 3];
-    sprintf(format_with_n, "%s%%n", format);
+        nconsumed = 0;
+        nscan = sscanf((const char*)d->mem, format_with_n, p, &nconsumed);
 
-    int nconsumed = 0;
-    int nscan = sscanf((const char*)d->mem, format_with_n, p, &nconsumed);
-    d->mem += nconsumed;
+        delete[] format_with_n;
+    }
 
-    delete[] format_with_n;
+    d->mem += nconsumed;
 
     if (nconsumed == 0)
         return 0;
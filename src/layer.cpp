@@ -23,8 +23,8 @@ Layer::Layer()
     support_int8_storage = false;
     support_tensor_storage = false;
 
-    support_reserved_000 = false;
-    support_reserved_00 = false;
+    support_strided_input = false;
+    support_adaptive_thread_count = true;
 
     featmask = 0;
 
@@ -98,6 +98,20 @@ int Layer::forward_inplace(Mat& /*bottom_top_blob*/, const Option& /*opt*/) cons
     return -1;
 }
 
+int Layer::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    if (!support_inplace)
+        return -1;
+
+    // inplace layer keeps the shape
+    for (size_t i = 0; i < top_blob_shapes.size() && i < bottom_blob_shapes.size(); i++)
+    {
+        top_blob_shapes[i] = bottom_blob_shapes[i];
+    }
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int Layer::upload_model(VkTransfer& /*cmd*/, const Option& /*opt*/)
 {
@@ -528,4 +542,16 @@ Layer* create_layer_vulkan(int index)
 }
 #endif // NCNN_VULKAN
 
+void relocate_weight(Mat& weight, const Option& opt)
+{
+    if (!opt.weight_allocator || weight.empty() || weight.allocator == opt.weight_allocator)
+        return;
+
+    Mat weight_relocated = weight.clone(opt.weight_allocator);
+    if (weight_relocated.empty())
+        return;
+
+    weight = weight_relocated;
+}
+
 } // namespace ncnn
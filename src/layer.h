@@ -68,9 +68,12 @@ public:
     // shader tensor storage
     bool support_tensor_storage;
 
-    bool support_reserved_000;
+    // accept strided bottom blob, see Mat::is_strided()
+    bool support_strided_input;
 
-    bool support_reserved_00;
+    // forward may run on fewer threads than opt.num_threads, see opt.use_adaptive_thread_count
+    // turned off by layers packing weights for the load-time thread count or with output much larger than input
+    bool support_adaptive_thread_count;
 
     bool support_reserved_0;
     bool support_reserved_1;
@@ -98,6 +101,12 @@ public:
     virtual int forward_inplace(std::vector<Mat>& bottom_top_blobs, const Option& opt) const;
     virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
 
+    // infer top blob shapes from bottom blob shapes without computing
+    // shapes are elempack 1 Mat without data, see Mat::shape()
+    // set top shape to empty Mat if it depends on blob values
+    // return 0 if success, -1 if the layer has no shape function
+    virtual int infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const;
+
 #if NCNN_VULKAN
 public:
     // upload weight blob from host to device
@@ -194,6 +203,11 @@ NCNN_EXPORT Layer* create_layer_cpu(int index);
 NCNN_EXPORT Layer* create_layer_vulkan(int index);
 #endif // NCNN_VULKAN
 
+// copy a weight transformed in create_pipeline into opt.weight_allocator
+// no-op when opt.weight_allocator is null or the weight is already allocated from it
+// the weight is kept as is if the copy can not be allocated
+NCNN_EXPORT void relocate_weight(Mat& weight, const Option& opt);
+
 #define DEFINE_LAYER_CREATOR(name)                          \
     ::ncnn::Layer* name##_layer_creator(void* /*userdata*/) \
     {                                                       \
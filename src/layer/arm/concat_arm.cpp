@@ -35,6 +35,11 @@ int Concat_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
         return forward_bf16s_fp16s(bottom_blobs, top_blobs, opt);
 #endif
 
+#if NCNN_INT8
+    if (elembits == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+#endif
+
     int dims = bottom_blobs[0].dims;
     int positive_axis = axis < 0 ? dims + axis : axis;
 
@@ -945,4 +950,29 @@ int Concat_arm::forward_bf16s_fp16s(const std::vector<Mat>& bottom_blobs, std::v
     return 0;
 }
 
+#if NCNN_INT8
+int Concat_arm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    // concat int8 in elempack 1
+    std::vector<Mat> bottom_blobs_unpacked(bottom_blobs.size());
+    for (size_t b = 0; b < bottom_blobs.size(); b++)
+    {
+        Mat bottom_blob_unpacked = bottom_blobs[b];
+        if (bottom_blobs[b].elempack != 1)
+        {
+            Option opt_pack1 = opt;
+            opt_pack1.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blobs[b], bottom_blob_unpacked, 1, opt_pack1);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        bottom_blobs_unpacked[b] = bottom_blob_unpacked;
+    }
+
+    return Concat::forward(bottom_blobs_unpacked, top_blobs, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
@@ -123,6 +123,11 @@ static void crop_pack4_bf16_fp16s_neon(const Mat& src, Mat& dst, int top, int le
 
 int Crop_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+#if NCNN_INT8
+    if (bottom_blob.elembits() == 8)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int d = bottom_blob.d;
@@ -446,6 +451,11 @@ int Crop_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
 
 int Crop_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+#if NCNN_INT8
+    if (bottom_blobs[0].elembits() == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+#endif
+
     const Mat& bottom_blob = bottom_blobs[0];
     const Mat& reference_blob = bottom_blobs[1];
 
@@ -787,4 +797,45 @@ int Crop_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     return Crop::forward(bottom_blobs_unpacked, top_blobs, opt);
 }
 
+#if NCNN_INT8
+int Crop_arm::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // crop int8 in elempack 1
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.elempack != 1)
+    {
+        Option opt_pack1 = opt;
+        opt_pack1.blob_allocator = opt.workspace_allocator;
+
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack1);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    return Crop::forward(bottom_blob_unpacked, top_blob, opt);
+}
+
+int Crop_arm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    std::vector<Mat> bottom_blobs_unpacked(bottom_blobs.size());
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        Mat bottom_blob_unpacked = bottom_blobs[i];
+        if (bottom_blobs[i].elempack != 1)
+        {
+            Option opt_pack1 = opt;
+            opt_pack1.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blobs[i], bottom_blob_unpacked, 1, opt_pack1);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        bottom_blobs_unpacked[i] = bottom_blob_unpacked;
+    }
+
+    return Crop::forward(bottom_blobs_unpacked, top_blobs, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
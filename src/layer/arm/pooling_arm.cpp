@@ -79,6 +79,11 @@ int Pooling_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
         return forward_bf16s(bottom_blob, top_blob, opt);
 #endif
 
+#if NCNN_INT8
+    if (elembits == 8 && pooling_type == PoolMethod_MAX)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
     // max value in NxN window
     // avg value in NxN window
 
@@ -35,6 +35,11 @@ int Slice_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& t
         return forward_bf16s_fp16s(bottom_blobs, top_blobs, opt);
 #endif
 
+#if NCNN_INT8
+    if (elembits == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+#endif
+
     const Mat& bottom_blob = bottom_blobs[0];
     int dims = bottom_blob.dims;
     size_t elemsize = bottom_blob.elemsize;
@@ -1239,4 +1244,24 @@ int Slice_arm::forward_bf16s_fp16s(const std::vector<Mat>& bottom_blobs, std::ve
     return 0;
 }
 
+#if NCNN_INT8
+int Slice_arm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    // slice int8 in elempack 1
+    std::vector<Mat> bottom_blobs_unpacked(1);
+    bottom_blobs_unpacked[0] = bottom_blobs[0];
+    if (bottom_blobs[0].elempack != 1)
+    {
+        Option opt_pack1 = opt;
+        opt_pack1.blob_allocator = opt.workspace_allocator;
+
+        convert_packing(bottom_blobs[0], bottom_blobs_unpacked[0], 1, opt_pack1);
+        if (bottom_blobs_unpacked[0].empty())
+            return -100;
+    }
+
+    return Slice::forward(bottom_blobs_unpacked, top_blobs, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
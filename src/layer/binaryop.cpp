@@ -370,4 +370,94 @@ int BinaryOp::forward_inplace(Mat& bottom_top_blob, const Option& opt) const
     return 0;
 }
 
+// expand inner axes like the reshape in forward
+static void expand_broadcast_shape(const Mat& a, const Mat& b, int outdims, int& w, int& h, int& d, int& c)
+{
+    w = a.w;
+    h = a.h;
+    d = a.d;
+    c = a.c;
+
+    if (a.dims == outdims)
+        return;
+
+    if (outdims == 2)
+    {
+        if (a.w == b.h)
+        {
+            w = 1;
+            h = a.w;
+        }
+    }
+    if (outdims == 3 && a.dims == 1)
+    {
+        if (a.w == b.c)
+        {
+            w = 1;
+            c = a.w;
+        }
+    }
+    if (outdims == 3 && a.dims == 2)
+    {
+        w = 1;
+        h = a.w;
+        c = a.h;
+    }
+    if (outdims == 4 && a.dims == 1)
+    {
+        if (a.w == b.c)
+        {
+            w = 1;
+            c = a.w;
+        }
+    }
+    if (outdims == 4 && a.dims == 2)
+    {
+        w = 1;
+        d = a.w;
+        c = a.h;
+    }
+    if (outdims == 4 && a.dims == 3)
+    {
+        w = 1;
+        h = a.w;
+        d = a.h;
+        c = a.c;
+    }
+}
+
+int BinaryOp::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    if (with_scalar)
+    {
+        top_blob_shapes[0] = bottom_blob_shapes[0];
+        return 0;
+    }
+
+    const Mat& A = bottom_blob_shapes[0];
+    const Mat& B = bottom_blob_shapes[1];
+    const int outdims = std::max(A.dims, B.dims);
+
+    int aw, ah, ad, ac;
+    int bw, bh, bd, bc;
+    expand_broadcast_shape(A, B, outdims, aw, ah, ad, ac);
+    expand_broadcast_shape(B, A, outdims, bw, bh, bd, bc);
+
+    const int outw = std::max(aw, bw);
+    const int outh = std::max(ah, bh);
+    const int outd = std::max(ad, bd);
+    const int outc = std::max(ac, bc);
+
+    if (outdims == 1)
+        top_blob_shapes[0] = Mat(outw, (void*)0);
+    if (outdims == 2)
+        top_blob_shapes[0] = Mat(outw, outh, (void*)0);
+    if (outdims == 3)
+        top_blob_shapes[0] = Mat(outw, outh, outc, (void*)0);
+    if (outdims == 4)
+        top_blob_shapes[0] = Mat(outw, outh, outd, outc, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
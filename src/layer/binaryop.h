@@ -21,6 +21,8 @@ public:
 
     virtual int forward_inplace(Mat& bottom_top_blob, const Option& opt) const;
 
+    virtual int infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const;
+
     enum OperationType
     {
         Operation_ADD = 0,
@@ -176,4 +176,11 @@ int Cast::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
     return 0;
 }
 
+int Cast::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    top_blob_shapes[0] = bottom_blob_shapes[0];
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -289,4 +289,57 @@ int Concat::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
     return 0;
 }
 
+// extent of the positive axis, outermost first
+static int axis_extent(const Mat& shape, int positive_axis)
+{
+    if (shape.dims == 1)
+        return shape.w;
+    if (shape.dims == 2)
+        return positive_axis == 0 ? shape.h : shape.w;
+    if (shape.dims == 3)
+        return positive_axis == 0 ? shape.c : positive_axis == 1 ? shape.h : shape.w;
+
+    return positive_axis == 0 ? shape.c : positive_axis == 1 ? shape.d : positive_axis == 2 ? shape.h : shape.w;
+}
+
+static Mat shape_with_axis_extent(const Mat& shape, int positive_axis, int extent)
+{
+    if (shape.dims == 1)
+        return Mat(extent, (void*)0);
+    if (shape.dims == 2)
+        return positive_axis == 0 ? Mat(shape.w, extent, (void*)0) : Mat(extent, shape.h, (void*)0);
+    if (shape.dims == 3)
+    {
+        if (positive_axis == 0)
+            return Mat(shape.w, shape.h, extent, (void*)0);
+        if (positive_axis == 1)
+            return Mat(shape.w, extent, shape.c, (void*)0);
+        return Mat(extent, shape.h, shape.c, (void*)0);
+    }
+
+    if (positive_axis == 0)
+        return Mat(shape.w, shape.h, shape.d, extent, (void*)0);
+    if (positive_axis == 1)
+        return Mat(shape.w, shape.h, extent, shape.c, (void*)0);
+    if (positive_axis == 2)
+        return Mat(shape.w, extent, shape.d, shape.c, (void*)0);
+    return Mat(extent, shape.h, shape.d, shape.c, (void*)0);
+}
+
+int Concat::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+    int positive_axis = axis < 0 ? shape.dims + axis : axis;
+
+    int top_extent = 0;
+    for (size_t b = 0; b < bottom_blob_shapes.size(); b++)
+    {
+        top_extent += axis_extent(bottom_blob_shapes[b], positive_axis);
+    }
+
+    top_blob_shapes[0] = shape_with_axis_extent(shape, positive_axis, top_extent);
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -13,6 +13,7 @@ ConvolutionDepthWise::ConvolutionDepthWise()
 {
     one_blob_only = true;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int ConvolutionDepthWise::load_param(const ParamDict& pd)
@@ -636,4 +637,49 @@ int ConvolutionDepthWise::forward_int8(const Mat& bottom_blob, Mat& top_blob, co
 }
 #endif // NCNN_INT8
 
+int ConvolutionDepthWise::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    int _kernel_w = kernel_w;
+    int _kernel_h = kernel_h;
+    int _num_output = num_output;
+    if (dynamic_weight)
+    {
+        _kernel_w = bottom_blob_shapes[1].w;
+        _kernel_h = bottom_blob_shapes[1].h;
+        _num_output = bottom_blob_shapes[1].c;
+    }
+
+    const int kernel_extent_w = dilation_w * (_kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (_kernel_h - 1) + 1;
+
+    int w = shape.w;
+    int h = shape.h;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0)
+    {
+        w += pad_left + pad_right;
+        h += pad_top + pad_bottom;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233)
+             || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234))
+    {
+        // tensorflow padding=SAME or onnx padding=SAME_UPPER/SAME_LOWER
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        if (wpad > 0 || hpad > 0)
+        {
+            w += wpad;
+            h += hpad;
+        }
+    }
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+
+    top_blob_shapes[0] = Mat(outw, outh, _num_output, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
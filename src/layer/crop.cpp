@@ -806,4 +806,81 @@ int Crop::eval_crop_expr(const std::vector<Mat>& bottom_blobs, int& _woffset, in
     return 0;
 }
 
+int Crop::resolve_crop_window(const std::vector<Mat>& bottom_blobs, int& _woffset, int& _hoffset, int& _doffset, int& _coffset, int& _outw, int& _outh, int& _outd, int& _outc) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+
+    _woffset = 0;
+    _hoffset = 0;
+    _doffset = 0;
+    _coffset = 0;
+    _outw = -1;
+    _outh = -1;
+    _outd = -1;
+    _outc = -1;
+
+    if (!starts_expr.empty() && !ends_expr.empty())
+    {
+        std::vector<Mat> bottom_blob_shapes(bottom_blobs.size());
+        for (size_t i = 0; i < bottom_blobs.size(); i++)
+        {
+            bottom_blob_shapes[i] = bottom_blobs[i].shape();
+        }
+        return eval_crop_expr(bottom_blob_shapes, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+
+    if (bottom_blobs.size() == 1)
+    {
+        resolve_crop_roi(bottom_blob.shape(), _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+    else if (woffset == -233)
+    {
+        resolve_crop_roi(bottom_blob.shape(), (const int*)bottom_blobs[1], _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+    else
+    {
+        resolve_crop_roi(bottom_blob.shape(), bottom_blobs[1].shape(), _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+
+    return 0;
+}
+
+int Crop::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    int _woffset, _hoffset, _doffset, _coffset = -1;
+    int _outw = -1, _outh = -1, _outd = -1, _outc;
+
+    if (!starts_expr.empty() && !ends_expr.empty())
+    {
+        eval_crop_expr(bottom_blob_shapes, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+    else if (bottom_blob_shapes.size() == 1)
+    {
+        resolve_crop_roi(shape, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+    else if (woffset == -233)
+    {
+        // roi from reference blob values
+        top_blob_shapes[0] = Mat();
+        return 0;
+    }
+    else
+    {
+        resolve_crop_roi(shape, bottom_blob_shapes[1], _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
+    }
+
+    if (shape.dims == 1)
+        top_blob_shapes[0] = Mat(_outw, (void*)0);
+    if (shape.dims == 2)
+        top_blob_shapes[0] = Mat(_outw, _outh, (void*)0);
+    if (shape.dims == 3)
+        top_blob_shapes[0] = Mat(_outw, _outh, _outc, (void*)0);
+    if (shape.dims == 4)
+        top_blob_shapes[0] = Mat(_outw, _outh, _outd, _outc, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -21,6 +21,8 @@ public:
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+    virtual int infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const;
+
 protected:
     void cut_padding(const Mat& top_blob_bordered, Mat& top_blob, const Option& opt) const;
 
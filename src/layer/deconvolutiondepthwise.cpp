@@ -11,6 +11,7 @@ DeconvolutionDepthWise::DeconvolutionDepthWise()
 {
     one_blob_only = true;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int DeconvolutionDepthWise::load_param(const ParamDict& pd)
@@ -357,4 +358,41 @@ void DeconvolutionDepthWise::cut_padding(const Mat& top_blob_bordered, Mat& top_
     }
 }
 
+int DeconvolutionDepthWise::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    int _kernel_w = kernel_w;
+    int _kernel_h = kernel_h;
+    int _num_output = num_output;
+    if (dynamic_weight)
+    {
+        _kernel_w = bottom_blob_shapes[1].w;
+        _kernel_h = bottom_blob_shapes[1].h;
+        _num_output = bottom_blob_shapes[1].d * group;
+    }
+
+    const int kernel_extent_w = dilation_w * (_kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (_kernel_h - 1) + 1;
+
+    int outw = (shape.w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    int outh = (shape.h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+
+    // see cut_padding
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0)
+    {
+        outw -= pad_left + pad_right;
+        outh -= pad_top + pad_bottom;
+    }
+    else if (output_w > 0 && output_h > 0)
+    {
+        outw = output_w;
+        outh = output_h;
+    }
+
+    top_blob_shapes[0] = Mat(outw, outh, _num_output, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
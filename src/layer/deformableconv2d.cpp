@@ -11,6 +11,7 @@ DeformableConv2D::DeformableConv2D()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int DeformableConv2D::load_param(const ParamDict& pd)
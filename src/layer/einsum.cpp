@@ -10,6 +10,7 @@ Einsum::Einsum()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int Einsum::load_param(const ParamDict& pd)
@@ -175,4 +175,11 @@ int Eltwise::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top
     return 0;
 }
 
+int Eltwise::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    top_blob_shapes[0] = bottom_blob_shapes[0];
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -11,6 +11,7 @@ Embed::Embed()
 {
     one_blob_only = true;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int Embed::load_param(const ParamDict& pd)
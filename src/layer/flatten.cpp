@@ -38,4 +38,13 @@ int Flatten::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     return 0;
 }
 
+int Flatten::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    top_blob_shapes[0] = Mat(shape.w * shape.h * shape.d * shape.c, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
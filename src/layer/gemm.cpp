@@ -9,6 +9,7 @@ Gemm::Gemm()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int Gemm::load_param(const ParamDict& pd)
@@ -637,4 +638,46 @@ int Gemm::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& t
 }
 #endif // NCNN_INT8
 
+int Gemm::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    int M;
+    if (constantA)
+    {
+        M = constantM;
+    }
+    else
+    {
+        const Mat& A0 = bottom_blob_shapes[0];
+        M = transA == 0 ? (A0.dims == 3 ? A0.c : A0.h) : A0.w;
+    }
+
+    int N;
+    if (constantB)
+    {
+        N = constantN;
+    }
+    else
+    {
+        const Mat& B0 = constantA ? bottom_blob_shapes[0] : bottom_blob_shapes[1];
+        N = transB == 0 ? B0.w : (B0.dims == 3 ? B0.c : B0.h);
+    }
+
+    if (output_transpose)
+    {
+        if (output_N1M)
+            top_blob_shapes[0] = Mat(M, 1, N, (void*)0);
+        else
+            top_blob_shapes[0] = Mat(M, N, (void*)0);
+    }
+    else
+    {
+        if (output_N1M)
+            top_blob_shapes[0] = Mat(N, 1, M, (void*)0);
+        else
+            top_blob_shapes[0] = Mat(N, M, (void*)0);
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
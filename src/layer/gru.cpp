@@ -9,6 +9,7 @@ GRU::GRU()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int GRU::load_param(const ParamDict& pd)
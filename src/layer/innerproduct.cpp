@@ -269,4 +269,23 @@ int InnerProduct::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Opti
 }
 #endif // NCNN_INT8
 
+int InnerProduct::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    const int num_input = weight_data_size / num_output;
+
+    if (shape.dims == 2 && shape.w == num_input)
+    {
+        // gemm
+        top_blob_shapes[0] = Mat(num_output, shape.h, (void*)0);
+    }
+    else
+    {
+        top_blob_shapes[0] = Mat(num_output, (void*)0);
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
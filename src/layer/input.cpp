@@ -35,4 +35,21 @@ int Input::forward_inplace(VkMat& /*bottom_top_blob*/, VkCompute& /*cmd*/, const
 }
 #endif // NCNN_VULKAN
 
+int Input::infer_shape(const std::vector<Mat>& /*bottom_blob_shapes*/, std::vector<Mat>& top_blob_shapes) const
+{
+    // shape from param, empty if not provided
+    if (d != 0)
+        top_blob_shapes[0] = Mat(w, h, d, c, (void*)0);
+    else if (c != 0)
+        top_blob_shapes[0] = Mat(w, h, c, (void*)0);
+    else if (h != 0)
+        top_blob_shapes[0] = Mat(w, h, (void*)0);
+    else if (w != 0)
+        top_blob_shapes[0] = Mat(w, (void*)0);
+    else
+        top_blob_shapes[0] = Mat();
+
+    return 0;
+}
+
 } // namespace ncnn
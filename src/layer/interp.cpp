@@ -11,6 +11,7 @@ Interp::Interp()
 {
     one_blob_only = true;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int Interp::load_param(const ParamDict& pd)
@@ -703,4 +704,46 @@ int Interp::eval_size_expr(const std::vector<Mat>& bottom_blobs, int& outw, int&
     return 0;
 }
 
+int Interp::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    int outw;
+    int outh;
+    if (bottom_blob_shapes.size() == 1)
+    {
+        int w = shape.dims == 1 ? 1 : shape.w;
+        int h = shape.dims == 1 ? 1 : shape.h;
+
+        outw = output_width;
+        outh = output_height;
+        if (outw == 0 || outh == 0)
+        {
+            outw = static_cast<int>(w * width_scale);
+            outh = static_cast<int>(h * height_scale);
+        }
+    }
+    else
+    {
+        outw = bottom_blob_shapes[1].w;
+        outh = bottom_blob_shapes[1].h;
+    }
+
+    if (!size_expr.empty())
+    {
+        int r = eval_size_expr(bottom_blob_shapes, outw, outh);
+        if (r != 0)
+            return -1;
+    }
+
+    if (shape.dims == 1)
+        top_blob_shapes[0] = Mat(outw, outh, shape.w, (void*)0);
+    if (shape.dims == 2)
+        top_blob_shapes[0] = Mat(outw, shape.h, (void*)0);
+    if (shape.dims == 3)
+        top_blob_shapes[0] = Mat(outw, outh, shape.c, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -19,6 +19,8 @@ public:
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+    virtual int infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const;
+
 protected:
     int eval_size_expr(const std::vector<Mat>& bottom_blobs, int& outw, int& outh) const;
 
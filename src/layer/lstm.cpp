@@ -9,6 +9,7 @@ LSTM::LSTM()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int LSTM::load_param(const ParamDict& pd)
@@ -9,11 +9,21 @@ MatMul::MatMul()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int MatMul::load_param(const ParamDict& pd)
 {
     transB = pd.get(0, 0);
+    int8_scale_term = pd.get(18, 0);
+
+    if (int8_scale_term)
+    {
+#if !NCNN_INT8
+        NCNN_LOGE("please build ncnn with NCNN_INT8 enabled for int8 inference");
+        return -1;
+#endif
+    }
 
     return 0;
 }
@@ -37,7 +47,16 @@ static void transpose(const Mat& X, Mat& XT, const Option& opt)
     }
 }
 
-static void matmul_transb(const Mat& A, const Mat& B, Mat& top_blob, const Option& opt)
+#if NCNN_INT8
+static inline signed char float2int8(float v)
+{
+    int int32 = static_cast<int>(round(v));
+    if (int32 > 127) return 127;
+    if (int32 < -127) return -127;
+    return (signed char)int32;
+}
+
+static void matmul_transb_int8(const Mat& A, const Mat& B, Mat& top_blob, const Option& opt)
 {
     const int M = A.h;
     const int K = A.w; // assert A.w == B.w
@@ -47,6 +66,81 @@ static void matmul_transb(const Mat& A, const Mat& B, Mat& top_blob, const Optio
     const float* pB = B;
     float* pOut = top_blob;
 
+    // dynamic quantize B per tensor
+    float absmax = 0.f;
+    for (int j = 0; j < N * K; j++)
+    {
+        absmax = std::max(absmax, (float)fabs(pB[j]));
+    }
+
+    const float B_int8_scale = absmax == 0.f ? 1.f : 127.f / absmax;
+
+    std::vector<signed char> B_int8(N * K);
+    for (int j = 0; j < N * K; j++)
+    {
+        B_int8[j] = float2int8(pB[j] * B_int8_scale);
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        const float* ptrA = pA + i * K;
+        float* outptr = pOut + i * N;
+
+        // dynamic quantize A per row
+        float A_absmax = 0.f;
+        for (int k = 0; k < K; k++)
+        {
+            A_absmax = std::max(A_absmax, (float)fabs(ptrA[k]));
+        }
+
+        const float A_int8_scale = A_absmax == 0.f ? 1.f : 127.f / A_absmax;
+
+        std::vector<signed char> A_int8(K);
+        for (int k = 0; k < K; k++)
+        {
+            A_int8[k] = float2int8(ptrA[k] * A_int8_scale);
+        }
+
+        const float descale = 1.f / (A_int8_scale * B_int8_scale);
+
+        for (int j = 0; j < N; j++)
+        {
+            const signed char* ptrB = &B_int8[j * K];
+
+            int sum = 0;
+            for (int k = 0; k < K; k++)
+            {
+                sum += A_int8[k] * ptrB[k];
+            }
+
+            *outptr++ = sum * descale;
+        }
+    }
+}
+#endif // NCNN_INT8
+
+static void matmul_transb(const Mat& A, const Mat& B, Mat& top_blob, int int8_scale_term, const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        matmul_transb_int8(A, B, top_blob, opt);
+        return;
+    }
+#else
+    (void)int8_scale_term;
+#endif
+
+
+    const int M = A.h;
+    const int K = A.w; // assert A.w == B.w
+    const int N = B.h;
+
+    const float* pA = A;
+    const float* pB = B;
+    float* pOut = top_blob;
+
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int i = 0; i < M; i++)
     {
@@ -86,17 +180,9 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
         if (top_blob.empty())
             return -100;
 
-        const int K = A.w; // assert A.w == B.w
-        const float* ptrA = A;
-        const float* ptrB = B;
+        Mat top_blob1 = top_blob.reshape(1, 1);
 
-        float sum = 0.f;
-        for (int k = 0; k < K; k++)
-        {
-            sum += ptrA[k] * ptrB[k];
-        }
-
-        top_blob[0] = sum;
+        matmul_transb(A.reshape(A.w, 1), B.reshape(B.w, 1), top_blob1, int8_scale_term, opt);
     }
     else if (Adims == 2 && Bdims == 2)
     {
@@ -122,7 +208,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
             BT = B;
         }
 
-        matmul_transb(A, BT, top_blob, opt);
+        matmul_transb(A, BT, top_blob, int8_scale_term, opt);
     }
     else if (Adims == 1 && Bdims == 2)
     {
@@ -149,7 +235,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
             BT = B;
         }
 
-        matmul_transb(A1, BT, top_blob1, opt);
+        matmul_transb(A1, BT, top_blob1, int8_scale_term, opt);
 
         top_blob = top_blob1.reshape(N);
     }
@@ -164,7 +250,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
 
         Mat BT = B.reshape(B.w, 1);
 
-        matmul_transb(A, BT, top_blob1, opt);
+        matmul_transb(A, BT, top_blob1, int8_scale_term, opt);
 
         top_blob = top_blob1.reshape(M);
     }
@@ -198,7 +284,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
             }
 
             Mat top_blob1_p = top_blob1.channel(p);
-            matmul_transb(A1, BT, top_blob1_p, opt);
+            matmul_transb(A1, BT, top_blob1_p, int8_scale_term, opt);
         }
 
         if (Bdims == 3)
@@ -222,7 +308,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
         for (int p = 0; p < batch_size; p++)
         {
             Mat top_blob1_p = top_blob1.channel(p);
-            matmul_transb(A1.channel(p), BT, top_blob1_p, opt);
+            matmul_transb(A1.channel(p), BT, top_blob1_p, int8_scale_term, opt);
         }
 
         if (Adims == 3)
@@ -287,7 +373,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
             }
 
             Mat top_blob_p = top_blob.channel(p);
-            matmul_transb(A1.channel(Ap), BT, top_blob_p, opt);
+            matmul_transb(A1.channel(Ap), BT, top_blob_p, int8_scale_term, opt);
         }
     }
     else if (max_ABdims == 4)
@@ -374,7 +460,7 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
                 }
 
                 Mat top_blob_p_q = top_blob.channel(p).depth(q);
-                matmul_transb(A1.channel(Ap).depth(Ad), BT, top_blob_p_q, opt);
+                matmul_transb(A1.channel(Ap).depth(Ad), BT, top_blob_p_q, int8_scale_term, opt);
             }
         }
     }
@@ -387,4 +473,69 @@ int MatMul::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_
     return 0;
 }
 
+int MatMul::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& A = bottom_blob_shapes[0];
+    const Mat& B = bottom_blob_shapes[1];
+
+    const int Adims = A.dims;
+    const int Bdims = B.dims;
+    const int max_ABdims = std::max(Adims, Bdims);
+
+    const int M = A.h;
+    const int N = Bdims == 1 ? 1 : transB == 0 ? B.w : B.h;
+
+    Mat& top_blob_shape = top_blob_shapes[0];
+    if (Adims == 1 && Bdims == 1)
+    {
+        top_blob_shape = Mat(1, (void*)0);
+    }
+    else if (Adims == 2 && Bdims == 2)
+    {
+        top_blob_shape = Mat(N, M, (void*)0);
+    }
+    else if (Adims == 1 && Bdims == 2)
+    {
+        top_blob_shape = Mat(N, (void*)0);
+    }
+    else if (Adims == 2 && Bdims == 1)
+    {
+        top_blob_shape = Mat(M, (void*)0);
+    }
+    else if (Adims == 1 && Bdims > 2)
+    {
+        if (Bdims == 3)
+            top_blob_shape = Mat(N, B.d * B.c, (void*)0);
+        else
+            top_blob_shape = Mat(N, B.d, B.c, (void*)0);
+    }
+    else if (Adims > 2 && Bdims == 1)
+    {
+        if (Adims == 3)
+            top_blob_shape = Mat(M, A.d * A.c, (void*)0);
+        else
+            top_blob_shape = Mat(M, A.d, A.c, (void*)0);
+    }
+    else if (max_ABdims == 3)
+    {
+        top_blob_shape = Mat(N, M, std::max(A.c, B.c), (void*)0);
+    }
+    else if (max_ABdims == 4)
+    {
+        // 3-dim blob is reshaped to w-h-c-1
+        const int Ad = Adims == 3 ? A.c : A.d;
+        const int Ac = Adims == 3 ? 1 : A.c;
+        const int Bd = Bdims == 3 ? B.c : B.d;
+        const int Bc = Bdims == 3 ? 1 : B.c;
+        top_blob_shape = Mat(N, M, std::max(Ad, Bd), std::max(Ac, Bc), (void*)0);
+    }
+    else
+    {
+        NCNN_LOGE("impossible matmul %d %d", Adims, Bdims);
+        return -1;
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
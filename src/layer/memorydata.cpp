@@ -61,4 +61,20 @@ int MemoryData::forward(const std::vector<Mat>& /*bottom_blobs*/, std::vector<Ma
     return 0;
 }
 
+int MemoryData::infer_shape(const std::vector<Mat>& /*bottom_blob_shapes*/, std::vector<Mat>& top_blob_shapes) const
+{
+    if (d != 0)
+        top_blob_shapes[0] = Mat(w, h, d, c, (void*)0);
+    else if (c != 0)
+        top_blob_shapes[0] = Mat(w, h, c, (void*)0);
+    else if (h != 0)
+        top_blob_shapes[0] = Mat(w, h, (void*)0);
+    else if (w != 0)
+        top_blob_shapes[0] = Mat(w, (void*)0);
+    else // 0 0 0
+        top_blob_shapes[0] = Mat(1, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
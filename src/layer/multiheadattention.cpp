@@ -9,6 +9,7 @@ namespace ncnn {
 
 MultiHeadAttention::MultiHeadAttention()
 {
+    support_adaptive_thread_count = false;
 }
 
 int MultiHeadAttention::load_param(const ParamDict& pd)
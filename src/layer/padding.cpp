@@ -444,4 +444,23 @@ int Padding::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     return 0;
 }
 
+int Padding::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    const int outw = shape.w + left + right;
+    const int outh = shape.h + top + bottom;
+
+    if (shape.dims == 1)
+        top_blob_shapes[0] = Mat(outw, (void*)0);
+    if (shape.dims == 2)
+        top_blob_shapes[0] = Mat(outw, outh, (void*)0);
+    if (shape.dims == 3)
+        top_blob_shapes[0] = Mat(outw, outh, shape.c + front + behind, (void*)0);
+    if (shape.dims == 4)
+        top_blob_shapes[0] = Mat(outw, outh, shape.d + front + behind, shape.c, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
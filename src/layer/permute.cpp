@@ -781,4 +781,43 @@ int Permute::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     return 0;
 }
 
+int Permute::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    // source axis of each output axis, in w h c or w h d c order
+    static const int order_3d[6][3] = {
+        {0, 1, 2}, {1, 0, 2}, {0, 2, 1}, {2, 0, 1}, {1, 2, 0}, {2, 1, 0}
+    };
+    static const int order_4d[24][4] = {
+        {0, 1, 2, 3}, {1, 0, 2, 3}, {0, 2, 1, 3}, {2, 0, 1, 3}, {1, 2, 0, 3}, {2, 1, 0, 3},
+        {0, 1, 3, 2}, {1, 0, 3, 2}, {0, 3, 1, 2}, {3, 0, 1, 2}, {1, 3, 0, 2}, {3, 1, 0, 2},
+        {0, 2, 3, 1}, {2, 0, 3, 1}, {0, 3, 2, 1}, {3, 0, 2, 1}, {2, 3, 0, 1}, {3, 2, 0, 1},
+        {1, 2, 3, 0}, {2, 1, 3, 0}, {1, 3, 2, 0}, {3, 1, 2, 0}, {2, 3, 1, 0}, {3, 2, 1, 0}
+    };
+
+    if (shape.dims == 1 || order_type == 0)
+    {
+        top_blob_shapes[0] = shape;
+    }
+    else if (shape.dims == 2)
+    {
+        top_blob_shapes[0] = Mat(shape.h, shape.w, (void*)0);
+    }
+    else if (shape.dims == 3)
+    {
+        const int extents[3] = {shape.w, shape.h, shape.c};
+        const int* order = order_3d[order_type];
+        top_blob_shapes[0] = Mat(extents[order[0]], extents[order[1]], extents[order[2]], (void*)0);
+    }
+    else
+    {
+        const int extents[4] = {shape.w, shape.h, shape.d, shape.c};
+        const int* order = order_4d[order_type];
+        top_blob_shapes[0] = Mat(extents[order[0]], extents[order[1]], extents[order[2]], extents[order[3]], (void*)0);
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -69,4 +69,17 @@ int PixelShuffle::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
     return 0;
 }
 
+int PixelShuffle::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    const int outw = shape.w * upscale_factor;
+    const int outh = shape.h * upscale_factor;
+    const int outc = shape.c / (upscale_factor * upscale_factor);
+
+    top_blob_shapes[0] = Mat(outw, outh, outc, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
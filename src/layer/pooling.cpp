@@ -41,6 +41,11 @@ int Pooling::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     // max value in NxN window
     // avg value in NxN window
 
+#if NCNN_INT8
+    if (bottom_blob.elemsize == 1 && pooling_type == PoolMethod_MAX && !adaptive_pooling)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
@@ -347,6 +352,116 @@ int Pooling::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     return 0;
 }
 
+#if NCNN_INT8
+int Pooling::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // max of int8 values keeps the input scale, any elempack
+    // assert pooling_type == PoolMethod_MAX
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (global_pooling)
+    {
+        top_blob.create(channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        int size = w * h;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const signed char* ptr = bottom_blob.channel(q);
+            signed char* outptr = (signed char*)top_blob + q * elempack;
+
+            for (int k = 0; k < elempack; k++)
+            {
+                signed char max = ptr[k];
+                for (int i = 0; i < size; i++)
+                {
+                    max = std::max(max, ptr[i * elempack + k]);
+                }
+
+                outptr[k] = max;
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+    h = bottom_blob_bordered.h;
+
+    int outw = (w - kernel_w) / stride_w + 1;
+    int outh = (h - kernel_h) / stride_h + 1;
+
+    top_blob.create(outw, outh, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w - kernel_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2 * elempack;
+                p1++;
+                p2++;
+            }
+            p2 += gap;
+        }
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        signed char* outptr = top_blob.channel(q);
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const signed char* sptr = m.row<const signed char>(i * stride_h) + j * stride_w * elempack;
+
+                for (int k = 0; k < elempack; k++)
+                {
+                    signed char max = sptr[k];
+
+                    for (int l = 0; l < maxk; l++)
+                    {
+                        max = std::max(max, sptr[space_ofs[l] + k]);
+                    }
+
+                    outptr[k] = max;
+                }
+
+                outptr += elempack;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 void Pooling::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -357,7 +472,7 @@ void Pooling::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, co
     float pad_value = 0.f;
     if (pooling_type == PoolMethod_MAX)
     {
-        pad_value = bottom_blob.elemsize == 1 ? -128.f : -FLT_MAX;
+        pad_value = bottom_blob.elembits() == 8 ? -128.f : -FLT_MAX;
     }
     else if (pooling_type == PoolMethod_AVE)
     {
@@ -411,4 +526,61 @@ void Pooling::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, co
     }
 }
 
+int Pooling::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    if (global_pooling)
+    {
+        top_blob_shapes[0] = Mat(shape.c, (void*)0);
+        return 0;
+    }
+
+    if (adaptive_pooling)
+    {
+        int _out_w = out_w == -233 ? shape.w : out_w;
+        int _out_h = out_h == -233 ? shape.h : out_h;
+        top_blob_shapes[0] = Mat(_out_w, _out_h, shape.c, (void*)0);
+        return 0;
+    }
+
+    // see make_padding
+    int w = shape.w;
+    int h = shape.h;
+    if (pad_mode == 0) // full padding
+    {
+        w += pad_left + pad_right;
+        h += pad_top + pad_bottom;
+
+        int wtail = (w - kernel_w) % stride_w;
+        int htail = (h - kernel_h) % stride_h;
+        if (wtail != 0)
+            w += stride_w - wtail;
+        if (htail != 0)
+            h += stride_h - htail;
+    }
+    else if (pad_mode == 1) // valid padding
+    {
+        w += pad_left + pad_right;
+        h += pad_top + pad_bottom;
+    }
+    else if (pad_mode == 2 || pad_mode == 3) // tensorflow padding=SAME or onnx padding=SAME_UPPER/SAME_LOWER
+    {
+        int wpad = kernel_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_h + (h - 1) / stride_h * stride_h - h;
+        if (wpad > 0 || hpad > 0)
+        {
+            w += wpad;
+            h += hpad;
+        }
+    }
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+    const int outh = (h - kernel_h) / stride_h + 1;
+
+    top_blob_shapes[0] = Mat(outw, outh, shape.c, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
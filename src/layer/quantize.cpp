@@ -107,4 +107,11 @@ int Quantize::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
     return 0;
 }
 
+int Quantize::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    top_blob_shapes[0] = bottom_blob_shapes[0];
+
+    return 0;
+}
+
 } // namespace ncnn
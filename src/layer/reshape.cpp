@@ -52,36 +52,11 @@ int Reshape::load_param(const ParamDict& pd)
     return 0;
 }
 
-int Reshape::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
-{
-    std::vector<Mat> bottom_blobs(1);
-    bottom_blobs[0] = bottom_blob;
-    std::vector<Mat> top_blobs(1);
-    int ret = forward(bottom_blobs, top_blobs, opt);
-    top_blob = top_blobs[0];
-    return ret;
-}
-
-int Reshape::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+// resolve 0 as the bottom extent and -1 as the remaining size
+static void resolve_shape(const Mat& bottom_blob, int ndim, int& outw, int& outh, int& outd, int& outc)
 {
-    const Mat& bottom_blob = bottom_blobs[0];
-    Mat& top_blob = top_blobs[0];
-
-    // resolve out shape
-    int outw = w;
-    int outh = h;
-    int outd = d;
-    int outc = c;
-
-    if (!shape_expr.empty())
-    {
-        eval_shape_expr(bottom_blobs, outw, outh, outd, outc);
-    }
-
     int total = bottom_blob.w * bottom_blob.h * bottom_blob.d * bottom_blob.c;
 
-    int dims = bottom_blob.dims;
-
     if (ndim == 1)
     {
         if (outw == 0)
@@ -89,12 +64,6 @@ int Reshape::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top
 
         if (outw == -1)
             outw = total;
-
-        if (dims == 1 && bottom_blob.w == outw)
-        {
-            top_blob = bottom_blob;
-            return 0;
-        }
     }
     if (ndim == 2)
     {
@@ -107,12 +76,6 @@ int Reshape::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top
             outw = total / outh;
         if (outh == -1)
             outh = total / outw;
-
-        if (dims == 2 && bottom_blob.h == outh)
-        {
-            top_blob = bottom_blob;
-            return 0;
-        }
     }
     if (ndim == 3)
     {
@@ -129,14 +92,6 @@ int Reshape::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top
             outh = total / outc / outw;
         if (outc == -1)
             outc = total / outh / outw;
-
-        if (dims == 3 && bottom_blob.c == outc)
-        {
-            top_blob = bottom_blob;
-            top_blob.w = outw;
-            top_blob.h = outh;
-            return 0;
-        }
     }
     if (ndim == 4)
     {
@@ -157,15 +112,63 @@ int Reshape::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top
             outd = total / outc / outh / outw;
         if (outc == -1)
             outc = total / outd / outh / outw;
+    }
+}
+
+int Reshape::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    std::vector<Mat> bottom_blobs(1);
+    bottom_blobs[0] = bottom_blob;
+    std::vector<Mat> top_blobs(1);
+    int ret = forward(bottom_blobs, top_blobs, opt);
+    top_blob = top_blobs[0];
+    return ret;
+}
 
-        if (dims == 4 && bottom_blob.c == outc)
-        {
-            top_blob = bottom_blob;
-            top_blob.w = outw;
-            top_blob.h = outh;
-            top_blob.d = outd;
-            return 0;
-        }
+int Reshape::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    Mat& top_blob = top_blobs[0];
+
+    // resolve out shape
+    int outw = w;
+    int outh = h;
+    int outd = d;
+    int outc = c;
+
+    if (!shape_expr.empty())
+    {
+        eval_shape_expr(bottom_blobs, outw, outh, outd, outc);
+    }
+
+    resolve_shape(bottom_blob, ndim, outw, outh, outd, outc);
+
+    int dims = bottom_blob.dims;
+
+    if (ndim == 1 && dims == 1 && bottom_blob.w == outw)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+    if (ndim == 2 && dims == 2 && bottom_blob.h == outh)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+    if (ndim == 3 && dims == 3 && bottom_blob.c == outc)
+    {
+        top_blob = bottom_blob;
+        top_blob.w = outw;
+        top_blob.h = outh;
+        return 0;
+    }
+    if (ndim == 4 && dims == 4 && bottom_blob.c == outc)
+    {
+        top_blob = bottom_blob;
+        top_blob.w = outw;
+        top_blob.h = outh;
+        top_blob.d = outd;
+        return 0;
     }
 
     if (ndim == 1)
@@ -228,4 +231,30 @@ int Reshape::eval_shape_expr(const std::vector<Mat>& bottom_blobs, int& outw, in
     return 0;
 }
 
+int Reshape::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    int outw = w;
+    int outh = h;
+    int outd = d;
+    int outc = c;
+
+    if (!shape_expr.empty())
+    {
+        eval_shape_expr(bottom_blob_shapes, outw, outh, outd, outc);
+    }
+
+    resolve_shape(bottom_blob_shapes[0], ndim, outw, outh, outd, outc);
+
+    if (ndim == 1)
+        top_blob_shapes[0] = Mat(outw, (void*)0);
+    if (ndim == 2)
+        top_blob_shapes[0] = Mat(outw, outh, (void*)0);
+    if (ndim == 3)
+        top_blob_shapes[0] = Mat(outw, outh, outc, (void*)0);
+    if (ndim == 4)
+        top_blob_shapes[0] = Mat(outw, outh, outd, outc, (void*)0);
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -9,6 +9,7 @@ RNN::RNN()
 {
     one_blob_only = false;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int RNN::load_param(const ParamDict& pd)
@@ -0,0 +1,272 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "separableconvolution.h"
+
+#include "fused_activation.h"
+
+namespace ncnn {
+
+SeparableConvolution::SeparableConvolution()
+{
+    one_blob_only = true;
+    support_inplace = false;
+    support_adaptive_thread_count = false;
+}
+
+int SeparableConvolution::load_param(const ParamDict& pd)
+{
+    num_output = pd.get(0, 0);
+    kernel_w = pd.get(1, 0);
+    kernel_h = pd.get(11, kernel_w);
+    dilation_w = pd.get(2, 1);
+    dilation_h = pd.get(12, dilation_w);
+    stride_w = pd.get(3, 1);
+    stride_h = pd.get(13, stride_w);
+    pad_left = pd.get(4, 0);
+    pad_right = pd.get(15, pad_left);
+    pad_top = pd.get(14, pad_left);
+    pad_bottom = pd.get(16, pad_top);
+    pad_value = pd.get(18, 0.f);
+    bias_term = pd.get(5, 0);
+    weight_data_size = pd.get(6, 0);
+    activation_type = pd.get(9, 0);
+    activation_params = pd.get(10, Mat());
+
+    depthwise_bias_term = pd.get(20, 0);
+    depthwise_weight_data_size = pd.get(21, 0);
+    depthwise_activation_type = pd.get(22, 0);
+    depthwise_activation_params = pd.get(23, Mat());
+
+    const int maxk = kernel_w * kernel_h;
+    if (maxk == 0 || depthwise_weight_data_size % maxk != 0)
+    {
+        // reject invalid depthwise kernel
+        return -100;
+    }
+
+    const int channels = depthwise_weight_data_size / maxk;
+    if (num_output == 0 || weight_data_size != channels * num_output)
+    {
+        // reject invalid pointwise kernel
+        return -100;
+    }
+
+    return 0;
+}
+
+int SeparableConvolution::load_model(const ModelBin& mb)
+{
+    const int channels = depthwise_weight_data_size / (kernel_w * kernel_h);
+
+    depthwise_weight_data = mb.load(depthwise_weight_data_size, 0);
+    if (depthwise_weight_data.empty())
+        return -100;
+
+    if (depthwise_bias_term)
+    {
+        depthwise_bias_data = mb.load(channels, 1);
+        if (depthwise_bias_data.empty())
+            return -100;
+    }
+
+    weight_data = mb.load(weight_data_size, 0);
+    if (weight_data.empty())
+        return -100;
+
+    if (bias_term)
+    {
+        bias_data = mb.load(num_output, 1);
+        if (bias_data.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
+int SeparableConvolution::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+    const int channels = bottom_blob_bordered.c;
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+
+    const int maxk = kernel_w * kernel_h;
+
+    if (channels * maxk != depthwise_weight_data_size)
+        return -1;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w * dilation_h - kernel_w * dilation_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2;
+                p1++;
+                p2 += dilation_w;
+            }
+            p2 += gap;
+        }
+    }
+
+    // depthwise
+    Mat dw_blob(outw, outh, channels, elemsize, opt.workspace_allocator);
+    if (dw_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int g = 0; g < channels; g++)
+    {
+        float* outptr = dw_blob.channel(g);
+        const float* kptr = (const float*)depthwise_weight_data + maxk * g;
+        const Mat m = bottom_blob_bordered.channel(g);
+
+        const float bias = depthwise_bias_term ? depthwise_bias_data[g] : 0.f;
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                float sum = bias;
+
+                const float* sptr = m.row(i * stride_h) + j * stride_w;
+
+                for (int k = 0; k < maxk; k++)
+                {
+                    sum += sptr[space_ofs[k]] * kptr[k];
+                }
+
+                outptr[j] = activation_ss(sum, depthwise_activation_type, depthwise_activation_params);
+            }
+
+            outptr += outw;
+        }
+    }
+
+    // pointwise
+    top_blob.create(outw, outh, num_output, elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int size = outw * outh;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output; p++)
+    {
+        float* outptr = top_blob.channel(p);
+        const float* kptr = (const float*)weight_data + channels * p;
+
+        const float bias = bias_term ? bias_data[p] : 0.f;
+
+        for (int i = 0; i < size; i++)
+        {
+            float sum = bias;
+
+            const float* sptr = (const float*)dw_blob + i;
+
+            for (int q = 0; q < channels; q++)
+            {
+                sum += sptr[dw_blob.cstep * q] * kptr[q];
+            }
+
+            outptr[i] = activation_ss(sum, activation_type, activation_params);
+        }
+    }
+
+    return 0;
+}
+
+void SeparableConvolution::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    bottom_blob_bordered = bottom_blob;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        copy_make_border(bottom_blob, bottom_blob_bordered, pad_top, pad_bottom, pad_left, pad_right, BORDER_CONSTANT, pad_value, opt_b);
+    }
+    else if (pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233)
+    {
+        // tensorflow padding=SAME or onnx padding=SAME_UPPER
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        if (wpad > 0 || hpad > 0)
+        {
+            Option opt_b = opt;
+            opt_b.blob_allocator = opt.workspace_allocator;
+            copy_make_border(bottom_blob, bottom_blob_bordered, hpad / 2, hpad - hpad / 2, wpad / 2, wpad - wpad / 2, BORDER_CONSTANT, pad_value, opt_b);
+        }
+    }
+    else if (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234)
+    {
+        // onnx padding=SAME_LOWER
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        if (wpad > 0 || hpad > 0)
+        {
+            Option opt_b = opt;
+            opt_b.blob_allocator = opt.workspace_allocator;
+            copy_make_border(bottom_blob, bottom_blob_bordered, hpad - hpad / 2, hpad / 2, wpad - wpad / 2, wpad / 2, BORDER_CONSTANT, pad_value, opt_b);
+        }
+    }
+}
+
+int SeparableConvolution::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    int w = shape.w;
+    int h = shape.h;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0)
+    {
+        w += pad_left + pad_right;
+        h += pad_top + pad_bottom;
+    }
+    else if ((pad_left == -233 && pad_right == -233 && pad_top == -233 && pad_bottom == -233)
+             || (pad_left == -234 && pad_right == -234 && pad_top == -234 && pad_bottom == -234))
+    {
+        // tensorflow padding=SAME or onnx padding=SAME_UPPER/SAME_LOWER
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        if (wpad > 0 || hpad > 0)
+        {
+            w += wpad;
+            h += hpad;
+        }
+    }
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+
+    top_blob_shapes[0] = Mat(outw, outh, num_output, (void*)0);
+
+    return 0;
+}
+
+} // namespace ncnn
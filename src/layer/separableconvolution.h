@@ -0,0 +1,65 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SEPARABLECONVOLUTION_H
+#define LAYER_SEPARABLECONVOLUTION_H
+
+#include "layer.h"
+
+namespace ncnn {
+
+// depthwise convolution followed by pointwise 1x1 convolution
+class SeparableConvolution : public Layer
+{
+public:
+    SeparableConvolution();
+
+    virtual int load_param(const ParamDict& pd);
+
+    virtual int load_model(const ModelBin& mb);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+    virtual int infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const;
+
+protected:
+    void make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, const Option& opt) const;
+
+public:
+    // param
+    int num_output;
+    int kernel_w;
+    int kernel_h;
+    int dilation_w;
+    int dilation_h;
+    int stride_w;
+    int stride_h;
+    int pad_left; // -233=SAME_UPPER -234=SAME_LOWER
+    int pad_right;
+    int pad_top;
+    int pad_bottom;
+    float pad_value;
+    int bias_term;
+
+    int weight_data_size;
+
+    // 0=none 1=relu 2=leakyrelu 3=clip 4=sigmoid
+    int activation_type;
+    Mat activation_params;
+
+    // depthwise stage
+    int depthwise_bias_term;
+    int depthwise_weight_data_size;
+    int depthwise_activation_type;
+    Mat depthwise_activation_params;
+
+    // model
+    Mat depthwise_weight_data;
+    Mat depthwise_bias_data;
+    Mat weight_data;
+    Mat bias_data;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SEPARABLECONVOLUTION_H
@@ -402,4 +402,84 @@ int Slice::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
     return 0;
 }
 
+// extent of the positive axis, outermost first
+static int axis_extent(const Mat& shape, int positive_axis)
+{
+    if (shape.dims == 1)
+        return shape.w;
+    if (shape.dims == 2)
+        return positive_axis == 0 ? shape.h : shape.w;
+    if (shape.dims == 3)
+        return positive_axis == 0 ? shape.c : positive_axis == 1 ? shape.h : shape.w;
+
+    return positive_axis == 0 ? shape.c : positive_axis == 1 ? shape.d : positive_axis == 2 ? shape.h : shape.w;
+}
+
+static Mat shape_with_axis_extent(const Mat& shape, int positive_axis, int extent)
+{
+    if (shape.dims == 1)
+        return Mat(extent, (void*)0);
+    if (shape.dims == 2)
+        return positive_axis == 0 ? Mat(shape.w, extent, (void*)0) : Mat(extent, shape.h, (void*)0);
+    if (shape.dims == 3)
+    {
+        if (positive_axis == 0)
+            return Mat(shape.w, shape.h, extent, (void*)0);
+        if (positive_axis == 1)
+            return Mat(shape.w, extent, shape.c, (void*)0);
+        return Mat(extent, shape.h, shape.c, (void*)0);
+    }
+
+    if (positive_axis == 0)
+        return Mat(shape.w, shape.h, shape.d, extent, (void*)0);
+    if (positive_axis == 1)
+        return Mat(shape.w, shape.h, extent, shape.c, (void*)0);
+    if (positive_axis == 2)
+        return Mat(shape.w, extent, shape.d, shape.c, (void*)0);
+    return Mat(extent, shape.h, shape.d, shape.c, (void*)0);
+}
+
+int Slice::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    const Mat& shape = bottom_blob_shapes[0];
+    const int* slices_ptr = slices;
+    const int* indices_ptr = indices;
+    int positive_axis = axis < 0 ? shape.dims + axis : axis;
+
+    const int extent = axis_extent(shape, positive_axis);
+
+    int q = 0;
+    for (size_t i = 0; i < top_blob_shapes.size(); i++)
+    {
+        int slice;
+        if (indices_ptr)
+        {
+            if (i == top_blob_shapes.size() - 1)
+            {
+                slice = extent - q;
+            }
+            else
+            {
+                int indice = indices_ptr[i];
+                int positive_indice = indice < 0 ? extent + indice : indice;
+                slice = positive_indice - q;
+            }
+        }
+        else
+        {
+            slice = slices_ptr[i];
+            if (slice == -233)
+            {
+                slice = static_cast<int>((extent - q) / (top_blob_shapes.size() - i));
+            }
+        }
+
+        top_blob_shapes[i] = shape_with_axis_extent(shape, positive_axis, slice);
+
+        q += slice;
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -26,4 +26,14 @@ int Split::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_b
     return 0;
 }
 
+int Split::infer_shape(const std::vector<Mat>& bottom_blob_shapes, std::vector<Mat>& top_blob_shapes) const
+{
+    for (size_t i = 0; i < top_blob_shapes.size(); i++)
+    {
+        top_blob_shapes[i] = bottom_blob_shapes[0];
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
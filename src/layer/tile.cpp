@@ -9,6 +9,7 @@ Tile::Tile()
 {
     one_blob_only = true;
     support_inplace = false;
+    support_adaptive_thread_count = false;
 }
 
 int Tile::load_param(const ParamDict& pd)
@@ -0,0 +1,180 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "topk.h"
+
+#include <float.h>
+
+namespace ncnn {
+
+TopK::TopK()
+{
+    one_blob_only = false;
+    support_inplace = false;
+}
+
+int TopK::load_param(const ParamDict& pd)
+{
+    axis = pd.get(0, -1);
+    k = pd.get(1, 1);
+    largest = pd.get(2, 1);
+    sorted = pd.get(3, 1);
+    softmax = pd.get(4, 0);
+
+    return 0;
+}
+
+struct topk_greater
+{
+    bool operator()(const std::pair<float, int>& a, const std::pair<float, int>& b) const
+    {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+};
+
+struct topk_less
+{
+    bool operator()(const std::pair<float, int>& a, const std::pair<float, int>& b) const
+    {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+    }
+};
+
+struct topk_index_less
+{
+    bool operator()(const std::pair<float, int>& a, const std::pair<float, int>& b) const
+    {
+        return a.second < b.second;
+    }
+};
+
+int TopK::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const int dims = bottom_blob.dims;
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const int c = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+    if (positive_axis < 0 || positive_axis >= dims)
+        return -1;
+
+    // view the blob as channels x outer x n x inner, n being the axis to select along
+    int channels = 1;
+    int outer = 1;
+    int n = 0;
+    int inner = 1;
+    if (dims >= 3 && positive_axis == 0)
+    {
+        n = c;
+        inner = w * h * d;
+    }
+    else
+    {
+        int shape[3];
+        int shape_dims = 0;
+        if (dims >= 3) channels = c;
+        if (dims == 4) shape[shape_dims++] = d;
+        if (dims >= 2) shape[shape_dims++] = h;
+        shape[shape_dims++] = w;
+
+        const int shape_axis = dims >= 3 ? positive_axis - 1 : positive_axis;
+        for (int i = 0; i < shape_axis; i++)
+            outer *= shape[i];
+        n = shape[shape_axis];
+        for (int i = shape_axis + 1; i < shape_dims; i++)
+            inner *= shape[i];
+    }
+
+    const int kk = std::min(k, n);
+
+    int outw = (positive_axis == dims - 1) ? kk : w;
+    int outh = (dims >= 2 && positive_axis == dims - 2) ? kk : h;
+    int outd = (dims == 4 && positive_axis == 1) ? kk : d;
+    int outc = (dims >= 3 && positive_axis == 0) ? kk : c;
+
+    for (size_t b = 0; b < top_blobs.size(); b++)
+    {
+        Mat& top_blob = top_blobs[b];
+        if (dims == 1)
+            top_blob.create(outw, elemsize, opt.blob_allocator);
+        if (dims == 2)
+            top_blob.create(outw, outh, elemsize, opt.blob_allocator);
+        if (dims == 3)
+            top_blob.create(outw, outh, outc, elemsize, opt.blob_allocator);
+        if (dims == 4)
+            top_blob.create(outw, outh, outd, outc, elemsize, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    const bool channel_axis = dims >= 3 && positive_axis == 0;
+    const size_t bottom_stride = channel_axis ? bottom_blob.cstep : inner;
+    const size_t top_stride = channel_axis ? top_blobs[0].cstep : inner;
+
+    const int rows = channels * outer * inner;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int r = 0; r < rows; r++)
+    {
+        const int q = r / (outer * inner);
+        const int o = r % (outer * inner) / inner;
+        const int i = r % inner;
+
+        const float* ptr = channel_axis ? (const float*)bottom_blob + i : (const float*)bottom_blob + q * bottom_blob.cstep + (size_t)o * n * inner + i;
+        const size_t top_offset = channel_axis ? i : q * top_blobs[0].cstep + (size_t)o * kk * inner + i;
+
+        std::vector<std::pair<float, int> > vec(n);
+        for (int j = 0; j < n; j++)
+        {
+            vec[j] = std::make_pair(ptr[j * bottom_stride], j);
+        }
+
+        if (largest)
+            std::partial_sort(vec.begin(), vec.begin() + kk, vec.end(), topk_greater());
+        else
+            std::partial_sort(vec.begin(), vec.begin() + kk, vec.end(), topk_less());
+
+        if (!sorted)
+        {
+            // keep the selected elements in their original order
+            std::sort(vec.begin(), vec.begin() + kk, topk_index_less());
+        }
+
+        float max = -FLT_MAX;
+        float sum = 0.f;
+        if (softmax)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                max = std::max(max, ptr[j * bottom_stride]);
+            }
+            for (int j = 0; j < n; j++)
+            {
+                sum += expf(ptr[j * bottom_stride] - max);
+            }
+        }
+
+        float* outptr = (float*)top_blobs[0] + top_offset;
+        for (int j = 0; j < kk; j++)
+        {
+            outptr[j * top_stride] = softmax ? expf(vec[j].first - max) / sum : vec[j].first;
+        }
+
+        if (top_blobs.size() > 1)
+        {
+            float* indptr = (float*)top_blobs[1] + top_offset;
+            for (int j = 0; j < kk; j++)
+            {
+                indptr[j * top_stride] = (float)vec[j].second;
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
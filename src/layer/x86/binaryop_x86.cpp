@@ -22,6 +22,8 @@ BinaryOp_x86::BinaryOp_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+    support_strided_input = true;
 }
 
 template<typename Op>
@@ -945,10 +947,24 @@ static int get_reverse_op_type(int op_type)
 
 int BinaryOp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
-    const Mat& A = bottom_blobs[0];
-    const Mat& B = bottom_blobs[1];
+    Mat A = bottom_blobs[0];
+    Mat B = bottom_blobs[1];
     const int outdims = std::max(A.dims, B.dims);
 
+    // reshape assumes the dense channel step, pack strided views before expanding them
+    if (A.dims < outdims && A.is_strided())
+    {
+        A = A.clone(opt.workspace_allocator);
+        if (A.empty())
+            return -100;
+    }
+    if (B.dims < outdims && B.is_strided())
+    {
+        B = B.clone(opt.workspace_allocator);
+        if (B.empty())
+            return -100;
+    }
+
     Mat A2 = A;
     Mat B2 = B;
     if (A.dims < outdims)
@@ -0,0 +1,77 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// 1x4 block sparse weight shared by innerproduct and convolution 1x1
+
+static bool block_sparse_1x4_prefer(const Mat& weight_data, int num_input, int num_output)
+{
+    // 1x4 block along num_input, the same block layout ncnnoptimize writes
+    if (weight_data.elemsize != 4u || num_input % 4 != 0)
+        return false;
+
+    const int nblocks = num_input / 4 * num_output;
+
+    const float* ptr = weight_data;
+
+    int nnzb = 0;
+    for (int i = 0; i < nblocks; i++)
+    {
+        if (ptr[0] != 0.f || ptr[1] != 0.f || ptr[2] != 0.f || ptr[3] != 0.f)
+            nnzb++;
+
+        ptr += 4;
+    }
+
+    // the sparse kernel wins once about 5/8 of the blocks are zero
+    return nnzb * 8 <= nblocks * 3;
+}
+
+static void block_sparse_1x4_transform_kernel(const Mat& weight_data, Mat& weight_sparse_data, Mat& weight_sparse_rowptr, Mat& weight_sparse_colidx, int num_input, int num_output)
+{
+    // src = inch-outch
+    // dst = 4-nnzb  rowptr = outch+1  colidx = nnzb
+    weight_sparse_rowptr.create(num_output + 1, (size_t)4u);
+
+    int* rowptr = weight_sparse_rowptr;
+
+    int nnzb = 0;
+    for (int p = 0; p < num_output; p++)
+    {
+        rowptr[p] = nnzb;
+
+        const float* kptr = (const float*)weight_data + num_input * p;
+
+        for (int i = 0; i < num_input; i += 4)
+        {
+            if (kptr[i] != 0.f || kptr[i + 1] != 0.f || kptr[i + 2] != 0.f || kptr[i + 3] != 0.f)
+                nnzb++;
+        }
+    }
+    rowptr[num_output] = nnzb;
+
+    // keep one block at least so that an all-zero weight still marks the sparse path
+    weight_sparse_data.create(std::max(nnzb, 1) * 4);
+    weight_sparse_colidx.create(std::max(nnzb, 1), (size_t)4u);
+
+    float* ptr = weight_sparse_data;
+    int* colidx = weight_sparse_colidx;
+
+    for (int p = 0; p < num_output; p++)
+    {
+        const float* kptr = (const float*)weight_data + num_input * p;
+
+        for (int i = 0; i < num_input; i += 4)
+        {
+            if (kptr[i] != 0.f || kptr[i + 1] != 0.f || kptr[i + 2] != 0.f || kptr[i + 3] != 0.f)
+            {
+                ptr[0] = kptr[i];
+                ptr[1] = kptr[i + 1];
+                ptr[2] = kptr[i + 2];
+                ptr[3] = kptr[i + 3];
+                ptr += 4;
+
+                *colidx++ = i;
+            }
+        }
+    }
+}
@@ -14,6 +14,11 @@ Concat_x86::Concat_x86()
 
 int Concat_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    int elembits = bottom_blobs[0].elembits();
+
+    if (elembits == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+
     int dims = bottom_blobs[0].dims;
     int positive_axis = axis < 0 ? dims + axis : axis;
 
@@ -814,4 +819,45 @@ int Concat_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
     return 0;
 }
 
+int Concat_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    int elempack = bottom_blobs[0].elempack;
+    for (size_t b = 1; b < bottom_blobs.size(); b++)
+    {
+        if (bottom_blobs[b].elempack != elempack)
+            elempack = 1;
+    }
+
+    // a packed int8 element is copied as a whole by memcpy, concat the same elempack as elempack 1
+    std::vector<Mat> bottom_blobs_unpacked(bottom_blobs.size());
+    for (size_t b = 0; b < bottom_blobs.size(); b++)
+    {
+        const Mat& bottom_blob = bottom_blobs[b];
+
+        if (bottom_blob.elempack == elempack)
+        {
+            bottom_blobs_unpacked[b] = bottom_blob;
+        }
+        else
+        {
+            Option opt_pack1 = opt;
+            opt_pack1.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blobs_unpacked[b], 1, opt_pack1);
+            if (bottom_blobs_unpacked[b].empty())
+                return -100;
+        }
+
+        bottom_blobs_unpacked[b].elempack = 1;
+    }
+
+    int ret = Concat::forward(bottom_blobs_unpacked, top_blobs, opt);
+    if (ret != 0)
+        return ret;
+
+    top_blobs[0].elempack = elempack;
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -32,6 +32,8 @@ int Convolution1D_x86::create_pipeline(const Option& opt)
 
     convolution1d_transform_kernel_packed(weight_data, weight_data_tm, num_input, num_output, kernel_w);
 
+    relocate_weight(weight_data_tm, opt);
+
     if (opt.lightmode)
         weight_data.release();
 
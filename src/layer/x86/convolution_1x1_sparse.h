@@ -0,0 +1,214 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+static void conv1x1s1_sparse_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_sparse_data, const Mat& weight_sparse_rowptr, const Mat& weight_sparse_colidx, const Mat& bias_data, const Option& opt)
+{
+    // bottom_blob and top_blob are elempack=1
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int outch = top_blob.c;
+    const size_t cstep = bottom_blob.cstep;
+
+    const int* rowptr = weight_sparse_rowptr;
+    const int* colidx = weight_sparse_colidx;
+    const float* bias_data_ptr = bias_data;
+
+    // walk pixel tiles in the outer loop so that the bottom tile of all channels stays in cache
+    // and accumulate all nonzero blocks of one output channel in registers
+    const int TILE = 64;
+    const int nn_tile = (size + TILE - 1) / TILE;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ti = 0; ti < nn_tile; ti++)
+    {
+        const int i0 = ti * TILE;
+        const int max_i = std::min(i0 + TILE, size);
+
+        for (int p = 0; p < outch; p++)
+        {
+            const int start = rowptr[p];
+            const int end = rowptr[p + 1];
+
+            const float bias = bias_data_ptr ? bias_data_ptr[p] : 0.f;
+
+            float* outptr = top_blob.channel(p);
+
+            int i = i0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+            for (; i + 63 < max_i; i += 64)
+            {
+                __m512 _sum0 = _mm512_set1_ps(bias);
+                __m512 _sum1 = _mm512_set1_ps(bias);
+                __m512 _sum2 = _mm512_set1_ps(bias);
+                __m512 _sum3 = _mm512_set1_ps(bias);
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    for (int b = 0; b < 4; b++)
+                    {
+                        __m512 _k = _mm512_set1_ps(kptr[b]);
+                        _sum0 = _mm512_fmadd_ps(_k, _mm512_loadu_ps(r0), _sum0);
+                        _sum1 = _mm512_fmadd_ps(_k, _mm512_loadu_ps(r0 + 16), _sum1);
+                        _sum2 = _mm512_fmadd_ps(_k, _mm512_loadu_ps(r0 + 32), _sum2);
+                        _sum3 = _mm512_fmadd_ps(_k, _mm512_loadu_ps(r0 + 48), _sum3);
+                        r0 += cstep;
+                    }
+
+                    kptr += 4;
+                }
+
+                _mm512_storeu_ps(outptr + i, _sum0);
+                _mm512_storeu_ps(outptr + i + 16, _sum1);
+                _mm512_storeu_ps(outptr + i + 32, _sum2);
+                _mm512_storeu_ps(outptr + i + 48, _sum3);
+            }
+            for (; i + 15 < max_i; i += 16)
+            {
+                __m512 _sum = _mm512_set1_ps(bias);
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    _sum = _mm512_fmadd_ps(_mm512_set1_ps(kptr[0]), _mm512_loadu_ps(r0), _sum);
+                    _sum = _mm512_fmadd_ps(_mm512_set1_ps(kptr[1]), _mm512_loadu_ps(r0 + cstep), _sum);
+                    _sum = _mm512_fmadd_ps(_mm512_set1_ps(kptr[2]), _mm512_loadu_ps(r0 + cstep * 2), _sum);
+                    _sum = _mm512_fmadd_ps(_mm512_set1_ps(kptr[3]), _mm512_loadu_ps(r0 + cstep * 3), _sum);
+
+                    kptr += 4;
+                }
+
+                _mm512_storeu_ps(outptr + i, _sum);
+            }
+#endif // __AVX512F__
+            for (; i + 31 < max_i; i += 32)
+            {
+                __m256 _sum0 = _mm256_set1_ps(bias);
+                __m256 _sum1 = _mm256_set1_ps(bias);
+                __m256 _sum2 = _mm256_set1_ps(bias);
+                __m256 _sum3 = _mm256_set1_ps(bias);
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    for (int b = 0; b < 4; b++)
+                    {
+                        __m256 _k = _mm256_set1_ps(kptr[b]);
+                        _sum0 = _mm256_comp_fmadd_ps(_k, _mm256_loadu_ps(r0), _sum0);
+                        _sum1 = _mm256_comp_fmadd_ps(_k, _mm256_loadu_ps(r0 + 8), _sum1);
+                        _sum2 = _mm256_comp_fmadd_ps(_k, _mm256_loadu_ps(r0 + 16), _sum2);
+                        _sum3 = _mm256_comp_fmadd_ps(_k, _mm256_loadu_ps(r0 + 24), _sum3);
+                        r0 += cstep;
+                    }
+
+                    kptr += 4;
+                }
+
+                _mm256_storeu_ps(outptr + i, _sum0);
+                _mm256_storeu_ps(outptr + i + 8, _sum1);
+                _mm256_storeu_ps(outptr + i + 16, _sum2);
+                _mm256_storeu_ps(outptr + i + 24, _sum3);
+            }
+            for (; i + 7 < max_i; i += 8)
+            {
+                __m256 _sum = _mm256_set1_ps(bias);
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[0]), _mm256_loadu_ps(r0), _sum);
+                    _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[1]), _mm256_loadu_ps(r0 + cstep), _sum);
+                    _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[2]), _mm256_loadu_ps(r0 + cstep * 2), _sum);
+                    _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[3]), _mm256_loadu_ps(r0 + cstep * 3), _sum);
+
+                    kptr += 4;
+                }
+
+                _mm256_storeu_ps(outptr + i, _sum);
+            }
+#endif // __AVX__
+            for (; i + 15 < max_i; i += 16)
+            {
+                __m128 _sum0 = _mm_set1_ps(bias);
+                __m128 _sum1 = _mm_set1_ps(bias);
+                __m128 _sum2 = _mm_set1_ps(bias);
+                __m128 _sum3 = _mm_set1_ps(bias);
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    for (int b = 0; b < 4; b++)
+                    {
+                        __m128 _k = _mm_set1_ps(kptr[b]);
+                        _sum0 = _mm_comp_fmadd_ps(_k, _mm_loadu_ps(r0), _sum0);
+                        _sum1 = _mm_comp_fmadd_ps(_k, _mm_loadu_ps(r0 + 4), _sum1);
+                        _sum2 = _mm_comp_fmadd_ps(_k, _mm_loadu_ps(r0 + 8), _sum2);
+                        _sum3 = _mm_comp_fmadd_ps(_k, _mm_loadu_ps(r0 + 12), _sum3);
+                        r0 += cstep;
+                    }
+
+                    kptr += 4;
+                }
+
+                _mm_storeu_ps(outptr + i, _sum0);
+                _mm_storeu_ps(outptr + i + 4, _sum1);
+                _mm_storeu_ps(outptr + i + 8, _sum2);
+                _mm_storeu_ps(outptr + i + 12, _sum3);
+            }
+            for (; i + 3 < max_i; i += 4)
+            {
+                __m128 _sum = _mm_set1_ps(bias);
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    _sum = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[0]), _mm_loadu_ps(r0), _sum);
+                    _sum = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[1]), _mm_loadu_ps(r0 + cstep), _sum);
+                    _sum = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[2]), _mm_loadu_ps(r0 + cstep * 2), _sum);
+                    _sum = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[3]), _mm_loadu_ps(r0 + cstep * 3), _sum);
+
+                    kptr += 4;
+                }
+
+                _mm_storeu_ps(outptr + i, _sum);
+            }
+#endif // __SSE2__
+            for (; i < max_i; i++)
+            {
+                float sum = bias;
+
+                const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* r0 = (const float*)bottom_blob + cstep * colidx[k] + i;
+
+                    sum += kptr[0] * r0[0] + kptr[1] * r0[cstep] + kptr[2] * r0[cstep * 2] + kptr[3] * r0[cstep * 3];
+
+                    kptr += 4;
+                }
+
+                outptr[i] = sum;
+            }
+        }
+    }
+}
@@ -30,6 +30,8 @@ namespace ncnn {
 #include "convolution_3x3_winograd.h"
 #include "convolution_packed.h"
 #include "convolution_im2col_gemm.h"
+#include "block_sparse_1x4.h"
+#include "convolution_1x1_sparse.h"
 
 #if NCNN_INT8
 #include "convolution_3x3_int8.h"
@@ -61,6 +63,8 @@ Convolution_x86::Convolution_x86()
     support_packing = true;
 #endif // __SSE2__
 
+    support_strided_input = true;
+
     activation = 0;
     nT = 0;
     convolution_dilation1 = 0;
@@ -441,6 +445,24 @@ int Convolution_x86::create_pipeline(const Option& opt)
             }
         }
 
+        relocate_weight(weight_winograd23_data, opt);
+        relocate_weight(weight_winograd43_data, opt);
+        relocate_weight(weight_winograd63_data, opt);
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+
+    if (kernel_w == 1 && kernel_h == 1 && stride_w == 1 && stride_h == 1 && block_sparse_1x4_prefer(weight_data, num_input, num_output))
+    {
+        block_sparse_1x4_transform_kernel(weight_data, weight_sparse_data, weight_sparse_rowptr, weight_sparse_colidx, num_input, num_output);
+
+        relocate_weight(weight_sparse_data, opt);
+        relocate_weight(weight_sparse_rowptr, opt);
+        relocate_weight(weight_sparse_colidx, opt);
+
         if (opt.lightmode)
             weight_data.release();
 
@@ -454,6 +476,8 @@ int Convolution_x86::create_pipeline(const Option& opt)
     {
         convolution_im2col_gemm_transform_kernel(weight_data, weight_sgemm_data, num_input, num_output, kernel_w, kernel_h, opt);
 
+        relocate_weight(weight_sgemm_data, opt);
+
         if (opt.lightmode)
             weight_data.release();
 
@@ -476,6 +500,8 @@ int Convolution_x86::create_pipeline(const Option& opt)
         convolution_transform_kernel_packed(weight_data, weight_data_tm, num_input, num_output, kernel_w, kernel_h);
     }
 
+    relocate_weight(weight_data_tm, opt);
+
     if (opt.lightmode)
         weight_data.release();
 
@@ -673,6 +699,43 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
         return 0;
     }
 
+    if (kernel_w == 1 && kernel_h == 1 && stride_w == 1 && stride_h == 1 && !weight_sparse_rowptr.empty())
+    {
+        Option opt_pack = opt;
+        opt_pack.blob_allocator = opt.workspace_allocator;
+
+        Mat bottom_blob_unpacked = bottom_blob_bordered;
+        if (elempack != 1)
+        {
+            convert_packing(bottom_blob_bordered, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        Mat top_blob_unpacked = top_blob;
+        if (out_elempack != 1)
+        {
+            top_blob_unpacked.create(outw, outh, num_output, out_elemsize / out_elempack, 1, opt.workspace_allocator);
+            if (top_blob_unpacked.empty())
+                return -100;
+        }
+
+        conv1x1s1_sparse_sse(bottom_blob_unpacked, top_blob_unpacked, weight_sparse_data, weight_sparse_rowptr, weight_sparse_colidx, bias_data, opt);
+
+        if (out_elempack != 1)
+        {
+            convert_packing(top_blob_unpacked, top_blob, out_elempack, opt);
+            if (top_blob.empty())
+                return -100;
+        }
+
+        if (activation)
+        {
+            activation->forward_inplace(top_blob, opt);
+        }
+        return 0;
+    }
+
     int l2_cache_size = get_cpu_level2_cache_size();
     bool prefer_sgemm = num_input * num_output * kernel_w * kernel_h * dilation_w * dilation_h * stride_w * stride_h * (int)sizeof(float) * 2 > l2_cache_size || (num_input > 16 || num_output > 16);
 
@@ -906,6 +969,11 @@ int Convolution_x86::create_pipeline_int8_x86(const Option& opt)
         convolution_transform_kernel_packed_int8(weight_data, weight_data_tm, num_input, num_output, kernel_w, kernel_h);
     }
 
+    relocate_weight(weight_winograd23_data, opt);
+    relocate_weight(weight_winograd43_data, opt);
+    relocate_weight(weight_sgemm_data, opt);
+    relocate_weight(weight_data_tm, opt);
+
     scale_in_data.create(num_output);
     for (int p = 0; p < num_output; p++)
     {
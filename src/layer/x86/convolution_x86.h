@@ -37,6 +37,11 @@ public:
     Mat weight_winograd43_data;
     Mat weight_winograd63_data;
 
+    // 1x4 block sparse weight for conv1x1s1
+    Mat weight_sparse_data;
+    Mat weight_sparse_rowptr;
+    Mat weight_sparse_colidx;
+
     // forwardDilation
     Layer* convolution_dilation1;
 
@@ -40,6 +40,9 @@ ConvolutionDepthWise_x86::ConvolutionDepthWise_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+    support_strided_input = true;
+
     activation = 0;
 }
 
@@ -121,6 +124,8 @@ int ConvolutionDepthWise_x86::create_pipeline(const Option& opt)
             }
         }
 
+        relocate_weight(weight_data_tm, opt);
+
         if (opt.lightmode)
             weight_data.release();
 
@@ -840,6 +845,8 @@ int ConvolutionDepthWise_x86::create_pipeline_int8_x86(const Option& opt)
             weight_data_tm = weight_data;
         }
 
+        relocate_weight(weight_data_tm, opt);
+
         if (opt.lightmode)
             weight_data.release();
 
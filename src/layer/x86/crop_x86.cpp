@@ -92,6 +92,130 @@ static void crop_pack4_sse(const Mat& src, Mat& dst, int top, int left)
         ptr += (left + right) * 4;
     }
 }
+static void crop_pack8_int8(const Mat& src, Mat& dst, int top, int left)
+{
+    int w = dst.w;
+    int h = dst.h;
+
+    // a packed int8 element is copied as a whole
+    const size_t elemsize = src.elemsize;
+
+    const unsigned char* ptr = src.row<const unsigned char>(top) + left * elemsize;
+    unsigned char* outptr = dst;
+
+    for (int y = 0; y < h; y++)
+    {
+        memcpy(outptr, ptr, w * elemsize);
+        ptr += src.w * elemsize;
+        outptr += w * elemsize;
+    }
+}
+
+// int8 is packed by 8 on x86, return 1 if the crop window splits the packed axis
+static int crop_int8_pack8(const Mat& bottom_blob, Mat& top_blob, int _woffset, int _hoffset, int _doffset, int _coffset, int _outw, int _outh, int _outd, int _outc, const Option& opt)
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    int channels = bottom_blob.c;
+    int dims = bottom_blob.dims;
+    size_t elemsize = bottom_blob.elemsize;
+
+    if (dims == 1)
+    {
+        if (_woffset % 8 != 0 || _outw % 8 != 0)
+            return 1;
+
+        if (_outw / 8 == w)
+        {
+            top_blob = bottom_blob;
+            return 0;
+        }
+
+        top_blob.create(_outw / 8, elemsize, 8, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        crop_pack8_int8(bottom_blob, top_blob, 0, _woffset / 8);
+
+        return 0;
+    }
+
+    if (dims == 2)
+    {
+        if (_hoffset % 8 != 0 || _outh % 8 != 0)
+            return 1;
+
+        if (_outw == w && _outh / 8 == h)
+        {
+            top_blob = bottom_blob;
+            return 0;
+        }
+
+        top_blob.create(_outw, _outh / 8, elemsize, 8, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        crop_pack8_int8(bottom_blob, top_blob, _hoffset / 8, _woffset);
+
+        return 0;
+    }
+
+    if (_coffset % 8 != 0 || _outc % 8 != 0)
+        return 1;
+
+    if (_outw == w && _outh == h && (dims == 3 || _outd == d) && _outc / 8 == channels)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    const Mat bottom_blob_sliced = bottom_blob.channel_range(_coffset / 8, _outc / 8);
+
+    if (_outw == w && _outh == h && (dims == 3 || _outd == d))
+    {
+        top_blob = bottom_blob_sliced.clone(opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    if (dims == 3)
+    {
+        top_blob.create(_outw, _outh, _outc / 8, elemsize, 8, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < top_blob.c; q++)
+        {
+            const Mat m = bottom_blob_sliced.channel(q);
+            Mat borderm = top_blob.channel(q);
+            crop_pack8_int8(m, borderm, _hoffset, _woffset);
+        }
+
+        return 0;
+    }
+
+    // dims == 4
+    top_blob.create(_outw, _outh, _outd, _outc / 8, elemsize, 8, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < top_blob.c; q++)
+    {
+        for (int z = 0; z < _outd; z++)
+        {
+            const Mat m = bottom_blob_sliced.channel(q).depth(z + _doffset);
+            Mat borderm = top_blob.channel(q).depth(z);
+            crop_pack8_int8(m, borderm, _hoffset, _woffset);
+        }
+    }
+
+    return 0;
+}
 #endif // __SSE2__
 
 int Crop_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
@@ -118,6 +242,29 @@ int Crop_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         resolve_crop_roi(bottom_blob.shape(), _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
     }
 
+    if (bottom_blob.elembits() == 8)
+    {
+        if (elempack == 8)
+        {
+            int ret = crop_int8_pack8(bottom_blob, top_blob, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc, opt);
+            if (ret != 1)
+                return ret;
+        }
+
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_pack1 = opt;
+            opt_pack1.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack1);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return Crop::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
 #if __AVX__
 #if __AVX512F__
     if (elempack == 16)
@@ -559,6 +706,35 @@ int Crop_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
         resolve_crop_roi(bottom_blob.shape(), reference_blob.shape(), _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
     }
 
+    if (bottom_blob.elembits() == 8)
+    {
+        if (elempack == 8)
+        {
+            int ret = crop_int8_pack8(bottom_blob, top_blob, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc, opt);
+            if (ret != 1)
+                return ret;
+        }
+
+        std::vector<Mat> bottom_blobs_unpacked(bottom_blobs.size());
+        for (size_t i = 0; i < bottom_blobs.size(); i++)
+        {
+            Mat bottom_blob_unpacked = bottom_blobs[i];
+            if (bottom_blobs[i].elempack != 1)
+            {
+                Option opt_pack1 = opt;
+                opt_pack1.blob_allocator = opt.workspace_allocator;
+
+                convert_packing(bottom_blobs[i], bottom_blob_unpacked, 1, opt_pack1);
+                if (bottom_blob_unpacked.empty())
+                    return -100;
+            }
+
+            bottom_blobs_unpacked[i] = bottom_blob_unpacked;
+        }
+
+        return Crop::forward(bottom_blobs_unpacked, top_blobs, opt);
+    }
+
 #if __AVX__
 #if __AVX512F__
     if (elempack == 16)
@@ -47,6 +47,8 @@ Deconvolution_x86::Deconvolution_x86()
     support_packing = true;
 #endif // __SSE2__
 
+    support_strided_input = true;
+
     activation = 0;
     gemm = 0;
 }
@@ -156,7 +158,7 @@ int Deconvolution_x86::create_pipeline(const Option& opt)
         // dst = pb-pa-kw-kh-inch/pa-outch/pb
         Mat weight_data_r2 = weight_data_transposed.reshape(maxk, num_input, num_output);
 
-        weight_data_tm.create(maxk, num_input / elempack, num_output / out_elempack, (size_t)4u * elempack * out_elempack, elempack * out_elempack);
+        weight_data_tm.create(maxk, num_input / elempack, num_output / out_elempack, (size_t)4u * elempack * out_elempack, elempack * out_elempack, opt.weight_allocator);
 
         for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
         {
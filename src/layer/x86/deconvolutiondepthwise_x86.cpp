@@ -98,6 +98,8 @@ int DeconvolutionDepthWise_x86::create_pipeline(const Option& opt)
             weight_data_tm = weight_data_transposed;
         }
 
+        relocate_weight(weight_data_tm, opt);
+
         if (opt.lightmode)
             weight_data.release();
 
@@ -192,6 +192,8 @@ int DeformableConv2D_x86::create_pipeline(const Option& opt)
         deformableconv2d_transform_kernel_packed_sse(weight_data, weight_data_tm, num_input, num_output, kernel_w, kernel_h, elempack, out_elempack);
     }
 
+    relocate_weight(weight_data_tm, opt);
+
     if (opt.lightmode)
         weight_data.release();
 
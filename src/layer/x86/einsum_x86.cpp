@@ -0,0 +1,484 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "einsum_x86.h"
+
+#include "layer_type.h"
+
+namespace ncnn {
+
+Einsum_x86::Einsum_x86()
+{
+    lowering_type = 0;
+    transA = 0;
+    transB = 0;
+    output_transpose = 0;
+    gemm = 0;
+}
+
+static bool has_repeated_letter(const std::string& token)
+{
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (token.find(token[i], i + 1) != std::string::npos)
+            return true;
+    }
+
+    return false;
+}
+
+static bool has_letter(const std::string& token, char x)
+{
+    return token.find(x) != std::string::npos;
+}
+
+int Einsum_x86::create_pipeline(const Option& opt)
+{
+    lowering_type = 0;
+
+    // trace, more than two operands and diagonals keep the generic loop
+    if (lhs_tokens.empty() || lhs_tokens.size() > 2 || rhs_token.empty())
+        return 0;
+
+    if (has_repeated_letter(rhs_token))
+        return 0;
+
+    for (size_t i = 0; i < lhs_tokens.size(); i++)
+    {
+        if (has_repeated_letter(lhs_tokens[i]))
+            return 0;
+    }
+
+    if (lhs_tokens.size() == 1)
+    {
+        // transpose and reduction
+        lowering_type = 1;
+        return 0;
+    }
+
+    const std::string& tokenA = lhs_tokens[0];
+    const std::string& tokenB = lhs_tokens[1];
+
+    batch_letters.clear();
+    m_letters.clear();
+    n_letters.clear();
+    k_letters.clear();
+
+    for (size_t i = 0; i < rhs_token.size(); i++)
+    {
+        const char x = rhs_token[i];
+        const bool inA = has_letter(tokenA, x);
+        const bool inB = has_letter(tokenB, x);
+
+        if (inA && inB)
+            batch_letters.push_back(x);
+        else if (inA)
+            m_letters.push_back(x);
+        else if (inB)
+            n_letters.push_back(x);
+        else
+            return 0;
+    }
+
+    for (size_t i = 0; i < tokenA.size(); i++)
+    {
+        const char x = tokenA[i];
+        if (has_letter(rhs_token, x))
+            continue;
+
+        // summed over one operand only
+        if (!has_letter(tokenB, x))
+            return 0;
+
+        k_letters.push_back(x);
+    }
+
+    for (size_t i = 0; i < tokenB.size(); i++)
+    {
+        const char x = tokenB[i];
+        if (!has_letter(rhs_token, x) && !has_letter(tokenA, x))
+            return 0;
+    }
+
+    // pick the gemm layouts that read the operands and write the output in place
+    transA = tokenA == batch_letters + k_letters + m_letters ? 1 : 0;
+    transB = tokenB == batch_letters + n_letters + k_letters ? 1 : 0;
+    output_transpose = rhs_token == batch_letters + n_letters + m_letters ? 1 : 0;
+
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, transA);            // transA
+    pd.set(3, transB);            // transB
+    pd.set(4, 0);                 // constantA
+    pd.set(5, 0);                 // constantB
+    pd.set(6, 1);                 // constantC
+    pd.set(7, 0);                 // M
+    pd.set(8, 0);                 // N
+    pd.set(9, 0);                 // K
+    pd.set(10, -1);               // constant_broadcast_type_C = null
+    pd.set(11, 0);                // output_N1M
+    pd.set(12, 1);                // output_elempack
+    pd.set(14, output_transpose); // output_transpose
+
+    gemm->load_param(pd);
+
+    gemm->load_model(ModelBinFromMatArray(0));
+
+    gemm->create_pipeline(opt);
+
+    lowering_type = 2;
+
+    return 0;
+}
+
+int Einsum_x86::destroy_pipeline(const Option& opt)
+{
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+// element stride of every letter in token, indexed by letter - 'i'
+static int resolve_letter_strides(const Mat& m, const std::string& token, int* sizes, size_t* strides)
+{
+    const int dims = m.dims;
+    if ((int)token.size() != dims)
+        return -1;
+
+    int shape[4];
+    size_t shape_strides[4];
+    if (dims == 1)
+    {
+        shape[0] = m.w;
+        shape_strides[0] = 1;
+    }
+    if (dims == 2)
+    {
+        shape[0] = m.h;
+        shape[1] = m.w;
+        shape_strides[0] = m.w;
+        shape_strides[1] = 1;
+    }
+    if (dims == 3)
+    {
+        shape[0] = m.c;
+        shape[1] = m.h;
+        shape[2] = m.w;
+        shape_strides[0] = m.cstep;
+        shape_strides[1] = m.w;
+        shape_strides[2] = 1;
+    }
+    if (dims == 4)
+    {
+        shape[0] = m.c;
+        shape[1] = m.d;
+        shape[2] = m.h;
+        shape[3] = m.w;
+        shape_strides[0] = m.cstep;
+        shape_strides[1] = (size_t)m.w * m.h;
+        shape_strides[2] = m.w;
+        shape_strides[3] = 1;
+    }
+
+    for (int s = 0; s < dims; s++)
+    {
+        const int x = token[s] - 'i';
+        if (sizes[x] != 0 && sizes[x] != shape[s])
+            return -1;
+
+        sizes[x] = shape[s];
+        strides[x] = shape_strides[s];
+    }
+
+    return 0;
+}
+
+// element offsets of all index combinations of letters, the last letter runs fastest
+static void resolve_offsets(const std::string& letters, const int* sizes, const size_t* strides, std::vector<size_t>& offsets)
+{
+    offsets.assign(1, 0);
+
+    for (size_t i = 0; i < letters.size(); i++)
+    {
+        const int x = letters[i] - 'i';
+
+        std::vector<size_t> offsets1;
+        offsets1.reserve(offsets.size() * sizes[x]);
+        for (size_t j = 0; j < offsets.size(); j++)
+        {
+            for (int k = 0; k < sizes[x]; k++)
+            {
+                offsets1.push_back(offsets[j] + k * strides[x]);
+            }
+        }
+
+        offsets.swap(offsets1);
+    }
+}
+
+// rows and columns form one contiguous matrix
+static bool is_dense(const std::vector<size_t>& row_offsets, const std::vector<size_t>& col_offsets)
+{
+    const size_t cols = col_offsets.size();
+
+    for (size_t i = 0; i < cols; i++)
+    {
+        if (col_offsets[i] != i)
+            return false;
+    }
+
+    for (size_t i = 0; i < row_offsets.size(); i++)
+    {
+        if (row_offsets[i] != i * cols)
+            return false;
+    }
+
+    return true;
+}
+
+static int create_top_blob(Mat& top_blob, const std::string& token, const int* sizes, const Option& opt)
+{
+    const int out_dims = (int)token.size();
+
+    if (out_dims == 1)
+        top_blob.create(sizes[token[0] - 'i'], 4u, opt.blob_allocator);
+    if (out_dims == 2)
+        top_blob.create(sizes[token[1] - 'i'], sizes[token[0] - 'i'], 4u, opt.blob_allocator);
+    if (out_dims == 3)
+        top_blob.create(sizes[token[2] - 'i'], sizes[token[1] - 'i'], sizes[token[0] - 'i'], 4u, opt.blob_allocator);
+    if (out_dims == 4)
+        top_blob.create(sizes[token[3] - 'i'], sizes[token[2] - 'i'], sizes[token[1] - 'i'], sizes[token[0] - 'i'], 4u, opt.blob_allocator);
+
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+int Einsum_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (lowering_type == 1)
+        return forward_reduce(bottom_blobs, top_blobs, opt);
+
+    if (lowering_type == 2)
+        return forward_gemm(bottom_blobs, top_blobs, opt);
+
+    return Einsum::forward(bottom_blobs, top_blobs, opt);
+}
+
+int Einsum_x86::forward_reduce(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const std::string& token = lhs_tokens[0];
+
+    int sizes[16] = {0};
+    size_t strides[16] = {0};
+    if (resolve_letter_strides(bottom_blob, token, sizes, strides) != 0)
+        return Einsum::forward(bottom_blobs, top_blobs, opt);
+
+    std::string sum_letters;
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (!has_letter(rhs_token, token[i]))
+            sum_letters.push_back(token[i]);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    int ret = create_top_blob(top_blob, rhs_token, sizes, opt);
+    if (ret != 0)
+        return ret;
+
+    int out_sizes[16] = {0};
+    size_t out_strides[16] = {0};
+    resolve_letter_strides(top_blob, rhs_token, out_sizes, out_strides);
+
+    std::vector<size_t> row_offsets;
+    std::vector<size_t> sum_offsets;
+    std::vector<size_t> out_offsets;
+    resolve_offsets(rhs_token, sizes, strides, row_offsets);
+    resolve_offsets(sum_letters, sizes, strides, sum_offsets);
+    resolve_offsets(rhs_token, out_sizes, out_strides, out_offsets);
+
+    const int rows = (int)row_offsets.size();
+    const int sum_size = (int)sum_offsets.size();
+
+    const float* ptr = bottom_blob;
+    float* outptr = top_blob;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < rows; i++)
+    {
+        const float* p = ptr + row_offsets[i];
+
+        float sum = 0.f;
+        for (int j = 0; j < sum_size; j++)
+        {
+            sum += p[sum_offsets[j]];
+        }
+
+        outptr[out_offsets[i]] = sum;
+    }
+
+    return 0;
+}
+
+int Einsum_x86::forward_gemm(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& A = bottom_blobs[0];
+    const Mat& B = bottom_blobs[1];
+
+    int sizes[16] = {0};
+    size_t A_strides[16] = {0};
+    size_t B_strides[16] = {0};
+    if (resolve_letter_strides(A, lhs_tokens[0], sizes, A_strides) != 0 || resolve_letter_strides(B, lhs_tokens[1], sizes, B_strides) != 0)
+        return Einsum::forward(bottom_blobs, top_blobs, opt);
+
+    Mat& top_blob = top_blobs[0];
+    int ret = create_top_blob(top_blob, rhs_token, sizes, opt);
+    if (ret != 0)
+        return ret;
+
+    int out_sizes[16] = {0};
+    size_t out_strides[16] = {0};
+    resolve_letter_strides(top_blob, rhs_token, out_sizes, out_strides);
+
+    const std::string& A_rows = transA ? k_letters : m_letters;
+    const std::string& A_cols = transA ? m_letters : k_letters;
+    const std::string& B_rows = transB ? n_letters : k_letters;
+    const std::string& B_cols = transB ? k_letters : n_letters;
+    const std::string& out_rows = output_transpose ? n_letters : m_letters;
+    const std::string& out_cols = output_transpose ? m_letters : n_letters;
+
+    std::vector<size_t> A_batch_offsets, A_row_offsets, A_col_offsets;
+    std::vector<size_t> B_batch_offsets, B_row_offsets, B_col_offsets;
+    std::vector<size_t> out_batch_offsets, out_row_offsets, out_col_offsets;
+    resolve_offsets(batch_letters, sizes, A_strides, A_batch_offsets);
+    resolve_offsets(A_rows, sizes, A_strides, A_row_offsets);
+    resolve_offsets(A_cols, sizes, A_strides, A_col_offsets);
+    resolve_offsets(batch_letters, sizes, B_strides, B_batch_offsets);
+    resolve_offsets(B_rows, sizes, B_strides, B_row_offsets);
+    resolve_offsets(B_cols, sizes, B_strides, B_col_offsets);
+    resolve_offsets(batch_letters, out_sizes, out_strides, out_batch_offsets);
+    resolve_offsets(out_rows, out_sizes, out_strides, out_row_offsets);
+    resolve_offsets(out_cols, out_sizes, out_strides, out_col_offsets);
+
+    const int batch = (int)A_batch_offsets.size();
+
+    // gather operands that are not one contiguous matrix per batch
+    Mat A_gathered;
+    if (!is_dense(A_row_offsets, A_col_offsets))
+    {
+        const int rows = (int)A_row_offsets.size();
+        const int cols = (int)A_col_offsets.size();
+
+        A_gathered.create(rows * cols, batch, 4u, opt.workspace_allocator);
+        if (A_gathered.empty())
+            return -100;
+
+        for (int p = 0; p < batch; p++)
+        {
+            const float* ptr = (const float*)A + A_batch_offsets[p];
+            float* outptr = A_gathered.row(p);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int i = 0; i < rows; i++)
+            {
+                const float* p0 = ptr + A_row_offsets[i];
+                float* outptr0 = outptr + i * cols;
+
+                for (int j = 0; j < cols; j++)
+                {
+                    outptr0[j] = p0[A_col_offsets[j]];
+                }
+            }
+        }
+    }
+
+    Mat B_gathered;
+    if (!is_dense(B_row_offsets, B_col_offsets))
+    {
+        const int rows = (int)B_row_offsets.size();
+        const int cols = (int)B_col_offsets.size();
+
+        B_gathered.create(rows * cols, batch, 4u, opt.workspace_allocator);
+        if (B_gathered.empty())
+            return -100;
+
+        for (int p = 0; p < batch; p++)
+        {
+            const float* ptr = (const float*)B + B_batch_offsets[p];
+            float* outptr = B_gathered.row(p);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int i = 0; i < rows; i++)
+            {
+                const float* p0 = ptr + B_row_offsets[i];
+                float* outptr0 = outptr + i * cols;
+
+                for (int j = 0; j < cols; j++)
+                {
+                    outptr0[j] = p0[B_col_offsets[j]];
+                }
+            }
+        }
+    }
+
+    const int out_h = (int)out_row_offsets.size();
+    const int out_w = (int)out_col_offsets.size();
+
+    Mat out_gathered;
+    if (!is_dense(out_row_offsets, out_col_offsets))
+    {
+        out_gathered.create(out_w * out_h, batch, 4u, opt.workspace_allocator);
+        if (out_gathered.empty())
+            return -100;
+    }
+
+    for (int p = 0; p < batch; p++)
+    {
+        const float* ptrA = A_gathered.empty() ? (const float*)A + A_batch_offsets[p] : A_gathered.row(p);
+        const float* ptrB = B_gathered.empty() ? (const float*)B + B_batch_offsets[p] : B_gathered.row(p);
+        float* outptr = out_gathered.empty() ? (float*)top_blob + out_batch_offsets[p] : out_gathered.row(p);
+
+        std::vector<Mat> _bottom_blobs(2);
+        _bottom_blobs[0] = Mat((int)A_col_offsets.size(), (int)A_row_offsets.size(), (void*)ptrA, 4u);
+        _bottom_blobs[1] = Mat((int)B_col_offsets.size(), (int)B_row_offsets.size(), (void*)ptrB, 4u);
+        std::vector<Mat> _top_blobs(1);
+        _top_blobs[0] = Mat(out_w, out_h, (void*)outptr, 4u, opt.blob_allocator);
+        ret = gemm->forward(_bottom_blobs, _top_blobs, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    // scatter into the output order
+    if (!out_gathered.empty())
+    {
+        for (int p = 0; p < batch; p++)
+        {
+            const float* ptr = out_gathered.row(p);
+            float* outptr = (float*)top_blob + out_batch_offsets[p];
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int i = 0; i < out_h; i++)
+            {
+                const float* p0 = ptr + i * out_w;
+                float* outptr0 = outptr + out_row_offsets[i];
+
+                for (int j = 0; j < out_w; j++)
+                {
+                    outptr0[out_col_offsets[j]] = p0[j];
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
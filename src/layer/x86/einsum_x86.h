@@ -0,0 +1,46 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_EINSUM_X86_H
+#define LAYER_EINSUM_X86_H
+
+#include "einsum.h"
+
+namespace ncnn {
+
+class Einsum_x86 : public Einsum
+{
+public:
+    Einsum_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int forward_reduce(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+    int forward_gemm(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+public:
+    // 0 = generic loop
+    // 1 = permute and sum of a single operand
+    // 2 = batched gemm of two operands
+    int lowering_type;
+
+    // letters shared by operands and output, only in A and output, only in B and output, summed
+    std::string batch_letters;
+    std::string m_letters;
+    std::string n_letters;
+    std::string k_letters;
+
+    int transA;
+    int transB;
+    int output_transpose;
+
+    Layer* gemm;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_EINSUM_X86_H
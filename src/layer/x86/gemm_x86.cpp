@@ -7237,7 +7237,7 @@ int Gemm_x86::create_pipeline(const Option& opt)
 
         const int nn_M = (M + TILE_M - 1) / TILE_M;
 
-        AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 4u, (Allocator*)0);
+        AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 4u, opt.weight_allocator);
         if (AT_data.empty())
             return -100;
 
@@ -7279,7 +7279,7 @@ int Gemm_x86::create_pipeline(const Option& opt)
         const int nn_N = (N + TILE_N - 1) / TILE_N;
         const int nn_K = (K + TILE_K - 1) / TILE_K;
 
-        BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, (Allocator*)0);
+        BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 4u, opt.weight_allocator);
         if (BT_data.empty())
             return -100;
 
@@ -7346,6 +7346,8 @@ int Gemm_x86::create_pipeline(const Option& opt)
             CT_data = C2;
         }
 
+        relocate_weight(CT_data, opt);
+
         if (opt.lightmode)
             C_data.release();
     }
@@ -8095,12 +8097,12 @@ int Gemm_x86::create_pipeline_int8(const Option& opt)
         if (has_w_shift)
         {
             int w_shift_count = TILE_M >= 16 ? 16 : TILE_M >= 8 ? 8 : TILE_M >= 4 ? 4 : TILE_M >= 2 ? 2 : 1;
-            AT_data.create((TILE_K + w_shift_count * 4) * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, (Allocator*)0);
+            AT_data.create((TILE_K + w_shift_count * 4) * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, opt.weight_allocator);
         }
         else
 #endif // NCNN_AVX512VNNI || NCNN_AVXVNNI
         {
-            AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, (Allocator*)0);
+            AT_data.create(TILE_K * TILE_M, (K + TILE_K - 1) / TILE_K, (M + TILE_M - 1) / TILE_M, 1u, opt.weight_allocator);
         }
         if (AT_data.empty())
             return -100;
@@ -8142,7 +8144,7 @@ int Gemm_x86::create_pipeline_int8(const Option& opt)
 
         const int nn_N = (N + TILE_N - 1) / TILE_N;
 
-        BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 1u, (Allocator*)0);
+        BT_data.create(TILE_K * TILE_N, (K + TILE_K - 1) / TILE_K, (N + TILE_N - 1) / TILE_N, 1u, opt.weight_allocator);
         if (BT_data.empty())
             return -100;
 
@@ -8177,6 +8179,8 @@ int Gemm_x86::create_pipeline_int8(const Option& opt)
     {
         CT_data = C_data;
 
+        relocate_weight(CT_data, opt);
+
         if (opt.lightmode)
             C_data.release();
     }
@@ -290,7 +290,69 @@ static void gridsample_2d_bilinear_apply_interpolation_p1(const Mat& src, Mat& d
 
         const float* offset_value_ptr = offset_value.channel(0);
 
-        for (int x = 0; x < grid_size; x++)
+        int x = 0;
+#if __AVX512F__
+        {
+            // 16 pixels of 4 offsets and 2 weights each, out of range offsets are -1
+            const __m512i _vindex = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm512_set1_epi32(6));
+            const __m512i _minus1 = _mm512_set1_epi32(-1);
+            for (; x + 15 < grid_size; x += 16)
+            {
+                const int* offset_ptr = (const int*)offset_value_ptr;
+
+                __m512i _o00 = _mm512_i32gather_epi32(_vindex, offset_ptr, sizeof(int));
+                __m512i _o01 = _mm512_i32gather_epi32(_vindex, offset_ptr + 1, sizeof(int));
+                __m512i _o10 = _mm512_i32gather_epi32(_vindex, offset_ptr + 2, sizeof(int));
+                __m512i _o11 = _mm512_i32gather_epi32(_vindex, offset_ptr + 3, sizeof(int));
+                __m512 _alpha = _mm512_i32gather_ps(_vindex, offset_value_ptr + 4, sizeof(float));
+                __m512 _beta = _mm512_i32gather_ps(_vindex, offset_value_ptr + 5, sizeof(float));
+
+                __m512 _v00 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), _mm512_cmpgt_epi32_mask(_o00, _minus1), _o00, srcptr, sizeof(float));
+                __m512 _v01 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), _mm512_cmpgt_epi32_mask(_o01, _minus1), _o01, srcptr, sizeof(float));
+                __m512 _v10 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), _mm512_cmpgt_epi32_mask(_o10, _minus1), _o10, srcptr, sizeof(float));
+                __m512 _v11 = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), _mm512_cmpgt_epi32_mask(_o11, _minus1), _o11, srcptr, sizeof(float));
+
+                __m512 _v0 = _mm512_fmadd_ps(_mm512_sub_ps(_v01, _v00), _alpha, _v00);
+                __m512 _v1 = _mm512_fmadd_ps(_mm512_sub_ps(_v11, _v10), _alpha, _v10);
+                __m512 _v = _mm512_fmadd_ps(_mm512_sub_ps(_v1, _v0), _beta, _v0);
+                _mm512_storeu_ps(dstptr, _v);
+
+                dstptr += 16;
+                offset_value_ptr += 6 * 16;
+            }
+        }
+#endif // __AVX512F__
+#if __AVX2__
+        {
+            const __m256i _vindex = _mm256_setr_epi32(0, 6, 12, 18, 24, 30, 36, 42);
+            const __m256i _minus1 = _mm256_set1_epi32(-1);
+            for (; x + 7 < grid_size; x += 8)
+            {
+                const int* offset_ptr = (const int*)offset_value_ptr;
+
+                __m256i _o00 = _mm256_i32gather_epi32(offset_ptr, _vindex, sizeof(int));
+                __m256i _o01 = _mm256_i32gather_epi32(offset_ptr + 1, _vindex, sizeof(int));
+                __m256i _o10 = _mm256_i32gather_epi32(offset_ptr + 2, _vindex, sizeof(int));
+                __m256i _o11 = _mm256_i32gather_epi32(offset_ptr + 3, _vindex, sizeof(int));
+                __m256 _alpha = _mm256_i32gather_ps(offset_value_ptr + 4, _vindex, sizeof(float));
+                __m256 _beta = _mm256_i32gather_ps(offset_value_ptr + 5, _vindex, sizeof(float));
+
+                __m256 _v00 = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), srcptr, _o00, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_o00, _minus1)), sizeof(float));
+                __m256 _v01 = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), srcptr, _o01, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_o01, _minus1)), sizeof(float));
+                __m256 _v10 = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), srcptr, _o10, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_o10, _minus1)), sizeof(float));
+                __m256 _v11 = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), srcptr, _o11, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_o11, _minus1)), sizeof(float));
+
+                __m256 _v0 = _mm256_comp_fmadd_ps(_mm256_sub_ps(_v01, _v00), _alpha, _v00);
+                __m256 _v1 = _mm256_comp_fmadd_ps(_mm256_sub_ps(_v11, _v10), _alpha, _v10);
+                __m256 _v = _mm256_comp_fmadd_ps(_mm256_sub_ps(_v1, _v0), _beta, _v0);
+                _mm256_storeu_ps(dstptr, _v);
+
+                dstptr += 8;
+                offset_value_ptr += 6 * 8;
+            }
+        }
+#endif // __AVX2__
+        for (; x < grid_size; x++)
         {
             const int* offset_ptr = (int*)offset_value_ptr;
             const float* value_ptr = offset_value_ptr + 4;
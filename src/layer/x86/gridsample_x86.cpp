@@ -3,6 +3,8 @@
 
 #include "gridsample_x86.h"
 
+#include <string.h>
+
 #if __SSE2__
 #include <emmintrin.h>
 #include "sse_mathfun.h"
@@ -29,44 +31,42 @@ GridSample_x86::GridSample_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+    cached_w = 0;
+    cached_h = 0;
+    cached_d = 0;
+    cached_elempack = 0;
+    cache_miss_count = 0;
 }
 
-int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+static bool gridsample_same_grid(const Mat& a, const Mat& b)
 {
-    const Mat& bottom_blob = bottom_blobs[0];
-    const Mat& grid = bottom_blobs[1];
-    Mat& top_blob = top_blobs[0];
-    int elempack = bottom_blob.elempack;
-
-    int channels = bottom_blob.c;
-    int dims = bottom_blob.dims;
-    size_t elemsize = bottom_blob.elemsize;
-
-    int outw, outh, outd;
-    Mat offset_value_blob;
+    if (a.dims != b.dims || a.w != b.w || a.h != b.h || a.d != b.d || a.c != b.c || a.elemsize != b.elemsize)
+        return false;
 
-    Mat grid_p1;
-    if (grid.elempack != 1)
+    const size_t size = (size_t)a.w * a.h * a.d * a.elemsize;
+    for (int q = 0; q < a.c; q++)
     {
-        convert_packing(grid, grid_p1, 1, opt);
-    }
-    else
-    {
-        grid_p1 = grid;
+        if (memcmp(a.channel(q), b.channel(q), size) != 0)
+            return false;
     }
 
+    return true;
+}
+
+int GridSample_x86::compute_offset_value(const Mat& bottom_blob, const Mat& grid_p1, Mat& offset_value_blob, Allocator* allocator) const
+{
+    const int dims = bottom_blob.dims;
+    const size_t elemsize = bottom_blob.elemsize;
+
     if (dims == 3)
     {
-        outw = permute_fusion == 0 ? grid_p1.h : grid_p1.w;
-        outh = permute_fusion == 0 ? grid_p1.c : grid_p1.h;
-
-        top_blob.create(outw, outh, channels, elemsize, elempack, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
+        const int outw = permute_fusion == 0 ? grid_p1.h : grid_p1.w;
+        const int outh = permute_fusion == 0 ? grid_p1.c : grid_p1.h;
 
         if (sample_type == GridSample::Interpolation_BILINEAR)
         {
-            offset_value_blob.create(outw, outh, elemsize * 6, 6, opt.workspace_allocator);
+            offset_value_blob.create(outw, outh, elemsize * 6, 6, allocator);
             if (offset_value_blob.empty())
                 return -100;
 
@@ -112,7 +112,7 @@ int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Ma
 
         if (sample_type == GridSample::Interpolation_NEAREST)
         {
-            offset_value_blob.create(outw, outh, 1, elemsize, 1, opt.workspace_allocator);
+            offset_value_blob.create(outw, outh, 1, elemsize, 1, allocator);
             if (offset_value_blob.empty())
                 return -100;
 
@@ -158,7 +158,7 @@ int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Ma
 
         if (sample_type == GridSample::Interpolation_BICUBIC)
         {
-            offset_value_blob.create(outw, outh, elemsize * 18, 18, opt.workspace_allocator);
+            offset_value_blob.create(outw, outh, elemsize * 18, 18, allocator);
             if (offset_value_blob.empty())
                 return -100;
 
@@ -205,17 +205,13 @@ int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Ma
 
     if (dims == 4)
     {
-        outw = permute_fusion == 0 ? grid_p1.h : grid_p1.w;
-        outh = permute_fusion == 0 ? grid_p1.d : grid_p1.h;
-        outd = permute_fusion == 0 ? grid_p1.c : grid_p1.d;
-
-        top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
-        if (top_blob.empty())
-            return -100;
+        const int outw = permute_fusion == 0 ? grid_p1.h : grid_p1.w;
+        const int outh = permute_fusion == 0 ? grid_p1.d : grid_p1.h;
+        const int outd = permute_fusion == 0 ? grid_p1.c : grid_p1.d;
 
         if (sample_type == GridSample::Interpolation_BILINEAR)
         {
-            offset_value_blob.create(outw, outh, outd, elemsize * 11, 11, opt.workspace_allocator);
+            offset_value_blob.create(outw, outh, outd, elemsize * 11, 11, allocator);
             if (offset_value_blob.empty())
                 return -100;
 
@@ -261,7 +257,7 @@ int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Ma
 
         if (sample_type == GridSample::Interpolation_NEAREST)
         {
-            offset_value_blob.create(outw, outh, outd, 1, elemsize, 1, opt.workspace_allocator);
+            offset_value_blob.create(outw, outh, outd, 1, elemsize, 1, allocator);
             if (offset_value_blob.empty())
                 return -100;
 
@@ -312,6 +308,123 @@ int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Ma
         }
     }
 
+    return 0;
+}
+
+// the offsets and weights only depend on the input shape and the grid values,
+// a constant grid such as one from MemoryData is computed once and then only compared
+int GridSample_x86::get_offset_value(const Mat& bottom_blob, const Mat& grid_p1, Mat& offset_value_blob, const Option& opt) const
+{
+    Mat grid_cached;
+    Mat offset_value_cached;
+    bool cache_enabled;
+    {
+        MutexLockGuard guard(offset_value_lock);
+
+        grid_cached = cached_grid;
+        offset_value_cached = cached_offset_value;
+        cache_enabled = cache_miss_count < 2;
+
+        if (cached_w != bottom_blob.w || cached_h != bottom_blob.h || cached_d != bottom_blob.d || cached_elempack != bottom_blob.elempack)
+            grid_cached.release();
+    }
+
+    if (!grid_cached.empty() && gridsample_same_grid(grid_p1, grid_cached))
+    {
+        MutexLockGuard guard(offset_value_lock);
+        cache_miss_count = 0;
+
+        offset_value_blob = offset_value_cached;
+        return 0;
+    }
+
+    if (!cache_enabled)
+        return compute_offset_value(bottom_blob, grid_p1, offset_value_blob, opt.workspace_allocator);
+
+    // cached tables outlive this call, keep them off the workspace allocator
+    int ret = compute_offset_value(bottom_blob, grid_p1, offset_value_blob, 0);
+    if (ret != 0)
+        return ret;
+
+    Mat grid_clone = grid_p1.clone();
+    if (grid_clone.empty())
+        return 0;
+
+    {
+        MutexLockGuard guard(offset_value_lock);
+
+        // the grid changes between calls, stop paying for the copies
+        if (!cached_grid.empty())
+            cache_miss_count++;
+
+        if (cache_miss_count < 2)
+        {
+            cached_grid = grid_clone;
+            cached_offset_value = offset_value_blob;
+            cached_w = bottom_blob.w;
+            cached_h = bottom_blob.h;
+            cached_d = bottom_blob.d;
+            cached_elempack = bottom_blob.elempack;
+        }
+        else
+        {
+            cached_grid.release();
+            cached_offset_value.release();
+        }
+    }
+
+    return 0;
+}
+
+int GridSample_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& grid = bottom_blobs[1];
+    Mat& top_blob = top_blobs[0];
+    int elempack = bottom_blob.elempack;
+
+    int channels = bottom_blob.c;
+    int dims = bottom_blob.dims;
+    size_t elemsize = bottom_blob.elemsize;
+
+    int outw, outh, outd;
+
+    Mat grid_p1;
+    if (grid.elempack != 1)
+    {
+        convert_packing(grid, grid_p1, 1, opt);
+    }
+    else
+    {
+        grid_p1 = grid;
+    }
+
+    if (dims == 3)
+    {
+        outw = permute_fusion == 0 ? grid_p1.h : grid_p1.w;
+        outh = permute_fusion == 0 ? grid_p1.c : grid_p1.h;
+
+        top_blob.create(outw, outh, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    if (dims == 4)
+    {
+        outw = permute_fusion == 0 ? grid_p1.h : grid_p1.w;
+        outh = permute_fusion == 0 ? grid_p1.d : grid_p1.h;
+        outd = permute_fusion == 0 ? grid_p1.c : grid_p1.d;
+
+        top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    Mat offset_value_blob;
+    int ret = get_offset_value(bottom_blob, grid_p1, offset_value_blob, opt);
+    if (ret != 0)
+        return ret;
+
 #if __SSE2__
 #if __AVX__
 #if __AVX512F__
@@ -14,6 +14,21 @@ public:
     GridSample_x86();
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int compute_offset_value(const Mat& bottom_blob, const Mat& grid_p1, Mat& offset_value_blob, Allocator* allocator) const;
+    int get_offset_value(const Mat& bottom_blob, const Mat& grid_p1, Mat& offset_value_blob, const Option& opt) const;
+
+public:
+    // offsets and weights of the last grid, reused while the grid and input shape stay the same
+    mutable Mutex offset_value_lock;
+    mutable Mat cached_grid;
+    mutable Mat cached_offset_value;
+    mutable int cached_w;
+    mutable int cached_h;
+    mutable int cached_d;
+    mutable int cached_elempack;
+    mutable int cache_miss_count;
 };
 
 } // namespace ncnn
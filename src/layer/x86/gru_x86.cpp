@@ -0,0 +1,399 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gru_x86.h"
+
+#include "layer_type.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+GRU_x86::GRU_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+
+    xc_gemm = 0;
+}
+
+int GRU_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        // int8 runs the reference implementation
+        return 0;
+    }
+#endif
+
+    // pack RUN
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+#if __AVX__
+    const int packn = 8;
+#else
+    const int packn = 4;
+#endif
+    const int nn_num_output = (num_output + packn - 1) / packn;
+
+    // W_xc * x_t + b_c of all timesteps and directions is one gemm up front
+    // output unit q of direction dr is at (dr * nn_num_output + q / packn) * packn * 3 + gate * packn + q % packn
+    // gate R and U take the combined bias, gate N takes the input bias only
+    Mat weight_xc_RUN(size, nn_num_output * packn * 3 * num_directions);
+    if (weight_xc_RUN.empty())
+        return -100;
+
+    Mat bias_c_RUN(nn_num_output * packn * 3 * num_directions);
+    if (bias_c_RUN.empty())
+        return -100;
+
+    weight_xc_RUN.fill(0.f);
+    bias_c_RUN.fill(0.f);
+
+    weight_hc_data_packed.create(num_output * packn * 3, nn_num_output, num_directions, 4u, opt.weight_allocator);
+    if (weight_hc_data_packed.empty())
+        return -100;
+
+    bias_c_data_packed.create(nn_num_output * packn, 1, num_directions, 4u, opt.weight_allocator);
+    if (bias_c_data_packed.empty())
+        return -100;
+
+    weight_hc_data_packed.fill(0.f);
+    bias_c_data_packed.fill(0.f);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const Mat bias_c = bias_c_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+
+        Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
+        float* bias_c_BN = bias_c_data_packed.channel(dr);
+
+        for (int q = 0; q < num_output; q++)
+        {
+            const int qq = q / packn;
+            const int k = q % packn;
+
+            for (int g = 0; g < 3; g++)
+            {
+                const int xc_offset = (dr * nn_num_output + qq) * packn * 3 + g * packn + k;
+
+                memcpy(weight_xc_RUN.row(xc_offset), weight_xc.row(num_output * g + q), size * sizeof(float));
+
+                bias_c_RUN[xc_offset] = bias_c.row(g)[q];
+
+                const float* weight_hc_ptr = weight_hc.row(num_output * g + q);
+                float* weight_hc_RUN = weight_hc_data_packed_dr.row(qq) + g * packn + k;
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    weight_hc_RUN[i * packn * 3] = weight_hc_ptr[i];
+                }
+            }
+
+            bias_c_BN[q] = bias_c.row(3)[q];
+        }
+    }
+
+    {
+        xc_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+        ncnn::ParamDict pd;
+        pd.set(2, 0);                                          // transA
+        pd.set(3, 1);                                          // transB
+        pd.set(4, 0);                                          // constantA
+        pd.set(5, 1);                                          // constantB
+        pd.set(6, 1);                                          // constantC
+        pd.set(7, 0);                                          // M = T
+        pd.set(8, nn_num_output * packn * 3 * num_directions); // N
+        pd.set(9, size);                                       // K
+        pd.set(10, 4);                                         // constant_broadcast_type_C
+        pd.set(11, 0);                                         // output_N1M
+        pd.set(12, 1);                                         // output_elempack
+        xc_gemm->load_param(pd);
+        Mat weights[2];
+        weights[0] = weight_xc_RUN;
+        weights[1] = bias_c_RUN;
+        xc_gemm->load_model(ModelBinFromMatArray(weights));
+        xc_gemm->create_pipeline(opt);
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+int GRU_x86::destroy_pipeline(const Option& opt)
+{
+    if (xc_gemm)
+    {
+        xc_gemm->destroy_pipeline(opt);
+        delete xc_gemm;
+        xc_gemm = 0;
+    }
+
+    return 0;
+}
+
+static int gru(const Mat& gates_x, Mat& top_blob, int direction, const Mat& weight_hc, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+    const int T = gates_x.h;
+    const int num_directions = direction == 2 ? 2 : 1;
+
+    const int num_output = top_blob.w / num_directions;
+
+#if __AVX__
+    const int packn = 8;
+#else
+    const int packn = 4;
+#endif
+    const int nn_num_output = (num_output + packn - 1) / packn;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        // all directions run in one parallel region per step
+        // h_{t-1} is read back from the previous output row
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ii = 0; ii < num_directions * nn_num_output; ii++)
+        {
+            const int dr = ii / nn_num_output;
+            const int q = ii % nn_num_output * packn;
+            const int max_jj = std::min(num_output - q, packn);
+
+            const int reverse = direction == 2 ? dr : direction;
+            const int ti = reverse ? T - 1 - t : t;
+
+            const float* hidden_ptr = t == 0 ? hidden_state.row(dr) : top_blob.row(reverse ? ti + 1 : ti - 1) + dr * num_output;
+
+            const float* gates_x_ptr = gates_x.row(ti) + (dr * nn_num_output + q / packn) * packn * 3;
+            const float* weight_hc_RUN = weight_hc.channel(dr).row(q / packn);
+            const float* bias_c_BN = (const float*)bias_c.channel(dr) + q;
+
+            float* outptr = top_blob.row(ti) + dr * num_output + q;
+
+            // h_t := (1 - update) .* new + update .* h_{t-1}
+            //     == new + update .* (h_{t-1} - new)
+#if __AVX__
+            __m256 _R = _mm256_loadu_ps(gates_x_ptr);
+            __m256 _U = _mm256_loadu_ps(gates_x_ptr + 8);
+            __m256 _N = _mm256_loadu_ps(bias_c_BN);
+
+            for (int i = 0; i < num_output; i++)
+            {
+                __m256 _h_cont = _mm256_broadcast_ss(hidden_ptr + i);
+                _R = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN), _h_cont, _R);
+                _U = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 8), _h_cont, _U);
+                _N = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_RUN + 16), _h_cont, _N);
+
+                weight_hc_RUN += 24;
+            }
+
+            _R = sigmoid_avx(_R);
+            _U = sigmoid_avx(_U);
+            _N = tanh_avx(_mm256_comp_fmadd_ps(_R, _N, _mm256_loadu_ps(gates_x_ptr + 16)));
+
+            if (max_jj == 8)
+            {
+                __m256 _H = _mm256_comp_fmadd_ps(_U, _mm256_sub_ps(_mm256_loadu_ps(hidden_ptr + q), _N), _N);
+                _mm256_storeu_ps(outptr, _H);
+            }
+            else
+            {
+                float U[8];
+                float N[8];
+                _mm256_storeu_ps(U, _U);
+                _mm256_storeu_ps(N, _N);
+
+                for (int jj = 0; jj < max_jj; jj++)
+                {
+                    outptr[jj] = N[jj] + U[jj] * (hidden_ptr[q + jj] - N[jj]);
+                }
+            }
+#elif __SSE2__
+            __m128 _R = _mm_loadu_ps(gates_x_ptr);
+            __m128 _U = _mm_loadu_ps(gates_x_ptr + 4);
+            __m128 _N = _mm_loadu_ps(bias_c_BN);
+
+            for (int i = 0; i < num_output; i++)
+            {
+                __m128 _h_cont = _mm_load1_ps(hidden_ptr + i);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN), _h_cont, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 4), _h_cont, _U);
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_RUN + 8), _h_cont, _N);
+
+                weight_hc_RUN += 12;
+            }
+
+            _R = sigmoid_sse(_R);
+            _U = sigmoid_sse(_U);
+            _N = tanh_sse(_mm_comp_fmadd_ps(_R, _N, _mm_loadu_ps(gates_x_ptr + 8)));
+
+            if (max_jj == 4)
+            {
+                __m128 _H = _mm_comp_fmadd_ps(_U, _mm_sub_ps(_mm_loadu_ps(hidden_ptr + q), _N), _N);
+                _mm_storeu_ps(outptr, _H);
+            }
+            else
+            {
+                float U[4];
+                float N[4];
+                _mm_storeu_ps(U, _U);
+                _mm_storeu_ps(N, _N);
+
+                for (int jj = 0; jj < max_jj; jj++)
+                {
+                    outptr[jj] = N[jj] + U[jj] * (hidden_ptr[q + jj] - N[jj]);
+                }
+            }
+#else
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                float R = gates_x_ptr[jj];
+                float U = gates_x_ptr[packn + jj];
+                float N = bias_c_BN[jj];
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    float h_cont = hidden_ptr[i];
+
+                    R += weight_hc_RUN[i * packn * 3 + jj] * h_cont;
+                    U += weight_hc_RUN[i * packn * 3 + packn + jj] * h_cont;
+                    N += weight_hc_RUN[i * packn * 3 + packn * 2 + jj] * h_cont;
+                }
+
+                // sigmoid(R)
+                // sigmoid(U)
+                R = 1.f / (1.f + expf(-R));
+                U = 1.f / (1.f + expf(-U));
+
+                // tanh(N)
+                N = tanhf(gates_x_ptr[packn * 2 + jj] + R * N);
+
+                outptr[jj] = N + U * (hidden_ptr[q + jj] - N);
+            }
+#endif
+        }
+    }
+
+    // h_T of each direction
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const int reverse = direction == 2 ? dr : direction;
+
+        if (T > 0)
+            memcpy(hidden_state.row(dr), top_blob.row(reverse ? 0 : T - 1) + dr * num_output, num_output * sizeof(float));
+    }
+
+    return 0;
+}
+
+int GRU_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return GRU::forward(bottom_blob, top_blob, opt);
+    }
+#endif
+
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, num_directions, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // W_xc * x_t + b_c
+    Mat gates_x;
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = xc_gemm->forward(bottom_blob, gates_x, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    return gru(gates_x, top_blob, direction, weight_hc_data_packed, bias_c_data_packed, hidden, opt);
+}
+
+int GRU_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return GRU::forward(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // W_xc * x_t + b_c
+    Mat gates_x;
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = xc_gemm->forward(bottom_blob, gates_x, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    int ret = gru(gates_x, top_blob, direction, weight_hc_data_packed, bias_c_data_packed, hidden, opt);
+    if (ret != 0)
+        return ret;
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,135 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+static void innerproduct_sparse_sse(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_sparse_data, const Mat& weight_sparse_rowptr, const Mat& weight_sparse_colidx, const Mat& bias_data, int activation_type, const Mat& activation_params, const Option& opt)
+{
+    // flattened vector is always treated as elempack=1
+    const int h = bottom_blob.dims == 2 ? bottom_blob.h : 1;
+    const int elempack = bottom_blob.dims == 2 ? bottom_blob.elempack : 1;
+    const int num_output = weight_sparse_rowptr.w - 1;
+
+    const int* rowptr = weight_sparse_rowptr;
+    const int* colidx = weight_sparse_colidx;
+    const float* bias_data_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output; p++)
+    {
+        const int start = rowptr[p];
+        const int end = rowptr[p + 1];
+
+        const float bias = bias_data_ptr ? bias_data_ptr[p] : 0.f;
+
+        for (int j = 0; j < h; j++)
+        {
+            const float* sptr = bottom_blob.dims == 2 ? bottom_blob.row(j) : (const float*)bottom_blob;
+            float* outptr = bottom_blob.dims == 2 ? top_blob.row(j) : (float*)top_blob;
+            outptr += p * elempack;
+
+            const float* kptr = (const float*)weight_sparse_data + start * 4;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+            if (elempack == 16)
+            {
+                __m512 _sum0 = _mm512_set1_ps(bias);
+                __m512 _sum1 = _mm512_setzero_ps();
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* s = sptr + colidx[k] * 16;
+                    _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(kptr[0]), _mm512_loadu_ps(s), _sum0);
+                    _sum1 = _mm512_fmadd_ps(_mm512_set1_ps(kptr[1]), _mm512_loadu_ps(s + 16), _sum1);
+                    _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(kptr[2]), _mm512_loadu_ps(s + 32), _sum0);
+                    _sum1 = _mm512_fmadd_ps(_mm512_set1_ps(kptr[3]), _mm512_loadu_ps(s + 48), _sum1);
+                    kptr += 4;
+                }
+
+                _sum0 = _mm512_add_ps(_sum0, _sum1);
+                _sum0 = activation_avx512(_sum0, activation_type, activation_params);
+                _mm512_storeu_ps(outptr, _sum0);
+                continue;
+            }
+#endif // __AVX512F__
+            if (elempack == 8)
+            {
+                __m256 _sum0 = _mm256_set1_ps(bias);
+                __m256 _sum1 = _mm256_setzero_ps();
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* s = sptr + colidx[k] * 8;
+                    _sum0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[0]), _mm256_loadu_ps(s), _sum0);
+                    _sum1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[1]), _mm256_loadu_ps(s + 8), _sum1);
+                    _sum0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[2]), _mm256_loadu_ps(s + 16), _sum0);
+                    _sum1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr[3]), _mm256_loadu_ps(s + 24), _sum1);
+                    kptr += 4;
+                }
+
+                _sum0 = _mm256_add_ps(_sum0, _sum1);
+                _sum0 = activation_avx(_sum0, activation_type, activation_params);
+                _mm256_storeu_ps(outptr, _sum0);
+                continue;
+            }
+#endif // __AVX__
+            if (elempack == 4)
+            {
+                __m128 _sum0 = _mm_set1_ps(bias);
+                __m128 _sum1 = _mm_setzero_ps();
+
+                for (int k = start; k < end; k++)
+                {
+                    const float* s = sptr + colidx[k] * 4;
+                    _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[0]), _mm_loadu_ps(s), _sum0);
+                    _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[1]), _mm_loadu_ps(s + 4), _sum1);
+                    _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[2]), _mm_loadu_ps(s + 8), _sum0);
+                    _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(kptr[3]), _mm_loadu_ps(s + 12), _sum1);
+                    kptr += 4;
+                }
+
+                _sum0 = _mm_add_ps(_sum0, _sum1);
+                _sum0 = activation_sse(_sum0, activation_type, activation_params);
+                _mm_storeu_ps(outptr, _sum0);
+                continue;
+            }
+#endif // __SSE2__
+            if (elempack == 1)
+            {
+                float sum = bias;
+                int k = start;
+#if __SSE2__
+                __m128 _sum0 = _mm_setzero_ps();
+                __m128 _sum1 = _mm_setzero_ps();
+                __m128 _sum2 = _mm_setzero_ps();
+                __m128 _sum3 = _mm_setzero_ps();
+                for (; k + 3 < end; k += 4)
+                {
+                    _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_loadu_ps(sptr + colidx[k]), _sum0);
+                    _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _mm_loadu_ps(sptr + colidx[k + 1]), _sum1);
+                    _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 8), _mm_loadu_ps(sptr + colidx[k + 2]), _sum2);
+                    _sum3 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 12), _mm_loadu_ps(sptr + colidx[k + 3]), _sum3);
+                    kptr += 16;
+                }
+                for (; k < end; k++)
+                {
+                    _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_loadu_ps(sptr + colidx[k]), _sum0);
+                    kptr += 4;
+                }
+                _sum0 = _mm_add_ps(_sum0, _sum1);
+                _sum2 = _mm_add_ps(_sum2, _sum3);
+                _sum0 = _mm_add_ps(_sum0, _sum2);
+                sum += _mm_reduce_add_ps(_sum0);
+#endif // __SSE2__
+                for (; k < end; k++)
+                {
+                    const float* s = sptr + colidx[k];
+                    sum += kptr[0] * s[0] + kptr[1] * s[1] + kptr[2] * s[2] + kptr[3] * s[3];
+                    kptr += 4;
+                }
+
+                outptr[0] = activation_ss(sum, activation_type, activation_params);
+            }
+        }
+    }
+}
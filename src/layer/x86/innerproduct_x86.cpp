@@ -21,6 +21,8 @@ namespace ncnn {
 
 #include "innerproduct_fp.h"
 #include "innerproduct_gemm_fp.h"
+#include "block_sparse_1x4.h"
+#include "innerproduct_sparse.h"
 
 #if NCNN_F16C && __AVX__
 #define NCNN_IMPL_FP16S 1
@@ -35,6 +37,8 @@ InnerProduct_x86::InnerProduct_x86()
     support_packing = true;
 #endif // __SSE2__
 
+    support_strided_input = true;
+
     flatten = 0;
 }
 
@@ -58,6 +62,22 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
     }
 #endif
 
+    const int num_input = weight_data_size / num_output;
+
+    if (block_sparse_1x4_prefer(weight_data, num_input, num_output))
+    {
+        block_sparse_1x4_transform_kernel(weight_data, weight_sparse_data, weight_sparse_rowptr, weight_sparse_colidx, num_input, num_output);
+
+        relocate_weight(weight_sparse_data, opt);
+        relocate_weight(weight_sparse_rowptr, opt);
+        relocate_weight(weight_sparse_colidx, opt);
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+
 #if NCNN_F16C && __AVX__
     if (cpu_support_x86_f16c() && opt.use_fp16_storage)
     {
@@ -65,10 +85,10 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
     }
 #endif
 
-    const int num_input = weight_data_size / num_output;
-
     innerproduct_transform_kernel_sse(weight_data, weight_data_tm, num_input, num_output, opt);
 
+    relocate_weight(weight_data_tm, opt);
+
     if (opt.lightmode)
         weight_data.release();
 
@@ -96,6 +116,11 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     }
 #endif
 
+    if (!weight_sparse_rowptr.empty())
+    {
+        return forward_sparse(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_F16C && __AVX__
     if (cpu_support_x86_f16c() && opt.use_fp16_storage)
     {
@@ -160,6 +185,66 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     return 0;
 }
 
+int InnerProduct_x86::forward_sparse(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    if (bottom_blob.dims == 2 && bottom_blob.w == num_input)
+    {
+        // gemm
+        int h = bottom_blob.h;
+        size_t elemsize = bottom_blob.elemsize;
+        int elempack = bottom_blob.elempack;
+
+        top_blob.create(num_output, h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        innerproduct_sparse_sse(bottom_blob, top_blob, weight_sparse_data, weight_sparse_rowptr, weight_sparse_colidx, bias_data, activation_type, activation_params, opt);
+
+        return 0;
+    }
+
+    // flatten
+    Mat bottom_blob_flattened = bottom_blob;
+    if (bottom_blob.dims != 1)
+    {
+        Option opt_flatten = opt;
+        opt_flatten.blob_allocator = opt.workspace_allocator;
+
+        flatten->forward(bottom_blob, bottom_blob_flattened, opt_flatten);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    size_t elemsize = bottom_blob_flattened.elemsize;
+    int elempack = bottom_blob_flattened.elempack;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // packed vector shares the plain vector memory layout
+    innerproduct_sparse_sse(bottom_blob_flattened, top_blob, weight_sparse_data, weight_sparse_rowptr, weight_sparse_colidx, bias_data, activation_type, activation_params, opt);
+
+    return 0;
+}
+
 #if NCNN_F16C && __AVX__
 int InnerProduct_x86::create_pipeline_fp16s(const Option& opt)
 {
@@ -167,6 +252,8 @@ int InnerProduct_x86::create_pipeline_fp16s(const Option& opt)
 
     innerproduct_transform_kernel_fp16s_sse(weight_data, weight_data_tm, num_input, num_output, opt);
 
+    relocate_weight(weight_data_tm, opt);
+
     if (opt.lightmode)
         weight_data.release();
 
@@ -247,7 +334,7 @@ int InnerProduct_x86::create_pipeline_int8_x86(const Option& opt)
     {
         Mat weight_data_r2 = weight_data.reshape(num_input, num_output);
 
-        weight_data_tm.create(num_input, num_output / out_elempack, (size_t)out_elempack, out_elempack);
+        weight_data_tm.create(num_input, num_output / out_elempack, (size_t)out_elempack, out_elempack, opt.weight_allocator);
 
         for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
         {
@@ -19,6 +19,7 @@ public:
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
 protected:
+    int forward_sparse(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #if NCNN_F16C && __AVX__
     int create_pipeline_fp16s(const Option& opt);
     int forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
@@ -33,6 +34,11 @@ public:
 
     Mat weight_data_tm;
 
+    // 1x4 block sparse weight
+    Mat weight_sparse_data;
+    Mat weight_sparse_rowptr;
+    Mat weight_sparse_colidx;
+
 #if NCNN_INT8
     Mat scale_in_data;
 #endif
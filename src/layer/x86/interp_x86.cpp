@@ -37,6 +37,62 @@ Interp_x86::Interp_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+    support_strided_input = true;
+
+    coeffs_w = 0;
+    coeffs_h = 0;
+    coeffs_outw = 0;
+    coeffs_outh = 0;
+}
+
+// xofs yofs alpha beta laid out back to back, h and outh are 0 for the 1d resize
+// the tables only depend on the shapes, so a static resize computes them once
+Mat Interp_x86::get_resize_coeffs(int w, int h, int outw, int outh) const
+{
+    {
+        MutexLockGuard guard(coeffs_lock);
+
+        if (!coeffs_cache.empty() && coeffs_w == w && coeffs_h == h && coeffs_outw == outw && coeffs_outh == outh)
+            return coeffs_cache;
+    }
+
+    const int coeffs_per_pixel = resize_type == 3 ? 4 : 2;
+
+    Mat coeffs;
+    coeffs.create(outw + outh + (outw + outh) * coeffs_per_pixel, (size_t)4u);
+    if (coeffs.empty())
+        return coeffs;
+
+    int* xofs = coeffs;
+    int* yofs = (int*)coeffs + outw;
+    float* alpha = (float*)coeffs + outw + outh;
+    float* beta = (float*)coeffs + outw + outh + outw * coeffs_per_pixel;
+
+    if (resize_type == 2)
+    {
+        linear_coeffs(w, outw, xofs, alpha, align_corner);
+        if (outh)
+            linear_coeffs(h, outh, yofs, beta, align_corner);
+    }
+    if (resize_type == 3)
+    {
+        cubic_coeffs(w, outw, xofs, alpha, align_corner);
+        if (outh)
+            cubic_coeffs(h, outh, yofs, beta, align_corner);
+    }
+
+    {
+        MutexLockGuard guard(coeffs_lock);
+
+        coeffs_cache = coeffs;
+        coeffs_w = w;
+        coeffs_h = h;
+        coeffs_outw = outw;
+        coeffs_outh = outh;
+    }
+
+    return coeffs;
 }
 
 int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
@@ -167,12 +223,12 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
             if (resize_type == 2) // bilinear
             {
-                int* buf = new int[outw + outw * 2];
-
-                int* xofs = buf;
-                float* alpha = (float*)(buf + outw);
+                Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+                if (coeffs.empty())
+                    return -100;
 
-                linear_coeffs(w, outw, xofs, alpha, align_corner);
+                const int* xofs = coeffs;
+                const float* alpha = (const float*)coeffs + outw;
 
                 #pragma omp parallel for num_threads(opt.num_threads)
                 for (int y = 0; y < h; y++)
@@ -199,18 +255,16 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                         outptr += 16;
                     }
                 }
-
-                delete[] buf;
             }
 
             if (resize_type == 3) // bicubic
             {
-                int* buf = new int[outw + outw * 4];
-
-                int* xofs = buf;
-                float* alpha = (float*)(buf + outw);
+                Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+                if (coeffs.empty())
+                    return -100;
 
-                cubic_coeffs(w, outw, xofs, alpha, align_corner);
+                const int* xofs = coeffs;
+                const float* alpha = (const float*)coeffs + outw;
 
                 #pragma omp parallel for num_threads(opt.num_threads)
                 for (int y = 0; y < h; y++)
@@ -243,8 +297,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                         outptr += 16;
                     }
                 }
-
-                delete[] buf;
             }
 
             return 0;
@@ -276,12 +328,12 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
             if (resize_type == 2) // bilinear
             {
-                int* buf = new int[outw + outw * 2];
-
-                int* xofs = buf;
-                float* alpha = (float*)(buf + outw);
+                Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+                if (coeffs.empty())
+                    return -100;
 
-                linear_coeffs(w, outw, xofs, alpha, align_corner);
+                const int* xofs = coeffs;
+                const float* alpha = (const float*)coeffs + outw;
 
                 #pragma omp parallel for num_threads(opt.num_threads)
                 for (int y = 0; y < h; y++)
@@ -308,18 +360,16 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                         outptr += 8;
                     }
                 }
-
-                delete[] buf;
             }
 
             if (resize_type == 3) // bicubic
             {
-                int* buf = new int[outw + outw * 4];
-
-                int* xofs = buf;
-                float* alpha = (float*)(buf + outw);
+                Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+                if (coeffs.empty())
+                    return -100;
 
-                cubic_coeffs(w, outw, xofs, alpha, align_corner);
+                const int* xofs = coeffs;
+                const float* alpha = (const float*)coeffs + outw;
 
                 #pragma omp parallel for num_threads(opt.num_threads)
                 for (int y = 0; y < h; y++)
@@ -352,8 +402,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                         outptr += 8;
                     }
                 }
-
-                delete[] buf;
             }
 
             return 0;
@@ -385,12 +433,12 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
             if (resize_type == 2) // bilinear
             {
-                int* buf = new int[outw + outw * 2];
-
-                int* xofs = buf;
-                float* alpha = (float*)(buf + outw);
+                Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+                if (coeffs.empty())
+                    return -100;
 
-                linear_coeffs(w, outw, xofs, alpha, align_corner);
+                const int* xofs = coeffs;
+                const float* alpha = (const float*)coeffs + outw;
 
                 #pragma omp parallel for num_threads(opt.num_threads)
                 for (int y = 0; y < h; y++)
@@ -417,18 +465,16 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                         outptr += 4;
                     }
                 }
-
-                delete[] buf;
             }
 
             if (resize_type == 3) // bicubic
             {
-                int* buf = new int[outw + outw * 4];
-
-                int* xofs = buf;
-                float* alpha = (float*)(buf + outw);
+                Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+                if (coeffs.empty())
+                    return -100;
 
-                cubic_coeffs(w, outw, xofs, alpha, align_corner);
+                const int* xofs = coeffs;
+                const float* alpha = (const float*)coeffs + outw;
 
                 #pragma omp parallel for num_threads(opt.num_threads)
                 for (int y = 0; y < h; y++)
@@ -461,8 +507,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                         outptr += 4;
                     }
                 }
-
-                delete[] buf;
             }
 
             return 0;
@@ -488,12 +532,12 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
         if (resize_type == 2) // bilinear
         {
-            int* buf = new int[outw + outw * 2];
+            Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+            if (coeffs.empty())
+                return -100;
 
-            int* xofs = buf;
-            float* alpha = (float*)(buf + outw);
-
-            linear_coeffs(w, outw, xofs, alpha, align_corner);
+            const int* xofs = coeffs;
+            const float* alpha = (const float*)coeffs + outw;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int y = 0; y < h; y++)
@@ -512,18 +556,16 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                     alphap += 2;
                 }
             }
-
-            delete[] buf;
         }
 
         if (resize_type == 3) // bicubic
         {
-            int* buf = new int[outw + outw * 4];
+            Mat coeffs = get_resize_coeffs(w, 0, outw, 0);
+            if (coeffs.empty())
+                return -100;
 
-            int* xofs = buf;
-            float* alpha = (float*)(buf + outw);
-
-            cubic_coeffs(w, outw, xofs, alpha, align_corner);
+            const int* xofs = coeffs;
+            const float* alpha = (const float*)coeffs + outw;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int y = 0; y < h; y++)
@@ -544,8 +586,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
                     alphap += 4;
                 }
             }
-
-            delete[] buf;
         }
 
         return 0;
@@ -598,16 +638,15 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
         if (resize_type == 2) // bilinear
         {
-            int* buf = new int[outw + outh + outw * 2 + outh * 2];
+            Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+            if (coeffs.empty())
+                return -100;
 
-            int* xofs = buf;        //new int[outw];
-            int* yofs = buf + outw; //new int[outh];
+            int* xofs = coeffs;
+            int* yofs = (int*)coeffs + outw;
 
-            float* alpha = (float*)(buf + outw + outh);           //new float[outw * 2];
-            float* beta = (float*)(buf + outw + outh + outw * 2); //new float[outh * 2];
-
-            linear_coeffs(w, outw, xofs, alpha, align_corner);
-            linear_coeffs(h, outh, yofs, beta, align_corner);
+            float* alpha = (float*)coeffs + outw + outh;
+            float* beta = (float*)coeffs + outw + outh + outw * 2;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int q = 0; q < channels; q++)
@@ -617,22 +656,19 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
                 resize_bilinear_image_pack16(src, dst, alpha, xofs, beta, yofs);
             }
-
-            delete[] buf;
         }
 
         if (resize_type == 3) // bicubic
         {
-            int* buf = new int[outw + outh + outw * 4 + outh * 4];
-
-            int* xofs = buf;        //new int[outw];
-            int* yofs = buf + outw; //new int[outh];
+            Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+            if (coeffs.empty())
+                return -100;
 
-            float* alpha = (float*)(buf + outw + outh);           //new float[outw * 4];
-            float* beta = (float*)(buf + outw + outh + outw * 4); //new float[outh * 4];
+            int* xofs = coeffs;
+            int* yofs = (int*)coeffs + outw;
 
-            cubic_coeffs(w, outw, xofs, alpha, align_corner);
-            cubic_coeffs(h, outh, yofs, beta, align_corner);
+            float* alpha = (float*)coeffs + outw + outh;
+            float* beta = (float*)coeffs + outw + outh + outw * 4;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int q = 0; q < channels; q++)
@@ -642,8 +678,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
                 resize_bicubic_image_pack16(src, dst, alpha, xofs, beta, yofs);
             }
-
-            delete[] buf;
         }
 
         return 0;
@@ -684,16 +718,15 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
         if (resize_type == 2) // bilinear
         {
-            int* buf = new int[outw + outh + outw * 2 + outh * 2];
+            Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+            if (coeffs.empty())
+                return -100;
 
-            int* xofs = buf;        //new int[outw];
-            int* yofs = buf + outw; //new int[outh];
+            int* xofs = coeffs;
+            int* yofs = (int*)coeffs + outw;
 
-            float* alpha = (float*)(buf + outw + outh);           //new float[outw * 2];
-            float* beta = (float*)(buf + outw + outh + outw * 2); //new float[outh * 2];
-
-            linear_coeffs(w, outw, xofs, alpha, align_corner);
-            linear_coeffs(h, outh, yofs, beta, align_corner);
+            float* alpha = (float*)coeffs + outw + outh;
+            float* beta = (float*)coeffs + outw + outh + outw * 2;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int q = 0; q < channels; q++)
@@ -703,22 +736,19 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
                 resize_bilinear_image_pack8(src, dst, alpha, xofs, beta, yofs);
             }
-
-            delete[] buf;
         }
 
         if (resize_type == 3) // bicubic
         {
-            int* buf = new int[outw + outh + outw * 4 + outh * 4];
+            Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+            if (coeffs.empty())
+                return -100;
 
-            int* xofs = buf;        //new int[outw];
-            int* yofs = buf + outw; //new int[outh];
+            int* xofs = coeffs;
+            int* yofs = (int*)coeffs + outw;
 
-            float* alpha = (float*)(buf + outw + outh);           //new float[outw * 4];
-            float* beta = (float*)(buf + outw + outh + outw * 4); //new float[outh * 4];
-
-            cubic_coeffs(w, outw, xofs, alpha, align_corner);
-            cubic_coeffs(h, outh, yofs, beta, align_corner);
+            float* alpha = (float*)coeffs + outw + outh;
+            float* beta = (float*)coeffs + outw + outh + outw * 4;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int q = 0; q < channels; q++)
@@ -728,8 +758,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
                 resize_bicubic_image_pack8(src, dst, alpha, xofs, beta, yofs);
             }
-
-            delete[] buf;
         }
 
         return 0;
@@ -770,16 +798,15 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
         if (resize_type == 2) // bilinear
         {
-            int* buf = new int[outw + outh + outw * 2 + outh * 2];
+            Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+            if (coeffs.empty())
+                return -100;
 
-            int* xofs = buf;        //new int[outw];
-            int* yofs = buf + outw; //new int[outh];
+            int* xofs = coeffs;
+            int* yofs = (int*)coeffs + outw;
 
-            float* alpha = (float*)(buf + outw + outh);           //new float[outw * 2];
-            float* beta = (float*)(buf + outw + outh + outw * 2); //new float[outh * 2];
-
-            linear_coeffs(w, outw, xofs, alpha, align_corner);
-            linear_coeffs(h, outh, yofs, beta, align_corner);
+            float* alpha = (float*)coeffs + outw + outh;
+            float* beta = (float*)coeffs + outw + outh + outw * 2;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int q = 0; q < channels; q++)
@@ -789,22 +816,19 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
                 resize_bilinear_image_pack4(src, dst, alpha, xofs, beta, yofs);
             }
-
-            delete[] buf;
         }
 
         if (resize_type == 3) // bicubic
         {
-            int* buf = new int[outw + outh + outw * 4 + outh * 4];
-
-            int* xofs = buf;        //new int[outw];
-            int* yofs = buf + outw; //new int[outh];
+            Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+            if (coeffs.empty())
+                return -100;
 
-            float* alpha = (float*)(buf + outw + outh);           //new float[outw * 4];
-            float* beta = (float*)(buf + outw + outh + outw * 4); //new float[outh * 4];
+            int* xofs = coeffs;
+            int* yofs = (int*)coeffs + outw;
 
-            cubic_coeffs(w, outw, xofs, alpha, align_corner);
-            cubic_coeffs(h, outh, yofs, beta, align_corner);
+            float* alpha = (float*)coeffs + outw + outh;
+            float* beta = (float*)coeffs + outw + outh + outw * 4;
 
             #pragma omp parallel for num_threads(opt.num_threads)
             for (int q = 0; q < channels; q++)
@@ -814,8 +838,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
                 resize_bicubic_image_pack4(src, dst, alpha, xofs, beta, yofs);
             }
-
-            delete[] buf;
         }
 
         return 0;
@@ -850,16 +872,15 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
     if (resize_type == 2) // bilinear
     {
-        int* buf = new int[outw + outh + outw * 2 + outh * 2];
-
-        int* xofs = buf;        //new int[outw];
-        int* yofs = buf + outw; //new int[outh];
+        Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+        if (coeffs.empty())
+            return -100;
 
-        float* alpha = (float*)(buf + outw + outh);           //new float[outw * 2];
-        float* beta = (float*)(buf + outw + outh + outw * 2); //new float[outh * 2];
+        int* xofs = coeffs;
+        int* yofs = (int*)coeffs + outw;
 
-        linear_coeffs(w, outw, xofs, alpha, align_corner);
-        linear_coeffs(h, outh, yofs, beta, align_corner);
+        float* alpha = (float*)coeffs + outw + outh;
+        float* beta = (float*)coeffs + outw + outh + outw * 2;
 
         #pragma omp parallel for num_threads(opt.num_threads)
         for (int q = 0; q < channels; q++)
@@ -869,22 +890,19 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
             resize_bilinear_image(src, dst, alpha, xofs, beta, yofs);
         }
-
-        delete[] buf;
     }
 
     if (resize_type == 3) // bicubic
     {
-        int* buf = new int[outw + outh + outw * 4 + outh * 4];
-
-        int* xofs = buf;        //new int[outw];
-        int* yofs = buf + outw; //new int[outh];
+        Mat coeffs = get_resize_coeffs(w, h, outw, outh);
+        if (coeffs.empty())
+            return -100;
 
-        float* alpha = (float*)(buf + outw + outh);           //new float[outw * 4];
-        float* beta = (float*)(buf + outw + outh + outw * 4); //new float[outh * 4];
+        int* xofs = coeffs;
+        int* yofs = (int*)coeffs + outw;
 
-        cubic_coeffs(w, outw, xofs, alpha, align_corner);
-        cubic_coeffs(h, outh, yofs, beta, align_corner);
+        float* alpha = (float*)coeffs + outw + outh;
+        float* beta = (float*)coeffs + outw + outh + outw * 4;
 
         #pragma omp parallel for num_threads(opt.num_threads)
         for (int q = 0; q < channels; q++)
@@ -894,8 +912,6 @@ int Interp_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
 
             resize_bicubic_image(src, dst, alpha, xofs, beta, yofs);
         }
-
-        delete[] buf;
     }
 
     return 0;
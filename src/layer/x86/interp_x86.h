@@ -14,6 +14,18 @@ public:
     Interp_x86();
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    Mat get_resize_coeffs(int w, int h, int outw, int outh) const;
+
+public:
+    // coefficient tables of the last resize shape, reused by later calls with the same shape
+    mutable Mutex coeffs_lock;
+    mutable Mat coeffs_cache;
+    mutable int coeffs_w;
+    mutable int coeffs_h;
+    mutable int coeffs_outw;
+    mutable int coeffs_outh;
 };
 
 } // namespace ncnn
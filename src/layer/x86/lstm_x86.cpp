@@ -3,6 +3,8 @@
 
 #include "lstm_x86.h"
 
+#include "layer_type.h"
+
 #if __SSE2__
 #include <emmintrin.h>
 #include "sse_mathfun.h"
@@ -28,6 +30,8 @@ LSTM_x86::LSTM_x86()
 {
     one_blob_only = false;
     support_inplace = false;
+
+    xc_gemm = 0;
 }
 
 int LSTM_x86::create_pipeline(const Option& opt)
@@ -40,17 +44,23 @@ int LSTM_x86::create_pipeline(const Option& opt)
 #endif
 
     // pack IFOG
-    int num_directions = direction == 2 ? 2 : 1;
-    int size = weight_data_size / num_directions / hidden_size / 4;
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / hidden_size / 4;
+
+    // W_xc * x_t + b_c of all timesteps and directions is one gemm up front
+    // each gemm output row holds gate I F O G of hidden unit q of direction dr at (dr * hidden_size + q) * 4
+    Mat weight_xc_IFOG(size, hidden_size * 4 * num_directions);
+    if (weight_xc_IFOG.empty())
+        return -100;
+
+    Mat bias_c_IFOG(hidden_size * 4 * num_directions);
+    if (bias_c_IFOG.empty())
+        return -100;
 
 #if __AVX__
-    weight_xc_data_packed.create(size, hidden_size / 2 + hidden_size % 2, num_directions, 32u, 8);
-    bias_c_data_packed.create(hidden_size, 1, num_directions, 16u, 4);
-    weight_hc_data_packed.create(num_output, hidden_size / 2 + hidden_size % 2, num_directions, 32u, 8);
+    weight_hc_data_packed.create(num_output, hidden_size / 2 + hidden_size % 2, num_directions, 32u, 8, opt.weight_allocator);
 #else
-    weight_xc_data_packed.create(size, hidden_size, num_directions, 16u, 4);
-    bias_c_data_packed.create(hidden_size, 1, num_directions, 16u, 4);
-    weight_hc_data_packed.create(num_output, hidden_size, num_directions, 16u, 4);
+    weight_hc_data_packed.create(num_output, hidden_size, num_directions, 16u, 4, opt.weight_allocator);
 #endif
 
     #pragma omp parallel for num_threads(opt.num_threads)
@@ -60,41 +70,22 @@ int LSTM_x86::create_pipeline(const Option& opt)
         const Mat bias_c = bias_c_data.channel(dr);
         const Mat weight_hc = weight_hc_data.channel(dr);
 
-        Mat weight_xc_data_packed_dr = weight_xc_data_packed.channel(dr);
-        Mat bias_c_data_packed_dr = bias_c_data_packed.channel(dr);
         Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
 
-        const float* bias_c_I = bias_c.row(0);
-        const float* bias_c_F = bias_c.row(1);
-        const float* bias_c_O = bias_c.row(2);
-        const float* bias_c_G = bias_c.row(3);
+        for (int q = 0; q < hidden_size; q++)
+        {
+            for (int g = 0; g < 4; g++)
+            {
+                memcpy(weight_xc_IFOG.row((dr * hidden_size + q) * 4 + g), weight_xc.row(hidden_size * g + q), size * sizeof(float));
 
-        float* bias_c_IFOG = bias_c_data_packed_dr.row(0);
+                bias_c_IFOG[(dr * hidden_size + q) * 4 + g] = bias_c.row(g)[q];
+            }
+        }
 
         int q = 0;
 #if __AVX__
         for (; q + 1 < hidden_size; q += 2)
         {
-            bias_c_IFOG[0] = bias_c_I[q];
-            bias_c_IFOG[1] = bias_c_F[q];
-            bias_c_IFOG[2] = bias_c_O[q];
-            bias_c_IFOG[3] = bias_c_G[q];
-            bias_c_IFOG[4] = bias_c_I[q + 1];
-            bias_c_IFOG[5] = bias_c_F[q + 1];
-            bias_c_IFOG[6] = bias_c_O[q + 1];
-            bias_c_IFOG[7] = bias_c_G[q + 1];
-
-            bias_c_IFOG += 8;
-
-            const float* weight_xc_I = weight_xc.row(hidden_size * 0 + q);
-            const float* weight_xc_F = weight_xc.row(hidden_size * 1 + q);
-            const float* weight_xc_O = weight_xc.row(hidden_size * 2 + q);
-            const float* weight_xc_G = weight_xc.row(hidden_size * 3 + q);
-            const float* weight_xc_I_1 = weight_xc.row(hidden_size * 0 + q + 1);
-            const float* weight_xc_F_1 = weight_xc.row(hidden_size * 1 + q + 1);
-            const float* weight_xc_O_1 = weight_xc.row(hidden_size * 2 + q + 1);
-            const float* weight_xc_G_1 = weight_xc.row(hidden_size * 3 + q + 1);
-
             const float* weight_hc_I = weight_hc.row(hidden_size * 0 + q);
             const float* weight_hc_F = weight_hc.row(hidden_size * 1 + q);
             const float* weight_hc_O = weight_hc.row(hidden_size * 2 + q);
@@ -104,23 +95,8 @@ int LSTM_x86::create_pipeline(const Option& opt)
             const float* weight_hc_O_1 = weight_hc.row(hidden_size * 2 + q + 1);
             const float* weight_hc_G_1 = weight_hc.row(hidden_size * 3 + q + 1);
 
-            float* weight_xc_IFOG = weight_xc_data_packed_dr.row(q / 2);
             float* weight_hc_IFOG = weight_hc_data_packed_dr.row(q / 2);
 
-            for (int i = 0; i < size; i++)
-            {
-                weight_xc_IFOG[0] = weight_xc_I[i];
-                weight_xc_IFOG[1] = weight_xc_F[i];
-                weight_xc_IFOG[2] = weight_xc_O[i];
-                weight_xc_IFOG[3] = weight_xc_G[i];
-                weight_xc_IFOG[4] = weight_xc_I_1[i];
-                weight_xc_IFOG[5] = weight_xc_F_1[i];
-                weight_xc_IFOG[6] = weight_xc_O_1[i];
-                weight_xc_IFOG[7] = weight_xc_G_1[i];
-
-                weight_xc_IFOG += 8;
-            }
-
             for (int i = 0; i < num_output; i++)
             {
                 weight_hc_IFOG[0] = weight_hc_I[i];
@@ -138,41 +114,17 @@ int LSTM_x86::create_pipeline(const Option& opt)
 #endif // __AVX__
         for (; q < hidden_size; q++)
         {
-            bias_c_IFOG[0] = bias_c_I[q];
-            bias_c_IFOG[1] = bias_c_F[q];
-            bias_c_IFOG[2] = bias_c_O[q];
-            bias_c_IFOG[3] = bias_c_G[q];
-
-            bias_c_IFOG += 4;
-
-            const float* weight_xc_I = weight_xc.row(hidden_size * 0 + q);
-            const float* weight_xc_F = weight_xc.row(hidden_size * 1 + q);
-            const float* weight_xc_O = weight_xc.row(hidden_size * 2 + q);
-            const float* weight_xc_G = weight_xc.row(hidden_size * 3 + q);
-
             const float* weight_hc_I = weight_hc.row(hidden_size * 0 + q);
             const float* weight_hc_F = weight_hc.row(hidden_size * 1 + q);
             const float* weight_hc_O = weight_hc.row(hidden_size * 2 + q);
             const float* weight_hc_G = weight_hc.row(hidden_size * 3 + q);
 
 #if __AVX__
-            float* weight_xc_IFOG = weight_xc_data_packed_dr.row(q / 2 + q % 2);
             float* weight_hc_IFOG = weight_hc_data_packed_dr.row(q / 2 + q % 2);
 #else
-            float* weight_xc_IFOG = weight_xc_data_packed_dr.row(q);
             float* weight_hc_IFOG = weight_hc_data_packed_dr.row(q);
 #endif
 
-            for (int i = 0; i < size; i++)
-            {
-                weight_xc_IFOG[0] = weight_xc_I[i];
-                weight_xc_IFOG[1] = weight_xc_F[i];
-                weight_xc_IFOG[2] = weight_xc_O[i];
-                weight_xc_IFOG[3] = weight_xc_G[i];
-
-                weight_xc_IFOG += 4;
-            }
-
             for (int i = 0; i < num_output; i++)
             {
                 weight_hc_IFOG[0] = weight_hc_I[i];
@@ -185,6 +137,28 @@ int LSTM_x86::create_pipeline(const Option& opt)
         }
     }
 
+    {
+        xc_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+        ncnn::ParamDict pd;
+        pd.set(2, 0);                                // transA
+        pd.set(3, 1);                                // transB
+        pd.set(4, 0);                                // constantA
+        pd.set(5, 1);                                // constantB
+        pd.set(6, 1);                                // constantC
+        pd.set(7, 0);                                // M = T
+        pd.set(8, hidden_size * 4 * num_directions); // N
+        pd.set(9, size);                             // K
+        pd.set(10, 4);                               // constant_broadcast_type_C
+        pd.set(11, 0);                               // output_N1M
+        pd.set(12, 1);                               // output_elempack
+        xc_gemm->load_param(pd);
+        Mat weights[2];
+        weights[0] = weight_xc_IFOG;
+        weights[1] = bias_c_IFOG;
+        xc_gemm->load_model(ModelBinFromMatArray(weights));
+        xc_gemm->create_pipeline(opt);
+    }
+
     if (opt.lightmode)
     {
         weight_xc_data.release();
@@ -195,27 +169,38 @@ int LSTM_x86::create_pipeline(const Option& opt)
     return 0;
 }
 
-static int lstm(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_xc, const Mat& bias_c, const Mat& weight_hc, const Mat& weight_hr, Mat& hidden_state, Mat& cell_state, const Option& opt)
+int LSTM_x86::destroy_pipeline(const Option& opt)
 {
-    int size = bottom_blob.w;
-    int T = bottom_blob.h;
+    if (xc_gemm)
+    {
+        xc_gemm->destroy_pipeline(opt);
+        delete xc_gemm;
+        xc_gemm = 0;
+    }
 
-    int num_output = top_blob.w;
-    int hidden_size = cell_state.w;
+    return 0;
+}
 
-    // 4 x hidden_size
-    Mat gates(4, hidden_size, 4u, opt.workspace_allocator);
-    if (gates.empty())
-        return -100;
+static int lstm(const Mat& gates_x, Mat& top_blob, int direction, const Mat& weight_hc, const Mat& weight_hr, Mat& hidden_state, Mat& cell_state, const Option& opt)
+{
+    const int T = gates_x.h;
+    const int num_directions = direction == 2 ? 2 : 1;
+
+    const int num_output = top_blob.w / num_directions;
+    const int hidden_size = cell_state.w;
 
     Mat tmp_hidden_state;
     if (num_output != hidden_size)
     {
-        tmp_hidden_state.create(hidden_size, 4u, opt.workspace_allocator);
+        tmp_hidden_state.create(hidden_size, num_directions, 4u, opt.workspace_allocator);
         if (tmp_hidden_state.empty())
             return -100;
     }
 
+    // gates and unit of all directions run in one parallel region per step
+    // h_{t-1} is read back from the previous output row
+    const int nn_hidden_size = (hidden_size + 3) / 4;
+
     // unroll
     for (int t = 0; t < T; t++)
     {
@@ -226,325 +211,215 @@ static int lstm(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& w
         // calculate hidden
         // gate_input_t := W_hc * h_conted_{t-1} + W_xc * x_t + b_c
 
-        int ti = reverse ? T - 1 - t : t;
-
-#if __AVX__
-        int nn_hidden_size = hidden_size >> 1;
-        int remain_hidden_size_start = nn_hidden_size << 1;
         #pragma omp parallel for num_threads(opt.num_threads)
-        for (int qq = 0; qq < nn_hidden_size; qq++)
+        for (int ii = 0; ii < num_directions * nn_hidden_size; ii++)
         {
-            int q = qq * 2;
+            const int dr = ii / nn_hidden_size;
+            const int q = ii % nn_hidden_size * 4;
+            const int max_jj = std::min(hidden_size - q, 4);
 
-            const float* bias_c_IFOG = (const float*)bias_c + q * 4;
+            const int reverse = direction == 2 ? dr : direction;
+            const int ti = reverse ? T - 1 - t : t;
 
-            // gate I F O G
-            const float* weight_xc_IFOG = weight_xc.row(q / 2);
-            const float* weight_hc_IFOG = weight_hc.row(q / 2);
+            const float* hidden_ptr0 = t == 0 ? hidden_state.row(dr) : top_blob.row(reverse ? ti + 1 : ti - 1) + dr * num_output;
 
-            __m256 _IFOG = _mm256_loadu_ps(bias_c_IFOG);
-            __m256 _sum1 = _mm256_setzero_ps();
-            __m256 _sum2 = _mm256_setzero_ps();
-            __m256 _sum3 = _mm256_setzero_ps();
+            const float* gates_x_ptr = gates_x.row(ti) + dr * hidden_size * 4;
+            const Mat weight_hc_dr = weight_hc.channel(dr);
 
-            const float* x = bottom_blob.row(ti);
+            // gate I F O G of 4 hidden units
+            float gates_data[16];
 
-            int i = 0;
-            for (; i + 3 < size; i += 4)
-            {
-                __m256 _xi0 = _mm256_broadcast_ss(x);
-                __m256 _xi1 = _mm256_broadcast_ss(x + 1);
-                __m256 _xi2 = _mm256_broadcast_ss(x + 2);
-                __m256 _xi3 = _mm256_broadcast_ss(x + 3);
-                __m256 _weight_xc_IFOG0 = _mm256_loadu_ps(weight_xc_IFOG);
-                __m256 _weight_xc_IFOG1 = _mm256_loadu_ps(weight_xc_IFOG + 8);
-                __m256 _weight_xc_IFOG2 = _mm256_loadu_ps(weight_xc_IFOG + 16);
-                __m256 _weight_xc_IFOG3 = _mm256_loadu_ps(weight_xc_IFOG + 24);
-                _IFOG = _mm256_comp_fmadd_ps(_weight_xc_IFOG0, _xi0, _IFOG);
-                _sum1 = _mm256_comp_fmadd_ps(_weight_xc_IFOG1, _xi1, _sum1);
-                _sum2 = _mm256_comp_fmadd_ps(_weight_xc_IFOG2, _xi2, _sum2);
-                _sum3 = _mm256_comp_fmadd_ps(_weight_xc_IFOG3, _xi3, _sum3);
-
-                x += 4;
-                weight_xc_IFOG += 32;
-            }
-            for (; i < size; i++)
+            int jj = 0;
+#if __AVX__
+            for (; jj + 1 < max_jj; jj += 2)
             {
-                __m256 _xi = _mm256_broadcast_ss(x);
-                __m256 _weight_xc_IFOG = _mm256_loadu_ps(weight_xc_IFOG);
-                _IFOG = _mm256_comp_fmadd_ps(_weight_xc_IFOG, _xi, _IFOG);
-
-                x += 1;
-                weight_xc_IFOG += 8;
-            }
+                const float* weight_hc_IFOG = weight_hc_dr.row((q + jj) / 2);
 
-            const float* hidden_ptr = hidden_state;
+                __m256 _IFOG = _mm256_loadu_ps(gates_x_ptr + (q + jj) * 4);
+                __m256 _sum1 = _mm256_setzero_ps();
+                __m256 _sum2 = _mm256_setzero_ps();
+                __m256 _sum3 = _mm256_setzero_ps();
 
-            i = 0;
-            for (; i + 3 < num_output; i += 4)
-            {
-                __m256 _h_cont0 = _mm256_broadcast_ss(hidden_ptr);
-                __m256 _h_cont1 = _mm256_broadcast_ss(hidden_ptr + 1);
-                __m256 _h_cont2 = _mm256_broadcast_ss(hidden_ptr + 2);
-                __m256 _h_cont3 = _mm256_broadcast_ss(hidden_ptr + 3);
-                __m256 _weight_hc_IFOG0 = _mm256_loadu_ps(weight_hc_IFOG);
-                __m256 _weight_hc_IFOG1 = _mm256_loadu_ps(weight_hc_IFOG + 8);
-                __m256 _weight_hc_IFOG2 = _mm256_loadu_ps(weight_hc_IFOG + 16);
-                __m256 _weight_hc_IFOG3 = _mm256_loadu_ps(weight_hc_IFOG + 24);
-                _IFOG = _mm256_comp_fmadd_ps(_weight_hc_IFOG0, _h_cont0, _IFOG);
-                _sum1 = _mm256_comp_fmadd_ps(_weight_hc_IFOG1, _h_cont1, _sum1);
-                _sum2 = _mm256_comp_fmadd_ps(_weight_hc_IFOG2, _h_cont2, _sum2);
-                _sum3 = _mm256_comp_fmadd_ps(_weight_hc_IFOG3, _h_cont3, _sum3);
-
-                hidden_ptr += 4;
-                weight_hc_IFOG += 32;
-            }
-            for (; i < num_output; i++)
-            {
-                __m256 _h_cont = _mm256_broadcast_ss(hidden_ptr);
-                __m256 _weight_hc_IFOG = _mm256_loadu_ps(weight_hc_IFOG);
-                _IFOG = _mm256_comp_fmadd_ps(_weight_hc_IFOG, _h_cont, _IFOG);
+                const float* hidden_ptr = hidden_ptr0;
 
-                hidden_ptr += 1;
-                weight_hc_IFOG += 8;
-            }
+                int i = 0;
+                for (; i + 3 < num_output; i += 4)
+                {
+                    __m256 _h_cont0 = _mm256_broadcast_ss(hidden_ptr);
+                    __m256 _h_cont1 = _mm256_broadcast_ss(hidden_ptr + 1);
+                    __m256 _h_cont2 = _mm256_broadcast_ss(hidden_ptr + 2);
+                    __m256 _h_cont3 = _mm256_broadcast_ss(hidden_ptr + 3);
+                    __m256 _weight_hc_IFOG0 = _mm256_loadu_ps(weight_hc_IFOG);
+                    __m256 _weight_hc_IFOG1 = _mm256_loadu_ps(weight_hc_IFOG + 8);
+                    __m256 _weight_hc_IFOG2 = _mm256_loadu_ps(weight_hc_IFOG + 16);
+                    __m256 _weight_hc_IFOG3 = _mm256_loadu_ps(weight_hc_IFOG + 24);
+                    _IFOG = _mm256_comp_fmadd_ps(_weight_hc_IFOG0, _h_cont0, _IFOG);
+                    _sum1 = _mm256_comp_fmadd_ps(_weight_hc_IFOG1, _h_cont1, _sum1);
+                    _sum2 = _mm256_comp_fmadd_ps(_weight_hc_IFOG2, _h_cont2, _sum2);
+                    _sum3 = _mm256_comp_fmadd_ps(_weight_hc_IFOG3, _h_cont3, _sum3);
+
+                    hidden_ptr += 4;
+                    weight_hc_IFOG += 32;
+                }
+                for (; i < num_output; i++)
+                {
+                    __m256 _h_cont = _mm256_broadcast_ss(hidden_ptr);
+                    __m256 _weight_hc_IFOG = _mm256_loadu_ps(weight_hc_IFOG);
+                    _IFOG = _mm256_comp_fmadd_ps(_weight_hc_IFOG, _h_cont, _IFOG);
 
-            float* gates_data = gates.row(q);
+                    hidden_ptr += 1;
+                    weight_hc_IFOG += 8;
+                }
 
-            _IFOG = _mm256_add_ps(_IFOG, _sum1);
-            _sum2 = _mm256_add_ps(_sum2, _sum3);
-            _IFOG = _mm256_add_ps(_IFOG, _sum2);
+                _IFOG = _mm256_add_ps(_IFOG, _sum1);
+                _sum2 = _mm256_add_ps(_sum2, _sum3);
+                _IFOG = _mm256_add_ps(_IFOG, _sum2);
 
-            _mm256_storeu_ps(gates_data, _IFOG);
-        }
-#else
-        int nn_hidden_size = 0;
-        int remain_hidden_size_start = 0;
+                _mm256_storeu_ps(gates_data + jj * 4, _IFOG);
+            }
 #endif // __AVX__
-
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = remain_hidden_size_start; q < hidden_size; q++)
-        {
-            const float* bias_c_IFOG = (const float*)bias_c + q * 4;
-
-            // gate I F O G
+            for (; jj < max_jj; jj++)
+            {
 #if __AVX__
-            const float* weight_xc_IFOG = weight_xc.row(q / 2 + q % 2);
-            const float* weight_hc_IFOG = weight_hc.row(q / 2 + q % 2);
+                const float* weight_hc_IFOG = weight_hc_dr.row((q + jj) / 2 + (q + jj) % 2);
 #else
-            const float* weight_xc_IFOG = weight_xc.row(q);
-            const float* weight_hc_IFOG = weight_hc.row(q);
+                const float* weight_hc_IFOG = weight_hc_dr.row(q + jj);
 #endif
 
 #if __SSE2__
-            __m128 _IFOG = _mm_loadu_ps(bias_c_IFOG);
-            __m128 _sum1 = _mm_setzero_ps();
-            __m128 _sum2 = _mm_setzero_ps();
-            __m128 _sum3 = _mm_setzero_ps();
+                __m128 _IFOG = _mm_loadu_ps(gates_x_ptr + (q + jj) * 4);
+                __m128 _sum1 = _mm_setzero_ps();
+                __m128 _sum2 = _mm_setzero_ps();
+                __m128 _sum3 = _mm_setzero_ps();
 #else  // __SSE2__
-            float I = bias_c_IFOG[0];
-            float F = bias_c_IFOG[1];
-            float O = bias_c_IFOG[2];
-            float G = bias_c_IFOG[3];
+                float I = gates_x_ptr[(q + jj) * 4];
+                float F = gates_x_ptr[(q + jj) * 4 + 1];
+                float O = gates_x_ptr[(q + jj) * 4 + 2];
+                float G = gates_x_ptr[(q + jj) * 4 + 3];
 #endif // __SSE2__
 
-            const float* x = bottom_blob.row(ti);
+                const float* hidden_ptr = hidden_ptr0;
 
-            int i = 0;
+                int i = 0;
 #if __SSE2__
-            for (; i + 3 < size; i += 4)
-            {
-                __m128 _xi0 = _mm_load1_ps(x);
-                __m128 _xi1 = _mm_load1_ps(x + 1);
-                __m128 _xi2 = _mm_load1_ps(x + 2);
-                __m128 _xi3 = _mm_load1_ps(x + 3);
-                __m128 _weight_xc_IFOG0 = _mm_loadu_ps(weight_xc_IFOG);
-                __m128 _weight_xc_IFOG1 = _mm_loadu_ps(weight_xc_IFOG + 4);
-                __m128 _weight_xc_IFOG2 = _mm_loadu_ps(weight_xc_IFOG + 8);
-                __m128 _weight_xc_IFOG3 = _mm_loadu_ps(weight_xc_IFOG + 12);
-                _IFOG = _mm_comp_fmadd_ps(_weight_xc_IFOG0, _xi0, _IFOG);
-                _sum1 = _mm_comp_fmadd_ps(_weight_xc_IFOG1, _xi1, _sum1);
-                _sum2 = _mm_comp_fmadd_ps(_weight_xc_IFOG2, _xi2, _sum2);
-                _sum3 = _mm_comp_fmadd_ps(_weight_xc_IFOG3, _xi3, _sum3);
-
-                x += 4;
-                weight_xc_IFOG += 16;
-            }
-#endif // __SSE2__
-            for (; i < size; i++)
-            {
-#if __SSE2__
-                __m128 _xi = _mm_load1_ps(x);
-                __m128 _weight_xc_IFOG = _mm_loadu_ps(weight_xc_IFOG);
-                _IFOG = _mm_comp_fmadd_ps(_weight_xc_IFOG, _xi, _IFOG);
-#else  // __SSE2__
-                float xi = x[0];
-                I += xi * weight_xc_IFOG[0];
-                F += xi * weight_xc_IFOG[1];
-                O += xi * weight_xc_IFOG[2];
-                G += xi * weight_xc_IFOG[3];
-#endif // __SSE2__
-
-                x += 1;
-                weight_xc_IFOG += 4;
-            }
-
-            const float* hidden_ptr = hidden_state;
-
-            i = 0;
-#if __SSE2__
-            for (; i + 3 < num_output; i += 4)
-            {
-                __m128 _h_cont0 = _mm_load1_ps(hidden_ptr);
-                __m128 _h_cont1 = _mm_load1_ps(hidden_ptr + 1);
-                __m128 _h_cont2 = _mm_load1_ps(hidden_ptr + 2);
-                __m128 _h_cont3 = _mm_load1_ps(hidden_ptr + 3);
-                __m128 _weight_hc_IFOG0 = _mm_loadu_ps(weight_hc_IFOG);
-                __m128 _weight_hc_IFOG1 = _mm_loadu_ps(weight_hc_IFOG + 4);
-                __m128 _weight_hc_IFOG2 = _mm_loadu_ps(weight_hc_IFOG + 8);
-                __m128 _weight_hc_IFOG3 = _mm_loadu_ps(weight_hc_IFOG + 12);
-                _IFOG = _mm_comp_fmadd_ps(_weight_hc_IFOG0, _h_cont0, _IFOG);
-                _sum1 = _mm_comp_fmadd_ps(_weight_hc_IFOG1, _h_cont1, _sum1);
-                _sum2 = _mm_comp_fmadd_ps(_weight_hc_IFOG2, _h_cont2, _sum2);
-                _sum3 = _mm_comp_fmadd_ps(_weight_hc_IFOG3, _h_cont3, _sum3);
-
-                hidden_ptr += 4;
-                weight_hc_IFOG += 16;
-            }
+                for (; i + 3 < num_output; i += 4)
+                {
+                    __m128 _h_cont0 = _mm_load1_ps(hidden_ptr);
+                    __m128 _h_cont1 = _mm_load1_ps(hidden_ptr + 1);
+                    __m128 _h_cont2 = _mm_load1_ps(hidden_ptr + 2);
+                    __m128 _h_cont3 = _mm_load1_ps(hidden_ptr + 3);
+                    __m128 _weight_hc_IFOG0 = _mm_loadu_ps(weight_hc_IFOG);
+                    __m128 _weight_hc_IFOG1 = _mm_loadu_ps(weight_hc_IFOG + 4);
+                    __m128 _weight_hc_IFOG2 = _mm_loadu_ps(weight_hc_IFOG + 8);
+                    __m128 _weight_hc_IFOG3 = _mm_loadu_ps(weight_hc_IFOG + 12);
+                    _IFOG = _mm_comp_fmadd_ps(_weight_hc_IFOG0, _h_cont0, _IFOG);
+                    _sum1 = _mm_comp_fmadd_ps(_weight_hc_IFOG1, _h_cont1, _sum1);
+                    _sum2 = _mm_comp_fmadd_ps(_weight_hc_IFOG2, _h_cont2, _sum2);
+                    _sum3 = _mm_comp_fmadd_ps(_weight_hc_IFOG3, _h_cont3, _sum3);
+
+                    hidden_ptr += 4;
+                    weight_hc_IFOG += 16;
+                }
 #endif // __SSE2__
-            for (; i < num_output; i++)
-            {
+                for (; i < num_output; i++)
+                {
 #if __SSE2__
-                __m128 _h_cont = _mm_load1_ps(hidden_ptr);
-                __m128 _weight_hc_IFOG = _mm_loadu_ps(weight_hc_IFOG);
-                _IFOG = _mm_comp_fmadd_ps(_weight_hc_IFOG, _h_cont, _IFOG);
+                    __m128 _h_cont = _mm_load1_ps(hidden_ptr);
+                    __m128 _weight_hc_IFOG = _mm_loadu_ps(weight_hc_IFOG);
+                    _IFOG = _mm_comp_fmadd_ps(_weight_hc_IFOG, _h_cont, _IFOG);
 #else  // __SSE2__
-                float h_cont = hidden_ptr[0];
-                I += h_cont * weight_hc_IFOG[0];
-                F += h_cont * weight_hc_IFOG[1];
-                O += h_cont * weight_hc_IFOG[2];
-                G += h_cont * weight_hc_IFOG[3];
+                    float h_cont = hidden_ptr[0];
+                    I += h_cont * weight_hc_IFOG[0];
+                    F += h_cont * weight_hc_IFOG[1];
+                    O += h_cont * weight_hc_IFOG[2];
+                    G += h_cont * weight_hc_IFOG[3];
 #endif // __SSE2__
 
-                hidden_ptr += 1;
-                weight_hc_IFOG += 4;
-            }
-
-            float* gates_data = gates.row(q);
+                    hidden_ptr += 1;
+                    weight_hc_IFOG += 4;
+                }
 
 #if __SSE2__
-            _IFOG = _mm_add_ps(_IFOG, _sum1);
-            _sum2 = _mm_add_ps(_sum2, _sum3);
-            _IFOG = _mm_add_ps(_IFOG, _sum2);
+                _IFOG = _mm_add_ps(_IFOG, _sum1);
+                _sum2 = _mm_add_ps(_sum2, _sum3);
+                _IFOG = _mm_add_ps(_IFOG, _sum2);
 
-            _mm_storeu_ps(gates_data, _IFOG);
+                _mm_storeu_ps(gates_data + jj * 4, _IFOG);
 #else  // __SSE2__
-            gates_data[0] = I;
-            gates_data[1] = F;
-            gates_data[2] = O;
-            gates_data[3] = G;
+                gates_data[jj * 4] = I;
+                gates_data[jj * 4 + 1] = F;
+                gates_data[jj * 4 + 2] = O;
+                gates_data[jj * 4 + 3] = G;
 #endif // __SSE2__
-        }
-
-        // lstm unit
-        // sigmoid(I)
-        // sigmoid(F)
-        // sigmoid(O)
-        // tanh(G)
-        // c_t := f_t .* c_{t-1} + i_t .* g_t
-        // h_t := o_t .* tanh[c_t]
-        float* output_data = top_blob.row(ti);
+            }
 
-        float* cell_ptr = cell_state;
-        float* hidden_ptr = hidden_state;
-        float* tmp_hidden_ptr = tmp_hidden_state;
+            // lstm unit
+            // sigmoid(I)
+            // sigmoid(F)
+            // sigmoid(O)
+            // tanh(G)
+            // c_t := f_t .* c_{t-1} + i_t .* g_t
+            // h_t := o_t .* tanh[c_t]
+            float* cell_ptr = cell_state.row(dr) + q;
+            float* outptr = num_output == hidden_size ? top_blob.row(ti) + dr * num_output + q : tmp_hidden_state.row(dr) + q;
 
 #if __SSE2__
-        nn_hidden_size = hidden_size >> 2;
-        remain_hidden_size_start = nn_hidden_size << 2;
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int qq = 0; qq < nn_hidden_size; qq++)
-        {
-            int q = qq * 4;
-
-            const float* gates_data = gates.row(q);
-
-            __m128 _IFOG_4x4_0 = _mm_loadu_ps(gates_data);
-            __m128 _IFOG_4x4_1 = _mm_loadu_ps(gates_data + 4);
-            __m128 _IFOG_4x4_2 = _mm_loadu_ps(gates_data + 8);
-            __m128 _IFOG_4x4_3 = _mm_loadu_ps(gates_data + 12);
+            if (max_jj == 4)
+            {
+                __m128 _IFOG_4x4_0 = _mm_loadu_ps(gates_data);
+                __m128 _IFOG_4x4_1 = _mm_loadu_ps(gates_data + 4);
+                __m128 _IFOG_4x4_2 = _mm_loadu_ps(gates_data + 8);
+                __m128 _IFOG_4x4_3 = _mm_loadu_ps(gates_data + 12);
 
-            _MM_TRANSPOSE4_PS(_IFOG_4x4_0, _IFOG_4x4_1, _IFOG_4x4_2, _IFOG_4x4_3);
+                _MM_TRANSPOSE4_PS(_IFOG_4x4_0, _IFOG_4x4_1, _IFOG_4x4_2, _IFOG_4x4_3);
 
-            __m128 _lstm_I = sigmoid_sse(_IFOG_4x4_0);
-            __m128 _lstm_F = sigmoid_sse(_IFOG_4x4_1);
-            __m128 _lstm_O = sigmoid_sse(_IFOG_4x4_2);
-            __m128 _lstm_G = tanh_sse(_IFOG_4x4_3);
+                __m128 _lstm_I = sigmoid_sse(_IFOG_4x4_0);
+                __m128 _lstm_F = sigmoid_sse(_IFOG_4x4_1);
+                __m128 _lstm_O = sigmoid_sse(_IFOG_4x4_2);
+                __m128 _lstm_G = tanh_sse(_IFOG_4x4_3);
 
-            __m128 _cell2 = _mm_add_ps(_mm_mul_ps(_lstm_F, _mm_loadu_ps(cell_ptr + q)), _mm_mul_ps(_lstm_I, _lstm_G));
-            __m128 _lstm_H = _mm_mul_ps(_lstm_O, tanh_sse(_cell2));
+                __m128 _cell2 = _mm_add_ps(_mm_mul_ps(_lstm_F, _mm_loadu_ps(cell_ptr)), _mm_mul_ps(_lstm_I, _lstm_G));
+                __m128 _lstm_H = _mm_mul_ps(_lstm_O, tanh_sse(_cell2));
 
-            _mm_storeu_ps(cell_ptr + q, _cell2);
+                _mm_storeu_ps(cell_ptr, _cell2);
+                _mm_storeu_ps(outptr, _lstm_H);
 
-            if (num_output == hidden_size)
-            {
-                _mm_storeu_ps(hidden_ptr + q, _lstm_H);
-                _mm_storeu_ps(output_data + q, _lstm_H);
+                continue;
             }
-            else
-            {
-                _mm_storeu_ps(tmp_hidden_ptr + q, _lstm_H);
-            }
-        }
-#else  // __SSE2__
-        remain_hidden_size_start = 0;
 #endif // __SSE2__
-        #pragma omp parallel for num_threads(opt.num_threads)
-        for (int q = remain_hidden_size_start; q < hidden_size; q++)
-        {
-            const float* gates_data = gates.row(q);
-
-            float I = gates_data[0];
-            float F = gates_data[1];
-            float O = gates_data[2];
-            float G = gates_data[3];
+            for (jj = 0; jj < max_jj; jj++)
+            {
+                float I = gates_data[jj * 4];
+                float F = gates_data[jj * 4 + 1];
+                float O = gates_data[jj * 4 + 2];
+                float G = gates_data[jj * 4 + 3];
 
-            I = 1.f / (1.f + expf(-I));
-            F = 1.f / (1.f + expf(-F));
-            O = 1.f / (1.f + expf(-O));
-            G = tanhf(G);
+                I = 1.f / (1.f + expf(-I));
+                F = 1.f / (1.f + expf(-F));
+                O = 1.f / (1.f + expf(-O));
+                G = tanhf(G);
 
-            float cell2 = F * cell_ptr[q] + I * G;
-            float H = O * tanhf(cell2);
+                float cell2 = F * cell_ptr[jj] + I * G;
+                float H = O * tanhf(cell2);
 
-            cell_ptr[q] = cell2;
-            if (num_output == hidden_size)
-            {
-                hidden_ptr[q] = H;
-                output_data[q] = H;
-            }
-            else
-            {
-                tmp_hidden_ptr[q] = H;
+                cell_ptr[jj] = cell2;
+                outptr[jj] = H;
             }
         }
 
         if (num_output != hidden_size)
         {
-            // int nn_num_output = num_output >> 2;
-            // int remain_num_output_start = nn_num_output << 2;
-            // #pragma omp parallel for num_threads(opt.num_threads)
-            // for (int qq = 0; qq < nn_num_output; qq++)
-            // {
-            //     int q = qq * 4;
-            //
-            // }
-            int remain_num_output_start = 0;
             #pragma omp parallel for num_threads(opt.num_threads)
-            for (int q = remain_num_output_start; q < num_output; q++)
+            for (int ii = 0; ii < num_directions * num_output; ii++)
             {
-                const float* hr = weight_hr.row(q);
-                const float* tmp_hidden_ptr = tmp_hidden_state;
+                const int dr = ii / num_output;
+                const int q = ii % num_output;
+
+                const int reverse = direction == 2 ? dr : direction;
+                const int ti = reverse ? T - 1 - t : t;
+
+                const float* hr = weight_hr.channel(dr).row(q);
+                const float* tmp_hidden_ptr = tmp_hidden_state.row(dr);
 
                 float H = 0;
                 for (int i = 0; i < hidden_size; i++)
@@ -552,12 +427,20 @@ static int lstm(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& w
                     H += tmp_hidden_ptr[i] * hr[i];
                 }
 
-                output_data[q] = H;
-                hidden_ptr[q] = H;
+                top_blob.row(ti)[dr * num_output + q] = H;
             }
         }
     }
 
+    // h_T of each direction
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const int reverse = direction == 2 ? dr : direction;
+
+        if (T > 0)
+            memcpy(hidden_state.row(dr), top_blob.row(reverse ? 0 : T - 1) + dr * num_output, num_output * sizeof(float));
+    }
+
     return 0;
 }
 
@@ -575,12 +458,12 @@ int LSTM_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
     int num_directions = direction == 2 ? 2 : 1;
 
     // initial hidden state
-    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    Mat hidden(num_output, num_directions, 4u, opt.workspace_allocator);
     if (hidden.empty())
         return -100;
     hidden.fill(0.f);
 
-    Mat cell(hidden_size, 4u, opt.workspace_allocator);
+    Mat cell(hidden_size, num_directions, 4u, opt.workspace_allocator);
     if (cell.empty())
         return -100;
     cell.fill(0.f);
@@ -589,52 +472,17 @@ int LSTM_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
     if (top_blob.empty())
         return -100;
 
-    // Uni directional
-    if (direction == 0 || direction == 1)
+    // W_xc * x_t + b_c
+    Mat gates_x;
     {
-        int ret = lstm(bottom_blob, top_blob, direction, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden, cell, opt);
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = xc_gemm->forward(bottom_blob, gates_x, opt_b);
         if (ret != 0)
             return ret;
     }
 
-    if (direction == 2)
-    {
-        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
-        if (top_blob_forward.empty())
-            return -100;
-
-        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
-        if (top_blob_reverse.empty())
-            return -100;
-
-        {
-            int ret = lstm(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden, cell, opt);
-            if (ret != 0)
-                return ret;
-        }
-
-        hidden.fill(0.0f);
-        cell.fill(0.0f);
-
-        {
-            int ret = lstm(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden, cell, opt);
-            if (ret != 0)
-                return ret;
-        }
-
-        // concat w
-        for (int i = 0; i < T; i++)
-        {
-            const float* pf = top_blob_forward.row(i);
-            const float* pr = top_blob_reverse.row(i);
-            float* ptr = top_blob.row(i);
-
-            memcpy(ptr, pf, num_output * sizeof(float));
-            memcpy(ptr + num_output, pr, num_output * sizeof(float));
-        }
-    }
-
-    return 0;
+    return lstm(gates_x, top_blob, direction, weight_hc_data_packed, weight_hr_data, hidden, cell, opt);
 }
 
 int LSTM_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
@@ -676,51 +524,19 @@ int LSTM_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     if (top_blob.empty())
         return -100;
 
-    // Uni directional
-    if (direction == 0 || direction == 1)
+    // W_xc * x_t + b_c
+    Mat gates_x;
     {
-        int ret = lstm(bottom_blob, top_blob, direction, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden, cell, opt);
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = xc_gemm->forward(bottom_blob, gates_x, opt_b);
         if (ret != 0)
             return ret;
     }
 
-    if (direction == 2)
-    {
-        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
-        if (top_blob_forward.empty())
-            return -100;
-
-        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
-        if (top_blob_reverse.empty())
-            return -100;
-
-        Mat hidden0 = hidden.row_range(0, 1);
-        Mat cell0 = cell.row_range(0, 1);
-        {
-            int ret = lstm(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
-            if (ret != 0)
-                return ret;
-        }
-
-        Mat hidden1 = hidden.row_range(1, 1);
-        Mat cell1 = cell.row_range(1, 1);
-        {
-            int ret = lstm(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden1, cell1, opt);
-            if (ret != 0)
-                return ret;
-        }
-
-        // concat w
-        for (int i = 0; i < T; i++)
-        {
-            const float* pf = top_blob_forward.row(i);
-            const float* pr = top_blob_reverse.row(i);
-            float* ptr = top_blob.row(i);
-
-            memcpy(ptr, pf, num_output * sizeof(float));
-            memcpy(ptr + num_output, pr, num_output * sizeof(float));
-        }
-    }
+    int ret = lstm(gates_x, top_blob, direction, weight_hc_data_packed, weight_hr_data, hidden, cell, opt);
+    if (ret != 0)
+        return ret;
 
     if (top_blobs.size() == 3)
     {
@@ -740,6 +556,10 @@ int LSTM_x86::create_pipeline_int8(const Option& opt)
 
     lstm_transform_weight_int8(weight_xc_data, weight_xc_data_int8_scales, weight_hc_data, weight_hc_data_int8_scales, bias_c_data, weight_data_tm, weight_data_tm_int8_descales, bias_c_data_packed, size, num_output, num_directions, hidden_size, opt);
 
+    relocate_weight(weight_data_tm, opt);
+    relocate_weight(weight_data_tm_int8_descales, opt);
+    relocate_weight(bias_c_data_packed, opt);
+
     if (opt.lightmode)
     {
         weight_xc_data.release();
@@ -14,6 +14,7 @@ public:
     LSTM_x86();
 
     virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
@@ -27,7 +28,8 @@ protected:
 #endif
 
 public:
-    Mat weight_xc_data_packed;
+    Layer* xc_gemm;
+
     Mat bias_c_data_packed;
     Mat weight_hc_data_packed;
 
@@ -28,6 +28,9 @@ int MatMul_x86::create_pipeline(const Option& opt)
     pd.set(10, -1);    // constant_broadcast_type_C = null
     pd.set(11, 0);     // output_N1M
     pd.set(12, 1);     // output_elempack
+#if NCNN_INT8
+    pd.set(18, int8_scale_term);
+#endif
 
     gemm->load_param(pd);
 
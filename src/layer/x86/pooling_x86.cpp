@@ -5,6 +5,9 @@
 
 #if __SSE2__
 #include <emmintrin.h>
+#if __SSE4_1__
+#include <smmintrin.h>
+#endif
 #if __AVX__
 #include <immintrin.h>
 #endif
@@ -33,6 +36,8 @@ Pooling_x86::Pooling_x86()
 #if __SSE2__
     support_packing = true;
 #endif // __SSE2__
+
+    support_strided_input = true;
 }
 
 int Pooling_x86::create_pipeline(const Option& /*opt*/)
@@ -59,6 +64,11 @@ int Pooling_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
         return Pooling::forward(bottom_blob, top_blob, opt);
     }
 
+#if NCNN_INT8
+    if (bottom_blob.elembits() == 8 && pooling_type == PoolMethod_MAX)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
 #if __SSE2__
     int elempack = bottom_blob.elempack;
     int w = bottom_blob.w;
@@ -815,4 +825,125 @@ int Pooling_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
 #endif
 }
 
+#if NCNN_INT8
+#if __SSE2__
+static inline __m128i max_epi8_sse2(__m128i a, __m128i b)
+{
+#if __SSE4_1__
+    return _mm_max_epi8(a, b);
+#else
+    __m128i _mask = _mm_cmpgt_epi8(a, b);
+    return _mm_or_si128(_mm_and_si128(_mask, a), _mm_andnot_si128(_mask, b));
+#endif
+}
+#endif // __SSE2__
+
+int Pooling_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if __SSE2__
+    if (bottom_blob.elempack == 8)
+    {
+        int w = bottom_blob.w;
+        int h = bottom_blob.h;
+        int channels = bottom_blob.c;
+        size_t elemsize = bottom_blob.elemsize;
+        int elempack = bottom_blob.elempack;
+
+        if (global_pooling)
+        {
+            top_blob.create(channels, elemsize, elempack, opt.blob_allocator);
+            if (top_blob.empty())
+                return -100;
+
+            int size = w * h;
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < channels; q++)
+            {
+                const signed char* ptr = bottom_blob.channel(q);
+
+                __m128i _max = _mm_loadl_epi64((const __m128i*)ptr);
+                for (int i = 0; i < size; i++)
+                {
+                    __m128i _val = _mm_loadl_epi64((const __m128i*)ptr);
+                    _max = max_epi8_sse2(_max, _val);
+                    ptr += 8;
+                }
+
+                signed char* outptr = top_blob;
+                _mm_storel_epi64((__m128i*)(outptr + q * 8), _max);
+            }
+
+            return 0;
+        }
+
+        Mat bottom_blob_bordered;
+        make_padding(bottom_blob, bottom_blob_bordered, opt);
+        if (bottom_blob_bordered.empty())
+            return -100;
+
+        w = bottom_blob_bordered.w;
+        h = bottom_blob_bordered.h;
+
+        int outw = (w - kernel_w) / stride_w + 1;
+        int outh = (h - kernel_h) / stride_h + 1;
+
+        top_blob.create(outw, outh, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const int maxk = kernel_w * kernel_h;
+
+        // kernel offsets
+        std::vector<int> _space_ofs(maxk);
+        int* space_ofs = &_space_ofs[0];
+        {
+            int p1 = 0;
+            int p2 = 0;
+            int gap = w - kernel_w;
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2 * 8;
+                    p1++;
+                    p2++;
+                }
+                p2 += gap;
+            }
+        }
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const Mat m = bottom_blob_bordered.channel(q);
+            signed char* outptr = top_blob.channel(q);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    const signed char* sptr = m.row<const signed char>(i * stride_h) + j * stride_w * 8;
+
+                    __m128i _max = _mm_loadl_epi64((const __m128i*)sptr);
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        __m128i _val = _mm_loadl_epi64((const __m128i*)(sptr + space_ofs[k]));
+                        _max = max_epi8_sse2(_max, _val);
+                    }
+
+                    _mm_storel_epi64((__m128i*)outptr, _max);
+                    outptr += 8;
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __SSE2__
+
+    return Pooling::forward_int8(bottom_blob, top_blob, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
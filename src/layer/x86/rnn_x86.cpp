@@ -0,0 +1,365 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rnn_x86.h"
+
+#include "layer_type.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+RNN_x86::RNN_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+
+    xc_gemm = 0;
+}
+
+int RNN_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        // int8 runs the reference implementation
+        return 0;
+    }
+#endif
+
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output;
+
+#if __AVX__
+    const int packn = 8;
+#else
+    const int packn = 4;
+#endif
+    const int nn_num_output = (num_output + packn - 1) / packn;
+
+    // W_xc * x_t + b_c of all timesteps and directions is one gemm up front
+    // output unit q of direction dr is at dr * nn_num_output * packn + q
+    Mat weight_xc_data_padded(size, nn_num_output * packn * num_directions);
+    if (weight_xc_data_padded.empty())
+        return -100;
+
+    Mat bias_c_data_padded(nn_num_output * packn * num_directions);
+    if (bias_c_data_padded.empty())
+        return -100;
+
+    weight_xc_data_padded.fill(0.f);
+    bias_c_data_padded.fill(0.f);
+
+    weight_hc_data_packed.create(num_output * packn, nn_num_output, num_directions, 4u, opt.weight_allocator);
+    if (weight_hc_data_packed.empty())
+        return -100;
+
+    weight_hc_data_packed.fill(0.f);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const float* bias_c = bias_c_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+
+        Mat weight_hc_data_packed_dr = weight_hc_data_packed.channel(dr);
+
+        for (int q = 0; q < num_output; q++)
+        {
+            const int xc_offset = dr * nn_num_output * packn + q;
+
+            memcpy(weight_xc_data_padded.row(xc_offset), weight_xc.row(q), size * sizeof(float));
+
+            bias_c_data_padded[xc_offset] = bias_c[q];
+
+            const float* weight_hc_ptr = weight_hc.row(q);
+            float* weight_hc_ptr_packed = weight_hc_data_packed_dr.row(q / packn) + q % packn;
+
+            for (int i = 0; i < num_output; i++)
+            {
+                weight_hc_ptr_packed[i * packn] = weight_hc_ptr[i];
+            }
+        }
+    }
+
+    {
+        xc_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+        ncnn::ParamDict pd;
+        pd.set(2, 0);                                      // transA
+        pd.set(3, 1);                                      // transB
+        pd.set(4, 0);                                      // constantA
+        pd.set(5, 1);                                      // constantB
+        pd.set(6, 1);                                      // constantC
+        pd.set(7, 0);                                      // M = T
+        pd.set(8, nn_num_output * packn * num_directions); // N
+        pd.set(9, size);                                   // K
+        pd.set(10, 4);                                     // constant_broadcast_type_C
+        pd.set(11, 0);                                     // output_N1M
+        pd.set(12, 1);                                     // output_elempack
+        xc_gemm->load_param(pd);
+        Mat weights[2];
+        weights[0] = weight_xc_data_padded;
+        weights[1] = bias_c_data_padded;
+        xc_gemm->load_model(ModelBinFromMatArray(weights));
+        xc_gemm->create_pipeline(opt);
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+int RNN_x86::destroy_pipeline(const Option& opt)
+{
+    if (xc_gemm)
+    {
+        xc_gemm->destroy_pipeline(opt);
+        delete xc_gemm;
+        xc_gemm = 0;
+    }
+
+    return 0;
+}
+
+static int rnn(const Mat& gates_x, Mat& top_blob, int direction, const Mat& weight_hc, Mat& hidden_state, const Option& opt)
+{
+    const int T = gates_x.h;
+    const int num_directions = direction == 2 ? 2 : 1;
+
+    const int num_output = top_blob.w / num_directions;
+
+#if __AVX__
+    const int packn = 8;
+#else
+    const int packn = 4;
+#endif
+    const int nn_num_output = (num_output + packn - 1) / packn;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        // all directions run in one parallel region per step
+        // h_{t-1} is read back from the previous output row
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ii = 0; ii < num_directions * nn_num_output; ii++)
+        {
+            const int dr = ii / nn_num_output;
+            const int q = ii % nn_num_output * packn;
+            const int max_jj = std::min(num_output - q, packn);
+
+            const int reverse = direction == 2 ? dr : direction;
+            const int ti = reverse ? T - 1 - t : t;
+
+            const float* hidden_ptr = t == 0 ? hidden_state.row(dr) : top_blob.row(reverse ? ti + 1 : ti - 1) + dr * num_output;
+
+            const float* gates_x_ptr = gates_x.row(ti) + dr * nn_num_output * packn + q;
+            const float* weight_hc_ptr = weight_hc.channel(dr).row(q / packn);
+
+            float* outptr = top_blob.row(ti) + dr * num_output + q;
+
+            // h_t := tanh(W_hc * h_{t-1} + W_xc * x_t + b_c)
+#if __AVX__
+            __m256 _H = _mm256_loadu_ps(gates_x_ptr);
+            __m256 _sum1 = _mm256_setzero_ps();
+
+            int i = 0;
+            for (; i + 1 < num_output; i += 2)
+            {
+                _H = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_ptr), _mm256_broadcast_ss(hidden_ptr + i), _H);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_ptr + 8), _mm256_broadcast_ss(hidden_ptr + i + 1), _sum1);
+
+                weight_hc_ptr += 16;
+            }
+            for (; i < num_output; i++)
+            {
+                _H = _mm256_comp_fmadd_ps(_mm256_loadu_ps(weight_hc_ptr), _mm256_broadcast_ss(hidden_ptr + i), _H);
+
+                weight_hc_ptr += 8;
+            }
+
+            _H = tanh_avx(_mm256_add_ps(_H, _sum1));
+
+            if (max_jj == 8)
+            {
+                _mm256_storeu_ps(outptr, _H);
+            }
+            else
+            {
+                float H[8];
+                _mm256_storeu_ps(H, _H);
+
+                for (int jj = 0; jj < max_jj; jj++)
+                {
+                    outptr[jj] = H[jj];
+                }
+            }
+#elif __SSE2__
+            __m128 _H = _mm_loadu_ps(gates_x_ptr);
+            __m128 _sum1 = _mm_setzero_ps();
+
+            int i = 0;
+            for (; i + 1 < num_output; i += 2)
+            {
+                _H = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr), _mm_load1_ps(hidden_ptr + i), _H);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr + 4), _mm_load1_ps(hidden_ptr + i + 1), _sum1);
+
+                weight_hc_ptr += 8;
+            }
+            for (; i < num_output; i++)
+            {
+                _H = _mm_comp_fmadd_ps(_mm_loadu_ps(weight_hc_ptr), _mm_load1_ps(hidden_ptr + i), _H);
+
+                weight_hc_ptr += 4;
+            }
+
+            _H = tanh_sse(_mm_add_ps(_H, _sum1));
+
+            if (max_jj == 4)
+            {
+                _mm_storeu_ps(outptr, _H);
+            }
+            else
+            {
+                float H[4];
+                _mm_storeu_ps(H, _H);
+
+                for (int jj = 0; jj < max_jj; jj++)
+                {
+                    outptr[jj] = H[jj];
+                }
+            }
+#else
+            for (int jj = 0; jj < max_jj; jj++)
+            {
+                float H = gates_x_ptr[jj];
+
+                for (int i = 0; i < num_output; i++)
+                {
+                    H += weight_hc_ptr[i * packn + jj] * hidden_ptr[i];
+                }
+
+                outptr[jj] = tanhf(H);
+            }
+#endif
+        }
+    }
+
+    // h_T of each direction
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const int reverse = direction == 2 ? dr : direction;
+
+        if (T > 0)
+            memcpy(hidden_state.row(dr), top_blob.row(reverse ? 0 : T - 1) + dr * num_output, num_output * sizeof(float));
+    }
+
+    return 0;
+}
+
+int RNN_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return RNN::forward(bottom_blob, top_blob, opt);
+    }
+#endif
+
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, num_directions, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // W_xc * x_t + b_c
+    Mat gates_x;
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = xc_gemm->forward(bottom_blob, gates_x, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    return rnn(gates_x, top_blob, direction, weight_hc_data_packed, hidden, opt);
+}
+
+int RNN_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return RNN::forward(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // W_xc * x_t + b_c
+    Mat gates_x;
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = xc_gemm->forward(bottom_blob, gates_x, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    int ret = rnn(gates_x, top_blob, direction, weight_hc_data_packed, hidden, opt);
+    if (ret != 0)
+        return ret;
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,231 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "separableconvolution_x86.h"
+
+#include "cpu.h"
+#include "layer_type.h"
+
+namespace ncnn {
+
+SeparableConvolution_x86::SeparableConvolution_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    depthwise = 0;
+    pointwise = 0;
+}
+
+int SeparableConvolution_x86::create_pipeline(const Option& _opt)
+{
+    Option opt = _opt;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    const int maxk = kernel_w * kernel_h;
+    const int channels = depthwise_weight_data_size / maxk;
+
+    {
+        depthwise = ncnn::create_layer_cpu(ncnn::LayerType::ConvolutionDepthWise);
+
+        // set param
+        ncnn::ParamDict pd;
+        pd.set(0, channels); // num_output
+        pd.set(1, kernel_w);
+        pd.set(11, kernel_h);
+        pd.set(2, dilation_w);
+        pd.set(12, dilation_h);
+        pd.set(3, stride_w);
+        pd.set(13, stride_h);
+        pd.set(4, 0);  // pad_w
+        pd.set(14, 0); // pad_h
+        pd.set(5, depthwise_bias_term);
+        pd.set(6, depthwise_weight_data_size);
+        pd.set(7, channels); // group
+        pd.set(9, depthwise_activation_type);
+        pd.set(10, depthwise_activation_params);
+
+        depthwise->load_param(pd);
+
+        // set weights
+        ncnn::Mat weights[2];
+        weights[0] = depthwise_weight_data;
+        weights[1] = depthwise_bias_data;
+
+        depthwise->load_model(ModelBinFromMatArray(weights));
+
+        depthwise->create_pipeline(opt);
+    }
+
+    {
+        pointwise = ncnn::create_layer_cpu(ncnn::LayerType::Convolution);
+
+        // set param
+        ncnn::ParamDict pd;
+        pd.set(0, num_output);
+        pd.set(1, 1);
+        pd.set(5, bias_term);
+        pd.set(6, weight_data_size);
+        pd.set(9, activation_type);
+        pd.set(10, activation_params);
+
+        pointwise->load_param(pd);
+
+        // set weights
+        ncnn::Mat weights[2];
+        weights[0] = weight_data;
+        weights[1] = bias_data;
+
+        pointwise->load_model(ModelBinFromMatArray(weights));
+
+        pointwise->create_pipeline(opt);
+    }
+
+    if (opt.lightmode)
+    {
+        depthwise_weight_data.release();
+        depthwise_bias_data.release();
+        weight_data.release();
+        bias_data.release();
+    }
+
+    return 0;
+}
+
+int SeparableConvolution_x86::destroy_pipeline(const Option& _opt)
+{
+    Option opt = _opt;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    if (depthwise)
+    {
+        depthwise->destroy_pipeline(opt);
+        delete depthwise;
+        depthwise = 0;
+    }
+
+    if (pointwise)
+    {
+        pointwise->destroy_pipeline(opt);
+        delete pointwise;
+        pointwise = 0;
+    }
+
+    return 0;
+}
+
+int SeparableConvolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& _opt) const
+{
+    Option opt = _opt;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c * bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    // resolve the padding of the whole input
+    int pl = std::max(pad_left, 0);
+    int pr = std::max(pad_right, 0);
+    int pt = std::max(pad_top, 0);
+    int pb = std::max(pad_bottom, 0);
+    if (pad_left == -233 || pad_left == -234)
+    {
+        int wpad = kernel_extent_w + (w - 1) / stride_w * stride_w - w;
+        int hpad = kernel_extent_h + (h - 1) / stride_h * stride_h - h;
+        pl = pad_left == -233 ? wpad / 2 : wpad - wpad / 2;
+        pr = wpad - pl;
+        pt = pad_left == -233 ? hpad / 2 : hpad - hpad / 2;
+        pb = hpad - pt;
+    }
+
+    const int outw = (w + pl + pr - kernel_extent_w) / stride_w + 1;
+    const int outh = (h + pt + pb - kernel_extent_h) / stride_h + 1;
+
+    // this is not a fused kernel, the depthwise and pointwise sub-layers run one after the other on bands of output rows
+    // each band has its input, depthwise output and pointwise output within half of L2 together,
+    // so the depthwise feature map never leaves the cache, at the cost of a border copy of the input rows
+    // and a copy of the pointwise output band into top_blob
+    const size_t row_size = ((size_t)(w + pl + pr) * stride_h + outw) * channels * 4u + (size_t)outw * num_output * 4u;
+    const int l2_cache_size = get_cpu_level2_cache_size();
+    int band_h = std::max(1, (int)(l2_cache_size / 2 / row_size));
+    band_h = std::max(band_h, (64 + outw - 1) / outw);
+
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+
+    if (band_h >= outh || pt >= kernel_extent_h || pb >= kernel_extent_h)
+    {
+        Mat bottom_blob_bordered = bottom_blob;
+        if (pl != 0 || pr != 0 || pt != 0 || pb != 0)
+        {
+            copy_make_border(bottom_blob, bottom_blob_bordered, pt, pb, pl, pr, BORDER_CONSTANT, pad_value, opt_b);
+            if (bottom_blob_bordered.empty())
+                return -100;
+        }
+
+        Mat bottom_blob_dw;
+        int ret = depthwise->forward(bottom_blob_bordered, bottom_blob_dw, opt_b);
+        if (ret != 0)
+            return ret;
+
+        return pointwise->forward(bottom_blob_dw, top_blob, opt);
+    }
+
+    for (int y0 = 0; y0 < outh; y0 += band_h)
+    {
+        const int bh = std::min(band_h, outh - y0);
+
+        // input rows of this band in padded coordinates
+        const int py0 = y0 * stride_h;
+        const int py1 = (y0 + bh - 1) * stride_h + kernel_extent_h;
+
+        const int iy0 = std::max(py0 - pt, 0);
+        const int iy1 = std::min(py1 - pt, h);
+        const int band_pt = std::max(pt - py0, 0);
+        const int band_pb = std::max(py1 - pt - h, 0);
+
+        // view of input rows [iy0, iy1) sharing the channel step of bottom_blob
+        Mat bottom_blob_band(w, iy1 - iy0, bottom_blob.c, (unsigned char*)bottom_blob.data + (size_t)w * iy0 * bottom_blob.elemsize, bottom_blob.elemsize, bottom_blob.elempack);
+        bottom_blob_band.cstep = bottom_blob.cstep;
+
+        Mat bottom_blob_band_bordered;
+        copy_make_border(bottom_blob_band, bottom_blob_band_bordered, band_pt, band_pb, pl, pr, BORDER_CONSTANT, pad_value, opt_b);
+        if (bottom_blob_band_bordered.empty())
+            return -100;
+
+        Mat bottom_blob_band_dw;
+        int ret = depthwise->forward(bottom_blob_band_bordered, bottom_blob_band_dw, opt_b);
+        if (ret != 0)
+            return ret;
+
+        Mat top_blob_band;
+        ret = pointwise->forward(bottom_blob_band_dw, top_blob_band, opt_b);
+        if (ret != 0)
+            return ret;
+
+        if (y0 == 0)
+        {
+            top_blob.create(outw, outh, top_blob_band.c, top_blob_band.elemsize, top_blob_band.elempack, opt.blob_allocator);
+            if (top_blob.empty())
+                return -100;
+        }
+
+        const size_t band_size = (size_t)outw * bh * top_blob.elemsize;
+
+        for (int q = 0; q < top_blob.c; q++)
+        {
+            memcpy(top_blob.channel(q).row<unsigned char>(y0), top_blob_band.channel(q), band_size);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
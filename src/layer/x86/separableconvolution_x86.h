@@ -0,0 +1,28 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SEPARABLECONVOLUTION_X86_H
+#define LAYER_SEPARABLECONVOLUTION_X86_H
+
+#include "separableconvolution.h"
+
+namespace ncnn {
+
+class SeparableConvolution_x86 : public SeparableConvolution
+{
+public:
+    SeparableConvolution_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* depthwise;
+    Layer* pointwise;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SEPARABLECONVOLUTION_X86_H
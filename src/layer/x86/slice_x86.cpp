@@ -22,6 +22,11 @@ Slice_x86::Slice_x86()
 int Slice_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     const Mat& bottom_blob = bottom_blobs[0];
+    int elembits = bottom_blob.elembits();
+
+    if (elembits == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+
     int dims = bottom_blob.dims;
     size_t elemsize = bottom_blob.elemsize;
     int elempack = bottom_blob.elempack;
@@ -962,4 +967,45 @@ int Slice_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& t
     return 0;
 }
 
+int Slice_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    int dims = bottom_blob.dims;
+    int elempack = bottom_blob.elempack;
+    int positive_axis = axis < 0 ? dims + axis : axis;
+
+    // slice points along the packed axis are in unpacked elements
+    if (positive_axis == 0)
+        elempack = 1;
+
+    // a packed int8 element is copied as a whole by memcpy, slice it as elempack 1
+    std::vector<Mat> bottom_blobs_unpacked(1);
+    if (bottom_blob.elempack == elempack)
+    {
+        bottom_blobs_unpacked[0] = bottom_blob;
+    }
+    else
+    {
+        Option opt_pack1 = opt;
+        opt_pack1.blob_allocator = opt.workspace_allocator;
+
+        convert_packing(bottom_blob, bottom_blobs_unpacked[0], 1, opt_pack1);
+        if (bottom_blobs_unpacked[0].empty())
+            return -100;
+    }
+
+    bottom_blobs_unpacked[0].elempack = 1;
+
+    int ret = Slice::forward(bottom_blobs_unpacked, top_blobs, opt);
+    if (ret != 0)
+        return ret;
+
+    for (size_t i = 0; i < top_blobs.size(); i++)
+    {
+        top_blobs[i].elempack = elempack;
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
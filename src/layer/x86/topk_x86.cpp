@@ -0,0 +1,522 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "topk_x86.h"
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+#include "cpu.h"
+
+namespace ncnn {
+
+TopK_x86::TopK_x86()
+{
+}
+
+// heap of the selected elements with the worst one on top
+// an element is worse when its value is smaller, or equal with a larger index
+static void topk_sift_down(float* hv, int* hi, int size, int pos)
+{
+    const float v = hv[pos];
+    const int idx = hi[pos];
+
+    for (;;)
+    {
+        int child = pos * 2 + 1;
+        if (child >= size)
+            break;
+
+        if (child + 1 < size && (hv[child + 1] < hv[child] || (hv[child + 1] == hv[child] && hi[child + 1] > hi[child])))
+            child++;
+
+        if (!(hv[child] < v || (hv[child] == v && hi[child] > idx)))
+            break;
+
+        hv[pos] = hv[child];
+        hi[pos] = hi[child];
+        pos = child;
+    }
+
+    hv[pos] = v;
+    hi[pos] = idx;
+}
+
+static void topk_heapify(float* hv, int* hi, int size)
+{
+    for (int j = size / 2 - 1; j >= 0; j--)
+    {
+        topk_sift_down(hv, hi, size, j);
+    }
+}
+
+static NCNN_FORCEINLINE void topk_replace_top(float* hv, int* hi, int size, float v, int idx)
+{
+    hv[0] = v;
+    hi[0] = idx;
+    topk_sift_down(hv, hi, size, 0);
+}
+
+// select the kk largest of ptr[0..n) * sign into the heap hv hi
+// the simd loops only compare against the current heap top and fall back to scalar on hits,
+// which become rare once the heap holds good candidates
+static void topk_select(const float* ptr, int n, int kk, float sign, int index_offset, float* hv, int* hi)
+{
+    for (int j = 0; j < kk; j++)
+    {
+        hv[j] = ptr[j] * sign;
+        hi[j] = index_offset + j;
+    }
+
+    topk_heapify(hv, hi, kk);
+
+    int j = kk;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    {
+        __m512 _sign = _mm512_set1_ps(sign);
+        __m512 _threshold = _mm512_set1_ps(hv[0]);
+        for (; j + 15 < n; j += 16)
+        {
+            __m512 _p = _mm512_mul_ps(_mm512_loadu_ps(ptr + j), _sign);
+            unsigned int mask = _mm512_cmp_ps_mask(_p, _threshold, _CMP_GT_OQ);
+            if (mask == 0)
+                continue;
+
+            for (int b = 0; b < 16; b++)
+            {
+                if (!(mask & (1u << b)))
+                    continue;
+
+                const float v = ptr[j + b] * sign;
+                if (v > hv[0])
+                    topk_replace_top(hv, hi, kk, v, index_offset + j + b);
+            }
+
+            _threshold = _mm512_set1_ps(hv[0]);
+        }
+    }
+#endif // __AVX512F__
+    {
+        __m256 _sign = _mm256_set1_ps(sign);
+        __m256 _threshold = _mm256_set1_ps(hv[0]);
+        for (; j + 7 < n; j += 8)
+        {
+            __m256 _p = _mm256_mul_ps(_mm256_loadu_ps(ptr + j), _sign);
+            int mask = _mm256_movemask_ps(_mm256_cmp_ps(_p, _threshold, _CMP_GT_OQ));
+            if (mask == 0)
+                continue;
+
+            for (int b = 0; b < 8; b++)
+            {
+                if (!(mask & (1 << b)))
+                    continue;
+
+                const float v = ptr[j + b] * sign;
+                if (v > hv[0])
+                    topk_replace_top(hv, hi, kk, v, index_offset + j + b);
+            }
+
+            _threshold = _mm256_set1_ps(hv[0]);
+        }
+    }
+#endif // __AVX__
+    {
+        __m128 _sign = _mm_set1_ps(sign);
+        __m128 _threshold = _mm_set1_ps(hv[0]);
+        for (; j + 3 < n; j += 4)
+        {
+            __m128 _p = _mm_mul_ps(_mm_loadu_ps(ptr + j), _sign);
+            int mask = _mm_movemask_ps(_mm_cmpgt_ps(_p, _threshold));
+            if (mask == 0)
+                continue;
+
+            for (int b = 0; b < 4; b++)
+            {
+                if (!(mask & (1 << b)))
+                    continue;
+
+                const float v = ptr[j + b] * sign;
+                if (v > hv[0])
+                    topk_replace_top(hv, hi, kk, v, index_offset + j + b);
+            }
+
+            _threshold = _mm_set1_ps(hv[0]);
+        }
+    }
+#endif // __SSE2__
+    for (; j < n; j++)
+    {
+        const float v = ptr[j] * sign;
+        if (v > hv[0])
+            topk_replace_top(hv, hi, kk, v, index_offset + j);
+    }
+}
+
+// max and sum of exp(x - max) over ptr[0..n)
+static void topk_softmax_stats(const float* ptr, int n, float& max, float& sum)
+{
+    max = -FLT_MAX;
+    {
+        int j = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _max_avx512 = _mm512_set1_ps(-FLT_MAX);
+        for (; j + 15 < n; j += 16)
+        {
+            _max_avx512 = _mm512_max_ps(_max_avx512, _mm512_loadu_ps(ptr + j));
+        }
+        max = std::max(max, _mm512_comp_reduce_max_ps(_max_avx512));
+#endif // __AVX512F__
+        __m256 _max_avx = _mm256_set1_ps(-FLT_MAX);
+        for (; j + 7 < n; j += 8)
+        {
+            _max_avx = _mm256_max_ps(_max_avx, _mm256_loadu_ps(ptr + j));
+        }
+        max = std::max(max, _mm256_reduce_max_ps(_max_avx));
+#endif // __AVX__
+        __m128 _max = _mm_set1_ps(-FLT_MAX);
+        for (; j + 3 < n; j += 4)
+        {
+            _max = _mm_max_ps(_max, _mm_loadu_ps(ptr + j));
+        }
+        max = std::max(max, _mm_reduce_max_ps(_max));
+#endif // __SSE2__
+        for (; j < n; j++)
+        {
+            max = std::max(max, ptr[j]);
+        }
+    }
+
+    sum = 0.f;
+    {
+        int j = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        __m512 _max_avx512 = _mm512_set1_ps(max);
+        __m512 _sum_avx512 = _mm512_setzero_ps();
+        for (; j + 15 < n; j += 16)
+        {
+            __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(ptr + j), _max_avx512));
+            _sum_avx512 = _mm512_add_ps(_sum_avx512, _p);
+        }
+        sum += _mm512_comp_reduce_add_ps(_sum_avx512);
+#endif // __AVX512F__
+        __m256 _max_avx = _mm256_set1_ps(max);
+        __m256 _sum_avx = _mm256_setzero_ps();
+        for (; j + 7 < n; j += 8)
+        {
+            __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(ptr + j), _max_avx));
+            _sum_avx = _mm256_add_ps(_sum_avx, _p);
+        }
+        sum += _mm256_reduce_add_ps(_sum_avx);
+#endif // __AVX__
+        __m128 _max = _mm_set1_ps(max);
+        __m128 _sum = _mm_setzero_ps();
+        for (; j + 3 < n; j += 4)
+        {
+            __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(ptr + j), _max));
+            _sum = _mm_add_ps(_sum, _p);
+        }
+        sum += _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+        for (; j < n; j++)
+        {
+            sum += expf(ptr[j] - max);
+        }
+    }
+}
+
+static int topk_index_compare(const void* a, const void* b)
+{
+    return *(const int*)a - *(const int*)b;
+}
+
+// write out the selected heap, ptr is the whole row for re-reading values in index order
+static void topk_store(const float* ptr, float* hv, int* hi, int kk, float sign, int sorted, int softmax, float max, float sum, float* outptr, float* indptr, size_t stride)
+{
+    if (sorted)
+    {
+        // heap sort leaves the best element first
+        for (int j = kk - 1; j > 0; j--)
+        {
+            std::swap(hv[0], hv[j]);
+            std::swap(hi[0], hi[j]);
+            topk_sift_down(hv, hi, j, 0);
+        }
+    }
+    else
+    {
+        qsort(hi, kk, sizeof(int), topk_index_compare);
+        for (int j = 0; j < kk; j++)
+        {
+            hv[j] = ptr[hi[j]] * sign;
+        }
+    }
+
+    if (softmax)
+    {
+        const float scale = 1.f / sum;
+        for (int j = 0; j < kk; j++)
+        {
+            outptr[j * stride] = expf(hv[j] * sign - max) * scale;
+        }
+    }
+    else
+    {
+        for (int j = 0; j < kk; j++)
+        {
+            outptr[j * stride] = hv[j] * sign;
+        }
+    }
+
+    if (indptr)
+    {
+        for (int j = 0; j < kk; j++)
+        {
+            indptr[j * stride] = (float)hi[j];
+        }
+    }
+}
+
+int TopK_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const int dims = bottom_blob.dims;
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const int c = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+    if (positive_axis < 0 || positive_axis >= dims)
+        return -1;
+
+    // view the blob as channels x outer x n x inner, n being the axis to select along
+    int channels = 1;
+    int outer = 1;
+    int n = 0;
+    int inner = 1;
+    if (dims >= 3 && positive_axis == 0)
+    {
+        n = c;
+        inner = w * h * d;
+    }
+    else
+    {
+        int shape[3];
+        int shape_dims = 0;
+        if (dims >= 3) channels = c;
+        if (dims == 4) shape[shape_dims++] = d;
+        if (dims >= 2) shape[shape_dims++] = h;
+        shape[shape_dims++] = w;
+
+        const int shape_axis = dims >= 3 ? positive_axis - 1 : positive_axis;
+        for (int i = 0; i < shape_axis; i++)
+            outer *= shape[i];
+        n = shape[shape_axis];
+        for (int i = shape_axis + 1; i < shape_dims; i++)
+            inner *= shape[i];
+    }
+
+    const int kk = std::min(k, n);
+    if (kk < 1)
+        return -1;
+
+    int outw = (positive_axis == dims - 1) ? kk : w;
+    int outh = (dims >= 2 && positive_axis == dims - 2) ? kk : h;
+    int outd = (dims == 4 && positive_axis == 1) ? kk : d;
+    int outc = (dims >= 3 && positive_axis == 0) ? kk : c;
+
+    for (size_t b = 0; b < top_blobs.size(); b++)
+    {
+        Mat& top_blob = top_blobs[b];
+        if (dims == 1)
+            top_blob.create(outw, elemsize, opt.blob_allocator);
+        if (dims == 2)
+            top_blob.create(outw, outh, elemsize, opt.blob_allocator);
+        if (dims == 3)
+            top_blob.create(outw, outh, outc, elemsize, opt.blob_allocator);
+        if (dims == 4)
+            top_blob.create(outw, outh, outd, outc, elemsize, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+    }
+
+    const bool channel_axis = dims >= 3 && positive_axis == 0;
+    const size_t bottom_stride = channel_axis ? bottom_blob.cstep : inner;
+    const size_t top_stride = channel_axis ? top_blobs[0].cstep : inner;
+    const bool contiguous = bottom_stride == 1;
+
+    const float sign = largest ? 1.f : -1.f;
+    const int rows = channels * outer * inner;
+
+    // a few long rows, split each row across threads and merge the partial selections
+    const int split_min_size = 16384;
+    const int nsplit = std::min(opt.num_threads, n / std::max(split_min_size, kk));
+    if (rows < opt.num_threads && nsplit > 1)
+    {
+        Mat row_data;
+        if (!contiguous)
+        {
+            row_data.create(n, 4u, opt.workspace_allocator);
+            if (row_data.empty())
+                return -100;
+        }
+
+        Mat candidates(kk * 2, nsplit, 4u, opt.workspace_allocator);
+        Mat stats(2, nsplit, 4u, opt.workspace_allocator);
+        Mat heap(kk * 2, 4u, opt.workspace_allocator);
+        if (candidates.empty() || stats.empty() || heap.empty())
+            return -100;
+
+        const int split_size = (n + nsplit - 1) / nsplit;
+
+        for (int r = 0; r < rows; r++)
+        {
+            const int q = r / (outer * inner);
+            const int o = r % (outer * inner) / inner;
+            const int i = r % inner;
+
+            const float* ptr = channel_axis ? (const float*)bottom_blob + i : (const float*)bottom_blob + q * bottom_blob.cstep + (size_t)o * n * inner + i;
+            const size_t top_offset = channel_axis ? i : q * top_blobs[0].cstep + (size_t)o * kk * inner + i;
+
+            if (!contiguous)
+            {
+                float* row_ptr = row_data;
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int j = 0; j < n; j++)
+                {
+                    row_ptr[j] = ptr[j * bottom_stride];
+                }
+
+                ptr = row_data;
+            }
+
+            #pragma omp parallel for num_threads(nsplit)
+            for (int s = 0; s < nsplit; s++)
+            {
+                const int start = s * split_size;
+                const int size = std::min(split_size, n - start);
+                const int split_kk = std::min(kk, size);
+
+                float* hv = candidates.row(s);
+                int* hi = (int*)candidates.row(s) + kk;
+
+                topk_select(ptr + start, size, split_kk, sign, start, hv, hi);
+
+                if (softmax)
+                {
+                    float* stats_ptr = stats.row(s);
+                    topk_softmax_stats(ptr + start, size, stats_ptr[0], stats_ptr[1]);
+                }
+            }
+
+            // merge
+            float* hv = heap;
+            int* hi = (int*)heap + kk;
+            memcpy(hv, candidates.row(0), kk * sizeof(float));
+            memcpy(hi, (const int*)candidates.row(0) + kk, kk * sizeof(int));
+            topk_heapify(hv, hi, kk);
+            for (int s = 1; s < nsplit; s++)
+            {
+                const int split_kk = std::min(kk, n - s * split_size);
+
+                const float* cv = candidates.row(s);
+                const int* ci = (const int*)candidates.row(s) + kk;
+                for (int j = 0; j < split_kk; j++)
+                {
+                    if (cv[j] > hv[0] || (cv[j] == hv[0] && ci[j] < hi[0]))
+                        topk_replace_top(hv, hi, kk, cv[j], ci[j]);
+                }
+            }
+
+            float max = -FLT_MAX;
+            float sum = 0.f;
+            if (softmax)
+            {
+                for (int s = 0; s < nsplit; s++)
+                {
+                    max = std::max(max, stats.row(s)[0]);
+                }
+                for (int s = 0; s < nsplit; s++)
+                {
+                    sum += stats.row(s)[1] * expf(stats.row(s)[0] - max);
+                }
+            }
+
+            float* outptr = (float*)top_blobs[0] + top_offset;
+            float* indptr = top_blobs.size() > 1 ? (float*)top_blobs[1] + top_offset : 0;
+            topk_store(ptr, hv, hi, kk, sign, sorted, softmax, max, sum, outptr, indptr, top_stride);
+        }
+
+        return 0;
+    }
+
+    // per thread heap and gathered row
+    const int scratch_size = kk * 2 + (contiguous ? 0 : n);
+    Mat scratch(scratch_size, opt.num_threads, 4u, opt.workspace_allocator);
+    if (scratch.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int r = 0; r < rows; r++)
+    {
+        const int q = r / (outer * inner);
+        const int o = r % (outer * inner) / inner;
+        const int i = r % inner;
+
+        const float* ptr = channel_axis ? (const float*)bottom_blob + i : (const float*)bottom_blob + q * bottom_blob.cstep + (size_t)o * n * inner + i;
+        const size_t top_offset = channel_axis ? i : q * top_blobs[0].cstep + (size_t)o * kk * inner + i;
+
+        float* hv = scratch.row(get_omp_thread_num());
+        int* hi = (int*)hv + kk;
+
+        if (!contiguous)
+        {
+            float* row_ptr = hv + kk * 2;
+            for (int j = 0; j < n; j++)
+            {
+                row_ptr[j] = ptr[j * bottom_stride];
+            }
+
+            ptr = row_ptr;
+        }
+
+        topk_select(ptr, n, kk, sign, 0, hv, hi);
+
+        float max = -FLT_MAX;
+        float sum = 0.f;
+        if (softmax)
+        {
+            topk_softmax_stats(ptr, n, max, sum);
+        }
+
+        float* outptr = (float*)top_blobs[0] + top_offset;
+        float* indptr = top_blobs.size() > 1 ? (float*)top_blobs[1] + top_offset : 0;
+        topk_store(ptr, hv, hi, kk, sign, sorted, softmax, max, sum, outptr, indptr, top_stride);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
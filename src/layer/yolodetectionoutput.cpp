@@ -317,4 +317,15 @@ int YoloDetectionOutput::forward_inplace(std::vector<Mat>& bottom_top_blobs, con
     return 0;
 }
 
+int YoloDetectionOutput::infer_shape(const std::vector<Mat>& /*bottom_blob_shapes*/, std::vector<Mat>& top_blob_shapes) const
+{
+    // detection count depends on blob values
+    for (size_t i = 0; i < top_blob_shapes.size(); i++)
+    {
+        top_blob_shapes[i] = Mat();
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -179,6 +179,10 @@ public:
     bool empty() const;
     size_t total() const;
 
+    // channel step differs from a newly created mat of the same shape
+    // such as a view of some rows in each channel, use channel(q) to walk it
+    bool is_strided() const;
+
     // bits per element
     int elembits() const;
 
@@ -1221,6 +1225,14 @@ NCNN_FORCEINLINE size_t Mat::total() const
     return cstep * c;
 }
 
+NCNN_FORCEINLINE bool Mat::is_strided() const
+{
+    if (dims < 3)
+        return false;
+
+    return cstep != alignSize((size_t)w * h * d * elemsize, 16) / elemsize;
+}
+
 NCNN_FORCEINLINE int Mat::elembits() const
 {
     return elempack ? static_cast<int>(elemsize * 8) / elempack : 0;
@@ -9,6 +9,9 @@
 #include <arm_neon.h>
 #endif // __ARM_NEON
 #include "platform.h"
+#if __SSE2__
+#include "mat_pixel_x86.h"
+#endif // __SSE2__
 
 namespace ncnn {
 
@@ -35,6 +38,13 @@ static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m,
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = from_pixels_c3_x86(rgb, w, ptr0, ptr1, ptr2);
+        int remain = w - nn;
+        rgb += nn * 3;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -149,6 +159,13 @@ static void to_rgb(const Mat& m, unsigned char* rgb, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c3_x86(ptr0, ptr1, ptr2, w, rgb);
+        int remain = w - nn;
+        rgb += nn * 3;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -217,6 +234,11 @@ static int from_gray(const unsigned char* gray, int w, int h, int stride, Mat& m
 #if __ARM_NEON
         int nn = w >> 4;
         int remain = w - (nn << 4);
+#elif __SSE2__
+        int nn = from_pixels_c1_x86(gray, w, ptr);
+        int remain = w - nn;
+        gray += nn;
+        ptr += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -308,6 +330,11 @@ static void to_gray(const Mat& m, unsigned char* gray, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c1_x86(ptr, w, gray);
+        int remain = w - nn;
+        gray += nn;
+        ptr += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -364,6 +391,14 @@ static int from_rgba(const unsigned char* rgba, int w, int h, int stride, Mat& m
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = from_pixels_c4_x86(rgba, w, ptr0, ptr1, ptr2, ptr3);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -495,6 +530,14 @@ static void to_rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c4_x86(ptr0, ptr1, ptr2, ptr3, w, rgba);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -572,6 +615,13 @@ static int from_rgb2bgr(const unsigned char* rgb, int w, int h, int stride, Mat&
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = from_pixels_c3_x86(rgb, w, ptr2, ptr1, ptr0);
+        int remain = w - nn;
+        rgb += nn * 3;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -686,6 +736,13 @@ static void to_bgr2rgb(const Mat& m, unsigned char* rgb, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c3_x86(ptr2, ptr1, ptr0, w, rgb);
+        int remain = w - nn;
+        rgb += nn * 3;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -873,6 +930,13 @@ static void to_rgb2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c4_x86(ptr0, ptr1, ptr2, 0, w, rgba);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1063,6 +1127,13 @@ static void to_bgr2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c4_x86(ptr2, ptr1, ptr0, 0, w, rgba);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1332,6 +1403,13 @@ static int from_rgba2rgb(const unsigned char* rgba, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = from_pixels_c4_x86(rgba, w, ptr0, ptr1, ptr2, 0);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1445,6 +1523,13 @@ static int from_rgba2bgr(const unsigned char* rgba, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = from_pixels_c4_x86(rgba, w, ptr2, ptr1, ptr0, 0);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1660,6 +1745,14 @@ static int from_rgba2bgra(const unsigned char* rgba, int w, int h, int stride, M
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = from_pixels_c4_x86(rgba, w, ptr2, ptr1, ptr0, ptr3);
+        int remain = w - nn;
+        rgba += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1791,6 +1884,14 @@ static void to_rgba2bgra(const Mat& m, unsigned char* bgra, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = to_pixels_c4_x86(ptr2, ptr1, ptr0, ptr3, w, bgra);
+        int remain = w - nn;
+        bgra += nn * 4;
+        ptr0 += nn;
+        ptr1 += nn;
+        ptr2 += nn;
+        ptr3 += nn;
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -8,6 +8,9 @@
 #include <limits.h>
 
 #include "platform.h"
+#if __SSE2__
+#include "mat_pixel_x86.h"
+#endif // __SSE2__
 
 namespace ncnn {
 
@@ -967,7 +970,15 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 
                 dst0 += 3 * 8;
 #else
-                for (int xi = 0; xi < 8; xi++)
+                int xi = 0;
+#if __SSE2__
+                if (warpaffine_bilinear_c3_inside8_x86(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, dst0))
+                {
+                    xi = 8;
+                    dst0 += 3 * 8;
+                }
+#endif // __SSE2__
+                for (; xi < 8; xi++)
                 {
                     int X = X0 + adelta[x + xi];
                     int Y = Y0 + bdelta[x + xi];
@@ -9,6 +9,9 @@
 #include <arm_neon.h>
 #endif // __ARM_NEON
 #include "platform.h"
+#if __SSE2__
+#include "mat_pixel_x86.h"
+#endif // __SSE2__
 
 namespace ncnn {
 
@@ -57,6 +60,12 @@ static void vresize_two(const short* rows0p, const short* rows1p, int wsize, uns
     }
 #endif // __ARM_NEON
 #if __SSE2__
+    dx = vresize_two_x86(rows0p, rows1p, wsize, Dp0, Dp1, b0, b1, b2, b3);
+    Dp0 += dx;
+    Dp1 += dx;
+    rows0p += dx;
+    rows1p += dx;
+
     __m128i _b0 = _mm_set1_epi16(b0);
     __m128i _b1 = _mm_set1_epi16(b1);
     __m128i _b2 = _mm_set1_epi16(b2);
@@ -146,6 +155,11 @@ static void vresize_one(const short* rows0p, const short* rows1p, int wsize, uns
     }
 #endif // __ARM_NEON
 #if __SSE2__
+    dx = vresize_one_x86(rows0p, rows1p, wsize, Dp, b0, b1);
+    Dp += dx;
+    rows0p += dx;
+    rows1p += dx;
+
     __m128i _b0 = _mm_set1_epi16(b0);
     __m128i _b1 = _mm_set1_epi16(b1);
     __m128i _v2 = _mm_set1_epi16(2);
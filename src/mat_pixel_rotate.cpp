@@ -6,6 +6,9 @@
 #include <arm_neon.h>
 #endif // __ARM_NEON
 #include "platform.h"
+#if __SSE2__
+#include "mat_pixel_x86.h"
+#endif // __SSE2__
 
 namespace ncnn {
 
@@ -743,6 +746,11 @@ static void kanna_rotate_2_c3(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 3;
+#elif __SSE2__
+        int nn = kanna_rotate_reverse_c3_x86(src0, srcw, dst0);
+        int remain = srcw - nn;
+        src0 += nn * 3;
+        dst0 -= nn * 3;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -1086,6 +1094,11 @@ static void kanna_rotate_3_c3(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 3;
+#elif __SSE2__
+        int nn = kanna_rotate_reverse_c3_x86(src0, srcw, dst0);
+        int remain = srcw - nn;
+        src0 += nn * 3;
+        dst0 -= nn * 3;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -2420,6 +2433,30 @@ static void kanna_rotate_5_c3(const unsigned char* src, int srcw, int srch, int
         src0 += srcwgap + 7 * srcstride;
     }
 #endif // __ARM_NEON
+#if __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        unsigned char* dst0 = dst + y * 3;
+
+        int x = kanna_rotate_transpose_c3_x86(src0, srcstride, srcw, dst0, stride);
+        for (; x < srcw; x++)
+        {
+            const unsigned char* s0 = src0 + x * 3;
+            unsigned char* d0 = dst0 + x * stride;
+            for (int i = 0; i < 8; i++)
+            {
+                d0[0] = s0[0];
+                d0[1] = s0[1];
+                d0[2] = s0[2];
+
+                s0 += srcstride;
+                d0 += 3;
+            }
+        }
+
+        src0 += 8 * srcstride;
+    }
+#endif // __SSE2__
     for (; y < srch; y++)
     {
         unsigned char* dst0 = dst + y * 3;
@@ -3470,6 +3507,33 @@ static void kanna_rotate_6_c3(const unsigned char* src, int srcw, int srch, int
         src0 += srcwgap + 7 * srcstride;
     }
 #endif // __ARM_NEON
+#if __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        unsigned char* dst0 = dstend - y * 3 - 8 * 3;
+
+        // the bottom row of the strip goes first
+        const unsigned char* src7 = src0 + 7 * srcstride;
+
+        int x = kanna_rotate_transpose_c3_x86(src7, -srcstride, srcw, dst0, stride);
+        for (; x < srcw; x++)
+        {
+            const unsigned char* s0 = src7 + x * 3;
+            unsigned char* d0 = dst0 + x * stride;
+            for (int i = 0; i < 8; i++)
+            {
+                d0[0] = s0[0];
+                d0[1] = s0[1];
+                d0[2] = s0[2];
+
+                s0 -= srcstride;
+                d0 += 3;
+            }
+        }
+
+        src0 += 8 * srcstride;
+    }
+#endif // __SSE2__
     for (; y < srch; y++)
     {
         unsigned char* dst0 = dstend - y * 3 - 3;
@@ -4523,6 +4587,33 @@ static void kanna_rotate_7_c3(const unsigned char* src, int srcw, int srch, int
         src0 += srcwgap + 7 * srcstride;
     }
 #endif // __ARM_NEON
+#if __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        unsigned char* dst0 = dstend - y * 3 - 8 * 3;
+
+        // the bottom row of the strip goes first
+        const unsigned char* src7 = src0 + 7 * srcstride;
+
+        int x = kanna_rotate_transpose_c3_x86(src7, -srcstride, srcw, dst0, -stride);
+        for (; x < srcw; x++)
+        {
+            const unsigned char* s0 = src7 + x * 3;
+            unsigned char* d0 = dst0 - x * stride;
+            for (int i = 0; i < 8; i++)
+            {
+                d0[0] = s0[0];
+                d0[1] = s0[1];
+                d0[2] = s0[2];
+
+                s0 -= srcstride;
+                d0 += 3;
+            }
+        }
+
+        src0 += 8 * srcstride;
+    }
+#endif // __SSE2__
     for (; y < srch; y++)
     {
         unsigned char* dst0 = dstend - y * 3 - 3;
@@ -5576,6 +5667,30 @@ static void kanna_rotate_8_c3(const unsigned char* src, int srcw, int srch, int
         src0 += srcwgap + 7 * srcstride;
     }
 #endif // __ARM_NEON
+#if __SSE2__
+    for (; y + 7 < srch; y += 8)
+    {
+        unsigned char* dst0 = dstend + y * 3;
+
+        int x = kanna_rotate_transpose_c3_x86(src0, srcstride, srcw, dst0, -stride);
+        for (; x < srcw; x++)
+        {
+            const unsigned char* s0 = src0 + x * 3;
+            unsigned char* d0 = dst0 - x * stride;
+            for (int i = 0; i < 8; i++)
+            {
+                d0[0] = s0[0];
+                d0[1] = s0[1];
+                d0[2] = s0[2];
+
+                s0 += srcstride;
+                d0 += 3;
+            }
+        }
+
+        src0 += 8 * srcstride;
+    }
+#endif // __SSE2__
     for (; y < srch; y++)
     {
         unsigned char* dst0 = dstend + y * 3;
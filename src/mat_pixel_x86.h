@@ -0,0 +1,748 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_MAT_PIXEL_X86_H
+#define NCNN_MAT_PIXEL_X86_H
+
+// x86 kernels shared by the mat_pixel sources
+// each kernel handles the leading part of a row and returns the count done, the caller finishes the tail
+// the base build dispatches to the avx2 / avx512 builds of this file at runtime
+
+#include "cpu.h"
+#include "mat.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __SSSE3__
+#include <tmmintrin.h>
+#endif
+#if __AVX__
+#include <immintrin.h>
+#endif
+
+namespace ncnn {
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+#if NCNN_PIXEL
+int from_pixels_c1_x86_avx512(const unsigned char* p, int size, float* ptr0);
+int from_pixels_c3_x86_avx512(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2);
+int from_pixels_c4_x86_avx512(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2, float* ptr3);
+int to_pixels_c1_x86_avx512(const float* ptr0, int size, unsigned char* p);
+int to_pixels_c3_x86_avx512(const float* ptr0, const float* ptr1, const float* ptr2, int size, unsigned char* p);
+int to_pixels_c4_x86_avx512(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, int size, unsigned char* p);
+int vresize_two_x86_avx512(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp0, unsigned char* Dp1, short b0, short b1, short b2, short b3);
+int vresize_one_x86_avx512(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp, short b0, short b1);
+#endif // NCNN_PIXEL
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+#if NCNN_PIXEL
+int from_pixels_c1_x86_avx2(const unsigned char* p, int size, float* ptr0);
+int from_pixels_c3_x86_avx2(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2);
+int from_pixels_c4_x86_avx2(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2, float* ptr3);
+int to_pixels_c1_x86_avx2(const float* ptr0, int size, unsigned char* p);
+int to_pixels_c3_x86_avx2(const float* ptr0, const float* ptr1, const float* ptr2, int size, unsigned char* p);
+int to_pixels_c4_x86_avx2(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, int size, unsigned char* p);
+int vresize_two_x86_avx2(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp0, unsigned char* Dp1, short b0, short b1, short b2, short b3);
+int vresize_one_x86_avx2(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp, short b0, short b1);
+#endif // NCNN_PIXEL
+#if NCNN_PIXEL_AFFINE
+int warpaffine_bilinear_c3_inside8_x86_avx2(const unsigned char* src0, int srcstride, int X0, int Y0, const int* adelta, const int* bdelta, unsigned char* dst0);
+#endif // NCNN_PIXEL_AFFINE
+#if NCNN_PIXEL_ROTATE
+int kanna_rotate_reverse_c3_x86_avx2(const unsigned char* src0, int srcw, unsigned char* dst0);
+int kanna_rotate_transpose_c3_x86_avx2(const unsigned char* src0, int src_step, int srcw, unsigned char* dst0, int dst_step);
+#endif // NCNN_PIXEL_ROTATE
+#endif
+
+#if NCNN_PIXEL
+static inline void store_u8x16_as_float(__m128i _v, float* ptr)
+{
+#if __AVX512F__
+    _mm512_storeu_ps(ptr, _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_v)));
+#elif __AVX2__
+    _mm256_storeu_ps(ptr, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_v)));
+    _mm256_storeu_ps(ptr + 8, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpackhi_epi64(_v, _v))));
+#else
+    __m128i _zero = _mm_setzero_si128();
+    __m128i _v16l = _mm_unpacklo_epi8(_v, _zero);
+    __m128i _v16h = _mm_unpackhi_epi8(_v, _zero);
+    _mm_storeu_ps(ptr, _mm_cvtepi32_ps(_mm_unpacklo_epi16(_v16l, _zero)));
+    _mm_storeu_ps(ptr + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(_v16l, _zero)));
+    _mm_storeu_ps(ptr + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(_v16h, _zero)));
+    _mm_storeu_ps(ptr + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(_v16h, _zero)));
+#endif
+}
+
+// truncate and saturate 16 floats to uint8, the same as the scalar SATURATE_CAST_UCHAR
+static inline __m128i float2uint8_x16(const float* ptr)
+{
+#if __AVX512F__
+    __m512i _v = _mm512_cvttps_epi32(_mm512_loadu_ps(ptr));
+    return _mm512_cvtusepi32_epi8(_mm512_max_epi32(_v, _mm512_setzero_si512()));
+#elif __AVX2__
+    __m256i _v0 = _mm256_cvttps_epi32(_mm256_loadu_ps(ptr));
+    __m256i _v1 = _mm256_cvttps_epi32(_mm256_loadu_ps(ptr + 8));
+    __m256i _v16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(_v0, _v1), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm_packus_epi16(_mm256_castsi256_si128(_v16), _mm256_extracti128_si256(_v16, 1));
+#else
+    __m128i _v0 = _mm_cvttps_epi32(_mm_loadu_ps(ptr));
+    __m128i _v1 = _mm_cvttps_epi32(_mm_loadu_ps(ptr + 4));
+    __m128i _v2 = _mm_cvttps_epi32(_mm_loadu_ps(ptr + 8));
+    __m128i _v3 = _mm_cvttps_epi32(_mm_loadu_ps(ptr + 12));
+    return _mm_packus_epi16(_mm_packs_epi32(_v0, _v1), _mm_packs_epi32(_v2, _v3));
+#endif
+}
+
+#if !__SSSE3__
+static inline void unpack_u8x16_float(__m128i _v, __m128& _f0, __m128& _f1, __m128& _f2, __m128& _f3)
+{
+    __m128i _zero = _mm_setzero_si128();
+    __m128i _v16l = _mm_unpacklo_epi8(_v, _zero);
+    __m128i _v16h = _mm_unpackhi_epi8(_v, _zero);
+    _f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_v16l, _zero));
+    _f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_v16l, _zero));
+    _f2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_v16h, _zero));
+    _f3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_v16h, _zero));
+}
+
+// r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3  ->  r0 r1 r2 r3 | g0 g1 g2 g3 | b0 b1 b2 b3
+static inline void deinterleave_c3_ps(__m128 _a, __m128 _b, __m128 _c, __m128& _r, __m128& _g, __m128& _bb)
+{
+    _r = _mm_shuffle_ps(_mm_shuffle_ps(_a, _a, _MM_SHUFFLE(0, 3, 0, 0)), _mm_shuffle_ps(_b, _c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+    _g = _mm_shuffle_ps(_mm_shuffle_ps(_a, _b, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(_b, _c, _MM_SHUFFLE(0, 2, 0, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    _bb = _mm_shuffle_ps(_mm_shuffle_ps(_a, _b, _MM_SHUFFLE(0, 1, 0, 2)), _mm_shuffle_ps(_c, _c, _MM_SHUFFLE(0, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// the inverse of deinterleave_c3_ps
+static inline void interleave_c3_ps(__m128 _r, __m128 _g, __m128 _b, __m128& _x, __m128& _y, __m128& _z)
+{
+    _x = _mm_shuffle_ps(_mm_shuffle_ps(_r, _g, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(_b, _r, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    _y = _mm_shuffle_ps(_mm_shuffle_ps(_g, _b, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(_r, _g, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+    _z = _mm_shuffle_ps(_mm_shuffle_ps(_b, _r, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(_g, _b, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+#endif // !__SSSE3__
+
+static inline int from_pixels_c1_x86(const unsigned char* p, int size, float* ptr0)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return from_pixels_c1_x86_avx512(p, size, ptr0);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return from_pixels_c1_x86_avx2(p, size, ptr0);
+#endif
+
+    int i = 0;
+    for (; i + 15 < size; i += 16)
+    {
+        store_u8x16_as_float(_mm_loadu_si128((const __m128i*)(p + i)), ptr0 + i);
+    }
+
+    return i;
+}
+
+static inline int from_pixels_c3_x86(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return from_pixels_c3_x86_avx512(p, size, ptr0, ptr1, ptr2);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return from_pixels_c3_x86_avx2(p, size, ptr0, ptr1, ptr2);
+#endif
+
+    int i = 0;
+#if __SSSE3__
+    const __m128i _r0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _r1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+    const __m128i _r2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+    const __m128i _g0 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _g1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+    const __m128i _g2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+    const __m128i _b0 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _b1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+    const __m128i _b2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+    for (; i + 15 < size; i += 16)
+    {
+        __m128i _p0 = _mm_loadu_si128((const __m128i*)p);
+        __m128i _p1 = _mm_loadu_si128((const __m128i*)(p + 16));
+        __m128i _p2 = _mm_loadu_si128((const __m128i*)(p + 32));
+
+        __m128i _r = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(_p0, _r0), _mm_shuffle_epi8(_p1, _r1)), _mm_shuffle_epi8(_p2, _r2));
+        __m128i _g = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(_p0, _g0), _mm_shuffle_epi8(_p1, _g1)), _mm_shuffle_epi8(_p2, _g2));
+        __m128i _b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(_p0, _b0), _mm_shuffle_epi8(_p1, _b1)), _mm_shuffle_epi8(_p2, _b2));
+
+        store_u8x16_as_float(_r, ptr0 + i);
+        store_u8x16_as_float(_g, ptr1 + i);
+        store_u8x16_as_float(_b, ptr2 + i);
+
+        p += 48;
+    }
+#else
+    for (; i + 15 < size; i += 16)
+    {
+        __m128 _f[12];
+        unpack_u8x16_float(_mm_loadu_si128((const __m128i*)p), _f[0], _f[1], _f[2], _f[3]);
+        unpack_u8x16_float(_mm_loadu_si128((const __m128i*)(p + 16)), _f[4], _f[5], _f[6], _f[7]);
+        unpack_u8x16_float(_mm_loadu_si128((const __m128i*)(p + 32)), _f[8], _f[9], _f[10], _f[11]);
+
+        for (int k = 0; k < 4; k++)
+        {
+            __m128 _r;
+            __m128 _g;
+            __m128 _b;
+            deinterleave_c3_ps(_f[k * 3], _f[k * 3 + 1], _f[k * 3 + 2], _r, _g, _b);
+            _mm_storeu_ps(ptr0 + i + k * 4, _r);
+            _mm_storeu_ps(ptr1 + i + k * 4, _g);
+            _mm_storeu_ps(ptr2 + i + k * 4, _b);
+        }
+
+        p += 48;
+    }
+#endif // __SSSE3__
+
+    return i;
+}
+
+// ptr3 may be null to drop the 4th channel
+static inline int from_pixels_c4_x86(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2, float* ptr3)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return from_pixels_c4_x86_avx512(p, size, ptr0, ptr1, ptr2, ptr3);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return from_pixels_c4_x86_avx2(p, size, ptr0, ptr1, ptr2, ptr3);
+#endif
+
+    int i = 0;
+#if __SSSE3__
+    const __m128i _mask = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    for (; i + 15 < size; i += 16)
+    {
+        __m128i _p0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)p), _mask);
+        __m128i _p1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 16)), _mask);
+        __m128i _p2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 32)), _mask);
+        __m128i _p3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(p + 48)), _mask);
+
+        __m128i _t0 = _mm_unpacklo_epi32(_p0, _p1);
+        __m128i _t1 = _mm_unpacklo_epi32(_p2, _p3);
+        __m128i _t2 = _mm_unpackhi_epi32(_p0, _p1);
+        __m128i _t3 = _mm_unpackhi_epi32(_p2, _p3);
+
+        store_u8x16_as_float(_mm_unpacklo_epi64(_t0, _t1), ptr0 + i);
+        store_u8x16_as_float(_mm_unpackhi_epi64(_t0, _t1), ptr1 + i);
+        store_u8x16_as_float(_mm_unpacklo_epi64(_t2, _t3), ptr2 + i);
+        if (ptr3)
+            store_u8x16_as_float(_mm_unpackhi_epi64(_t2, _t3), ptr3 + i);
+
+        p += 64;
+    }
+#else
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _r;
+        __m128 _g;
+        __m128 _b;
+        __m128 _a;
+        unpack_u8x16_float(_mm_loadu_si128((const __m128i*)p), _r, _g, _b, _a);
+        _MM_TRANSPOSE4_PS(_r, _g, _b, _a);
+        _mm_storeu_ps(ptr0 + i, _r);
+        _mm_storeu_ps(ptr1 + i, _g);
+        _mm_storeu_ps(ptr2 + i, _b);
+        if (ptr3)
+            _mm_storeu_ps(ptr3 + i, _a);
+
+        p += 16;
+    }
+#endif // __SSSE3__
+
+    return i;
+}
+
+static inline int to_pixels_c1_x86(const float* ptr0, int size, unsigned char* p)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return to_pixels_c1_x86_avx512(ptr0, size, p);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return to_pixels_c1_x86_avx2(ptr0, size, p);
+#endif
+
+    int i = 0;
+    for (; i + 15 < size; i += 16)
+    {
+        _mm_storeu_si128((__m128i*)(p + i), float2uint8_x16(ptr0 + i));
+    }
+
+    return i;
+}
+
+static inline int to_pixels_c3_x86(const float* ptr0, const float* ptr1, const float* ptr2, int size, unsigned char* p)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return to_pixels_c3_x86_avx512(ptr0, ptr1, ptr2, size, p);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return to_pixels_c3_x86_avx2(ptr0, ptr1, ptr2, size, p);
+#endif
+
+    int i = 0;
+#if __SSSE3__
+    const __m128i _r0 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+    const __m128i _g0 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+    const __m128i _b0 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+    const __m128i _r1 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+    const __m128i _g1 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+    const __m128i _b1 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+    const __m128i _r2 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+    const __m128i _g2 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+    const __m128i _b2 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+    for (; i + 15 < size; i += 16)
+    {
+        __m128i _r = float2uint8_x16(ptr0 + i);
+        __m128i _g = float2uint8_x16(ptr1 + i);
+        __m128i _b = float2uint8_x16(ptr2 + i);
+
+        __m128i _p0 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(_r, _r0), _mm_shuffle_epi8(_g, _g0)), _mm_shuffle_epi8(_b, _b0));
+        __m128i _p1 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(_r, _r1), _mm_shuffle_epi8(_g, _g1)), _mm_shuffle_epi8(_b, _b1));
+        __m128i _p2 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(_r, _r2), _mm_shuffle_epi8(_g, _g2)), _mm_shuffle_epi8(_b, _b2));
+
+        _mm_storeu_si128((__m128i*)p, _p0);
+        _mm_storeu_si128((__m128i*)(p + 16), _p1);
+        _mm_storeu_si128((__m128i*)(p + 32), _p2);
+
+        p += 48;
+    }
+#else
+    for (; i + 15 < size; i += 16)
+    {
+        __m128i _v[12];
+        for (int k = 0; k < 4; k++)
+        {
+            __m128 _x;
+            __m128 _y;
+            __m128 _z;
+            interleave_c3_ps(_mm_loadu_ps(ptr0 + i + k * 4), _mm_loadu_ps(ptr1 + i + k * 4), _mm_loadu_ps(ptr2 + i + k * 4), _x, _y, _z);
+            _v[k * 3] = _mm_cvttps_epi32(_x);
+            _v[k * 3 + 1] = _mm_cvttps_epi32(_y);
+            _v[k * 3 + 2] = _mm_cvttps_epi32(_z);
+        }
+
+        __m128i _p0 = _mm_packus_epi16(_mm_packs_epi32(_v[0], _v[1]), _mm_packs_epi32(_v[2], _v[3]));
+        __m128i _p1 = _mm_packus_epi16(_mm_packs_epi32(_v[4], _v[5]), _mm_packs_epi32(_v[6], _v[7]));
+        __m128i _p2 = _mm_packus_epi16(_mm_packs_epi32(_v[8], _v[9]), _mm_packs_epi32(_v[10], _v[11]));
+
+        _mm_storeu_si128((__m128i*)p, _p0);
+        _mm_storeu_si128((__m128i*)(p + 16), _p1);
+        _mm_storeu_si128((__m128i*)(p + 32), _p2);
+
+        p += 48;
+    }
+#endif // __SSSE3__
+
+    return i;
+}
+
+// ptr3 may be null to fill the 4th channel with 255
+static inline int to_pixels_c4_x86(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, int size, unsigned char* p)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return to_pixels_c4_x86_avx512(ptr0, ptr1, ptr2, ptr3, size, p);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return to_pixels_c4_x86_avx2(ptr0, ptr1, ptr2, ptr3, size, p);
+#endif
+
+    int i = 0;
+    for (; i + 15 < size; i += 16)
+    {
+        __m128i _r = float2uint8_x16(ptr0 + i);
+        __m128i _g = float2uint8_x16(ptr1 + i);
+        __m128i _b = float2uint8_x16(ptr2 + i);
+        __m128i _a = ptr3 ? float2uint8_x16(ptr3 + i) : _mm_set1_epi8(-1);
+
+        __m128i _rgl = _mm_unpacklo_epi8(_r, _g);
+        __m128i _rgh = _mm_unpackhi_epi8(_r, _g);
+        __m128i _bal = _mm_unpacklo_epi8(_b, _a);
+        __m128i _bah = _mm_unpackhi_epi8(_b, _a);
+
+        _mm_storeu_si128((__m128i*)p, _mm_unpacklo_epi16(_rgl, _bal));
+        _mm_storeu_si128((__m128i*)(p + 16), _mm_unpackhi_epi16(_rgl, _bal));
+        _mm_storeu_si128((__m128i*)(p + 32), _mm_unpacklo_epi16(_rgh, _bah));
+        _mm_storeu_si128((__m128i*)(p + 48), _mm_unpackhi_epi16(_rgh, _bah));
+
+        p += 64;
+    }
+
+    return i;
+}
+
+// wide vertical pass of resize_bilinear, the sse2 part stays in mat_pixel_resize.cpp
+static inline int vresize_two_x86(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp0, unsigned char* Dp1, short b0, short b1, short b2, short b3)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return vresize_two_x86_avx512(rows0p, rows1p, wsize, Dp0, Dp1, b0, b1, b2, b3);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return vresize_two_x86_avx2(rows0p, rows1p, wsize, Dp0, Dp1, b0, b1, b2, b3);
+#endif
+
+    int dx = 0;
+#if __AVX512BW__
+    {
+        __m512i _b0 = _mm512_set1_epi16(b0);
+        __m512i _b1 = _mm512_set1_epi16(b1);
+        __m512i _b2 = _mm512_set1_epi16(b2);
+        __m512i _b3 = _mm512_set1_epi16(b3);
+        __m512i _v2 = _mm512_set1_epi16(2);
+        __m512i _idx = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+        for (; dx + 63 < wsize; dx += 64)
+        {
+            __m512i _r00 = _mm512_loadu_si512((const __m512i*)(rows0p + dx));
+            __m512i _r01 = _mm512_loadu_si512((const __m512i*)(rows0p + dx + 32));
+            __m512i _r10 = _mm512_loadu_si512((const __m512i*)(rows1p + dx));
+            __m512i _r11 = _mm512_loadu_si512((const __m512i*)(rows1p + dx + 32));
+            __m512i _acc00 = _mm512_add_epi16(_mm512_mulhi_epi16(_r00, _b0), _mm512_mulhi_epi16(_r10, _b1));
+            __m512i _acc01 = _mm512_add_epi16(_mm512_mulhi_epi16(_r01, _b0), _mm512_mulhi_epi16(_r11, _b1));
+            __m512i _acc10 = _mm512_add_epi16(_mm512_mulhi_epi16(_r00, _b2), _mm512_mulhi_epi16(_r10, _b3));
+            __m512i _acc11 = _mm512_add_epi16(_mm512_mulhi_epi16(_r01, _b2), _mm512_mulhi_epi16(_r11, _b3));
+            _acc00 = _mm512_srai_epi16(_mm512_add_epi16(_acc00, _v2), 2);
+            _acc01 = _mm512_srai_epi16(_mm512_add_epi16(_acc01, _v2), 2);
+            _acc10 = _mm512_srai_epi16(_mm512_add_epi16(_acc10, _v2), 2);
+            _acc11 = _mm512_srai_epi16(_mm512_add_epi16(_acc11, _v2), 2);
+            __m512i _Dp0 = _mm512_permutexvar_epi64(_idx, _mm512_packus_epi16(_acc00, _acc01));
+            __m512i _Dp1 = _mm512_permutexvar_epi64(_idx, _mm512_packus_epi16(_acc10, _acc11));
+            _mm512_storeu_si512((__m512i*)(Dp0 + dx), _Dp0);
+            _mm512_storeu_si512((__m512i*)(Dp1 + dx), _Dp1);
+        }
+    }
+#endif // __AVX512BW__
+#if __AVX2__
+    {
+        __m256i _b0 = _mm256_set1_epi16(b0);
+        __m256i _b1 = _mm256_set1_epi16(b1);
+        __m256i _b2 = _mm256_set1_epi16(b2);
+        __m256i _b3 = _mm256_set1_epi16(b3);
+        __m256i _v2 = _mm256_set1_epi16(2);
+        for (; dx + 31 < wsize; dx += 32)
+        {
+            __m256i _r00 = _mm256_loadu_si256((const __m256i*)(rows0p + dx));
+            __m256i _r01 = _mm256_loadu_si256((const __m256i*)(rows0p + dx + 16));
+            __m256i _r10 = _mm256_loadu_si256((const __m256i*)(rows1p + dx));
+            __m256i _r11 = _mm256_loadu_si256((const __m256i*)(rows1p + dx + 16));
+            __m256i _acc00 = _mm256_add_epi16(_mm256_mulhi_epi16(_r00, _b0), _mm256_mulhi_epi16(_r10, _b1));
+            __m256i _acc01 = _mm256_add_epi16(_mm256_mulhi_epi16(_r01, _b0), _mm256_mulhi_epi16(_r11, _b1));
+            __m256i _acc10 = _mm256_add_epi16(_mm256_mulhi_epi16(_r00, _b2), _mm256_mulhi_epi16(_r10, _b3));
+            __m256i _acc11 = _mm256_add_epi16(_mm256_mulhi_epi16(_r01, _b2), _mm256_mulhi_epi16(_r11, _b3));
+            _acc00 = _mm256_srai_epi16(_mm256_add_epi16(_acc00, _v2), 2);
+            _acc01 = _mm256_srai_epi16(_mm256_add_epi16(_acc01, _v2), 2);
+            _acc10 = _mm256_srai_epi16(_mm256_add_epi16(_acc10, _v2), 2);
+            _acc11 = _mm256_srai_epi16(_mm256_add_epi16(_acc11, _v2), 2);
+            __m256i _Dp0 = _mm256_permute4x64_epi64(_mm256_packus_epi16(_acc00, _acc01), _MM_SHUFFLE(3, 1, 2, 0));
+            __m256i _Dp1 = _mm256_permute4x64_epi64(_mm256_packus_epi16(_acc10, _acc11), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(Dp0 + dx), _Dp0);
+            _mm256_storeu_si256((__m256i*)(Dp1 + dx), _Dp1);
+        }
+    }
+#endif // __AVX2__
+
+    (void)rows0p;
+    (void)rows1p;
+    (void)Dp0;
+    (void)Dp1;
+    (void)b0;
+    (void)b1;
+    (void)b2;
+    (void)b3;
+    return dx;
+}
+
+static inline int vresize_one_x86(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp, short b0, short b1)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx512())
+        return vresize_one_x86_avx512(rows0p, rows1p, wsize, Dp, b0, b1);
+#endif
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return vresize_one_x86_avx2(rows0p, rows1p, wsize, Dp, b0, b1);
+#endif
+
+    int dx = 0;
+#if __AVX512BW__
+    {
+        __m512i _b0 = _mm512_set1_epi16(b0);
+        __m512i _b1 = _mm512_set1_epi16(b1);
+        __m512i _v2 = _mm512_set1_epi16(2);
+        __m512i _idx = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+        for (; dx + 63 < wsize; dx += 64)
+        {
+            __m512i _r00 = _mm512_loadu_si512((const __m512i*)(rows0p + dx));
+            __m512i _r01 = _mm512_loadu_si512((const __m512i*)(rows0p + dx + 32));
+            __m512i _r10 = _mm512_loadu_si512((const __m512i*)(rows1p + dx));
+            __m512i _r11 = _mm512_loadu_si512((const __m512i*)(rows1p + dx + 32));
+            __m512i _acc0 = _mm512_add_epi16(_mm512_mulhi_epi16(_r00, _b0), _mm512_mulhi_epi16(_r10, _b1));
+            __m512i _acc1 = _mm512_add_epi16(_mm512_mulhi_epi16(_r01, _b0), _mm512_mulhi_epi16(_r11, _b1));
+            _acc0 = _mm512_srai_epi16(_mm512_add_epi16(_acc0, _v2), 2);
+            _acc1 = _mm512_srai_epi16(_mm512_add_epi16(_acc1, _v2), 2);
+            __m512i _Dp = _mm512_permutexvar_epi64(_idx, _mm512_packus_epi16(_acc0, _acc1));
+            _mm512_storeu_si512((__m512i*)(Dp + dx), _Dp);
+        }
+    }
+#endif // __AVX512BW__
+#if __AVX2__
+    {
+        __m256i _b0 = _mm256_set1_epi16(b0);
+        __m256i _b1 = _mm256_set1_epi16(b1);
+        __m256i _v2 = _mm256_set1_epi16(2);
+        for (; dx + 31 < wsize; dx += 32)
+        {
+            __m256i _r00 = _mm256_loadu_si256((const __m256i*)(rows0p + dx));
+            __m256i _r01 = _mm256_loadu_si256((const __m256i*)(rows0p + dx + 16));
+            __m256i _r10 = _mm256_loadu_si256((const __m256i*)(rows1p + dx));
+            __m256i _r11 = _mm256_loadu_si256((const __m256i*)(rows1p + dx + 16));
+            __m256i _acc0 = _mm256_add_epi16(_mm256_mulhi_epi16(_r00, _b0), _mm256_mulhi_epi16(_r10, _b1));
+            __m256i _acc1 = _mm256_add_epi16(_mm256_mulhi_epi16(_r01, _b0), _mm256_mulhi_epi16(_r11, _b1));
+            _acc0 = _mm256_srai_epi16(_mm256_add_epi16(_acc0, _v2), 2);
+            _acc1 = _mm256_srai_epi16(_mm256_add_epi16(_acc1, _v2), 2);
+            __m256i _Dp = _mm256_permute4x64_epi64(_mm256_packus_epi16(_acc0, _acc1), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256((__m256i*)(Dp + dx), _Dp);
+        }
+    }
+#endif // __AVX2__
+
+    (void)rows0p;
+    (void)rows1p;
+    (void)Dp;
+    (void)b0;
+    (void)b1;
+    return dx;
+}
+#endif // NCNN_PIXEL
+
+#if NCNN_PIXEL_AFFINE
+// 8 destination pixels whose sources are all inside, returns 0 when there is no simd path
+static inline int warpaffine_bilinear_c3_inside8_x86(const unsigned char* src0, int srcstride, int X0, int Y0, const int* adelta, const int* bdelta, unsigned char* dst0)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return warpaffine_bilinear_c3_inside8_x86_avx2(src0, srcstride, X0, Y0, adelta, bdelta, dst0);
+#endif
+
+#if __AVX2__
+    __m256i _X = _mm256_add_epi32(_mm256_set1_epi32(X0), _mm256_loadu_si256((const __m256i*)adelta));
+    __m256i _Y = _mm256_add_epi32(_mm256_set1_epi32(Y0), _mm256_loadu_si256((const __m256i*)bdelta));
+
+    __m256i _sx = _mm256_srai_epi32(_X, 10);
+    __m256i _sy = _mm256_srai_epi32(_Y, 10);
+
+    __m256i _v1024m1 = _mm256_set1_epi32((1 << 10) - 1);
+    __m256i _fx = _mm256_and_si256(_X, _v1024m1);
+    __m256i _fy = _mm256_and_si256(_Y, _v1024m1);
+
+    // alpha0 in the low 16 bits and alpha1 in the high 16 bits, for madd
+    __m256i _v1024 = _mm256_set1_epi32(1 << 10);
+    __m256i _alpha = _mm256_or_si256(_mm256_sub_epi32(_v1024, _fx), _mm256_slli_epi32(_fx, 16));
+    __m256i _beta = _mm256_or_si256(_mm256_sub_epi32(_v1024, _fy), _mm256_slli_epi32(_fy, 16));
+
+    __m256i _ofs = _mm256_add_epi32(_mm256_mullo_epi32(_sy, _mm256_set1_epi32(srcstride)), _mm256_add_epi32(_sx, _mm256_add_epi32(_sx, _sx)));
+
+    // the 2nd gather starts 2 bytes later so that neither reads past the right pixel
+    __m256i _a0 = _mm256_i32gather_epi32((const int*)src0, _ofs, 1);
+    __m256i _a1 = _mm256_i32gather_epi32((const int*)(src0 + 2), _ofs, 1);
+    __m256i _b0 = _mm256_i32gather_epi32((const int*)(src0 + srcstride), _ofs, 1);
+    __m256i _b1 = _mm256_i32gather_epi32((const int*)(src0 + srcstride + 2), _ofs, 1);
+
+    __m256i _dst = _mm256_setzero_si256();
+    for (int c = 0; c < 3; c++)
+    {
+        // left pixel byte c to the low 16 bits, right pixel byte c to the high 16 bits
+        const char l = (char)c;
+        const char r = (char)(c + 1);
+        __m256i _ml = _mm256_setr_epi8(l, -1, -1, -1, l + 4, -1, -1, -1, l + 8, -1, -1, -1, l + 12, -1, -1, -1, l, -1, -1, -1, l + 4, -1, -1, -1, l + 8, -1, -1, -1, l + 12, -1, -1, -1);
+        __m256i _mr = _mm256_setr_epi8(-1, -1, r, -1, -1, -1, r + 4, -1, -1, -1, r + 8, -1, -1, -1, r + 12, -1, -1, -1, r, -1, -1, -1, r + 4, -1, -1, -1, r + 8, -1, -1, -1, r + 12, -1);
+
+        __m256i _a = _mm256_or_si256(_mm256_shuffle_epi8(_a0, _ml), _mm256_shuffle_epi8(_a1, _mr));
+        __m256i _b = _mm256_or_si256(_mm256_shuffle_epi8(_b0, _ml), _mm256_shuffle_epi8(_b1, _mr));
+
+        __m256i _ta = _mm256_srli_epi32(_mm256_madd_epi16(_a, _alpha), 5);
+        __m256i _tb = _mm256_srli_epi32(_mm256_madd_epi16(_b, _alpha), 5);
+
+        __m256i _v = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_or_si256(_ta, _mm256_slli_epi32(_tb, 16)), _beta), 15);
+
+        _dst = _mm256_or_si256(_dst, _mm256_slli_epi32(_v, c * 8));
+    }
+
+    // 8 x rgb0 -> 24 bytes
+    __m256i _pack = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    _dst = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(_dst, _pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+    _mm_storeu_si128((__m128i*)dst0, _mm256_castsi256_si128(_dst));
+    _mm_storel_epi64((__m128i*)(dst0 + 16), _mm256_extracti128_si256(_dst, 1));
+
+    return 1;
+#else
+    (void)src0;
+    (void)srcstride;
+    (void)X0;
+    (void)Y0;
+    (void)adelta;
+    (void)bdelta;
+    (void)dst0;
+    return 0;
+#endif // __AVX2__
+}
+#endif // NCNN_PIXEL_AFFINE
+
+#if NCNN_PIXEL_ROTATE
+// mirror a row of rgb pixels, src pixel 0 goes to dst0 and the following ones go leftwards
+static inline int kanna_rotate_reverse_c3_x86(const unsigned char* src0, int srcw, unsigned char* dst0)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return kanna_rotate_reverse_c3_x86_avx2(src0, srcw, dst0);
+#endif
+
+    int x = 0;
+#if __SSSE3__
+    const __m128i _lo_lo = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 15, -1, -1, 12, 13, 14, 9, 10, 11, 6);
+    const __m128i _lo_hi = _mm_setr_epi8(5, 6, 7, 2, 3, 4, -1, 0, 1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _hi_lo = _mm_setr_epi8(7, 8, 3, 4, 5, 0, 1, 2, -1, -1, -1, -1, -1, -1, -1, -1);
+    for (; x + 7 < srcw; x += 8)
+    {
+        __m128i _lo = _mm_loadu_si128((const __m128i*)(src0 + x * 3));
+        __m128i _hi = _mm_loadl_epi64((const __m128i*)(src0 + x * 3 + 16));
+
+        __m128i _out_lo = _mm_or_si128(_mm_shuffle_epi8(_lo, _lo_lo), _mm_shuffle_epi8(_hi, _lo_hi));
+        __m128i _out_hi = _mm_shuffle_epi8(_lo, _hi_lo);
+
+        unsigned char* p = dst0 - (x + 7) * 3;
+        _mm_storeu_si128((__m128i*)p, _out_lo);
+        _mm_storel_epi64((__m128i*)(p + 16), _out_hi);
+    }
+#endif // __SSSE3__
+
+    (void)src0;
+    (void)srcw;
+    (void)dst0;
+    return x;
+}
+
+// transpose a strip of 8 rgb rows, src column x goes to dst0 + x * dst_step
+// a negative src_step walks the rows bottom-up, which mirrors each dst row
+static inline int kanna_rotate_transpose_c3_x86(const unsigned char* src0, int src_step, int srcw, unsigned char* dst0, int dst_step)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && !__AVX2__
+    if (ncnn::cpu_support_x86_avx2())
+        return kanna_rotate_transpose_c3_x86_avx2(src0, src_step, srcw, dst0, dst_step);
+#endif
+
+    int x = 0;
+#if __SSSE3__
+    const __m128i _rg_lo = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1);
+    const __m128i _rg_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, -1, -1, -1, -1, -1, 0, 3, 6);
+    const __m128i _b_lo = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _b_hi = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _out_lo_rg = _mm_setr_epi8(0, 8, -1, 1, 9, -1, 2, 10, -1, 3, 11, -1, 4, 12, -1, 5);
+    const __m128i _out_lo_b = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+    const __m128i _out_hi_rg = _mm_setr_epi8(13, -1, 6, 14, -1, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i _out_hi_b = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, -1, -1, -1, -1, -1, -1);
+    for (; x + 7 < srcw; x += 8)
+    {
+        // rows to r0..r7 g0..g7 and b0..b7
+        __m128i _rg[8];
+        __m128i _b[8];
+        for (int i = 0; i < 8; i++)
+        {
+            const unsigned char* p = src0 + i * src_step + x * 3;
+            __m128i _lo = _mm_loadu_si128((const __m128i*)p);
+            __m128i _hi = _mm_loadl_epi64((const __m128i*)(p + 16));
+            _rg[i] = _mm_or_si128(_mm_shuffle_epi8(_lo, _rg_lo), _mm_shuffle_epi8(_hi, _rg_hi));
+            _b[i] = _mm_or_si128(_mm_shuffle_epi8(_lo, _b_lo), _mm_shuffle_epi8(_hi, _b_hi));
+        }
+
+        // 8x8 byte transpose of each plane, column pairs end up in t0..t3
+        __m128i _r01 = _mm_unpacklo_epi8(_rg[0], _rg[1]);
+        __m128i _r23 = _mm_unpacklo_epi8(_rg[2], _rg[3]);
+        __m128i _r45 = _mm_unpacklo_epi8(_rg[4], _rg[5]);
+        __m128i _r67 = _mm_unpacklo_epi8(_rg[6], _rg[7]);
+        __m128i _g01 = _mm_unpackhi_epi8(_rg[0], _rg[1]);
+        __m128i _g23 = _mm_unpackhi_epi8(_rg[2], _rg[3]);
+        __m128i _g45 = _mm_unpackhi_epi8(_rg[4], _rg[5]);
+        __m128i _g67 = _mm_unpackhi_epi8(_rg[6], _rg[7]);
+        __m128i _b01 = _mm_unpacklo_epi8(_b[0], _b[1]);
+        __m128i _b23 = _mm_unpacklo_epi8(_b[2], _b[3]);
+        __m128i _b45 = _mm_unpacklo_epi8(_b[4], _b[5]);
+        __m128i _b67 = _mm_unpacklo_epi8(_b[6], _b[7]);
+
+        __m128i _rq0 = _mm_unpacklo_epi16(_r01, _r23);
+        __m128i _rq1 = _mm_unpackhi_epi16(_r01, _r23);
+        __m128i _rq2 = _mm_unpacklo_epi16(_r45, _r67);
+        __m128i _rq3 = _mm_unpackhi_epi16(_r45, _r67);
+        __m128i _gq0 = _mm_unpacklo_epi16(_g01, _g23);
+        __m128i _gq1 = _mm_unpackhi_epi16(_g01, _g23);
+        __m128i _gq2 = _mm_unpacklo_epi16(_g45, _g67);
+        __m128i _gq3 = _mm_unpackhi_epi16(_g45, _g67);
+        __m128i _bq0 = _mm_unpacklo_epi16(_b01, _b23);
+        __m128i _bq1 = _mm_unpackhi_epi16(_b01, _b23);
+        __m128i _bq2 = _mm_unpacklo_epi16(_b45, _b67);
+        __m128i _bq3 = _mm_unpackhi_epi16(_b45, _b67);
+
+        __m128i _rt[4];
+        __m128i _gt[4];
+        __m128i _bt[4];
+        _rt[0] = _mm_unpacklo_epi32(_rq0, _rq2);
+        _rt[1] = _mm_unpackhi_epi32(_rq0, _rq2);
+        _rt[2] = _mm_unpacklo_epi32(_rq1, _rq3);
+        _rt[3] = _mm_unpackhi_epi32(_rq1, _rq3);
+        _gt[0] = _mm_unpacklo_epi32(_gq0, _gq2);
+        _gt[1] = _mm_unpackhi_epi32(_gq0, _gq2);
+        _gt[2] = _mm_unpacklo_epi32(_gq1, _gq3);
+        _gt[3] = _mm_unpackhi_epi32(_gq1, _gq3);
+        _bt[0] = _mm_unpacklo_epi32(_bq0, _bq2);
+        _bt[1] = _mm_unpackhi_epi32(_bq0, _bq2);
+        _bt[2] = _mm_unpacklo_epi32(_bq1, _bq3);
+        _bt[3] = _mm_unpackhi_epi32(_bq1, _bq3);
+
+        for (int j = 0; j < 8; j++)
+        {
+            __m128i _rgj = (j & 1) ? _mm_unpackhi_epi64(_rt[j / 2], _gt[j / 2]) : _mm_unpacklo_epi64(_rt[j / 2], _gt[j / 2]);
+            __m128i _bj = (j & 1) ? _mm_unpackhi_epi64(_bt[j / 2], _bt[j / 2]) : _bt[j / 2];
+
+            __m128i _out_lo = _mm_or_si128(_mm_shuffle_epi8(_rgj, _out_lo_rg), _mm_shuffle_epi8(_bj, _out_lo_b));
+            __m128i _out_hi = _mm_or_si128(_mm_shuffle_epi8(_rgj, _out_hi_rg), _mm_shuffle_epi8(_bj, _out_hi_b));
+
+            unsigned char* p = dst0 + (x + j) * dst_step;
+            _mm_storeu_si128((__m128i*)p, _out_lo);
+            _mm_storel_epi64((__m128i*)(p + 16), _out_hi);
+        }
+    }
+#endif // __SSSE3__
+
+    (void)src0;
+    (void)src_step;
+    (void)srcw;
+    (void)dst0;
+    (void)dst_step;
+    return x;
+}
+#endif // NCNN_PIXEL_ROTATE
+
+} // namespace ncnn
+
+#endif // __SSE2__
+
+#endif // NCNN_MAT_PIXEL_X86_H
@@ -0,0 +1,50 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "mat_pixel_x86.h"
+
+namespace ncnn {
+
+#if NCNN_PIXEL
+int from_pixels_c1_x86_avx512(const unsigned char* p, int size, float* ptr0)
+{
+    return from_pixels_c1_x86(p, size, ptr0);
+}
+
+int from_pixels_c3_x86_avx512(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2)
+{
+    return from_pixels_c3_x86(p, size, ptr0, ptr1, ptr2);
+}
+
+int from_pixels_c4_x86_avx512(const unsigned char* p, int size, float* ptr0, float* ptr1, float* ptr2, float* ptr3)
+{
+    return from_pixels_c4_x86(p, size, ptr0, ptr1, ptr2, ptr3);
+}
+
+int to_pixels_c1_x86_avx512(const float* ptr0, int size, unsigned char* p)
+{
+    return to_pixels_c1_x86(ptr0, size, p);
+}
+
+int to_pixels_c3_x86_avx512(const float* ptr0, const float* ptr1, const float* ptr2, int size, unsigned char* p)
+{
+    return to_pixels_c3_x86(ptr0, ptr1, ptr2, size, p);
+}
+
+int to_pixels_c4_x86_avx512(const float* ptr0, const float* ptr1, const float* ptr2, const float* ptr3, int size, unsigned char* p)
+{
+    return to_pixels_c4_x86(ptr0, ptr1, ptr2, ptr3, size, p);
+}
+
+int vresize_two_x86_avx512(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp0, unsigned char* Dp1, short b0, short b1, short b2, short b3)
+{
+    return vresize_two_x86(rows0p, rows1p, wsize, Dp0, Dp1, b0, b1, b2, b3);
+}
+
+int vresize_one_x86_avx512(const short* rows0p, const short* rows1p, int wsize, unsigned char* Dp, short b0, short b1)
+{
+    return vresize_one_x86(rows0p, rows1p, wsize, Dp, b0, b1);
+}
+#endif // NCNN_PIXEL
+
+} // namespace ncnn
@@ -218,6 +218,81 @@ Mat ModelBinFromDataReader::load(int w, int type) const
 
             return m;
         }
+        else if (flag_struct.tag == 0x0B5E1D04)
+        {
+            // block sparse data
+            // block_size nnzb block_index[nnzb] value[nnzb * block_size]
+            int header[2];
+            nread = d->dr.read(header, sizeof(header));
+            if (nread != sizeof(header))
+            {
+                NCNN_LOGE("ModelBin read block sparse header failed %zd", nread);
+                return Mat();
+            }
+
+#if __BIG_ENDIAN__
+            swap_endianness_32(&header[0]);
+            swap_endianness_32(&header[1]);
+#endif
+
+            const int block_size = header[0];
+            const int nnzb = header[1];
+            if (block_size <= 0 || nnzb < 0 || (size_t)nnzb * block_size > (size_t)w)
+            {
+                NCNN_LOGE("ModelBin block sparse header %d %d mismatch w %d", block_size, nnzb, w);
+                return Mat();
+            }
+
+            std::vector<unsigned int> block_index;
+            std::vector<float> block_values;
+            block_index.resize(nnzb + 1);
+            block_values.resize((size_t)nnzb * block_size + 1);
+
+            nread = d->dr.read(&block_index[0], nnzb * sizeof(unsigned int));
+            if (nread != nnzb * sizeof(unsigned int))
+            {
+                NCNN_LOGE("ModelBin read block_index failed %zd", nread);
+                return Mat();
+            }
+
+            nread = d->dr.read(&block_values[0], (size_t)nnzb * block_size * sizeof(float));
+            if (nread != (size_t)nnzb * block_size * sizeof(float))
+            {
+                NCNN_LOGE("ModelBin read block_values failed %zd", nread);
+                return Mat();
+            }
+
+            m.create(w);
+            if (m.empty())
+                return m;
+
+            m.fill(0.f);
+
+            float* ptr = m;
+            for (int i = 0; i < nnzb; i++)
+            {
+                unsigned int bi = block_index[i];
+#if __BIG_ENDIAN__
+                swap_endianness_32(&bi);
+#endif
+                if ((size_t)bi * block_size + block_size > (size_t)w)
+                {
+                    NCNN_LOGE("ModelBin block sparse index %u out of range", bi);
+                    return Mat();
+                }
+
+                for (int j = 0; j < block_size; j++)
+                {
+                    float v = block_values[i * block_size + j];
+#if __BIG_ENDIAN__
+                    swap_endianness_32(&v);
+#endif
+                    ptr[bi * block_size + j] = v;
+                }
+            }
+
+            return m;
+        }
 
         if (flag != 0)
         {
@@ -9,6 +9,15 @@
 #include "modelbin.h"
 #include "paramdict.h"
 
+#include "layer/binaryop.h"
+#include "layer/concat.h"
+#include "layer/convolution.h"
+#include "layer/convolutiondepthwise.h"
+#include "layer/crop.h"
+#include "layer/innerproduct.h"
+#include "layer/pooling.h"
+#include "layer/slice.h"
+
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
@@ -23,6 +32,86 @@
 #endif // NCNN_VULKAN
 
 namespace ncnn {
+
+class ModelContainer;
+
+// counts live and peak bytes on top of another allocator, the size is kept in front of each block
+// it is deleted once its owner releases it and all blocks are freed, as blobs may outlive their extractor
+class MemoryStatAllocator : public Allocator
+{
+public:
+    MemoryStatAllocator(Allocator* _allocator)
+        : allocator(_allocator), refcount(1), bytes(0), peak_bytes(0)
+    {
+    }
+
+    virtual void* fastMalloc(size_t size)
+    {
+        unsigned char* ptr = allocator ? (unsigned char*)allocator->fastMalloc(size + NCNN_MALLOC_ALIGN) : (unsigned char*)ncnn::fastMalloc(size + NCNN_MALLOC_ALIGN);
+        if (!ptr)
+            return 0;
+
+        *(size_t*)ptr = size;
+
+        MutexLockGuard guard(lock);
+        refcount++;
+        bytes += size;
+        if (bytes > peak_bytes)
+            peak_bytes = bytes;
+
+        return ptr + NCNN_MALLOC_ALIGN;
+    }
+
+    virtual void fastFree(void* p)
+    {
+        unsigned char* ptr = (unsigned char*)p - NCNN_MALLOC_ALIGN;
+        const size_t size = *(size_t*)ptr;
+
+        if (allocator)
+            allocator->fastFree(ptr);
+        else
+            ncnn::fastFree(ptr);
+
+        release(size);
+    }
+
+    void addref()
+    {
+        MutexLockGuard guard(lock);
+        refcount++;
+    }
+
+    void release(size_t size = 0)
+    {
+        lock.lock();
+        bytes -= size;
+        const int rc = --refcount;
+        lock.unlock();
+
+        if (rc == 0)
+            delete this;
+    }
+
+    size_t get_bytes() const
+    {
+        MutexLockGuard guard(lock);
+        return bytes;
+    }
+
+    size_t get_peak_bytes() const
+    {
+        MutexLockGuard guard(lock);
+        return peak_bytes;
+    }
+
+private:
+    Allocator* const allocator;
+    mutable Mutex lock;
+    int refcount;
+    size_t bytes;
+    size_t peak_bytes;
+};
+
 //MPL (Pointer to Implementation) Idiom，也叫“d-指针”模式。
 class NetPrivate
 {
@@ -39,7 +128,7 @@ public:
 #endif // NCNN_VULKAN
 
     friend class Extractor;
-    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, std::vector<Mat>* blob_slices = 0, std::vector<Mat>* blob_owners = 0) const;
 
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
@@ -47,16 +136,34 @@ public:
 
     int convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
 
-    int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const;
+    // blob_owners holds the blob each view blob points into, see opt.use_blob_view
+    int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt, std::vector<Mat>* blob_slices = 0, std::vector<Mat>* blob_owners = 0) const;
 #if NCNN_VULKAN
     int do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
 
+    // zero-copy concat, see opt.use_zero_copy_concat
+    // blob_slices holds the channel slice of the concat output each pending blob should be written into
+    int plan_concat_slices(const Layer* layer, const std::vector<Mat>& blob_mats, std::vector<Mat>& blob_slices, std::vector<int>& slice_blob_indexes, const Option& opt) const;
+    void learn_concat_plan(const Layer* layer, const std::vector<Mat>& bottom_blobs, const Mat& top_blob) const;
+
     void update_input_output_indexes();
 #if NCNN_STRING
     void update_input_output_names();
 #endif // NCNN_STRING
 
+    bool use_parallel_create_pipeline() const;
+    void prepare_load_model();
+    int load_layer_model(int layer_index, const ModelBin& mb);
+    int create_layer_pipeline(int layer_index);
+    int finish_load_model(int ret);
+
+    int load_model(const ModelBin& mb);
+    int load_model(const ModelContainer& c);
+    int load_container_layer(const ModelContainer& c, int layer_index);
+
+    int load_container(Net& net, const ModelContainer& c);
+
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
 
@@ -73,6 +180,28 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+    Allocator* weight_allocator;
+
+    // weight accounting of each layer, wrapping weight_allocator
+    std::vector<MemoryStatAllocator*> layer_weight_allocators;
+    Allocator* get_layer_weight_allocator(int layer_index) const;
+    void release_layer_weight_allocators();
+
+    // weights loaded and pipelines created
+    bool model_loaded;
+
+    // output layout of each channel concat seen in the last forward, indexed by top blob
+    struct ConcatPlan
+    {
+        int w;
+        int h;
+        size_t elemsize;
+        int elempack;
+        std::vector<int> channels;
+    };
+    mutable std::vector<ConcatPlan> concat_plans;
+    mutable Mutex concat_plan_lock;
+
 #if NCNN_VULKAN
     const VulkanDevice* vkdev;
 
@@ -89,6 +218,10 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+    weight_allocator = 0;
+
+    model_loaded = false;
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -158,12 +291,39 @@ int NetPrivate::upload_model()
 }
 #endif // NCNN_VULKAN
 
-int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+static void release_concat_slices(std::vector<Mat>& blob_mats, std::vector<Mat>& blob_slices, const std::vector<int>& slice_blob_indexes)
+{
+    for (size_t i = 0; i < slice_blob_indexes.size(); i++)
+    {
+        int blob_index = slice_blob_indexes[i];
+
+        // slices do not own the concat output, never leave one behind
+        Mat& m = blob_mats[blob_index];
+        if (m.refcount == 0 && m.data && m.data == blob_slices[blob_index].data)
+            m.release();
+
+        blob_slices[blob_index].release();
+    }
+}
+
+int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, std::vector<Mat>* blob_slices, std::vector<Mat>* blob_owners) const
 {
     const Layer* layer = layers[layer_index];
 
     //     NCNN_LOGE("forward_layer %d %s", layer_index, layer->name.c_str());
 
+    // allocate the concat output before its bottoms are produced
+    std::vector<int> slice_blob_indexes;
+    if (blob_slices && layer->typeindex == LayerType::Concat)
+    {
+        int ret = plan_concat_slices(layer, blob_mats, *blob_slices, slice_blob_indexes, opt);
+        if (ret != 0)
+        {
+            release_concat_slices(blob_mats, *blob_slices, slice_blob_indexes);
+            return ret;
+        }
+    }
+
     // load bottom blobs
     for (size_t i = 0; i < layer->bottoms.size(); i++)
     {
@@ -171,9 +331,13 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
 
         if (blob_mats[bottom_blob_index].dims == 0)
         {
-            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt);
+            int ret = forward_layer(blobs[bottom_blob_index].producer, blob_mats, opt, blob_slices, blob_owners);
             if (ret != 0)
+            {
+                if (blob_slices)
+                    release_concat_slices(blob_mats, *blob_slices, slice_blob_indexes);
                 return ret;
+            }
         }
     }
 
@@ -195,11 +359,11 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     int ret = 0;
     if (layer->featmask)
     {
-        ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
+        ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask), blob_slices, blob_owners);
     }
     else
     {
-        ret = do_forward_layer(layer, blob_mats, opt);
+        ret = do_forward_layer(layer, blob_mats, opt, blob_slices, blob_owners);
     }
 #if NCNN_BENCHMARK
     double end = get_current_time();
@@ -213,6 +377,9 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
         benchmark(layer, start, end);
     }
 #endif
+    if (blob_slices)
+        release_concat_slices(blob_mats, *blob_slices, slice_blob_indexes);
+
     if (ret != 0)
         return ret;
 
@@ -546,7 +713,284 @@ int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Optio
     return 0;
 }
 
-int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const
+// bytes of work one layer forward touches, 0 if the layer should run on opt.num_threads
+static size_t get_layer_work_bytes(const Layer* layer, const Mat* bottom_blobs, size_t bottom_count)
+{
+    if (!layer->support_adaptive_thread_count)
+        return 0;
+
+    // custom layers may depend on the load-time thread count too
+    if (layer->typeindex & LayerType::CustomBit)
+        return 0;
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < bottom_count; i++)
+    {
+        const Mat& m = bottom_blobs[i];
+        bytes += m.total() * m.elemsize;
+    }
+
+    if (layer->typeindex == LayerType::InnerProduct && bottom_count == 1)
+    {
+        // every row of the input sweeps the whole weight
+        const Mat& m = bottom_blobs[0];
+        const int rows = m.dims == 2 ? m.h * m.elempack : 1;
+        bytes += (size_t)((const InnerProduct*)layer)->weight_data_size * m.elemsize / m.elempack * rows;
+    }
+
+    return bytes;
+}
+
+static int get_layer_num_threads(const Layer* layer, const Mat* bottom_blobs, size_t bottom_count, const Option& opt)
+{
+    if (!opt.use_adaptive_thread_count || opt.num_threads <= 1)
+        return opt.num_threads;
+
+    const size_t bytes = get_layer_work_bytes(layer, bottom_blobs, bottom_count);
+    if (bytes == 0)
+        return opt.num_threads;
+
+    const size_t num_threads = bytes / get_thread_work_threshold();
+    return (int)std::max(std::min(num_threads, (size_t)opt.num_threads), (size_t)1);
+}
+
+static bool is_concat_slice(const std::vector<Mat>* blob_slices, int blob_index, const Mat& m)
+{
+    return blob_slices && m.data && (*blob_slices)[blob_index].data == m.data;
+}
+
+static bool gather_concat_slices(const Layer* layer, const std::vector<Mat>& bottom_blobs, const Mat& top_blob, const std::vector<Mat>& blob_slices)
+{
+    if (top_blob.dims != 3)
+        return false;
+
+    int q = 0;
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        const Mat& slice = blob_slices[layer->bottoms[i]];
+        const Mat& bottom_blob = bottom_blobs[i];
+
+        if (slice.dims != 3 || bottom_blob.dims != 3 || slice.data != top_blob.channel(q).data)
+            return false;
+
+        q += slice.c;
+
+        if (bottom_blob.w != slice.w || bottom_blob.h != slice.h || bottom_blob.c != slice.c || bottom_blob.cstep != slice.cstep || bottom_blob.elemsize != slice.elemsize || bottom_blob.elempack != slice.elempack)
+            return false;
+    }
+
+    if (q != top_blob.c)
+        return false;
+
+    // copy the bottoms that were not produced in place
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        const Mat& slice = blob_slices[layer->bottoms[i]];
+        const Mat& bottom_blob = bottom_blobs[i];
+
+        if (bottom_blob.data != slice.data)
+        {
+            memcpy(slice.data, bottom_blob.data, bottom_blob.total() * bottom_blob.elemsize);
+        }
+    }
+
+    return true;
+}
+
+// view of the window in bottom_blob, if it can be addressed without a copy
+// the window is in unpacked elements and must span whole rows
+static bool make_window_view(const Mat& bottom_blob, const int* offsets, const int* extents, Mat& view)
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    // w h d c of bottom_blob in unpacked elements
+    int shape[4] = {bottom_blob.w, bottom_blob.h, bottom_blob.d, bottom_blob.c};
+    if (dims == 1)
+        shape[0] *= elempack;
+    if (dims == 2)
+        shape[1] *= elempack;
+    if (dims == 3 || dims == 4)
+        shape[3] *= elempack;
+
+    bool whole = true;
+    for (int i = 0; i < 4; i++)
+    {
+        if (offsets[i] < 0 || extents[i] <= 0 || offsets[i] + extents[i] > shape[i])
+            return false;
+
+        if (offsets[i] != 0 || extents[i] != shape[i])
+            whole = false;
+    }
+
+    // identity is handled by the layer itself
+    if (whole)
+        return false;
+
+    if (dims == 1)
+    {
+        if (offsets[0] % elempack != 0 || extents[0] % elempack != 0)
+            return false;
+
+        view = bottom_blob.range(offsets[0] / elempack, extents[0] / elempack);
+        return true;
+    }
+
+    // rows must be kept whole
+    if (offsets[0] != 0 || extents[0] != shape[0])
+        return false;
+
+    if (dims == 2)
+    {
+        if (offsets[1] % elempack != 0 || extents[1] % elempack != 0)
+            return false;
+
+        view = bottom_blob.row_range(offsets[1] / elempack, extents[1] / elempack);
+        return true;
+    }
+
+    if (offsets[3] % elempack != 0 || extents[3] % elempack != 0)
+        return false;
+
+    // a single depth if some rows are cut
+    if (extents[1] != shape[1] && extents[2] != 1)
+        return false;
+
+    view = bottom_blob.channel_range(offsets[3] / elempack, extents[3] / elempack);
+
+    // the channel step of bottom_blob is kept
+    view.data = (unsigned char*)view.data + ((size_t)offsets[2] * shape[1] + offsets[1]) * shape[0] * elemsize;
+    view.h = extents[1];
+    view.d = extents[2];
+
+    return true;
+}
+
+// let crop and slice output views into the bottom blob instead of copies
+static bool forward_view(const Layer* layer, const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs)
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const int dims = bottom_blob.dims;
+
+    if (layer->typeindex == LayerType::Crop)
+    {
+        int woffset, hoffset, doffset, coffset;
+        int outw, outh, outd, outc;
+        if (((const Crop*)layer)->resolve_crop_window(bottom_blobs, woffset, hoffset, doffset, coffset, outw, outh, outd, outc) != 0)
+            return false;
+
+        int offsets[4] = {woffset, 0, 0, 0};
+        int extents[4] = {outw, 1, 1, 1};
+        if (dims >= 2)
+        {
+            offsets[1] = hoffset;
+            extents[1] = outh;
+        }
+        if (dims == 4)
+        {
+            offsets[2] = doffset;
+            extents[2] = outd;
+        }
+        if (dims >= 3)
+        {
+            offsets[3] = coffset;
+            extents[3] = outc;
+        }
+
+        return make_window_view(bottom_blob, offsets, extents, top_blobs[0]);
+    }
+
+    if (layer->typeindex == LayerType::Slice)
+    {
+        const Mat shape = bottom_blob.shape();
+
+        std::vector<Mat> bottom_blob_shapes(1, shape);
+        std::vector<Mat> top_blob_shapes(top_blobs.size());
+        if (layer->infer_shape(bottom_blob_shapes, top_blob_shapes) != 0)
+            return false;
+
+        const int axis = ((const Slice*)layer)->axis;
+        const int positive_axis = axis < 0 ? dims + axis : axis;
+
+        // axis counts from the outermost dimension, map it onto w h d c
+        const int axis_map[4][4] = {{0}, {1, 0}, {3, 1, 0}, {3, 2, 1, 0}};
+        if (positive_axis < 0 || positive_axis >= dims)
+            return false;
+
+        const int k = axis_map[dims - 1][positive_axis];
+
+        std::vector<Mat> views(top_blobs.size());
+        int q = 0;
+        for (size_t i = 0; i < top_blobs.size(); i++)
+        {
+            const Mat& s = top_blob_shapes[i];
+            int offsets[4] = {0, 0, 0, 0};
+            int extents[4] = {shape.w, shape.h, shape.d, shape.c};
+            const int s_extents[4] = {s.w, s.h, s.d, s.c};
+            offsets[k] = q;
+            extents[k] = s_extents[k];
+            q += s_extents[k];
+
+            if (!make_window_view(bottom_blob, offsets, extents, views[i]))
+                return false;
+        }
+
+        top_blobs = views;
+        return true;
+    }
+
+    return false;
+}
+
+// the blob that owns the memory of m
+static const Mat& blob_owner(const std::vector<Mat>& blob_owners, int blob_index, const Mat& m)
+{
+    return m.refcount ? m : blob_owners[blob_index];
+}
+
+static bool has_blob_owner(const Layer* layer, const std::vector<Mat>& bottom_blobs, const std::vector<Mat>& blob_owners)
+{
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        if (blob_owner(blob_owners, layer->bottoms[i], bottom_blobs[i]).dims == 0)
+            return false;
+    }
+
+    return true;
+}
+
+// keep the owner alive as long as a top blob points into a bottom blob
+static void track_blob_owners(const Layer* layer, const std::vector<Mat>& bottom_blobs, const std::vector<Mat>& top_blobs, std::vector<Mat>& blob_owners)
+{
+    for (size_t i = 0; i < top_blobs.size(); i++)
+    {
+        const Mat& m = top_blobs[i];
+
+        Mat& top_owner = blob_owners[layer->tops[i]];
+        top_owner.release();
+
+        if (m.refcount || !m.data)
+            continue;
+
+        for (size_t j = 0; j < bottom_blobs.size(); j++)
+        {
+            const Mat& owner = blob_owner(blob_owners, layer->bottoms[j], bottom_blobs[j]);
+            if (owner.dims == 0)
+                continue;
+
+            const unsigned char* begin = (const unsigned char*)owner.data;
+            const unsigned char* end = begin + owner.total() * owner.elemsize;
+            if ((const unsigned char*)m.data >= begin && (const unsigned char*)m.data < end)
+            {
+                top_owner = owner;
+                break;
+            }
+        }
+    }
+}
+
+int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt, std::vector<Mat>* blob_slices, std::vector<Mat>* blob_owners) const
 {
     if (layer->one_blob_only)
     {
@@ -559,7 +1003,8 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
         if (opt.lightmode)
         {
             // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+            // a concat slice is owned by this chain alone
+            if (layer->support_inplace && !is_concat_slice(blob_slices, bottom_blob_index, bottom_blob_ref) && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
             {
                 bottom_blob = bottom_blob_ref.clone(opt.blob_allocator);
                 if (bottom_blob.empty())
@@ -571,15 +1016,25 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
             bottom_blob = bottom_blob_ref;
         }
 
+        if (bottom_blob.is_strided() && !layer->support_strided_input)
+        {
+            bottom_blob = bottom_blob.clone(opt.blob_allocator);
+            if (bottom_blob.empty())
+                return -100;
+        }
+
         int ret = convert_layout(bottom_blob, layer, opt);
         if (ret != 0)
             return ret;
 
+        Option opt1 = opt;
+        opt1.num_threads = get_layer_num_threads(layer, &bottom_blob, 1, opt);
+
         // forward
         if (opt.lightmode && layer->support_inplace)
         {
             Mat& bottom_top_blob = bottom_blob;
-            int ret = layer->forward_inplace(bottom_top_blob, opt);
+            int ret = layer->forward_inplace(bottom_top_blob, opt1);
             if (ret != 0)
                 return ret;
 
@@ -588,10 +1043,33 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
         }
         else
         {
+            // write into the concat slice if there is one
             Mat top_blob;
-            int ret = layer->forward(bottom_blob, top_blob, opt);
-            if (ret != 0)
-                return ret;
+            if (blob_slices)
+                top_blob = (*blob_slices)[top_blob_index];
+
+            if (blob_owners)
+            {
+                std::vector<Mat> bottom_blobs(1, bottom_blob);
+                std::vector<Mat> top_blobs(1, top_blob);
+
+                if (top_blob.dims != 0 || !has_blob_owner(layer, bottom_blobs, *blob_owners) || !forward_view(layer, bottom_blobs, top_blobs))
+                {
+                    int ret = layer->forward(bottom_blob, top_blobs[0], opt1);
+                    if (ret != 0)
+                        return ret;
+                }
+
+                track_blob_owners(layer, bottom_blobs, top_blobs, *blob_owners);
+
+                top_blob = top_blobs[0];
+            }
+            else
+            {
+                int ret = layer->forward(bottom_blob, top_blob, opt1);
+                if (ret != 0)
+                    return ret;
+            }
 
             // store top blob
             blob_mats[top_blob_index] = top_blob;
@@ -601,6 +1079,9 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
         {
             // delete after taken in light mode
             blob_mats[bottom_blob_index].release();
+
+            if (blob_owners)
+                (*blob_owners)[bottom_blob_index].release();
         }
     }
     else
@@ -616,7 +1097,7 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
             if (opt.lightmode)
             {
                 // deep copy for inplace forward if data is shared
-                if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+                if (layer->support_inplace && !is_concat_slice(blob_slices, bottom_blob_index, bottom_blob_ref) && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
                 {
                     bottom_blobs[i] = bottom_blob_ref.clone(opt.blob_allocator);
                     if (bottom_blobs[i].empty())
@@ -628,16 +1109,26 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
                 bottom_blobs[i] = bottom_blob_ref;
             }
 
+            if (bottom_blobs[i].is_strided() && !layer->support_strided_input)
+            {
+                bottom_blobs[i] = bottom_blobs[i].clone(opt.blob_allocator);
+                if (bottom_blobs[i].empty())
+                    return -100;
+            }
+
             int ret = convert_layout(bottom_blobs[i], layer, opt);
             if (ret != 0)
                 return ret;
         }
 
+        Option opt1 = opt;
+        opt1.num_threads = get_layer_num_threads(layer, bottom_blobs.empty() ? 0 : &bottom_blobs[0], bottom_blobs.size(), opt);
+
         // forward
         if (opt.lightmode && layer->support_inplace)
         {
             std::vector<Mat>& bottom_top_blobs = bottom_blobs;
-            int ret = layer->forward_inplace(bottom_top_blobs, opt);
+            int ret = layer->forward_inplace(bottom_top_blobs, opt1);
             if (ret != 0)
                 return ret;
 
@@ -652,9 +1143,47 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
         else
         {
             std::vector<Mat> top_blobs(layer->tops.size());
-            int ret = layer->forward(bottom_blobs, top_blobs, opt);
-            if (ret != 0)
-                return ret;
+            if (blob_slices)
+            {
+                for (size_t i = 0; i < layer->tops.size(); i++)
+                {
+                    top_blobs[i] = (*blob_slices)[layer->tops[i]];
+                }
+            }
+
+            if (blob_slices && layer->typeindex == LayerType::Concat)
+            {
+                // the concat output is ready once every bottom sits in its slice
+                if (!gather_concat_slices(layer, bottom_blobs, top_blobs[0], *blob_slices))
+                {
+                    top_blobs[0].release();
+
+                    int ret = layer->forward(bottom_blobs, top_blobs, opt1);
+                    if (ret != 0)
+                        return ret;
+                }
+
+                learn_concat_plan(layer, bottom_blobs, top_blobs[0]);
+            }
+            else
+            {
+                bool top_blobs_empty = true;
+                for (size_t i = 0; i < top_blobs.size(); i++)
+                {
+                    if (top_blobs[i].dims != 0)
+                        top_blobs_empty = false;
+                }
+
+                if (!blob_owners || !top_blobs_empty || !has_blob_owner(layer, bottom_blobs, *blob_owners) || !forward_view(layer, bottom_blobs, top_blobs))
+                {
+                    int ret = layer->forward(bottom_blobs, top_blobs, opt1);
+                    if (ret != 0)
+                        return ret;
+                }
+            }
+
+            if (blob_owners)
+                track_blob_owners(layer, bottom_blobs, top_blobs, *blob_owners);
 
             // store top blobs
             for (size_t i = 0; i < layer->tops.size(); i++)
@@ -673,6 +1202,9 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
 
                 // delete after taken in light mode
                 blob_mats[bottom_blob_index].release();
+
+                if (blob_owners)
+                    (*blob_owners)[bottom_blob_index].release();
             }
         }
     }
@@ -680,41 +1212,152 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
     return 0;
 }
 
-#if NCNN_VULKAN
-int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
+int NetPrivate::plan_concat_slices(const Layer* layer, const std::vector<Mat>& blob_mats, std::vector<Mat>& blob_slices, std::vector<int>& slice_blob_indexes, const Option& opt) const
 {
-    if (layer->one_blob_only)
+    const int top_blob_index = layer->tops[0];
+
+    ConcatPlan plan;
     {
-        // load bottom blob
-        int bottom_blob_index = layer->bottoms[0];
-        int top_blob_index = layer->tops[0];
+        MutexLockGuard guard(concat_plan_lock);
+        if (concat_plans.empty())
+            return 0;
 
-        VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
-        VkMat bottom_blob;
+        plan = concat_plans[top_blob_index];
+    }
 
-        if (opt.lightmode)
-        {
-            // deep copy for inplace forward if data is shared
-            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
-            {
-                cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
-                //                     NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blob.buffer(), bottom_blob.buffer_offset());
-            }
-        }
-        if (bottom_blob.dims == 0)
-        {
-            bottom_blob = bottom_blob_ref;
-        }
+    if (plan.channels.empty() || plan.channels.size() != layer->bottoms.size())
+        return 0;
 
-        // forward
-        if (opt.lightmode && layer->support_inplace)
-        {
-            VkMat& bottom_top_blob = bottom_blob;
-            int ret = layer->forward_inplace(bottom_top_blob, cmd, opt);
-            if (ret != 0)
-                return ret;
+    int channels = 0;
+    for (size_t i = 0; i < plan.channels.size(); i++)
+    {
+        channels += plan.channels[i];
+    }
 
-            // store top blob
+    // reuse the slice of an outer concat as our output
+    Mat top_blob = blob_slices[top_blob_index];
+    if (top_blob.dims == 0)
+    {
+        top_blob.create(plan.w, plan.h, channels, plan.elemsize, plan.elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        blob_slices[top_blob_index] = top_blob;
+        slice_blob_indexes.push_back(top_blob_index);
+    }
+    else if (top_blob.dims != 3 || top_blob.w != plan.w || top_blob.h != plan.h || top_blob.c != channels || top_blob.elemsize != plan.elemsize || top_blob.elempack != plan.elempack)
+    {
+        return 0;
+    }
+
+    int q = 0;
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        int blob_index = layer->bottoms[i];
+
+        const Mat slice = top_blob.channel_range(q, plan.channels[i]);
+        q += plan.channels[i];
+
+        if (blob_slices[blob_index].dims != 0)
+            continue;
+
+        blob_slices[blob_index] = slice;
+        slice_blob_indexes.push_back(blob_index);
+
+        if (blob_mats[blob_index].dims != 0)
+            continue;
+
+        // follow the inplace layers upward, their bottom shares the slice
+        int producer = blobs[blob_index].producer;
+        while (opt.lightmode && producer != -1)
+        {
+            const Layer* l = layers[producer];
+            if (!l->one_blob_only || !l->support_inplace || l->bottoms.size() != 1)
+                break;
+
+            int bottom_blob_index = l->bottoms[0];
+            if (blob_mats[bottom_blob_index].dims != 0 || blob_slices[bottom_blob_index].dims != 0)
+                break;
+
+            blob_slices[bottom_blob_index] = slice;
+            slice_blob_indexes.push_back(bottom_blob_index);
+
+            producer = blobs[bottom_blob_index].producer;
+        }
+    }
+
+    return 0;
+}
+
+void NetPrivate::learn_concat_plan(const Layer* layer, const std::vector<Mat>& bottom_blobs, const Mat& top_blob) const
+{
+    // channel concat of bottoms sharing the output layout
+    ConcatPlan plan;
+    plan.w = top_blob.w;
+    plan.h = top_blob.h;
+    plan.elemsize = top_blob.elemsize;
+    plan.elempack = top_blob.elempack;
+
+    int channels = 0;
+    for (size_t i = 0; i < bottom_blobs.size(); i++)
+    {
+        const Mat& m = bottom_blobs[i];
+        if (top_blob.dims != 3 || m.dims != 3 || m.w != plan.w || m.h != plan.h || m.elemsize != plan.elemsize || m.elempack != plan.elempack)
+        {
+            plan.channels.clear();
+            break;
+        }
+
+        plan.channels.push_back(m.c);
+        channels += m.c;
+    }
+
+    if (channels != top_blob.c)
+        plan.channels.clear();
+
+    MutexLockGuard guard(concat_plan_lock);
+
+    if (concat_plans.empty())
+        concat_plans.resize(blobs.size());
+
+    concat_plans[layer->tops[0]] = plan;
+}
+
+#if NCNN_VULKAN
+int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
+{
+    if (layer->one_blob_only)
+    {
+        // load bottom blob
+        int bottom_blob_index = layer->bottoms[0];
+        int top_blob_index = layer->tops[0];
+
+        VkMat& bottom_blob_ref = blob_mats_gpu[bottom_blob_index];
+        VkMat bottom_blob;
+
+        if (opt.lightmode)
+        {
+            // deep copy for inplace forward if data is shared
+            if (layer->support_inplace && *bottom_blob_ref.refcount != 1)
+            {
+                cmd.record_clone(bottom_blob_ref, bottom_blob, opt);
+                //                     NCNN_LOGE("clone %p[+%lu] %p[+%lu]", bottom_blob_ref.buffer(), bottom_blob_ref.buffer_offset(), bottom_blob.buffer(), bottom_blob.buffer_offset());
+            }
+        }
+        if (bottom_blob.dims == 0)
+        {
+            bottom_blob = bottom_blob_ref;
+        }
+
+        // forward
+        if (opt.lightmode && layer->support_inplace)
+        {
+            VkMat& bottom_top_blob = bottom_blob;
+            int ret = layer->forward_inplace(bottom_top_blob, cmd, opt);
+            if (ret != 0)
+                return ret;
+
+            // store top blob
             blob_mats_gpu[top_blob_index] = bottom_top_blob;
         }
         else
@@ -965,6 +1608,66 @@ int Net::register_custom_layer(int index, layer_creator_func creator, layer_dest
 }
 
 #if NCNN_STRING
+// blob name to index hash table for resolving bottoms while parsing param
+// open addressing with linear probing, the first blob of a name wins like find_blob_index_by_name
+class BlobNameIndex
+{
+public:
+    BlobNameIndex(const std::vector<Blob>& _blobs, int blob_count)
+        : blobs(_blobs)
+    {
+        int size = 16;
+        while (size < blob_count * 2)
+            size *= 2;
+
+        slots.resize(size, -1);
+    }
+
+    int find(const char* name) const
+    {
+        const int mask = (int)slots.size() - 1;
+        for (int i = hash(name) & mask;; i = (i + 1) & mask)
+        {
+            int index = slots[i];
+            if (index == -1 || blobs[index].name == name)
+                return index;
+        }
+    }
+
+    void insert(int index)
+    {
+        const int mask = (int)slots.size() - 1;
+        for (int i = hash(blobs[index].name.c_str()) & mask;; i = (i + 1) & mask)
+        {
+            if (slots[i] == -1)
+            {
+                slots[i] = index;
+                return;
+            }
+
+            if (blobs[slots[i]].name == blobs[index].name)
+                return;
+        }
+    }
+
+private:
+    // fnv1a
+    static int hash(const char* name)
+    {
+        unsigned int h = 0x811c9dc5;
+        while (*name)
+        {
+            h ^= (unsigned char)*name++;
+            h *= 0x01000193;
+        }
+        return (int)(h & 0x7fffffff);
+    }
+
+private:
+    const std::vector<Blob>& blobs;
+    std::vector<int> slots;
+};
+
 int Net::load_param(const DataReader& dr)
 {
 #define SCAN_VALUE(fmt, v)                \
@@ -1048,6 +1751,8 @@ int Net::load_param(const DataReader& dr)
 
     ParamDict pd;
 
+    BlobNameIndex blob_name_index(d->blobs, blob_count);
+
     int blob_index = 0;
     for (int i = 0; i < layer_count; i++)
     {
@@ -1097,7 +1802,7 @@ int Net::load_param(const DataReader& dr)
             char bottom_name[256];
             SCAN_VALUE("%255s", bottom_name)
 
-            int bottom_blob_index = find_blob_index_by_name(bottom_name);
+            int bottom_blob_index = blob_name_index.find(bottom_name);
             if (bottom_blob_index == -1)
             {
                 Blob& blob = d->blobs[blob_index];
@@ -1107,6 +1812,8 @@ int Net::load_param(const DataReader& dr)
                 blob.name = std::string(bottom_name);
                 //                 NCNN_LOGE("new blob %s", bottom_name);
 
+                blob_name_index.insert(blob_index);
+
                 blob_index++;
             }
 
@@ -1132,6 +1839,8 @@ int Net::load_param(const DataReader& dr)
 
             layer->tops[j] = blob_index;
 
+            blob_name_index.insert(blob_index);
+
             blob_index++;
         }
 
@@ -1539,79 +2248,154 @@ int Net::load_model(const DataReader& dr)
         return -1;
     }
 
-    int layer_count = (int)d->layers.size();
+    // 将数据流包装成 ModelBin
+    ModelBinFromDataReader mb(dr);
+    return d->load_model(mb);
+}
+
+bool NetPrivate::use_parallel_create_pipeline() const
+{
+    return opt.use_parallel_create_pipeline && !opt.use_vulkan_compute && opt.num_threads > 1;
+}
 
-    // load file
-    int ret = 0;
+Allocator* NetPrivate::get_layer_weight_allocator(int layer_index) const
+{
+    if (layer_weight_allocators.empty())
+        return weight_allocator;
+
+    return layer_weight_allocators[layer_index];
+}
+
+void NetPrivate::release_layer_weight_allocators()
+{
+    for (size_t i = 0; i < layer_weight_allocators.size(); i++)
+    {
+        layer_weight_allocators[i]->release();
+    }
+    layer_weight_allocators.clear();
+}
+
+void NetPrivate::prepare_load_model()
+{
+    release_layer_weight_allocators();
+
+    if (opt.use_memory_accounting)
+    {
+        layer_weight_allocators.resize(layers.size());
+        for (size_t i = 0; i < layers.size(); i++)
+        {
+            layer_weight_allocators[i] = new MemoryStatAllocator(weight_allocator);
+        }
+    }
 
 #if NCNN_VULKAN
     if (opt.use_vulkan_compute)
     {
         if (!opt.pipeline_cache)
         {
-            if (!d->pipeline_cache)
-                d->pipeline_cache = new PipelineCache(d->vkdev);
-            opt.pipeline_cache = d->pipeline_cache;
+            if (!pipeline_cache)
+                pipeline_cache = new PipelineCache(vkdev);
+            opt.pipeline_cache = pipeline_cache;
         }
     }
 #endif // NCNN_VULKAN
-    // 将数据流包装成 ModelBin
-    ModelBinFromDataReader mb(dr);
-    for (int i = 0; i < layer_count; i++)
+}
+
+// copy the weights read from mb into allocator
+class ModelBinWithAllocator : public ModelBin
+{
+public:
+    ModelBinWithAllocator(const ModelBin& _mb, Allocator* _allocator)
+        : mb(_mb), allocator(_allocator)
     {
-        Layer* layer = d->layers[i];
+    }
 
-        //Here we found inconsistent content in the parameter file.
-        if (!layer)
-        {
-            NCNN_LOGE("load_model error at layer %d, parameter file has inconsistent content.", i);
-            ret = -1;
-            break;
-        }
-        // 1. 调用每个 layer 自己的 load_model
-        int lret = layer->load_model(mb);
-        if (lret != 0)
-        {
+    virtual Mat load(int w, int type) const
+    {
+        Mat m = mb.load(w, type);
+        if (m.empty())
+            return m;
+
+        return m.clone(allocator);
+    }
+
+public:
+    const ModelBin& mb;
+    Allocator* allocator;
+};
+
+int NetPrivate::load_layer_model(int layer_index, const ModelBin& mb)
+{
+    Layer* layer = layers[layer_index];
+
+    //Here we found inconsistent content in the parameter file.
+    if (!layer)
+    {
+        NCNN_LOGE("load_model error at layer %d, parameter file has inconsistent content.", layer_index);
+        return -1;
+    }
+    // weights read from mb go to weight_allocator
+    // resolved here once, Mat::create without allocator keeps using ncnn::fastMalloc
+    Allocator* layer_weight_allocator = get_layer_weight_allocator(layer_index);
+
+    // 1. 调用每个 layer 自己的 load_model
+    int lret = layer_weight_allocator ? layer->load_model(ModelBinWithAllocator(mb, layer_weight_allocator)) : layer->load_model(mb);
+
+    if (lret != 0)
+    {
 #if NCNN_STRING
-            NCNN_LOGE("layer load_model %d %s failed", i, layer->name.c_str());
+        NCNN_LOGE("layer load_model %d %s failed", layer_index, layer->name.c_str());
 #else
-            NCNN_LOGE("layer load_model %d failed", i);
+        NCNN_LOGE("layer load_model %d failed", layer_index);
 #endif
-            ret = -1;
-            break;
-        }
+        return -1;
+    }
 
-        Option opt1 = get_masked_option(opt, layer->featmask);
-        // 调用每个 layer 自己的 create_pipeline
-        int cret = layer->create_pipeline(opt1);
-        if (cret != 0)
-        {
+    return 0;
+}
+
+int NetPrivate::create_layer_pipeline(int layer_index)
+{
+    Layer* layer = layers[layer_index];
+
+    // keep num_threads as weight packing may depend on it at inference time
+    // omp parallel regions inside run on a single thread when layers are created concurrently
+    Option opt1 = get_masked_option(opt, layer->featmask);
+    // transformed weights go to weight_allocator as well
+    opt1.weight_allocator = get_layer_weight_allocator(layer_index);
+    // 调用每个 layer 自己的 create_pipeline
+    int cret = layer->create_pipeline(opt1);
+    if (cret != 0)
+    {
 #if NCNN_STRING
-            NCNN_LOGE("layer create_pipeline %d %s failed", i, layer->name.c_str());
+        NCNN_LOGE("layer create_pipeline %d %s failed", layer_index, layer->name.c_str());
 #else
-            NCNN_LOGE("layer create_pipeline %d failed", i);
+        NCNN_LOGE("layer create_pipeline %d failed", layer_index);
 #endif
-            ret = -1;
-            break;
-        }
+        return -1;
     }
 
+    return 0;
+}
+
+int NetPrivate::finish_load_model(int ret)
+{
     if (opt.use_local_pool_allocator)
     {
         if (opt.blob_allocator == 0)
         {
-            if (!d->local_blob_allocator)
+            if (!local_blob_allocator)
             {
-                d->local_blob_allocator = new PoolAllocator;
-                d->local_blob_allocator->set_size_compare_ratio(0.f);
+                local_blob_allocator = new PoolAllocator;
+                local_blob_allocator->set_size_compare_ratio(0.f);
             }
         }
         if (opt.workspace_allocator == 0)
         {
-            if (!d->local_workspace_allocator)
+            if (!local_workspace_allocator)
             {
-                d->local_workspace_allocator = new PoolAllocator;
-                d->local_workspace_allocator->set_size_compare_ratio(0.f);
+                local_workspace_allocator = new PoolAllocator;
+                local_workspace_allocator->set_size_compare_ratio(0.f);
             }
         }
     }
@@ -1619,19 +2403,556 @@ int Net::load_model(const DataReader& dr)
 #if NCNN_VULKAN
     if (ret == 0 && opt.use_vulkan_compute)
     {
-        ret = d->upload_model();
+        ret = upload_model();
     }
 #endif // NCNN_VULKAN
 
+    model_loaded = ret == 0;
+
     return ret;
 }
 
+int NetPrivate::load_model(const ModelBin& mb)
+{
+    const int layer_count = (int)layers.size();
+
+    // weight data is read sequentially
+    // pipelines are created after all weights are read in parallel mode
+    const bool parallel = use_parallel_create_pipeline();
+
+    prepare_load_model();
+
+    int ret = 0;
+    for (int i = 0; i < layer_count; i++)
+    {
+        ret = load_layer_model(i, mb);
+        if (ret != 0)
+            break;
+
+        if (parallel)
+            continue;
+
+        ret = create_layer_pipeline(i);
+        if (ret != 0)
+            break;
+    }
+
+    if (ret == 0 && parallel)
+    {
+        std::vector<int> rets(layer_count, 0);
+
+        #pragma omp parallel for schedule(dynamic) num_threads(opt.num_threads)
+        for (int i = 0; i < layer_count; i++)
+        {
+            rets[i] = create_layer_pipeline(i);
+        }
+
+        for (int i = 0; i < layer_count; i++)
+        {
+            if (rets[i] != 0)
+            {
+                ret = -1;
+                break;
+            }
+        }
+    }
+
+    return finish_load_model(ret);
+}
+
+// single-file model container
+// see docs/developer-guide/param-and-model-file-structure.md
+struct container_header
+{
+    uint32_t magic; // 0x434E434E "NCNC"
+    uint32_t version;
+    uint32_t graph_type; // 0=plain param 1=binary param
+    uint32_t layer_count;
+    uint32_t weight_count;
+    uint32_t reserved;
+    uint64_t graph_offset;
+    uint64_t graph_size;
+    uint64_t layer_index_offset;
+    uint64_t weight_index_offset;
+    uint64_t file_size;
+};
+
+struct container_layer_entry
+{
+    uint32_t first_weight;
+    uint32_t weight_count;
+};
+
+struct container_weight_entry
+{
+    uint64_t offset; // 64-byte aligned
+    uint64_t size;
+    uint32_t type;     // 0=flagged weight 1=raw float32
+    uint32_t tag;      // storage flag of flagged weight
+    uint32_t checksum; // fnv1a of weight data words
+    uint32_t reserved;
+};
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+// hash 32bit words as weight data is always 32bit aligned, trailing bytes are hashed one by one
+static uint32_t container_checksum(const unsigned char* data, size_t size)
+{
+    uint32_t h = 0x811c9dc5;
+
+    size_t i = 0;
+    for (; i + 3 < size; i += 4)
+    {
+        uint32_t v;
+        memcpy(&v, data + i, 4);
+        h ^= v;
+        h *= 0x01000193;
+    }
+    for (; i < size; i++)
+    {
+        h ^= (uint32_t)data[i];
+        h *= 0x01000193;
+    }
+
+    return h;
+}
+
+class ModelContainer
+{
+public:
+    ModelContainer();
+
+    int parse(const unsigned char* mem);
+#if NCNN_STDIO
+    int parse(FILE* fp);
+#endif // NCNN_STDIO
+
+    // locate the data of weight i and verify its checksum
+    // data points into the external memory or into storage if read from file
+    int read_weight(int i, std::vector<unsigned char>& storage, const unsigned char*& data) const;
+
+protected:
+    int validate() const;
+
+public:
+    container_header header;
+    std::vector<container_layer_entry> layer_entries;
+    std::vector<container_weight_entry> weight_entries;
+
+    const unsigned char* graph_data;
+    std::vector<unsigned char> graph_storage;
+
+    const unsigned char* mem;
+#if NCNN_STDIO
+    FILE* fp;
+    mutable Mutex fp_lock;
+#endif // NCNN_STDIO
+};
+
+ModelContainer::ModelContainer()
+{
+    memset(&header, 0, sizeof(header));
+    graph_data = 0;
+    mem = 0;
+#if NCNN_STDIO
+    fp = 0;
+#endif // NCNN_STDIO
+}
+
+int ModelContainer::validate() const
+{
+    if (header.magic != 0x434E434E)
+    {
+        NCNN_LOGE("invalid container magic %x", header.magic);
+        return -1;
+    }
+
+    if (header.version != 1)
+    {
+        NCNN_LOGE("unsupported container version %u", header.version);
+        return -1;
+    }
+
+    if (header.graph_type > 1 || header.graph_size == 0 || header.graph_offset + header.graph_size > header.file_size)
+    {
+        NCNN_LOGE("invalid container graph section");
+        return -1;
+    }
+
+    if (header.layer_index_offset + header.layer_count * sizeof(container_layer_entry) > header.file_size
+            || header.weight_index_offset + header.weight_count * sizeof(container_weight_entry) > header.file_size)
+    {
+        NCNN_LOGE("invalid container index section");
+        return -1;
+    }
+
+    return 0;
+}
+
+int ModelContainer::parse(const unsigned char* _mem)
+{
+    mem = _mem;
+
+    memcpy(&header, mem, sizeof(header));
+    if (validate() != 0)
+        return -1;
+
+    graph_data = mem + header.graph_offset;
+
+    layer_entries.resize(header.layer_count);
+    if (header.layer_count)
+        memcpy(&layer_entries[0], mem + header.layer_index_offset, header.layer_count * sizeof(container_layer_entry));
+
+    weight_entries.resize(header.weight_count);
+    if (header.weight_count)
+        memcpy(&weight_entries[0], mem + header.weight_index_offset, header.weight_count * sizeof(container_weight_entry));
+
+    return 0;
+}
+
+#if NCNN_STDIO
+int ModelContainer::parse(FILE* _fp)
+{
+    fp = _fp;
+
+    long base = ftell(fp);
+
+    if (fread(&header, sizeof(header), 1, fp) != 1)
+    {
+        NCNN_LOGE("read container header failed");
+        return -1;
+    }
+
+    if (validate() != 0)
+        return -1;
+
+    // keep plain param null terminated
+    graph_storage.resize(header.graph_size + 1, 0);
+    graph_data = &graph_storage[0];
+
+    layer_entries.resize(header.layer_count);
+    weight_entries.resize(header.weight_count);
+
+    int ret = fseek(fp, base + (long)header.graph_offset, SEEK_SET);
+    if (ret != 0 || fread(&graph_storage[0], header.graph_size, 1, fp) != 1)
+    {
+        NCNN_LOGE("read container graph failed");
+        return -1;
+    }
+
+    if (header.layer_count)
+    {
+        ret = fseek(fp, base + (long)header.layer_index_offset, SEEK_SET);
+        if (ret != 0 || fread(&layer_entries[0], header.layer_count * sizeof(container_layer_entry), 1, fp) != 1)
+        {
+            NCNN_LOGE("read container layer index failed");
+            return -1;
+        }
+    }
+
+    if (header.weight_count)
+    {
+        ret = fseek(fp, base + (long)header.weight_index_offset, SEEK_SET);
+        if (ret != 0 || fread(&weight_entries[0], header.weight_count * sizeof(container_weight_entry), 1, fp) != 1)
+        {
+            NCNN_LOGE("read container weight index failed");
+            return -1;
+        }
+    }
+
+    // weights are read relative to the container start
+    header.file_size += base;
+    for (size_t i = 0; i < weight_entries.size(); i++)
+    {
+        weight_entries[i].offset += base;
+    }
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+int ModelContainer::read_weight(int i, std::vector<unsigned char>& storage, const unsigned char*& data) const
+{
+    const container_weight_entry& e = weight_entries[i];
+
+    if (e.offset + e.size > header.file_size)
+    {
+        NCNN_LOGE("container weight %d out of range", i);
+        return -1;
+    }
+
+    if (mem)
+    {
+        data = mem + e.offset;
+    }
+#if NCNN_STDIO
+    else
+    {
+        storage.resize(e.size + 1);
+
+        MutexLockGuard guard(fp_lock);
+        if (fseek(fp, (long)e.offset, SEEK_SET) != 0 || (e.size && fread(&storage[0], e.size, 1, fp) != 1))
+        {
+            NCNN_LOGE("read container weight %d failed", i);
+            return -1;
+        }
+
+        data = &storage[0];
+    }
+#endif // NCNN_STDIO
+
+    if (container_checksum(data, e.size) != e.checksum)
+    {
+        NCNN_LOGE("container weight %d checksum mismatch", i);
+        return -1;
+    }
+
+    return 0;
+}
+
+// feed the storage flag kept in the container index ahead of the weight data
+class DataReaderFromContainerWeight : public DataReader
+{
+public:
+    DataReaderFromContainerWeight(const container_weight_entry& e, const unsigned char* data, bool referenceable);
+
+    virtual size_t read(void* buf, size_t size) const;
+    virtual size_t reference(size_t size, const void** buf) const;
+
+public:
+    unsigned char tag[4];
+    size_t tag_size;
+    mutable size_t tag_pos;
+
+    const unsigned char* data;
+    size_t data_size;
+    mutable size_t data_pos;
+
+    bool referenceable;
+};
+
+DataReaderFromContainerWeight::DataReaderFromContainerWeight(const container_weight_entry& e, const unsigned char* _data, bool _referenceable)
+{
+    memcpy(tag, &e.tag, 4);
+    tag_size = e.type == 0 ? 4 : 0;
+    tag_pos = 0;
+
+    data = _data;
+    data_size = e.size;
+    data_pos = 0;
+
+    referenceable = _referenceable;
+}
+
+size_t DataReaderFromContainerWeight::read(void* buf, size_t size) const
+{
+    unsigned char* p = (unsigned char*)buf;
+
+    size_t nread = 0;
+    while (nread < size && tag_pos < tag_size)
+    {
+        p[nread++] = tag[tag_pos++];
+    }
+
+    size_t n = std::min(size - nread, data_size - data_pos);
+    memcpy(p + nread, data + data_pos, n);
+    data_pos += n;
+
+    return nread + n;
+}
+
+size_t DataReaderFromContainerWeight::reference(size_t size, const void** buf) const
+{
+    if (!referenceable || tag_pos < tag_size || data_size - data_pos < size)
+        return 0;
+
+    *buf = data + data_pos;
+    data_pos += size;
+
+    return size;
+}
+
+class ModelBinFromContainer : public ModelBin
+{
+public:
+    ModelBinFromContainer(const ModelContainer& c, int first_weight, int weight_count);
+
+    virtual Mat load(int w, int type) const;
+
+public:
+    const ModelContainer& c;
+    int weight_end;
+    mutable int weight_index;
+};
+
+ModelBinFromContainer::ModelBinFromContainer(const ModelContainer& _c, int first_weight, int weight_count)
+    : c(_c)
+{
+    weight_index = first_weight;
+    weight_end = first_weight + weight_count;
+}
+
+Mat ModelBinFromContainer::load(int w, int type) const
+{
+    if (weight_index >= weight_end)
+    {
+        NCNN_LOGE("container has no more weight for load %d", w);
+        return Mat();
+    }
+
+    const int i = weight_index++;
+    const container_weight_entry& e = c.weight_entries[i];
+
+    if ((int)e.type != type)
+    {
+        NCNN_LOGE("container weight %d type %u mismatch %d", i, e.type, type);
+        return Mat();
+    }
+
+    std::vector<unsigned char> storage;
+    const unsigned char* data = 0;
+    if (c.read_weight(i, storage, data) != 0)
+        return Mat();
+
+    // weight read from file is copied out of storage by ModelBinFromDataReader
+    DataReaderFromContainerWeight dr(e, data, storage.empty());
+    ModelBinFromDataReader mb(dr);
+
+    Mat m = mb.load(w, type);
+
+    if (!m.empty() && (dr.tag_pos != dr.tag_size || dr.data_pos != dr.data_size))
+    {
+        NCNN_LOGE("container weight %d size mismatch %d", i, w);
+        return Mat();
+    }
+
+    return m;
+}
+
+static int load_container_graph(Net& net, const ModelContainer& c)
+{
+    const unsigned char* mem = c.graph_data;
+    DataReaderFromMemory dr(mem);
+
+    if (c.header.graph_type == 1)
+        return net.load_param_bin(dr);
+
+#if NCNN_STRING
+    if (c.graph_data[c.header.graph_size - 1] != '\0' && c.graph_storage.empty())
+    {
+        NCNN_LOGE("container plain param is not null terminated");
+        return -1;
+    }
+
+    return net.load_param(dr);
+#else
+    NCNN_LOGE("plain param in container requires NCNN_STRING");
+    return -1;
+#endif // NCNN_STRING
+}
+
+int NetPrivate::load_container_layer(const ModelContainer& c, int layer_index)
+{
+    const container_layer_entry& e = c.layer_entries[layer_index];
+    if ((size_t)e.first_weight + e.weight_count > c.weight_entries.size())
+    {
+        NCNN_LOGE("container layer %d weight index out of range", layer_index);
+        return -1;
+    }
+
+    ModelBinFromContainer mb(c, e.first_weight, e.weight_count);
+    int ret = load_layer_model(layer_index, mb);
+    if (ret != 0)
+        return ret;
+
+    if (mb.weight_index != mb.weight_end)
+    {
+        NCNN_LOGE("container layer %d has %d unused weights", layer_index, mb.weight_end - mb.weight_index);
+        return -1;
+    }
+
+    return create_layer_pipeline(layer_index);
+}
+
+int NetPrivate::load_model(const ModelContainer& c)
+{
+    const int layer_count = (int)layers.size();
+
+    // every layer locates its own weights through the layer index
+    // so weight reading runs in parallel as well
+    const bool parallel = use_parallel_create_pipeline();
+
+    prepare_load_model();
+
+    std::vector<int> rets(layer_count, 0);
+
+    #pragma omp parallel for schedule(dynamic) num_threads(parallel ? opt.num_threads : 1)
+    for (int i = 0; i < layer_count; i++)
+    {
+        rets[i] = load_container_layer(c, i);
+    }
+
+    int ret = 0;
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (rets[i] != 0)
+        {
+            ret = -1;
+            break;
+        }
+    }
+
+    return finish_load_model(ret);
+}
+
+int NetPrivate::load_container(Net& net, const ModelContainer& c)
+{
+    int ret = load_container_graph(net, c);
+    if (ret != 0)
+        return ret;
+
+    if ((int)c.layer_entries.size() != (int)layers.size())
+    {
+        NCNN_LOGE("container layer count %d mismatch %d", (int)c.layer_entries.size(), (int)layers.size());
+        return -1;
+    }
+
+    return load_model(c);
+}
+
 #if NCNN_STDIO
 #if NCNN_STRING
 int Net::load_param(FILE* fp)
 {
-    DataReaderFromStdio dr(fp);
-    return load_param(dr);
+    // parse from memory instead of fscanf token by token
+    // fallback to stdio when the stream is not seekable
+    long pos = ftell(fp);
+    if (pos < 0 || fseek(fp, 0, SEEK_END) != 0)
+    {
+        DataReaderFromStdio dr(fp);
+        return load_param(dr);
+    }
+
+    long end = ftell(fp);
+    fseek(fp, pos, SEEK_SET);
+    if (end < pos)
+    {
+        DataReaderFromStdio dr(fp);
+        return load_param(dr);
+    }
+
+    const size_t size = (size_t)(end - pos);
+    std::vector<char> text(size + 1);
+    size_t nread = fread(text.data(), 1, size, fp);
+    text[nread] = '\0';
+
+    const unsigned char* mem = (const unsigned char*)text.data();
+    DataReaderFromMemory dr(mem);
+    int ret = load_param(dr);
+
+    // leave the stream right after the parsed text like fscanf does
+    fseek(fp, pos + (long)(mem - (const unsigned char*)text.data()), SEEK_SET);
+
+    return ret;
 }
 
 int Net::load_param_mem(const char* _mem)
@@ -1695,6 +3016,30 @@ int Net::load_model(const char* modelpath)
     fclose(fp);
     return ret;
 }
+
+int Net::load_container(FILE* fp)
+{
+    ModelContainer c;
+    int ret = c.parse(fp);
+    if (ret != 0)
+        return ret;
+
+    return d->load_container(*this, c);
+}
+
+int Net::load_container(const char* containerpath)
+{
+    FILE* fp = fopen(containerpath, "rb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", containerpath);
+        return -1;
+    }
+
+    int ret = load_container(fp);
+    fclose(fp);
+    return ret;
+}
 #endif // NCNN_STDIO
 
 int Net::load_param(const unsigned char* _mem)
@@ -1713,6 +3058,20 @@ int Net::load_model(const unsigned char* _mem)
     return static_cast<int>(mem - _mem);
 }
 
+int Net::load_container(const unsigned char* mem)
+{
+    ModelContainer c;
+    int ret = c.parse(mem);
+    if (ret != 0)
+        return ret;
+
+    ret = d->load_container(*this, c);
+    if (ret != 0)
+        return ret;
+
+    return static_cast<int>(c.header.file_size);
+}
+
 #if NCNN_PLATFORM_API
 #if __ANDROID_API__ >= 9
 #if NCNN_STRING
@@ -1781,7 +3140,12 @@ int Net::load_model(AAssetManager* mgr, const char* assetpath)
 
 void Net::clear()
 {
+    d->model_loaded = false;
     d->blobs.clear();
+    {
+        MutexLockGuard guard(d->concat_plan_lock);
+        d->concat_plans.clear();
+    }
     for (size_t i = 0; i < d->layers.size(); i++)
     {
         Layer* layer = d->layers[i];
@@ -1833,6 +3197,8 @@ void Net::clear()
     }
     d->layers.clear();
 
+    d->release_layer_weight_allocators();
+
     if (d->local_blob_allocator)
     {
         delete d->local_blob_allocator;
@@ -1869,6 +3235,105 @@ Extractor Net::create_extractor() const
     return Extractor(this, d->blobs.size());
 }
 
+int Net::infer_shapes(const std::vector<Mat>& input_shapes, std::vector<Mat>& blob_shapes) const
+{
+    const size_t blob_count = d->blobs.size();
+    const size_t layer_count = d->layers.size();
+
+    blob_shapes.clear();
+    blob_shapes.resize(blob_count);
+
+    for (size_t i = 0; i < input_shapes.size() && i < d->input_blob_indexes.size(); i++)
+    {
+        blob_shapes[d->input_blob_indexes[i]] = input_shapes[i].shape();
+    }
+
+    // layers without shape function are run on zero blobs
+    Option opt1 = d->opt;
+    opt1.lightmode = false;
+    std::vector<Mat> blob_mats;
+
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        const Layer* layer = d->layers[i];
+
+        // skip layer detached from graph
+        bool is_producer = layer->tops.empty();
+        for (size_t j = 0; j < layer->tops.size(); j++)
+        {
+            if (d->blobs[layer->tops[j]].producer == (int)i)
+                is_producer = true;
+        }
+        if (!is_producer)
+            continue;
+
+        std::vector<Mat> bottom_shapes(layer->bottoms.size());
+        bool bottoms_resolved = true;
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            bottom_shapes[j] = blob_shapes[layer->bottoms[j]];
+            if (bottom_shapes[j].dims == 0)
+                bottoms_resolved = false;
+        }
+
+        std::vector<Mat> top_shapes(layer->tops.size());
+        int ret = bottoms_resolved ? layer->infer_shape(bottom_shapes, top_shapes) : -1;
+        if (bottoms_resolved && ret == -1 && d->model_loaded && !(layer->support_vulkan && opt1.use_vulkan_compute))
+        {
+            if (blob_mats.empty())
+                blob_mats.resize(blob_count);
+
+            for (size_t j = 0; j < layer->bottoms.size(); j++)
+            {
+                Mat m;
+                m.create_like(bottom_shapes[j]);
+                if (m.empty())
+                    return -100;
+
+                m.fill(0.f);
+                blob_mats[layer->bottoms[j]] = m;
+            }
+
+            ret = d->do_forward_layer(layer, blob_mats, get_masked_option(opt1, layer->featmask));
+            if (ret != 0)
+            {
+#if NCNN_STRING
+                NCNN_LOGE("infer_shapes forward layer %s failed", layer->name.c_str());
+#else
+                NCNN_LOGE("infer_shapes forward layer %d failed", (int)i);
+#endif
+                return ret;
+            }
+
+            for (size_t j = 0; j < layer->tops.size(); j++)
+            {
+                top_shapes[j] = blob_mats[layer->tops[j]].shape();
+                blob_mats[layer->tops[j]].release();
+            }
+            for (size_t j = 0; j < layer->bottoms.size(); j++)
+            {
+                blob_mats[layer->bottoms[j]].release();
+            }
+        }
+
+        for (size_t j = 0; j < layer->tops.size(); j++)
+        {
+            Mat& top_shape = blob_shapes[layer->tops[j]];
+            if (top_shape.dims != 0 || d->blobs[layer->tops[j]].producer != (int)i)
+                continue;
+
+            if (ret == 0)
+                top_shape = top_shapes[j];
+
+            // fall back to shape hint from param
+            if (top_shape.dims == 0)
+                top_shape = d->blobs[layer->tops[j]].shape;
+        }
+    }
+
+    return 0;
+}
+
 const std::vector<int>& Net::input_indexes() const
 {
     return d->input_blob_indexes;
@@ -1911,6 +3376,30 @@ std::vector<Layer*>& Net::mutable_layers()
     return d->layers;
 }
 
+void Net::set_weight_allocator(Allocator* allocator)
+{
+    d->weight_allocator = allocator;
+}
+
+size_t Net::weight_bytes() const
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < d->layer_weight_allocators.size(); i++)
+    {
+        bytes += d->layer_weight_allocators[i]->get_bytes();
+    }
+
+    return bytes;
+}
+
+size_t Net::layer_weight_bytes(int layer_index) const
+{
+    if (layer_index < 0 || layer_index >= (int)d->layer_weight_allocators.size())
+        return 0;
+
+    return d->layer_weight_allocators[layer_index]->get_bytes();
+}
+
 #if NCNN_VULKAN
 void Net::set_vulkan_device(int device_index)
 {
@@ -2036,13 +3525,69 @@ class ExtractorPrivate
 {
 public:
     ExtractorPrivate(const Net* _net)
-        : net(_net)
+        : net(_net), blob_stat_allocator(0), workspace_stat_allocator(0)
+    {
+    }
+
+    void share_stat_allocators(const ExtractorPrivate* rhs)
+    {
+        release_stat_allocators();
+
+        blob_stat_allocator = rhs->blob_stat_allocator;
+        workspace_stat_allocator = rhs->workspace_stat_allocator;
+        if (blob_stat_allocator)
+            blob_stat_allocator->addref();
+        if (workspace_stat_allocator)
+            workspace_stat_allocator->addref();
+    }
+
+    void release_stat_allocators()
+    {
+        if (blob_stat_allocator)
+            blob_stat_allocator->release();
+        if (workspace_stat_allocator)
+            workspace_stat_allocator->release();
+
+        blob_stat_allocator = 0;
+        workspace_stat_allocator = 0;
+    }
+
+    std::vector<Mat>* get_blob_slices()
+    {
+        if (!opt.use_zero_copy_concat || !opt.lightmode)
+            return 0;
+
+        if (blob_slices.size() != blob_mats.size())
+            blob_slices.resize(blob_mats.size());
+
+        return &blob_slices;
+    }
+
+    std::vector<Mat>* get_blob_owners()
     {
+        if (!opt.use_blob_view)
+            return 0;
+
+        if (blob_owners.size() != blob_mats.size())
+            blob_owners.resize(blob_mats.size());
+
+        return &blob_owners;
     }
+
     const Net* net;
     std::vector<Mat> blob_mats;
     Option opt;
 
+    // concat slices pending during forward, see opt.use_zero_copy_concat
+    std::vector<Mat> blob_slices;
+
+    // the blob each view blob points into, see opt.use_blob_view
+    std::vector<Mat> blob_owners;
+
+    // memory accounting, installed as opt allocators on first extract
+    MemoryStatAllocator* blob_stat_allocator;
+    MemoryStatAllocator* workspace_stat_allocator;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2072,6 +3617,8 @@ Extractor::~Extractor()
 {
     clear();
 
+    d->release_stat_allocators();
+
     delete d;
 }
 
@@ -2080,7 +3627,9 @@ Extractor::Extractor(const Extractor& rhs)
 {
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->blob_owners = rhs.d->blob_owners;
     d->opt = rhs.d->opt;
+    d->share_stat_allocators(rhs.d);
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2097,7 +3646,9 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->blob_owners = rhs.d->blob_owners;
     d->opt = rhs.d->opt;
+    d->share_stat_allocators(rhs.d);
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2112,6 +3663,7 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 void Extractor::clear()
 {
     d->blob_mats.clear();
+    d->blob_owners.clear();
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
@@ -2153,6 +3705,26 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     d->opt.workspace_allocator = allocator;
 }
 
+size_t Extractor::blob_bytes() const
+{
+    return d->blob_stat_allocator ? d->blob_stat_allocator->get_bytes() : 0;
+}
+
+size_t Extractor::peak_blob_bytes() const
+{
+    return d->blob_stat_allocator ? d->blob_stat_allocator->get_peak_bytes() : 0;
+}
+
+size_t Extractor::workspace_bytes() const
+{
+    return d->workspace_stat_allocator ? d->workspace_stat_allocator->get_bytes() : 0;
+}
+
+size_t Extractor::peak_workspace_bytes() const
+{
+    return d->workspace_stat_allocator ? d->workspace_stat_allocator->get_peak_bytes() : 0;
+}
+
 #if NCNN_VULKAN
 void Extractor::set_vulkan_compute(bool enable)
 {
@@ -2176,6 +3748,163 @@ void Extractor::set_staging_vkallocator(VkAllocator* allocator)
 }
 #endif // NCNN_VULKAN
 
+// spatial geometry of a blob relative to the input blob
+// output position x reads input [x * stride_w - pad_w, x * stride_w - pad_w + extent_w)
+struct TileGeometry
+{
+    int w;
+    int h;
+    int stride_w;
+    int stride_h;
+    int pad_w;
+    int pad_h;
+    int extent_w;
+    int extent_h;
+};
+
+static int tile_geometry_window(const TileGeometry& g, int kernel_extent_w, int kernel_extent_h, int stride_w, int stride_h, int pad_left, int pad_right, int pad_top, int pad_bottom, TileGeometry& out)
+{
+    if (pad_left < 0 || pad_right < 0 || pad_top < 0 || pad_bottom < 0)
+        return -1;
+
+    if (g.w + pad_left + pad_right < kernel_extent_w || g.h + pad_top + pad_bottom < kernel_extent_h)
+        return -1;
+
+    out.w = (g.w + pad_left + pad_right - kernel_extent_w) / stride_w + 1;
+    out.h = (g.h + pad_top + pad_bottom - kernel_extent_h) / stride_h + 1;
+    out.stride_w = g.stride_w * stride_w;
+    out.stride_h = g.stride_h * stride_h;
+    out.pad_w = pad_left * g.stride_w + g.pad_w;
+    out.pad_h = pad_top * g.stride_h + g.pad_h;
+    out.extent_w = (kernel_extent_w - 1) * g.stride_w + g.extent_w;
+    out.extent_h = (kernel_extent_h - 1) * g.stride_h + g.extent_h;
+
+    return 0;
+}
+
+static int resolve_tile_geometry(const Layer* layer, const std::vector<TileGeometry>& geometry, TileGeometry& out)
+{
+    const TileGeometry& g = geometry[layer->bottoms[0]];
+
+    switch (layer->typeindex)
+    {
+    case LayerType::Convolution:
+    {
+        const Convolution* op = (const Convolution*)layer;
+        if (layer->bottoms.size() != 1 || op->dynamic_weight)
+            return -1;
+
+        const int kernel_extent_w = op->dilation_w * (op->kernel_w - 1) + 1;
+        const int kernel_extent_h = op->dilation_h * (op->kernel_h - 1) + 1;
+        return tile_geometry_window(g, kernel_extent_w, kernel_extent_h, op->stride_w, op->stride_h, op->pad_left, op->pad_right, op->pad_top, op->pad_bottom, out);
+    }
+    case LayerType::ConvolutionDepthWise:
+    {
+        const ConvolutionDepthWise* op = (const ConvolutionDepthWise*)layer;
+        if (layer->bottoms.size() != 1 || op->dynamic_weight)
+            return -1;
+
+        const int kernel_extent_w = op->dilation_w * (op->kernel_w - 1) + 1;
+        const int kernel_extent_h = op->dilation_h * (op->kernel_h - 1) + 1;
+        return tile_geometry_window(g, kernel_extent_w, kernel_extent_h, op->stride_w, op->stride_h, op->pad_left, op->pad_right, op->pad_top, op->pad_bottom, out);
+    }
+    case LayerType::Pooling:
+    {
+        const Pooling* op = (const Pooling*)layer;
+        if (op->global_pooling || op->adaptive_pooling)
+            return -1;
+
+        if (op->pad_mode == 1) // valid padding
+            return tile_geometry_window(g, op->kernel_w, op->kernel_h, op->stride_w, op->stride_h, op->pad_left, op->pad_right, op->pad_top, op->pad_bottom, out);
+
+        if (op->pad_mode != 0)
+            return -1;
+
+        // full padding, the tail pad only extends the last window
+        int wtailpad = 0;
+        int htailpad = 0;
+        int wtail = (g.w + op->pad_left + op->pad_right - op->kernel_w) % op->stride_w;
+        int htail = (g.h + op->pad_top + op->pad_bottom - op->kernel_h) % op->stride_h;
+        if (wtail != 0)
+            wtailpad = op->stride_w - wtail;
+        if (htail != 0)
+            htailpad = op->stride_h - htail;
+
+        return tile_geometry_window(g, op->kernel_w, op->kernel_h, op->stride_w, op->stride_h, op->pad_left, op->pad_right + wtailpad, op->pad_top, op->pad_bottom + htailpad, out);
+    }
+    case LayerType::BinaryOp:
+    case LayerType::Eltwise:
+    case LayerType::Concat:
+    {
+        if (layer->typeindex == LayerType::BinaryOp && ((const BinaryOp*)layer)->with_scalar == 0 && layer->bottoms.size() != 2)
+            return -1;
+
+        if (layer->typeindex == LayerType::Concat && ((const Concat*)layer)->axis != 0 && ((const Concat*)layer)->axis != -3)
+            return -1;
+
+        // no broadcast, the receptive field is the union of all operands
+        out = g;
+        for (size_t i = 1; i < layer->bottoms.size(); i++)
+        {
+            const TileGeometry& g1 = geometry[layer->bottoms[i]];
+            if (g1.w != g.w || g1.h != g.h || g1.stride_w != g.stride_w || g1.stride_h != g.stride_h)
+                return -1;
+
+            const int end_w = std::max(out.extent_w - out.pad_w, g1.extent_w - g1.pad_w);
+            const int end_h = std::max(out.extent_h - out.pad_h, g1.extent_h - g1.pad_h);
+            out.pad_w = std::max(out.pad_w, g1.pad_w);
+            out.pad_h = std::max(out.pad_h, g1.pad_h);
+            out.extent_w = end_w + out.pad_w;
+            out.extent_h = end_h + out.pad_h;
+        }
+
+        return 0;
+    }
+    case LayerType::AbsVal:
+    case LayerType::BatchNorm:
+    case LayerType::Bias:
+    case LayerType::BNLL:
+    case LayerType::CELU:
+    case LayerType::Clip:
+    case LayerType::Dropout:
+    case LayerType::ELU:
+    case LayerType::Erf:
+    case LayerType::Exp:
+    case LayerType::GELU:
+    case LayerType::HardSigmoid:
+    case LayerType::HardSwish:
+    case LayerType::Log:
+    case LayerType::Mish:
+    case LayerType::Noop:
+    case LayerType::Power:
+    case LayerType::PReLU:
+    case LayerType::ReLU:
+    case LayerType::Scale:
+    case LayerType::SELU:
+    case LayerType::ShuffleChannel:
+    case LayerType::Shrink:
+    case LayerType::Sigmoid:
+    case LayerType::Softplus:
+    case LayerType::Split:
+    case LayerType::Swish:
+    case LayerType::TanH:
+    case LayerType::Threshold:
+    case LayerType::UnaryOp:
+    {
+        // per pixel operators
+        if (layer->bottoms.size() != 1)
+            return -1;
+
+        out = g;
+        return 0;
+    }
+    default:
+        break;
+    }
+
+    return -1;
+}
+
 #if NCNN_STRING
 int Extractor::input(const char* blob_name, const Mat& in)
 {
@@ -2212,6 +3941,18 @@ int Extractor::extract(const char* blob_name, Mat& feat, int type)
 
     return extract(blob_index, feat, type);
 }
+
+int Extractor::extract_tiled(const char* blob_name, Mat& feat, int tile_w, int tile_h, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("find_blob_index_by_name %s failed", blob_name);
+        return -1;
+    }
+
+    return extract_tiled(blob_index, feat, tile_w, tile_h, type);
+}
 #endif // NCNN_STRING
 
 int Extractor::input(int blob_index, const Mat& in)
@@ -2254,6 +3995,14 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
             }
         }
 
+        if (d->opt.use_memory_accounting && !d->opt.use_vulkan_compute && !d->blob_stat_allocator)
+        {
+            d->blob_stat_allocator = new MemoryStatAllocator(d->opt.blob_allocator);
+            d->workspace_stat_allocator = new MemoryStatAllocator(d->opt.workspace_allocator);
+            d->opt.blob_allocator = d->blob_stat_allocator;
+            d->opt.workspace_allocator = d->workspace_stat_allocator;
+        }
+
 #if NCNN_VULKAN
         if (d->opt.use_vulkan_compute)
         {
@@ -2305,15 +4054,27 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
         }
         else
         {
-            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt, d->get_blob_slices(), d->get_blob_owners());
         }
 #else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt, d->get_blob_slices(), d->get_blob_owners());
 #endif // NCNN_VULKAN
     }
 
     feat = d->blob_mats[blob_index];
 
+    // views do not outlive the extractor
+    if (!feat.empty() && !feat.refcount && !d->blob_owners.empty() && d->blob_owners[blob_index].dims != 0)
+    {
+        feat = feat.clone(d->opt.blob_allocator);
+        if (feat.empty())
+        {
+            set_kmp_blocktime(old_blocktime);
+            set_flush_denormals(old_flush_denormals);
+            return -100;
+        }
+    }
+
     // empty is valid for outputs
     if (!feat.empty())
     {
@@ -2403,6 +4164,168 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
     return ret;
 }
 
+int Extractor::extract_tiled(int blob_index, Mat& feat, int tile_w, int tile_h, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    if (tile_w <= 0 || tile_h <= 0)
+        return -1;
+
+    if (d->blob_mats[blob_index].dims != 0)
+        return extract(blob_index, feat, type);
+
+    int input_blob_index = -1;
+    for (size_t i = 0; i < d->blob_mats.size(); i++)
+    {
+        if (d->blob_mats[i].dims == 0)
+            continue;
+
+        if (input_blob_index != -1)
+        {
+            NCNN_LOGE("extract_tiled requires exactly one input blob");
+            return -1;
+        }
+
+        input_blob_index = (int)i;
+    }
+
+    if (input_blob_index == -1 || d->blob_mats[input_blob_index].dims != 3)
+    {
+        NCNN_LOGE("extract_tiled requires exactly one 3-dim input blob");
+        return -1;
+    }
+
+    const Mat& in = d->blob_mats[input_blob_index];
+
+    // propagate the receptive field from the input blob, layers are stored in topological order
+    const std::vector<Layer*>& layers = d->net->layers();
+
+    std::vector<TileGeometry> geometry(d->blob_mats.size());
+    std::vector<int> tileable(d->blob_mats.size(), 0);
+
+    geometry[input_blob_index].w = in.w;
+    geometry[input_blob_index].h = in.h;
+    geometry[input_blob_index].stride_w = 1;
+    geometry[input_blob_index].stride_h = 1;
+    geometry[input_blob_index].pad_w = 0;
+    geometry[input_blob_index].pad_h = 0;
+    geometry[input_blob_index].extent_w = 1;
+    geometry[input_blob_index].extent_h = 1;
+    tileable[input_blob_index] = 1;
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+
+        if (layer->bottoms.empty())
+            continue;
+
+        bool bottoms_tileable = true;
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            if (!tileable[layer->bottoms[j]])
+                bottoms_tileable = false;
+        }
+
+        if (!bottoms_tileable)
+            continue;
+
+        TileGeometry g;
+        if (resolve_tile_geometry(layer, geometry, g) != 0)
+            continue;
+
+        for (size_t j = 0; j < layer->tops.size(); j++)
+        {
+            geometry[layer->tops[j]] = g;
+            tileable[layer->tops[j]] = 1;
+        }
+    }
+
+    if (!tileable[blob_index])
+    {
+        NCNN_LOGE("extract_tiled blob %d can not be computed tile by tile", blob_index);
+        return -1;
+    }
+
+    const TileGeometry& g = geometry[blob_index];
+
+    feat.release();
+
+    for (int ty = 0; ty < g.h; ty += tile_h)
+    {
+        const int outh = std::min(tile_h, g.h - ty);
+
+        // crop the input so that every kept output sees the same window as the untiled run
+        // the crop origin is aligned to the stride so that the tile output grid matches
+        const int y0 = std::max(0, (ty - (g.pad_h + g.stride_h - 1) / g.stride_h) * g.stride_h);
+        const int y1 = std::min(in.h, (ty + outh - 1) * g.stride_h - g.pad_h + g.extent_h);
+        const int dy = ty - y0 / g.stride_h;
+
+        for (int tx = 0; tx < g.w; tx += tile_w)
+        {
+            const int outw = std::min(tile_w, g.w - tx);
+
+            const int x0 = std::max(0, (tx - (g.pad_w + g.stride_w - 1) / g.stride_w) * g.stride_w);
+            const int x1 = std::min(in.w, (tx + outw - 1) * g.stride_w - g.pad_w + g.extent_w);
+            const int dx = tx - x0 / g.stride_w;
+
+            Mat in_tile;
+            copy_cut_border(in, in_tile, y0, in.h - y1, x0, in.w - x1, d->opt);
+            if (in_tile.empty())
+                return -100;
+
+            Mat out_tile;
+            {
+                Extractor ex = d->net->create_extractor();
+                ex.d->opt = d->opt;
+
+                ex.input(input_blob_index, in_tile);
+
+                int ret = ex.extract(blob_index, out_tile, type);
+                if (ret != 0)
+                    return ret;
+            }
+
+            if (out_tile.dims != 3 || out_tile.w < dx + outw || out_tile.h < dy + outh)
+            {
+                NCNN_LOGE("extract_tiled tile output %d x %d mismatch", out_tile.w, out_tile.h);
+                return -1;
+            }
+
+            if (feat.empty())
+            {
+                feat.create(g.w, g.h, out_tile.c, out_tile.elemsize, out_tile.elempack, d->opt.blob_allocator);
+                if (feat.empty())
+                    return -100;
+            }
+
+            if (out_tile.c != feat.c || out_tile.elemsize != feat.elemsize)
+            {
+                NCNN_LOGE("extract_tiled tile output channel mismatch");
+                return -1;
+            }
+
+            const size_t elemsize = feat.elemsize;
+
+            for (int q = 0; q < feat.c; q++)
+            {
+                const Mat m = out_tile.channel(q);
+                Mat outm = feat.channel(q);
+
+                for (int i = 0; i < outh; i++)
+                {
+                    const unsigned char* ptr = m.row<unsigned char>(dy + i) + dx * elemsize;
+                    unsigned char* outptr = outm.row<unsigned char>(ty + i) + tx * elemsize;
+                    memcpy(outptr, ptr, outw * elemsize);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 #if NCNN_STRING
 int Extractor::input(const char* blob_name, const VkMat& in)
@@ -36,6 +36,20 @@ public:
     // option can be changed before loading
     Option opt;
 
+    // weight memory allocator, such as HugePageAllocator
+    // weights read in load_model and the ones transformed in create_pipeline are allocated from it
+    // weights are copied at load when a weight allocator or opt.use_memory_accounting is set,
+    // which doubles the peak memory of each layer during loading and disables zero-copy DataReaderFromMemory weights
+    // set before load_model, allocator should be retained until the net is cleared or destroyed
+    void set_weight_allocator(Allocator* allocator);
+
+    // weight bytes held by all layers after create_pipeline, including transformed copies
+    // requires opt.use_memory_accounting before load_model, returns 0 otherwise
+    size_t weight_bytes() const;
+
+    // weight bytes held by the layer at layer_index
+    size_t layer_weight_bytes(int layer_index) const;
+
 #if NCNN_VULKAN
     // set gpu device by index
     void set_vulkan_device(int device_index);
@@ -81,6 +95,12 @@ public:
     // return 0 if success
     int load_model(FILE* fp);
     int load_model(const char* modelpath);
+
+    // load network structure and weight data from single-file model container
+    // weights are located through the container index and checksum verified
+    // return 0 if success
+    int load_container(FILE* fp);
+    int load_container(const char* containerpath);
 #endif // NCNN_STDIO
 
     // load network structure from external memory
@@ -95,6 +115,13 @@ public:
     // return bytes consumed
     int load_model(const unsigned char* mem);
 
+    // load network structure and reference weight data from single-file model container in external memory
+    // weight data is not copied but referenced, the container keeps each weight 64-byte aligned
+    // so external memory should be retained when used
+    // memory pointer must be 64-byte aligned
+    // return bytes consumed
+    int load_container(const unsigned char* mem);
+
 #if NCNN_PLATFORM_API
 #if __ANDROID_API__ >= 9
 #if NCNN_STRING
@@ -118,6 +145,13 @@ public:
     // construct an Extractor from network
     Extractor create_extractor() const;
 
+    // infer all blob shapes from input shapes without running the network
+    // input shapes are in input_indexes() order, empty Mat for Input layer shape param
+    // blob shapes are indexed by blob index, empty Mat if unresolved
+    // layers without shape function are run on zero blobs once the model is loaded
+    // return 0 if success
+    int infer_shapes(const std::vector<Mat>& input_shapes, std::vector<Mat>& blob_shapes) const;
+
     // get input/output indexes/names
     const std::vector<int>& input_indexes() const;
     const std::vector<int>& output_indexes() const;
@@ -181,6 +215,14 @@ public:
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // live and peak bytes of blob and workspace memory since the first extract
+    // requires opt.use_memory_accounting, returns 0 otherwise
+    // live blob bytes include the extracted outputs still referenced
+    size_t blob_bytes() const;
+    size_t peak_blob_bytes() const;
+    size_t workspace_bytes() const;
+    size_t peak_workspace_bytes() const;
+
 #if NCNN_VULKAN
     // deprecated, no-op
     // instead, set net.opt.use_vulkan_compute before net.load_param()
@@ -203,6 +245,10 @@ public:
     // type = 0, default
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(const char* blob_name, Mat& feat, int type = 0);
+
+    // get result by blob name, computed tile by tile over the spatial domain
+    // return 0 if success
+    int extract_tiled(const char* blob_name, Mat& feat, int tile_w, int tile_h, int type = 0);
 #endif // NCNN_STRING
 
     // set input by blob index
@@ -215,6 +261,14 @@ public:
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(int blob_index, Mat& feat, int type = 0);
 
+    // get result by blob index, computed tile by tile over the spatial domain
+    // each tile of tile_w x tile_h output pixels runs the whole chain on an input crop
+    // enlarged by the receptive field halo, so intermediate blobs scale with the tile size
+    // only convolution, convolutiondepthwise, pooling and elementwise layers are supported
+    // return 0 if success
+    // return -1 if the graph from the single 3-dim input blob can not be tiled
+    int extract_tiled(int blob_index, Mat& feat, int tile_w, int tile_h, int type = 0);
+
 #if NCNN_VULKAN
 #if NCNN_STRING
     // set input by blob name
@@ -47,9 +47,9 @@ Option::Option()
     use_reserved_1 = false;
 
     use_tensor_storage = false;
-    use_reserved_1p = false;
+    use_zero_copy_concat = false;
 
-    use_reserved_2 = false;
+    use_blob_view = false;
 
     flush_denormals = 3;
 
@@ -67,9 +67,11 @@ Option::Option()
     use_fp16_uniform = true;
     use_int8_uniform = true;
 
-    use_reserved_9 = false;
-    use_reserved_10 = false;
-    use_reserved_11 = false;
+    use_parallel_create_pipeline = false;
+    use_adaptive_thread_count = false;
+    use_memory_accounting = false;
+
+    weight_allocator = 0;
 }
 
 } // namespace ncnn
@@ -109,8 +109,16 @@ public:
 
     bool use_tensor_storage;
 
-    bool use_reserved_1p;
-    bool use_reserved_2;
+    // let the layers feeding a channel concat write into their slice of the concat output
+    // the output shape of each concat is learned on the first forward, later forwards skip the copy
+    // layers must create their top blob unconditionally, a preset slice is then kept as is
+    // applies to lightmode only, disabled by default
+    bool use_zero_copy_concat;
+
+    // let crop and slice output a view into their bottom blob instead of a copy
+    // when the window spans whole rows, layers without support_strided_input get a contiguous copy of a strided view
+    // cpu only, disabled by default
+    bool use_blob_view;
 
     // enable DAZ(Denormals-Are-Zero) and FTZ(Flush-To-Zero)
     // default value is 3
@@ -141,9 +149,28 @@ public:
     bool use_fp16_uniform;
     bool use_int8_uniform;
 
-    bool use_reserved_9;
-    bool use_reserved_10;
-    bool use_reserved_11;
+    // create layer pipelines concurrently on num_threads threads when loading weight
+    // improve cold start of large model, each layer transforms its weight on one of the threads
+    // weight data is read before any pipeline is created unless loading from container
+    // cpu only, custom layers must be safe to create pipeline in parallel
+    // disabled by default
+    bool use_parallel_create_pipeline;
+
+    // run layers with little work on fewer threads, such as softmax, pooling and small innerproduct
+    // the thread count of each layer forward is estimated from its input and weight bytes, see set_thread_work_threshold()
+    // layers packing weights for the load-time thread count, such as convolution and gemm, always use num_threads
+    // cpu only, disabled by default
+    bool use_adaptive_thread_count;
+
+    // count weight bytes per layer at load_model, and live and peak blob and workspace bytes per extractor
+    // see Net::weight_bytes() and Extractor::peak_blob_bytes()
+    // cpu only, disabled by default
+    bool use_memory_accounting;
+
+    // weight memory allocator passed to create_pipeline
+    // layers move the weights they transform, such as packed or winograd kernels, into it
+    // net sets it per layer from Net::set_weight_allocator() and memory accounting, null for ncnn::fastMalloc
+    Allocator* weight_allocator;
 };
 
 } // namespace ncnn
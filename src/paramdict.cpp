@@ -259,6 +259,31 @@ static float vstr_to_float(const char vstr[16])
     //     fprintf(stderr, "v = %f\n", v);
     return sign ? (float)v : (float)-v;
 }
+
+static bool vstr_to_int(const char vstr[16], int* v)
+{
+    const char* p = vstr;
+
+    // sign
+    bool sign = *p != '-';
+    if (*p == '+' || *p == '-')
+    {
+        p++;
+    }
+
+    if (!isdigit(*p))
+        return false;
+
+    unsigned int v1 = 0;
+    while (isdigit(*p))
+    {
+        v1 = v1 * 10 + (*p - '0');
+        p++;
+    }
+
+    *v = sign ? (int)v1 : (int)(0u - v1);
+    return true;
+}
 // 在 net.cpp 中，Net::load_param 调用 ParamDict::load_para
 int ParamDict::load_param(const DataReader& dr)
 {
@@ -316,8 +341,7 @@ int ParamDict::load_param(const DataReader& dr)
                 else
                 {
                     int* ptr = d->params[id].v;
-                    nscan = sscanf(vstr, "%d", &ptr[j]);
-                    if (nscan != 1)
+                    if (!vstr_to_int(vstr, &ptr[j]))
                     {
                         NCNN_LOGE("ParamDict parse array element failed");
                         return -1;
@@ -399,8 +423,7 @@ int ParamDict::load_param(const DataReader& dr)
             else
             {
                 int v = 0;
-                nscan = sscanf(vstr, "%d", &v);
-                if (nscan != 1)
+                if (!vstr_to_int(vstr, &v))
                 {
                     NCNN_LOGE("ParamDict parse value failed");
                     return -1;
@@ -424,8 +447,7 @@ int ParamDict::load_param(const DataReader& dr)
                 else
                 {
                     int v = 0;
-                    nscan = sscanf(vstr, "%d", &v);
-                    if (nscan != 1)
+                    if (!vstr_to_int(vstr, &v))
                     {
                         NCNN_LOGE("ParamDict parse value failed");
                         return -1;
@@ -462,8 +484,7 @@ int ParamDict::load_param(const DataReader& dr)
             }
             else
             {
-                nscan = sscanf(vstr, "%d", &d->params[id].i);
-                if (nscan != 1)
+                if (!vstr_to_int(vstr, &d->params[id].i))
                 {
                     NCNN_LOGE("ParamDict parse value failed");
                     return -1;
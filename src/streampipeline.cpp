@@ -0,0 +1,420 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "streampipeline.h"
+
+namespace ncnn {
+
+struct StreamFrame
+{
+    int index;
+    void* frame;
+    Extractor* ex;
+    std::vector<Mat> outputs;
+    int ret;
+};
+
+// bounded fifo between two stages
+class StreamQueue
+{
+public:
+    StreamQueue();
+
+    void reset(int capacity);
+
+    // block while full
+    void push(StreamFrame* frame);
+
+    // block while empty, return null once closed and drained
+    StreamFrame* pop();
+
+    void close();
+
+private:
+    Mutex lock;
+    ConditionVariable not_full;
+    ConditionVariable not_empty;
+    std::vector<StreamFrame*> ring;
+    int head;
+    int count;
+    bool closed;
+};
+
+StreamQueue::StreamQueue()
+{
+    head = 0;
+    count = 0;
+    closed = false;
+}
+
+void StreamQueue::reset(int capacity)
+{
+    MutexLockGuard guard(lock);
+
+    ring.resize(capacity);
+    head = 0;
+    count = 0;
+    closed = false;
+}
+
+void StreamQueue::push(StreamFrame* frame)
+{
+    lock.lock();
+
+    while (count == (int)ring.size())
+    {
+        not_full.wait(lock);
+    }
+
+    ring[(head + count) % ring.size()] = frame;
+    count++;
+
+    not_empty.signal();
+
+    lock.unlock();
+}
+
+StreamFrame* StreamQueue::pop()
+{
+    lock.lock();
+
+    while (count == 0 && !closed)
+    {
+        not_empty.wait(lock);
+    }
+
+    StreamFrame* frame = 0;
+    if (count > 0)
+    {
+        frame = ring[head];
+        head = (head + 1) % ring.size();
+        count--;
+
+        not_full.signal();
+    }
+
+    lock.unlock();
+
+    return frame;
+}
+
+void StreamQueue::close()
+{
+    MutexLockGuard guard(lock);
+
+    closed = true;
+
+    not_empty.broadcast();
+}
+
+enum
+{
+    STAGE_PREPROCESS = 0,
+    STAGE_INFERENCE = 1,
+    STAGE_POSTPROCESS = 2,
+    STAGE_COUNT = 3
+};
+
+class StreamPipelinePrivate;
+struct StreamWorkerArgs
+{
+    StreamPipelinePrivate* d;
+    int stage;
+};
+
+class StreamPipelinePrivate
+{
+public:
+    void run_stage(int stage, StreamFrame* f) const;
+    void complete(StreamFrame* f);
+    void worker(int stage);
+
+    const Net* net;
+    stream_preprocess_func preprocess;
+    stream_postprocess_func postprocess;
+    void* userdata;
+
+    std::vector<int> output_indexes;
+    int workers[STAGE_COUNT];
+    int queue_size;
+
+    bool running;
+    int frame_count;
+
+    // queue in front of each stage
+    StreamQueue queues[STAGE_COUNT];
+    StreamWorkerArgs worker_args[STAGE_COUNT];
+    std::vector<Thread*> threads;
+
+    Mutex lock;
+    int alive_workers[STAGE_COUNT];
+    int ret;
+};
+
+void StreamPipelinePrivate::run_stage(int stage, StreamFrame* f) const
+{
+    if (f->ret != 0)
+        return;
+
+    if (stage == STAGE_PREPROCESS)
+    {
+        f->ex = new Extractor(net->create_extractor());
+
+        f->ret = preprocess(f->index, f->frame, *f->ex, userdata);
+    }
+
+    if (stage == STAGE_INFERENCE)
+    {
+        f->outputs.resize(output_indexes.size());
+        for (size_t i = 0; i < output_indexes.size(); i++)
+        {
+            f->ret = f->ex->extract(output_indexes[i], f->outputs[i]);
+            if (f->ret != 0)
+            {
+                NCNN_LOGE("StreamPipeline extract blob %d failed at frame %d", output_indexes[i], f->index);
+                break;
+            }
+        }
+
+        // release intermediate blobs before postprocessing
+        delete f->ex;
+        f->ex = 0;
+    }
+
+    if (stage == STAGE_POSTPROCESS)
+    {
+        f->ret = postprocess(f->index, f->frame, f->outputs, userdata);
+    }
+}
+
+void StreamPipelinePrivate::complete(StreamFrame* f)
+{
+    {
+        MutexLockGuard guard(lock);
+
+        if (ret == 0 && f->ret != 0)
+            ret = f->ret;
+    }
+
+    delete f->ex;
+    delete f;
+}
+
+void StreamPipelinePrivate::worker(int stage)
+{
+    for (;;)
+    {
+        StreamFrame* f = queues[stage].pop();
+        if (!f)
+            break;
+
+        run_stage(stage, f);
+
+        if (stage == STAGE_POSTPROCESS)
+            complete(f);
+        else
+            queues[stage + 1].push(f);
+    }
+
+    // the last worker of this stage closes the next queue
+    bool last_worker = false;
+    {
+        MutexLockGuard guard(lock);
+
+        alive_workers[stage]--;
+        last_worker = alive_workers[stage] == 0;
+    }
+
+    if (last_worker && stage != STAGE_POSTPROCESS)
+        queues[stage + 1].close();
+}
+
+static void* stream_worker(void* args)
+{
+    StreamWorkerArgs* wargs = (StreamWorkerArgs*)args;
+
+    wargs->d->worker(wargs->stage);
+
+    return 0;
+}
+
+StreamPipeline::StreamPipeline(const Net* net, stream_preprocess_func preprocess, stream_postprocess_func postprocess, void* userdata)
+    : d(new StreamPipelinePrivate)
+{
+    d->net = net;
+    d->preprocess = preprocess;
+    d->postprocess = postprocess;
+    d->userdata = userdata;
+
+    d->output_indexes = net->output_indexes();
+    d->workers[STAGE_PREPROCESS] = 1;
+    d->workers[STAGE_INFERENCE] = 1;
+    d->workers[STAGE_POSTPROCESS] = 1;
+    d->queue_size = 2;
+
+    d->running = false;
+    d->frame_count = 0;
+
+    for (int i = 0; i < STAGE_COUNT; i++)
+    {
+        d->worker_args[i].d = d;
+        d->worker_args[i].stage = i;
+        d->alive_workers[i] = 0;
+    }
+
+    d->ret = 0;
+}
+
+StreamPipeline::~StreamPipeline()
+{
+    finish();
+
+    delete d;
+}
+
+StreamPipeline::StreamPipeline(const StreamPipeline&)
+    : d(0)
+{
+}
+
+StreamPipeline& StreamPipeline::operator=(const StreamPipeline&)
+{
+    return *this;
+}
+
+#if NCNN_STRING
+int StreamPipeline::set_outputs(const std::vector<const char*>& blob_names)
+{
+    const std::vector<Blob>& blobs = d->net->blobs();
+
+    std::vector<int> blob_indexes(blob_names.size(), -1);
+    for (size_t i = 0; i < blob_names.size(); i++)
+    {
+        for (size_t j = 0; j < blobs.size(); j++)
+        {
+            if (blobs[j].name == blob_names[i])
+            {
+                blob_indexes[i] = (int)j;
+                break;
+            }
+        }
+
+        if (blob_indexes[i] == -1)
+        {
+            NCNN_LOGE("StreamPipeline find_blob_index_by_name %s failed", blob_names[i]);
+            return -1;
+        }
+    }
+
+    set_outputs(blob_indexes);
+
+    return 0;
+}
+#endif // NCNN_STRING
+
+void StreamPipeline::set_outputs(const std::vector<int>& blob_indexes)
+{
+    d->output_indexes = blob_indexes;
+}
+
+void StreamPipeline::set_workers(int preprocess_workers, int inference_workers, int postprocess_workers)
+{
+    d->workers[STAGE_PREPROCESS] = std::max(preprocess_workers, 1);
+    d->workers[STAGE_INFERENCE] = std::max(inference_workers, 1);
+    d->workers[STAGE_POSTPROCESS] = std::max(postprocess_workers, 1);
+}
+
+void StreamPipeline::set_queue_size(int queue_size)
+{
+    d->queue_size = std::max(queue_size, 1);
+}
+
+int StreamPipeline::start()
+{
+    if (d->running)
+        return 0;
+
+    if (!d->preprocess || !d->postprocess)
+    {
+        NCNN_LOGE("StreamPipeline preprocess and postprocess must be set");
+        return -1;
+    }
+
+    d->ret = 0;
+    d->frame_count = 0;
+
+#if NCNN_THREADS
+    for (int i = 0; i < STAGE_COUNT; i++)
+    {
+        d->queues[i].reset(d->queue_size);
+        d->alive_workers[i] = d->workers[i];
+    }
+
+    for (int i = 0; i < STAGE_COUNT; i++)
+    {
+        for (int j = 0; j < d->workers[i]; j++)
+        {
+            d->threads.push_back(new Thread(stream_worker, (void*)&d->worker_args[i]));
+        }
+    }
+#endif // NCNN_THREADS
+
+    d->running = true;
+
+    return 0;
+}
+
+int StreamPipeline::submit(void* frame)
+{
+    if (!d->running)
+    {
+        int ret = start();
+        if (ret != 0)
+            return -1;
+    }
+
+    const int frame_index = d->frame_count++;
+
+    StreamFrame* f = new StreamFrame;
+    f->index = frame_index;
+    f->frame = frame;
+    f->ex = 0;
+    f->ret = 0;
+
+#if NCNN_THREADS
+    d->queues[STAGE_PREPROCESS].push(f);
+#else
+    // no worker threads, run all stages in place
+    for (int i = 0; i < STAGE_COUNT; i++)
+    {
+        d->run_stage(i, f);
+    }
+    d->complete(f);
+#endif // NCNN_THREADS
+
+    return frame_index;
+}
+
+int StreamPipeline::finish()
+{
+    if (!d->running)
+        return 0;
+
+#if NCNN_THREADS
+    // workers drain the queues stage by stage and exit
+    d->queues[STAGE_PREPROCESS].close();
+
+    for (size_t i = 0; i < d->threads.size(); i++)
+    {
+        d->threads[i]->join();
+        delete d->threads[i];
+    }
+    d->threads.clear();
+#endif // NCNN_THREADS
+
+    d->running = false;
+
+    return d->ret;
+}
+
+} // namespace ncnn
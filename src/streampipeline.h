@@ -0,0 +1,75 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_STREAMPIPELINE_H
+#define NCNN_STREAMPIPELINE_H
+
+#include "mat.h"
+#include "net.h"
+#include "platform.h"
+
+namespace ncnn {
+
+// set the input blobs of one frame with ex.input()
+// return 0 if success
+typedef int (*stream_preprocess_func)(int frame_index, void* frame, Extractor& ex, void* userdata);
+
+// consume the extracted output blobs of one frame, in set_outputs() order
+// return 0 if success
+typedef int (*stream_postprocess_func)(int frame_index, void* frame, const std::vector<Mat>& outputs, void* userdata);
+
+class StreamPipelinePrivate;
+class NCNN_EXPORT StreamPipeline
+{
+public:
+    // frames go through preprocess -> extract -> postprocess stages
+    // each stage runs on its own worker threads and stages are linked by bounded queues
+    // so the preprocessing of frame N+1 and the postprocessing of frame N-1 overlap the inference of frame N
+    // net should be retained until the pipeline is destroyed
+    StreamPipeline(const Net* net, stream_preprocess_func preprocess, stream_postprocess_func postprocess, void* userdata = 0);
+    // finish and destroy
+    ~StreamPipeline();
+
+#if NCNN_STRING
+    // extract output blobs by name
+    // return 0 if success
+    int set_outputs(const std::vector<const char*>& blob_names);
+#endif // NCNN_STRING
+
+    // extract output blobs by index
+    void set_outputs(const std::vector<int>& blob_indexes);
+
+    // worker thread count of each stage, 1 by default, applied on start()
+    // the omp team of one inference worker has net.opt.num_threads threads
+    // frames may reach postprocess out of order when the preprocess or inference stage has more than one worker
+    void set_workers(int preprocess_workers, int inference_workers, int postprocess_workers);
+
+    // frames waiting in front of each stage, 2 by default, applied on start()
+    void set_queue_size(int queue_size);
+
+    // start worker threads
+    // return 0 if success
+    int start();
+
+    // queue one frame, block while the preprocess queue is full
+    // start() is called implicitly
+    // frame is passed to the callbacks as is, it should be retained until postprocessed
+    // return frame index, or -1 on failure
+    int submit(void* frame);
+
+    // wait until all submitted frames are postprocessed and join worker threads
+    // return 0 if success, or the first failure of any stage
+    // a frame failing in one stage skips the remaining stages, the other frames are not affected
+    int finish();
+
+private:
+    StreamPipeline(const StreamPipeline&);
+    StreamPipeline& operator=(const StreamPipeline&);
+
+private:
+    StreamPipelinePrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_STREAMPIPELINE_H
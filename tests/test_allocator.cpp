@@ -0,0 +1,206 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "allocator.h"
+#include "datareader.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <string.h>
+
+static const char* test_net_param = "7767517\n"
+                                    "3 3\n"
+                                    "Input               data     0 1 data 0=32 1=32 2=16\n"
+                                    "Convolution         conv0    1 1 data c0 0=64 1=3 4=1 5=1 6=9216\n"
+                                    "InnerProduct        fc0      1 1 c0 fc0 0=32 1=1 2=2097152\n";
+
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual int scan(const char* /*format*/, void* /*p*/) const
+    {
+        return 0;
+    }
+    virtual size_t read(void* buf, size_t size) const
+    {
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = RandomFloat(-1.f, 1.f);
+        }
+        return size;
+    }
+};
+
+static int test_hugepage_allocator(size_t page_size)
+{
+    ncnn::HugePageAllocator allocator(page_size);
+
+    const size_t sizes[4] = {100, 1024 * 1024 - 1, 3 * 1024 * 1024 + 17, 5 * 1024 * 1024};
+
+    void* ptrs[4];
+    for (int i = 0; i < 4; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(sizes[i]);
+        if (!ptrs[i] || (size_t)ptrs[i] % NCNN_MALLOC_ALIGN != 0)
+        {
+            fprintf(stderr, "fastMalloc %d returns %p\n", (int)sizes[i], ptrs[i]);
+            return -1;
+        }
+
+        memset(ptrs[i], i + 1, sizes[i]);
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        const unsigned char* p = (const unsigned char*)ptrs[i];
+        if (p[0] != i + 1 || p[sizes[i] - 1] != i + 1)
+        {
+            fprintf(stderr, "block %d corrupted\n", i);
+            return -1;
+        }
+    }
+
+    const size_t hugetlb_bytes = allocator.hugetlb_bytes();
+    const size_t madvise_bytes = allocator.madvise_bytes();
+    const size_t fallback_bytes = allocator.fallback_bytes();
+
+    if (fallback_bytes < sizes[0] + sizes[1])
+    {
+        fprintf(stderr, "small blocks should fallback, fallback_bytes = %d\n", (int)fallback_bytes);
+        return -1;
+    }
+
+#if defined __linux__
+    if (hugetlb_bytes + madvise_bytes < sizes[2] + sizes[3])
+    {
+        fprintf(stderr, "large blocks should be mapped, hugetlb_bytes = %d madvise_bytes = %d\n", (int)hugetlb_bytes, (int)madvise_bytes);
+        return -1;
+    }
+
+    if (page_size == 0 && hugetlb_bytes != 0)
+    {
+        fprintf(stderr, "page_size 0 should not use explicit huge pages\n");
+        return -1;
+    }
+
+    if (allocator.thp_bytes() > madvise_bytes)
+    {
+        fprintf(stderr, "thp_bytes %d exceeds madvise_bytes %d\n", (int)allocator.thp_bytes(), (int)madvise_bytes);
+        return -1;
+    }
+#endif
+
+    // freed large block is reused
+    allocator.fastFree(ptrs[2]);
+    void* ptr = allocator.fastMalloc(sizes[2] - 1000);
+    if (ptr != ptrs[2] && (hugetlb_bytes || madvise_bytes))
+    {
+        fprintf(stderr, "large block is not reused\n");
+        return -1;
+    }
+    ptrs[2] = ptr;
+
+    for (int i = 0; i < 4; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    allocator.clear();
+
+    if (allocator.hugetlb_bytes() != 0 || allocator.madvise_bytes() != 0 || allocator.fallback_bytes() != 0)
+    {
+        fprintf(stderr, "bytes are not released\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_hugepage_allocator_net(size_t page_size)
+{
+    ncnn::Mat in = RandomMat(32, 32, 16);
+
+    ncnn::Mat out_ref;
+    {
+        ncnn::Net net;
+        net.opt.num_threads = 1;
+        net.opt.use_fp16_storage = false;
+        net.load_param_mem(test_net_param);
+
+        SRAND(7767517);
+        DataReaderFromRandom dr;
+        net.load_model(dr);
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ex.extract("fc0", out_ref);
+    }
+
+    ncnn::HugePageAllocator weight_allocator(page_size);
+    ncnn::HugePageAllocator blob_allocator(page_size);
+    ncnn::HugePageAllocator workspace_allocator(page_size);
+
+    ncnn::Mat out;
+    {
+        ncnn::Net net;
+        net.opt.num_threads = 1;
+        // keep the repacked innerproduct weight in fp32
+        net.opt.use_fp16_storage = false;
+        net.opt.use_memory_accounting = true;
+        net.opt.blob_allocator = &blob_allocator;
+        net.opt.workspace_allocator = &workspace_allocator;
+        net.set_weight_allocator(&weight_allocator);
+        net.load_param_mem(test_net_param);
+
+        SRAND(7767517);
+        DataReaderFromRandom dr;
+        net.load_model(dr);
+
+        // the original weights are released in lightmode, the repacked ones are counted
+        if (net.weight_bytes() < 2097152 * sizeof(float) || net.layer_weight_bytes(2) < 2097152 * sizeof(float))
+        {
+            fprintf(stderr, "repacked weights are not counted, weight_bytes = %d\n", (int)net.weight_bytes());
+            return -1;
+        }
+
+#if defined __linux__
+        // the repacked innerproduct weight is mapped
+        if (weight_allocator.hugetlb_bytes() + weight_allocator.madvise_bytes() < 2097152 * sizeof(float))
+        {
+            fprintf(stderr, "weights are not allocated from weight allocator\n");
+            return -1;
+        }
+#endif
+
+        for (int i = 0; i < 2; i++)
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.input("data", in);
+            ex.extract("fc0", out);
+        }
+
+        // detach from blob allocator before the net goes away
+        out = out.clone();
+    }
+
+    if (CompareMat(out, out_ref, 0.001) != 0)
+    {
+        fprintf(stderr, "test_hugepage_allocator_net failed page_size=%d\n", (int)page_size);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_hugepage_allocator(0)
+           || test_hugepage_allocator(2 * 1024 * 1024)
+           || test_hugepage_allocator(1024 * 1024 * 1024)
+           || test_hugepage_allocator_net(0)
+           || test_hugepage_allocator_net(2 * 1024 * 1024);
+}
@@ -0,0 +1,161 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <vector>
+
+static const char* test_net_param = "7767517\n"
+                                    "11 15\n"
+                                    "Input                data    0 1 data\n"
+                                    "Convolution          conv0   1 1 data c0 0=32 1=3 4=1 5=1 6=864\n"
+                                    "Split                split0  1 4 c0 s0 s1 s2 s3\n"
+                                    "Crop                 crop_c  1 1 s0 cc 2=8 3=-233 4=-233 5=16\n"
+                                    "Crop                 crop_h  1 1 s1 ch 1=2 3=-233 4=-233 5=-233 7=1\n"
+                                    "Crop                 crop_n  1 1 s3 cn -23309=1,4 -23310=1,20 -23311=1,0\n"
+                                    "Slice                slice_c 1 2 s2 sa sb -23300=2,-233,-233 1=0\n"
+                                    "Convolution          conv1   1 1 ch c1 0=16 1=3 4=1 5=1 6=4608\n"
+                                    "ReLU                 relu1   1 1 sa r1\n"
+                                    "Pooling              pool    1 1 cc p1 0=0 1=3 2=1 3=1\n"
+                                    "Concat               cat     4 1 r1 sb p1 cn cat 0=0\n";
+
+static void append_weight(std::vector<float>& model, int size, bool tagged)
+{
+    if (tagged)
+    {
+        // fp32 tag
+        model.push_back(0.f);
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        model.push_back(RandomFloat(-1.f, 1.f));
+    }
+}
+
+static int test_blob_view(int use_packing_layout, bool lightmode)
+{
+    std::vector<float> model;
+    append_weight(model, 864, true);
+    append_weight(model, 32, false);
+    append_weight(model, 4608, true);
+    append_weight(model, 16, false);
+
+    ncnn::Net net_ref;
+    net_ref.opt.use_packing_layout = use_packing_layout;
+    net_ref.opt.use_blob_view = false;
+    net_ref.load_param_mem(test_net_param);
+    net_ref.load_model((const unsigned char*)model.data());
+
+    ncnn::Net net;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.opt.use_blob_view = true;
+    net.load_param_mem(test_net_param);
+    net.load_model((const unsigned char*)model.data());
+
+    ncnn::Mat in = RandomMat(19, 15, 3);
+
+    // views are extracted directly as well as consumed
+    const char* blob_names[] = {"cat", "c1", "ch", "sb", "cn"};
+    for (int i = 0; i < 5; i++)
+    {
+        ncnn::Mat a;
+        {
+            ncnn::Extractor ex = net_ref.create_extractor();
+            ex.set_light_mode(lightmode);
+            ex.input("data", in);
+            ex.extract(blob_names[i], a);
+        }
+
+        ncnn::Mat b;
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.set_light_mode(lightmode);
+            ex.input("data", in);
+            int ret = ex.extract(blob_names[i], b);
+            if (ret != 0)
+            {
+                fprintf(stderr, "extract %s failed\n", blob_names[i]);
+                return -1;
+            }
+        }
+
+        if (CompareMat(a, b, 0.001) != 0)
+        {
+            fprintf(stderr, "test_blob_view failed use_packing_layout=%d lightmode=%d blob=%s\n", use_packing_layout, lightmode, blob_names[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// a row cropped view broadcast against another operand
+static const char* test_broadcast_param = "7767517\n"
+                                          "4 4\n"
+                                          "Input                data    0 1 data\n"
+                                          "Input                data1   0 1 data1\n"
+                                          "Crop                 crop    1 1 data cr 0=0 1=1 2=0 3=4 4=3 5=3\n"
+                                          "BinaryOp             add     2 1 cr data1 out 0=0\n";
+
+static int test_blob_view_broadcast(int use_packing_layout, const ncnn::Mat& b)
+{
+    ncnn::Net net_ref;
+    net_ref.opt.use_packing_layout = use_packing_layout;
+    net_ref.opt.use_blob_view = false;
+    net_ref.load_param_mem(test_broadcast_param);
+    net_ref.load_model((const unsigned char*)"");
+
+    ncnn::Net net;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.opt.use_blob_view = true;
+    net.load_param_mem(test_broadcast_param);
+    net.load_model((const unsigned char*)"");
+
+    ncnn::Mat in = RandomMat(4, 6, 3);
+
+    ncnn::Mat out_ref;
+    {
+        ncnn::Extractor ex = net_ref.create_extractor();
+        ex.input("data", in);
+        ex.input("data1", b);
+        ex.extract("out", out_ref);
+    }
+
+    ncnn::Mat out;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ex.input("data1", b);
+        int ret = ex.extract("out", out);
+        if (ret != 0)
+        {
+            fprintf(stderr, "extract out failed\n");
+            return -1;
+        }
+    }
+
+    if (CompareMat(out_ref, out, 0.001) != 0)
+    {
+        fprintf(stderr, "test_blob_view_broadcast failed use_packing_layout=%d b.dims=%d b=(%d %d %d %d)\n", use_packing_layout, b.dims, b.w, b.h, b.d, b.c);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_blob_view(1, true)
+           || test_blob_view(1, false)
+           || test_blob_view(0, true)
+           || test_blob_view(0, false)
+           || test_blob_view_broadcast(0, RandomMat(2, 4, 3, 3))
+           || test_blob_view_broadcast(1, RandomMat(2, 4, 3, 3))
+           || test_blob_view_broadcast(0, RandomMat(4, 3, 3))
+           || test_blob_view_broadcast(0, RandomMat(1, 1, 3))
+           || test_blob_view_broadcast(0, RandomMat(4));
+}
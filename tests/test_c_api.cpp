@@ -224,6 +224,23 @@ static size_t emptydr_read(ncnn_datareader_t /*dr*/, void* buf, size_t size)
     return size;
 }
 
+static size_t onesdr_read(ncnn_datareader_t /*dr*/, void* buf, size_t size)
+{
+    if (size == sizeof(unsigned int))
+    {
+        // fp32 weight tag
+        memset(buf, 0, size);
+        return size;
+    }
+
+    float* ptr = (float*)buf;
+    for (size_t i = 0; i < size / sizeof(float); i++)
+    {
+        ptr[i] = 1.f;
+    }
+    return size;
+}
+
 static int test_c_api_2()
 {
     // datareader from empty
@@ -329,7 +346,92 @@ static int test_c_api_2()
     return success ? 0 : -1;
 }
 
+static int test_c_api_3()
+{
+    // datareader from ones
+    ncnn_datareader_t onesdr = ncnn_datareader_create();
+    {
+        onesdr->read = onesdr_read;
+    }
+
+    ncnn_option_t opt = ncnn_option_create();
+    {
+        ncnn_option_set_num_threads(opt, 1);
+        ncnn_option_set_use_memory_accounting(opt, 1);
+    }
+
+    ncnn_net_t net = ncnn_net_create();
+    {
+        ncnn_net_set_option(net, opt);
+
+        const char param_txt[] = "7767517\n2 2\nInput input 0 1 data 0=64\nInnerProduct fc 1 1 data output 0=16 1=1 2=1024\n";
+
+        ncnn_net_load_param_memory(net, param_txt);
+        ncnn_net_load_model_datareader(net, onesdr);
+    }
+
+    // the repacked weight is counted, it may be stored in fp16
+    const size_t weight_bytes = ncnn_net_get_weight_bytes(net);
+    bool success = weight_bytes >= 1024 * sizeof(unsigned short) + 16 * sizeof(float) && ncnn_net_get_layer_weight_bytes(net, 0) == 0 && ncnn_net_get_layer_weight_bytes(net, 1) == weight_bytes;
+
+    ncnn_mat_t a = ncnn_mat_create_1d(64, NULL);
+    ncnn_mat_fill_float(a, 1.f);
+
+    ncnn_mat_t c = 0;
+
+    {
+        ncnn_extractor_t ex = ncnn_extractor_create(net);
+
+        ncnn_extractor_input(ex, "data", a);
+
+        ncnn_extractor_extract(ex, "output", &c);
+
+        // the output blob is still referenced
+        const size_t blob_bytes = ncnn_extractor_get_blob_bytes(ex);
+        const size_t peak_blob_bytes = ncnn_extractor_get_peak_blob_bytes(ex);
+        const size_t peak_workspace_bytes = ncnn_extractor_get_peak_workspace_bytes(ex);
+
+        if (blob_bytes < 16 * sizeof(float) || peak_blob_bytes < blob_bytes || peak_workspace_bytes < ncnn_extractor_get_workspace_bytes(ex))
+        {
+            fprintf(stderr, "blob_bytes = %d  peak_blob_bytes = %d  peak_workspace_bytes = %d\n", (int)blob_bytes, (int)peak_blob_bytes, (int)peak_workspace_bytes);
+            success = false;
+        }
+
+        ncnn_extractor_destroy(ex);
+    }
+
+    if (!c || ncnn_mat_get_w(c) != 16)
+    {
+        success = false;
+    }
+    else
+    {
+        // 64 ones plus the bias
+        const float* c_data = (const float*)ncnn_mat_get_data(c);
+        if (c_data[0] < 64.5f || c_data[0] > 65.5f)
+        {
+            success = false;
+        }
+    }
+
+    ncnn_mat_destroy(a);
+    ncnn_mat_destroy(c);
+
+    ncnn_net_destroy(net);
+
+    ncnn_option_destroy(opt);
+
+    ncnn_datareader_destroy(onesdr);
+
+    if (!success)
+    {
+        fprintf(stderr, "test_c_api_3 failed weight_bytes = %d\n", (int)weight_bytes);
+    }
+
+    return success ? 0 : -1;
+}
+
 int main()
 {
-    return test_c_api_0() || test_c_api_1() || test_c_api_2();
+    return test_c_api_0() || test_c_api_1() || test_c_api_2() || test_c_api_3();
 }
@@ -10,7 +10,10 @@ static int test_concat(const std::vector<ncnn::Mat>& a, int axis)
 
     std::vector<ncnn::Mat> weights(0);
 
-    int ret = test_layer("Concat", pd, weights, a);
+    // int8 blobs are passed through as is
+    int flag = a[0].elembits() == 8 ? TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING : 0;
+
+    int ret = test_layer("Concat", pd, weights, a, 1, 0.001, 0, flag);
     if (ret != 0)
     {
         fprintf(stderr, "test_concat failed a[0].dims=%d a[0]=(%d %d %d %d) axis=%d\n", a[0].dims, a[0].w, a[0].h, a[0].d, a[0].c, axis);
@@ -307,6 +310,46 @@ static int test_concat_9()
     return 0;
 }
 
+static int test_concat_10()
+{
+    ncnn::Mat a[] = {
+        RandomS8Mat(15, 5, 13),
+        RandomS8Mat(15, 5, 16),
+        RandomS8Mat(15, 5, 24)
+    };
+
+    const int n = sizeof(a) / sizeof(a[0]);
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            std::vector<ncnn::Mat> as(3);
+            as[0] = a[i];
+            as[1] = a[j];
+            as[2] = a[j];
+
+            int ret = test_concat(as, 0);
+            if (ret != 0)
+                return ret;
+        }
+
+        std::vector<ncnn::Mat> as(2);
+        as[0] = a[i];
+        as[1] = RandomS8Mat(15, 7, a[i].c);
+
+        std::vector<ncnn::Mat> bs(2);
+        bs[0] = a[i];
+        bs[1] = RandomS8Mat(17, 5, a[i].c);
+
+        int ret = test_concat(as, 1) || test_concat(bs, 2) || test_concat(bs, -1);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
@@ -321,5 +364,6 @@ int main()
            || test_concat_6()
            || test_concat_7()
            || test_concat_8()
-           || test_concat_9();
+           || test_concat_9()
+           || test_concat_10();
 }
@@ -0,0 +1,321 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// single-file model container, keep in sync with src/net.cpp
+struct container_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t graph_type;
+    uint32_t layer_count;
+    uint32_t weight_count;
+    uint32_t reserved;
+    uint64_t graph_offset;
+    uint64_t graph_size;
+    uint64_t layer_index_offset;
+    uint64_t weight_index_offset;
+    uint64_t file_size;
+};
+
+struct container_layer_entry
+{
+    uint32_t first_weight;
+    uint32_t weight_count;
+};
+
+struct container_weight_entry
+{
+    uint64_t offset;
+    uint64_t size;
+    uint32_t type;
+    uint32_t tag;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+
+static const char* test_net_param = "7767517\n"
+                                    "4 4\n"
+                                    "Input        data   0 1 data 0=9 1=7 2=3\n"
+                                    "Convolution  conv   1 1 data c1 0=8 1=3 4=1 5=1 6=216 9=1\n"
+                                    "Pooling      gap    1 1 c1 p1 0=1 4=1\n"
+                                    "InnerProduct fc     1 1 p1 out 0=5 1=1 2=40\n";
+
+struct test_weight
+{
+    uint32_t type;
+    uint32_t tag;
+    std::vector<unsigned char> data;
+};
+
+static test_weight make_fp32_weight(int size, uint32_t type)
+{
+    test_weight w;
+    w.type = type;
+    w.tag = 0;
+    w.data.resize(size * sizeof(float));
+
+    float* ptr = (float*)&w.data[0];
+    for (int i = 0; i < size; i++)
+    {
+        ptr[i] = RandomFloat(-1.f, 1.f);
+    }
+
+    return w;
+}
+
+static test_weight make_fp16_weight(int size)
+{
+    test_weight w;
+    w.type = 0;
+    w.tag = 0x01306B47;
+    w.data.resize((size * sizeof(unsigned short) + 3) / 4 * 4, 0);
+
+    unsigned short* ptr = (unsigned short*)&w.data[0];
+    for (int i = 0; i < size; i++)
+    {
+        ptr[i] = ncnn::float32_to_float16(RandomFloat(-1.f, 1.f));
+    }
+
+    return w;
+}
+
+static uint32_t fnv1a_32(const unsigned char* data, size_t size)
+{
+    // weight data in test is 32bit aligned
+    uint32_t h = 0x811c9dc5;
+    for (size_t i = 0; i < size; i += 4)
+    {
+        uint32_t v;
+        memcpy(&v, data + i, 4);
+        h ^= v;
+        h *= 0x01000193;
+    }
+    return h;
+}
+
+static size_t align64(size_t offset)
+{
+    return (offset + 63) / 64 * 64;
+}
+
+static void append_aligned(std::vector<unsigned char>& container, const void* data, size_t size)
+{
+    const unsigned char* ptr = (const unsigned char*)data;
+    container.insert(container.end(), ptr, ptr + size);
+    container.resize(align64(container.size()), 0);
+}
+
+static std::vector<unsigned char> make_container(const std::vector<test_weight>& weights, const std::vector<container_layer_entry>& layer_entries)
+{
+    const size_t param_size = strlen(test_net_param) + 1;
+
+    container_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = 0x434E434E;
+    header.version = 1;
+    header.graph_type = 0;
+    header.layer_count = (uint32_t)layer_entries.size();
+    header.weight_count = (uint32_t)weights.size();
+    header.graph_offset = align64(sizeof(header));
+    header.graph_size = param_size;
+    header.layer_index_offset = align64(header.graph_offset + param_size);
+    header.weight_index_offset = align64(header.layer_index_offset + layer_entries.size() * sizeof(container_layer_entry));
+
+    size_t offset = align64(header.weight_index_offset + weights.size() * sizeof(container_weight_entry));
+
+    std::vector<container_weight_entry> weight_entries(weights.size());
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        memset(&weight_entries[i], 0, sizeof(container_weight_entry));
+        weight_entries[i].offset = offset;
+        weight_entries[i].size = weights[i].data.size();
+        weight_entries[i].type = weights[i].type;
+        weight_entries[i].tag = weights[i].tag;
+        weight_entries[i].checksum = fnv1a_32(&weights[i].data[0], weights[i].data.size());
+
+        offset = align64(offset + weights[i].data.size());
+    }
+
+    header.file_size = offset;
+
+    std::vector<unsigned char> container;
+    append_aligned(container, &header, sizeof(header));
+    append_aligned(container, test_net_param, param_size);
+    append_aligned(container, layer_entries.data(), layer_entries.size() * sizeof(container_layer_entry));
+    append_aligned(container, weight_entries.data(), weight_entries.size() * sizeof(container_weight_entry));
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        append_aligned(container, weights[i].data.data(), weights[i].data.size());
+    }
+
+    return container;
+}
+
+static int run_net(const ncnn::Net& net, const ncnn::Mat& in, ncnn::Mat& out)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+    return ex.extract("out", out);
+}
+
+static void set_load_option(ncnn::Net& net, bool parallel)
+{
+    net.opt.num_threads = parallel ? 4 : 1;
+    net.opt.use_parallel_create_pipeline = parallel;
+}
+
+static int test_container(bool parallel)
+{
+    std::vector<test_weight> weights;
+    weights.push_back(make_fp32_weight(216, 0));
+    weights.push_back(make_fp32_weight(8, 1));
+    weights.push_back(make_fp16_weight(40));
+    weights.push_back(make_fp32_weight(5, 1));
+
+    std::vector<container_layer_entry> layer_entries(4);
+    memset(&layer_entries[0], 0, layer_entries.size() * sizeof(container_layer_entry));
+    layer_entries[1].first_weight = 0;
+    layer_entries[1].weight_count = 2;
+    layer_entries[2].first_weight = 2;
+    layer_entries[3].first_weight = 2;
+    layer_entries[3].weight_count = 2;
+
+    // the same weights in the sequential model binary
+    std::vector<unsigned char> model;
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        if (weights[i].type == 0)
+            model.insert(model.end(), (const unsigned char*)&weights[i].tag, (const unsigned char*)&weights[i].tag + 4);
+        model.insert(model.end(), weights[i].data.begin(), weights[i].data.end());
+    }
+
+    ncnn::Mat in = RandomMat(9, 7, 3);
+
+    ncnn::Mat ref;
+    {
+        ncnn::Net net;
+        net.load_param_mem(test_net_param);
+        net.load_model(&model[0]);
+        run_net(net, in, ref);
+    }
+
+    // param and bin
+    {
+        ncnn::Net net;
+        set_load_option(net, parallel);
+        net.load_param_mem(test_net_param);
+        int nread = net.load_model(&model[0]);
+        if (nread != (int)model.size())
+        {
+            fprintf(stderr, "load_model mem failed %d\n", nread);
+            return -1;
+        }
+
+        ncnn::Mat out;
+        run_net(net, in, out);
+
+        if (CompareMat(ref, out, 0.001) != 0)
+        {
+            fprintf(stderr, "test_container parallel=%d param bin output mismatch\n", parallel);
+            return -1;
+        }
+    }
+
+    const std::vector<unsigned char> container = make_container(weights, layer_entries);
+
+    // load from 64-byte aligned memory
+    {
+        unsigned char* mem = (unsigned char*)ncnn::fastMalloc(container.size());
+        memcpy(mem, &container[0], container.size());
+
+        ncnn::Mat out;
+        {
+            ncnn::Net net;
+            set_load_option(net, parallel);
+            int nread = net.load_container(mem);
+            if (nread != (int)container.size())
+            {
+                fprintf(stderr, "load_container mem failed %d\n", nread);
+                ncnn::fastFree(mem);
+                return -1;
+            }
+
+            run_net(net, in, out);
+        }
+
+        ncnn::fastFree(mem);
+
+        if (CompareMat(ref, out, 0.001) != 0)
+        {
+            fprintf(stderr, "test_container parallel=%d mem output mismatch\n", parallel);
+            return -1;
+        }
+    }
+
+#if NCNN_STDIO
+    // load from file
+    FILE* fp = tmpfile();
+    if (fp)
+    {
+        fwrite(&container[0], 1, container.size(), fp);
+        rewind(fp);
+
+        ncnn::Net net;
+        set_load_option(net, parallel);
+        int ret = net.load_container(fp);
+        fclose(fp);
+        if (ret != 0)
+        {
+            fprintf(stderr, "load_container fp failed %d\n", ret);
+            return -1;
+        }
+
+        ncnn::Mat out;
+        run_net(net, in, out);
+
+        if (CompareMat(ref, out, 0.001) != 0)
+        {
+            fprintf(stderr, "test_container parallel=%d fp output mismatch\n", parallel);
+            return -1;
+        }
+    }
+#endif // NCNN_STDIO
+
+    // corrupted weight must be rejected
+    {
+        std::vector<unsigned char> corrupted = container;
+
+        container_header header;
+        memcpy(&header, &corrupted[0], sizeof(header));
+        container_weight_entry e;
+        memcpy(&e, &corrupted[header.weight_index_offset], sizeof(e));
+        corrupted[e.offset + 5] ^= 0x40;
+
+        ncnn::Net net;
+        set_load_option(net, parallel);
+        int ret = net.load_container(&corrupted[0]);
+        if (ret >= 0)
+        {
+            fprintf(stderr, "load_container accepted corrupted weight\n");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_container(false)
+           || test_container(true);
+}
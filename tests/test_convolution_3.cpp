@@ -128,6 +128,69 @@ static int test_convolution_3()
     return 0;
 }
 
+static int test_convolution_sparse(int w, int h, int c, int outch, int bias, bool fixed_sparsity = false)
+{
+    ncnn::Mat a = RandomMat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, 1);     // kernel_w
+    pd.set(5, bias);  // bias_term
+    pd.set(6, outch * c);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomMat(outch * c);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    // prune three quarters of the 1x4 blocks along inch
+    // fixed_sparsity keeps every 4th block only, well below the sparse kernel threshold
+    {
+        float* ptr = weights[0];
+        for (int i = 0; i + 3 < weights[0].w; i += 4)
+        {
+            if (fixed_sparsity ? (i / 4) % 4 != 0 : RAND() % 4 != 0)
+            {
+                ptr[i] = 0.f;
+                ptr[i + 1] = 0.f;
+                ptr[i + 2] = 0.f;
+                ptr[i + 3] = 0.f;
+            }
+        }
+    }
+
+    int ret = test_layer("Convolution", pd, weights, a, 0.001f);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_convolution_sparse failed w=%d h=%d c=%d outch=%d bias=%d fixed_sparsity=%d act=%d actparams=[%f,%f]\n", w, h, c, outch, bias, fixed_sparsity, activation_type, activation_params[0], activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_convolution_4()
+{
+    return 0
+           || test_convolution_sparse(1, 1, 4, 3, 1)
+           || test_convolution_sparse(7, 5, 8, 16, 0)
+           || test_convolution_sparse(9, 7, 12, 5, 1)
+           || test_convolution_sparse(13, 11, 16, 16, 1)
+           || test_convolution_sparse(15, 12, 24, 32, 0)
+           || test_convolution_sparse(19, 17, 32, 28, 1)
+           || test_convolution_sparse(40, 40, 64, 48, 1)
+           || test_convolution_sparse(7, 5, 8, 16, 0, true)
+           || test_convolution_sparse(13, 11, 16, 16, 1, true)
+           || test_convolution_sparse(19, 17, 32, 28, 1, true)
+           || test_convolution_sparse(40, 40, 64, 48, 1, true);
+}
+
 #if NCNN_INT8
 static int test_convolution_int8(int w, int h, int c, int outch, int kernel, int dilation, int stride, int pad, int bias, bool requant = false)
 {
@@ -445,10 +508,12 @@ int main()
            || test_convolution_1()
            || test_convolution_1_2()
            || test_convolution_2()
-           || test_convolution_3();
+           || test_convolution_3()
+           || test_convolution_4();
 #else
     return 0
            || test_convolution_2()
-           || test_convolution_3();
+           || test_convolution_3()
+           || test_convolution_4();
 #endif
 }
@@ -151,11 +151,40 @@ static int test_cpu_powersave()
 
 #endif
 
+static int test_thread_work_threshold()
+{
+    const int threshold = ncnn::get_thread_work_threshold();
+    if (threshold != 65536)
+    {
+        fprintf(stderr, "By default thread work threshold must be 65536\n");
+        return 1;
+    }
+
+    ncnn::set_thread_work_threshold(1024);
+    if (ncnn::get_thread_work_threshold() != 1024)
+    {
+        fprintf(stderr, "Set thread work threshold works incorrectly\n");
+        return 1;
+    }
+
+    const int calibrated = ncnn::calibrate_thread_work_threshold(2);
+    if (calibrated != ncnn::get_thread_work_threshold() || calibrated <= 0 || calibrated > 64 * 1024 * 1024)
+    {
+        fprintf(stderr, "Calibrated thread work threshold %d is out of range\n", calibrated);
+        return 1;
+    }
+
+    ncnn::set_thread_work_threshold(threshold);
+
+    return 0;
+}
+
 int main()
 {
     return 0
            || test_cpu_set()
            || test_cpu_info()
            || test_cpu_omp()
-           || test_cpu_powersave();
+           || test_cpu_powersave()
+           || test_thread_work_threshold();
 }
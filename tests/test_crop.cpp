@@ -21,7 +21,10 @@ static int test_crop(const ncnn::Mat& a, int woffset, int hoffset, int doffset,
 
     std::vector<ncnn::Mat> weights(0);
 
-    int ret = test_layer("Crop", pd, weights, a);
+    // int8 blobs are passed through as is
+    int flag = a.elembits() == 8 ? TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING : 0;
+
+    int ret = test_layer("Crop", pd, weights, a, 0.001, 0, flag);
     if (ret != 0)
     {
         fprintf(stderr, "test_crop failed a.dims=%d a=(%d %d %d %d) woffset=%d hoffset=%d doffset=%d coffset=%d outw=%d outh=%d outd=%d outc=%d woffset2=%d hoffset2=%d doffset2=%d coffset2=%d\n", a.dims, a.w, a.h, a.d, a.c, woffset, hoffset, doffset, coffset, outw, outh, outd, outc, woffset2, hoffset2, doffset2, coffset2);
@@ -264,5 +267,10 @@ int main()
            || test_crop_6(RandomMat(16, 16, 33))
            || test_crop_9(RandomMat(20, 20, 20, 48))
            || test_crop_9(RandomMat(15, 15, 15, 36))
-           || test_crop_9(RandomMat(16, 16, 16, 33));
+           || test_crop_9(RandomMat(16, 16, 16, 33))
+           || test_crop_0(RandomS8Mat(112))
+           || test_crop_3(RandomS8Mat(20, 48))
+           || test_crop_6(RandomS8Mat(20, 20, 48))
+           || test_crop_6(RandomS8Mat(16, 16, 33))
+           || test_crop_9(RandomS8Mat(20, 20, 20, 48));
 }
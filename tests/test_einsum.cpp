@@ -149,6 +149,44 @@ static int test_einsum_11()
     return test_einsum(a, "imnj,kmln->ijkl");
 }
 
+static int test_einsum_12()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(16, 13, 4, 2);
+    a[1] = RandomMat(16, 11, 4, 2);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(9, 13, 3);
+    b[1] = RandomMat(7, 9, 3);
+
+    return 0
+           || test_einsum(a, "ijkm,ijlm->ijkl")
+           || test_einsum(a, "ijlm,ijkm->ijkl")
+           || test_einsum(b, "ijm,imk->ijk")
+           || test_einsum(b, "ikm,imj->ijk");
+}
+
+static int test_einsum_13()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(5, 3, 7);
+    a[1] = RandomMat(6, 7);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(5, 3, 7);
+    b[1] = RandomMat(3, 6, 7);
+
+    std::vector<ncnn::Mat> c(2);
+    c[0] = RandomMat(5, 3, 7);
+    c[1] = RandomMat(4, 5, 7);
+
+    return 0
+           || test_einsum(a, "mij,mk->ijk")
+           || test_einsum(a, "mjk,mi->ijk")
+           || test_einsum(b, "ilj,ikl->ijk")
+           || test_einsum(c, "jkm,jmi->ij");
+}
+
 int main()
 {
     SRAND(7767517);
@@ -165,5 +203,7 @@ int main()
            || test_einsum_8()
            || test_einsum_9()
            || test_einsum_10()
-           || test_einsum_11();
+           || test_einsum_11()
+           || test_einsum_12()
+           || test_einsum_13();
 }
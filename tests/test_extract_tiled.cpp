@@ -0,0 +1,122 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <vector>
+
+static const char* test_net_param = "7767517\n"
+                                    "11 13\n"
+                                    "Input                data   0 1 data 0=37 1=29 2=3\n"
+                                    "Convolution          conv1  1 1 data c1 0=8 1=3 4=1 5=1 6=216 9=1\n"
+                                    "ConvolutionDepthWise dw     1 1 c1 d1 0=8 1=3 3=2 4=1 5=1 6=72 7=8 9=2 -23310=1,1.000000e-01\n"
+                                    "Split                split  1 3 d1 s1 s2 s3\n"
+                                    "Pooling              pool   1 1 s1 p1 0=1 1=3 2=1 3=1\n"
+                                    "Convolution          conv2  1 1 s2 c2 0=8 1=1 5=1 6=64\n"
+                                    "BinaryOp             add    2 1 p1 c2 a1 0=0\n"
+                                    "Concat               cat    2 1 a1 s3 cat 0=0\n"
+                                    "Convolution          conv3  1 1 cat c3 0=4 1=3 3=2 5=1 6=576\n"
+                                    "Pooling              pool2  1 1 c3 out 0=0 1=2 2=2\n"
+                                    "Pooling              gap    1 1 out gap 0=1 4=1\n";
+
+static void append_weight(std::vector<float>& model, int size, bool tagged)
+{
+    if (tagged)
+    {
+        // fp32 tag
+        model.push_back(0.f);
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        model.push_back(RandomFloat(-1.f, 1.f));
+    }
+}
+
+static int test_extract_tiled(const ncnn::Net& net, const ncnn::Mat& in, const char* blob_name, int tile_w, int tile_h)
+{
+    ncnn::Mat a;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ex.extract(blob_name, a);
+    }
+
+    ncnn::Mat b;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        int ret = ex.extract_tiled(blob_name, b, tile_w, tile_h);
+        if (ret != 0)
+        {
+            fprintf(stderr, "extract_tiled %s failed tile=%d %d\n", blob_name, tile_w, tile_h);
+            return -1;
+        }
+    }
+
+    if (CompareMat(a, b, 0.001) != 0)
+    {
+        fprintf(stderr, "test_extract_tiled failed blob=%s tile=%d %d\n", blob_name, tile_w, tile_h);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_extract_tiled_0()
+{
+    std::vector<float> model;
+    append_weight(model, 216, true);
+    append_weight(model, 8, false);
+    append_weight(model, 72, true);
+    append_weight(model, 8, false);
+    append_weight(model, 64, true);
+    append_weight(model, 8, false);
+    append_weight(model, 576, true);
+    append_weight(model, 4, false);
+
+    ncnn::Net net;
+    net.load_param_mem(test_net_param);
+    net.load_model((const unsigned char*)model.data());
+
+    ncnn::Mat in = RandomMat(37, 29, 3);
+
+    const int tiles[][2] = {{1, 1}, {3, 2}, {4, 7}, {5, 16}, {100, 100}};
+
+    for (int i = 0; i < 5; i++)
+    {
+        const int tile_w = tiles[i][0];
+        const int tile_h = tiles[i][1];
+
+        int ret = test_extract_tiled(net, in, "c1", tile_w, tile_h)
+                  || test_extract_tiled(net, in, "cat", tile_w, tile_h)
+                  || test_extract_tiled(net, in, "out", tile_w, tile_h);
+
+        if (ret != 0)
+            return -1;
+    }
+
+    // global pooling has no spatial halo
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+
+        ncnn::Mat gap;
+        int ret = ex.extract_tiled("gap", gap, 8, 8);
+        if (ret != -1)
+        {
+            fprintf(stderr, "test_extract_tiled global pooling should fail\n");
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_extract_tiled_0();
+}
@@ -168,6 +168,84 @@ static int test_gridsample_3()
            || test_gridsample(RandomMat(16, 12, 11, 16), RandomMat(11, 12, 16, 3), 2, 3, 1, 1);
 }
 
+// the offsets of a repeated grid are cached across calls, feed one layer a sequence of grids and shapes
+static int test_gridsample_cache(int sample_type, int padding_mode, int align_corner)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, sample_type);
+    pd.set(1, padding_mode);
+    pd.set(2, align_corner);
+
+    std::vector<ncnn::Mat> weights(0);
+    ncnn::ModelBinFromMatArray mb(weights.data());
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+
+    ncnn::Layer* op = ncnn::create_layer_cpu("GridSample");
+    op->load_param(pd);
+    op->load_model(mb);
+    op->create_pipeline(opt);
+
+    ncnn::Layer* op_naive = ncnn::create_layer_naive("GridSample");
+    op_naive->load_param(pd);
+    op_naive->load_model(mb);
+    op_naive->create_pipeline(opt);
+
+    const ncnn::Mat a0 = RandomMat(9, 7, 3);
+    const ncnn::Mat a1 = RandomMat(11, 5, 3);
+    const ncnn::Mat grid0 = RandomMat(2, 13, 17);
+    const ncnn::Mat grid1 = RandomMat(2, 13, 17);
+
+    const ncnn::Mat inputs[][2] = {
+        {a0, grid0},
+        {a0, grid0},
+        {a0, grid0.clone()},
+        {a1, grid0},
+        {a1, grid1},
+        {a0, grid1},
+        {a0, grid0},
+        {a0, grid0},
+    };
+
+    int ret = 0;
+    for (int i = 0; i < (int)(sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        std::vector<ncnn::Mat> as(2);
+        as[0] = inputs[i][0];
+        as[1] = inputs[i][1];
+
+        std::vector<ncnn::Mat> b(1);
+        std::vector<ncnn::Mat> c(1);
+        op_naive->forward(as, b, opt);
+        op->forward(as, c, opt);
+
+        if (CompareMat(b, c, 0.001) != 0)
+        {
+            fprintf(stderr, "test_gridsample_cache failed call=%d sample_type=%d padding_mode=%d align_corner=%d\n", i, sample_type, padding_mode, align_corner);
+            ret = -1;
+            break;
+        }
+    }
+
+    op->destroy_pipeline(opt);
+    op_naive->destroy_pipeline(opt);
+    delete op;
+    delete op_naive;
+
+    return ret;
+}
+
+static int test_gridsample_4()
+{
+    return 0
+           || test_gridsample_cache(1, 1, 0)
+           || test_gridsample_cache(1, 3, 1)
+           || test_gridsample_cache(2, 2, 0)
+           || test_gridsample_cache(3, 1, 1);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -176,5 +254,6 @@ int main()
            || test_gridsample_0()
            || test_gridsample_1()
            || test_gridsample_2()
-           || test_gridsample_3();
+           || test_gridsample_3()
+           || test_gridsample_4();
 }
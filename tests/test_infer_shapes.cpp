@@ -0,0 +1,148 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "datareader.h"
+#include "net.h"
+#include "testutil.h"
+
+#include <string.h>
+
+static const char* test_net_param = "7767517\n"
+                                    "23 30\n"
+                                    "Input               data     0 1 data 0=24 1=20 2=3\n"
+                                    "Convolution         conv0    1 1 data c0 0=8 1=3 3=2 4=-233 5=1 6=216\n"
+                                    "Pooling             pool0    1 1 c0 p0 0=0 1=3 2=2\n"
+                                    "Split               split0   1 3 p0 p0a p0b p0c\n"
+                                    "ConvolutionDepthWise dw0     1 1 p0a d0 0=8 1=3 4=1 5=1 6=72 7=8\n"
+                                    "Deconvolution       deconv0  1 1 p0b u0 0=4 1=4 3=2 4=1 5=1 6=512\n"
+                                    "Interp              interp0  1 1 d0 i0 0=2 1=2.0 2=2.0\n"
+                                    "Split               split1   1 2 i0 i0a i0b\n"
+                                    "Concat              cat0     2 1 i0a u0 cat0 0=0\n"
+                                    "Slice               slice0   1 3 cat0 s0 s1 s2 -23300=3,-233,-233,-233 1=0\n"
+                                    "Pooling             gap0     1 1 s1 g0 0=1 4=1\n"
+                                    "BinaryOp            add0     2 1 s0 g0 b0 0=0\n"
+                                    "Crop                crop0    1 1 b0 cr0 0=1 1=2 2=0 3=10 4=6 5=4\n"
+                                    "Reshape             reshape0 2 1 cr0 s2 rs0 6=\"-1,*(0h,2),1c\"\n"
+                                    "Permute             permute0 1 1 rs0 pm0 0=3\n"
+                                    "Split               split2   1 2 pm0 pm0a pm0b\n"
+                                    "Flatten             flatten0 1 1 pm0a fl0\n"
+                                    "InnerProduct        fc0      1 1 fl0 fc0 0=10 1=1 2=2400\n"
+                                    "Reshape             reshape1 1 1 pm0b rs1 0=20 1=12\n"
+                                    "Gemm                gemm0    1 1 rs1 gm0 5=1 8=7 9=20\n"
+                                    "Split               split3   1 2 gm0 gm0a gm0b\n"
+                                    "MatMul              matmul0  2 1 gm0a gm0b mm0 0=1\n"
+                                    "Reorg               reorg0   1 1 i0b ro0 0=2\n";
+
+static int compare_shape(const ncnn::Mat& a, const ncnn::Mat& b)
+{
+    if (a.dims != b.dims || a.w != b.w || a.h != b.h || a.d != b.d || a.c != b.c)
+        return -1;
+
+    return 0;
+}
+
+static int test_infer_shapes(const ncnn::Net& net, const ncnn::Mat& in, bool model_loaded)
+{
+    std::vector<ncnn::Mat> input_shapes(1);
+    if (!in.empty())
+        input_shapes[0] = in.shape();
+
+    std::vector<ncnn::Mat> blob_shapes;
+    int ret = net.infer_shapes(input_shapes, blob_shapes);
+    if (ret != 0)
+    {
+        fprintf(stderr, "infer_shapes failed %d\n", ret);
+        return -1;
+    }
+
+    const ncnn::Mat data = in.empty() ? RandomMat(24, 20, 3) : in;
+
+    const std::vector<ncnn::Blob>& blobs = net.blobs();
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        const ncnn::Mat& shape = blob_shapes[i];
+
+        // reorg has no shape function and runs only when the model is loaded
+        if (!model_loaded && blobs[i].name == "ro0")
+        {
+            if (shape.dims != 0)
+            {
+                fprintf(stderr, "blob %s should be unresolved without model\n", blobs[i].name.c_str());
+                return -1;
+            }
+            continue;
+        }
+
+        if (!model_loaded)
+        {
+            if (shape.dims == 0)
+            {
+                fprintf(stderr, "blob %s unresolved\n", blobs[i].name.c_str());
+                return -1;
+            }
+            continue;
+        }
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", data);
+
+        ncnn::Mat out;
+        ex.extract((int)i, out);
+
+        if (compare_shape(shape, out.shape()) != 0)
+        {
+            fprintf(stderr, "blob %s inferred %d %d %d %d %d but got %d %d %d %d %d\n", blobs[i].name.c_str(),
+                    shape.dims, shape.w, shape.h, shape.d, shape.c, out.dims, out.w, out.h, out.d, out.c);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+class DataReaderFromZero : public ncnn::DataReader
+{
+public:
+    virtual int scan(const char* /*format*/, void* /*p*/) const
+    {
+        return 0;
+    }
+    virtual size_t read(void* buf, size_t size) const
+    {
+        memset(buf, 0, size);
+        return size;
+    }
+};
+
+static int test_infer_shapes_0()
+{
+    ncnn::Net net;
+    net.opt.use_packing_layout = true;
+    net.opt.use_fp16_storage = false;
+    net.opt.use_bf16_storage = false;
+
+    if (net.load_param_mem(test_net_param) != 0)
+    {
+        fprintf(stderr, "load_param_mem failed\n");
+        return -1;
+    }
+
+    // without weights
+    if (test_infer_shapes(net, ncnn::Mat(), false) != 0)
+        return -1;
+
+    DataReaderFromZero dr;
+    net.load_model(dr);
+
+    return 0
+           || test_infer_shapes(net, ncnn::Mat(), true)
+           || test_infer_shapes(net, RandomMat(24, 20, 3), true)
+           || test_infer_shapes(net, RandomMat(32, 28, 3), true);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_infer_shapes_0();
+}
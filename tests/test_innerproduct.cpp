@@ -246,6 +246,71 @@ static int test_innerproduct_5()
 }
 #endif // NCNN_INT8
 
+static int test_innerproduct_sparse(const ncnn::Mat& a, int outch, int bias, bool fixed_sparsity = false)
+{
+    const int num_input = a.dims == 2 ? a.w : a.w * a.h * a.c;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, bias);  // bias_term
+    pd.set(2, outch * num_input);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomMat(outch * num_input);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    // prune three quarters of the 1x4 blocks along num_input
+    // fixed_sparsity keeps every 4th block only, well below the sparse kernel threshold
+    {
+        float* ptr = weights[0];
+        for (int i = 0; i + 3 < weights[0].w; i += 4)
+        {
+            if (fixed_sparsity ? (i / 4) % 4 != 0 : RAND() % 4 != 0)
+            {
+                ptr[i] = 0.f;
+                ptr[i + 1] = 0.f;
+                ptr[i + 2] = 0.f;
+                ptr[i + 3] = 0.f;
+            }
+        }
+    }
+
+    int ret = test_layer("InnerProduct", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_innerproduct_sparse failed a.dims=%d a=(%d %d %d) outch=%d bias=%d fixed_sparsity=%d act=%d actparams=[%f,%f]\n", a.dims, a.w, a.h, a.c, outch, bias, fixed_sparsity, activation_type, activation_params[0], activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_innerproduct_6()
+{
+    return 0
+           || test_innerproduct_sparse(RandomMat(4), 1, 1)
+           || test_innerproduct_sparse(RandomMat(16), 7, 0)
+           || test_innerproduct_sparse(RandomMat(64), 16, 1)
+           || test_innerproduct_sparse(RandomMat(128), 24, 1)
+           || test_innerproduct_sparse(RandomMat(2, 2, 8), 8, 0)
+           || test_innerproduct_sparse(RandomMat(6, 2, 16), 32, 1)
+           || test_innerproduct_sparse(RandomMat(4, 15), 8, 1)
+           || test_innerproduct_sparse(RandomMat(16, 16), 12, 0)
+           || test_innerproduct_sparse(RandomMat(32, 24), 7, 1)
+           || test_innerproduct_sparse(RandomMat(48, 32), 32, 1)
+           || test_innerproduct_sparse(RandomMat(16), 7, 0, true)
+           || test_innerproduct_sparse(RandomMat(128), 24, 1, true)
+           || test_innerproduct_sparse(RandomMat(6, 2, 16), 32, 1, true)
+           || test_innerproduct_sparse(RandomMat(32, 24), 7, 1, true);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -257,12 +322,14 @@ int main()
            || test_innerproduct_2()
            || test_innerproduct_3()
            || test_innerproduct_4()
-           || test_innerproduct_5();
+           || test_innerproduct_5()
+           || test_innerproduct_6();
 #else
     return 0
            || test_innerproduct_0()
            || test_innerproduct_1()
            || test_innerproduct_2()
-           || test_innerproduct_4();
+           || test_innerproduct_4()
+           || test_innerproduct_6();
 #endif
 }
@@ -496,6 +496,71 @@ static int test_interp_6()
            || test_interp_ref(c, 1, 14, 17);
 }
 
+// the resize coefficients are cached by shape, feed one layer a sequence of shapes
+static int test_interp_cache(int resize_type, int align_corner)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, resize_type);
+    pd.set(1, 2.f);
+    pd.set(2, 3.f);
+    pd.set(6, align_corner);
+
+    std::vector<ncnn::Mat> weights(0);
+    ncnn::ModelBinFromMatArray mb(weights.data());
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+
+    ncnn::Layer* op = ncnn::create_layer_cpu("Interp");
+    op->load_param(pd);
+    op->load_model(mb);
+    op->create_pipeline(opt);
+
+    ncnn::Layer* op_naive = ncnn::create_layer_naive("Interp");
+    op_naive->load_param(pd);
+    op_naive->load_model(mb);
+    op_naive->create_pipeline(opt);
+
+    const ncnn::Mat a0 = RandomMat(9, 7, 3);
+    const ncnn::Mat a1 = RandomMat(11, 5, 3);
+    const ncnn::Mat a2 = RandomMat(9, 7);
+
+    const ncnn::Mat inputs[] = {a0, a0, a1, a0, a2, a0, a0};
+
+    int ret = 0;
+    for (int i = 0; i < (int)(sizeof(inputs) / sizeof(inputs[0])); i++)
+    {
+        ncnn::Mat b;
+        ncnn::Mat c;
+        op_naive->forward(inputs[i], b, opt);
+        op->forward(inputs[i], c, opt);
+
+        if (CompareMat(b, c, 0.001) != 0)
+        {
+            fprintf(stderr, "test_interp_cache failed call=%d resize_type=%d align_corner=%d\n", i, resize_type, align_corner);
+            ret = -1;
+            break;
+        }
+    }
+
+    op->destroy_pipeline(opt);
+    op_naive->destroy_pipeline(opt);
+    delete op;
+    delete op_naive;
+
+    return ret;
+}
+
+static int test_interp_7()
+{
+    return 0
+           || test_interp_cache(2, 0)
+           || test_interp_cache(2, 1)
+           || test_interp_cache(3, 0)
+           || test_interp_cache(3, 1);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -507,5 +572,6 @@ int main()
            || test_interp_3()
            || test_interp_4()
            || test_interp_5()
-           || test_interp_6();
+           || test_interp_6()
+           || test_interp_7();
 }
@@ -43,6 +43,97 @@ static int test_matmul_transb(const ncnn::Mat& a, const ncnn::Mat& b)
     return ret;
 }
 
+#if NCNN_INT8
+static ncnn::Mat RandomIntRowsMat(ncnn::Mat m)
+{
+    // integer values with absmax 127 in every row, dynamic int8 quantization is lossless
+    for (int q = 0; q < m.c; q++)
+    {
+        float* p = m.channel(q);
+        for (int i = 0; i < m.d * m.h; i++)
+        {
+            for (int j = 0; j < m.w; j++)
+            {
+                p[j] = (float)RandomInt(-127, 127);
+            }
+            p[RandomInt(0, m.w - 1)] = RandomInt(0, 1) ? 127.f : -127.f;
+            p += m.w;
+        }
+    }
+
+    return m;
+}
+
+// epsilon 0 feeds integer data that quantizes losslessly, otherwise random float data is compared with epsilon
+static int test_matmul_int8(const ncnn::Mat& a, const ncnn::Mat& b, int transB, float epsilon = 0.f)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, transB);
+    pd.set(18, 2); // int8_scale_term
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> as(2);
+    as[0] = epsilon == 0.f ? RandomIntRowsMat(a) : a;
+    as[1] = epsilon == 0.f ? RandomIntRowsMat(b) : b;
+
+    int ret = test_layer("MatMul", pd, weights, as, 1, epsilon == 0.f ? 0.001f : epsilon);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_matmul_int8 failed a.dims=%d a=(%d %d %d %d) b.dims=%d b=(%d %d %d %d) transB=%d epsilon=%f\n", a.dims, a.w, a.h, a.d, a.c, b.dims, b.w, b.h, b.d, b.c, transB, epsilon);
+    }
+
+    return ret;
+}
+
+// random float data, compared with the fp32 result within the quantization error
+static int test_matmul_int8_float(const ncnn::Mat& a, const ncnn::Mat& b, int transB)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, transB);
+
+    ncnn::ParamDict pd_int8;
+    pd_int8.set(0, transB);
+    pd_int8.set(18, 2); // int8_scale_term
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    std::vector<ncnn::Mat> as(2);
+    as[0] = a;
+    as[1] = b;
+
+    std::vector<ncnn::Mat> c(1);
+    {
+        ncnn::Layer* op = ncnn::create_layer_naive("MatMul");
+        op->load_param(pd);
+        op->create_pipeline(opt);
+        op->forward(as, c, opt);
+        op->destroy_pipeline(opt);
+        delete op;
+    }
+
+    std::vector<ncnn::Mat> d(1);
+    {
+        ncnn::Layer* op = ncnn::create_layer_cpu("MatMul");
+        op->load_param(pd_int8);
+        op->create_pipeline(opt);
+        op->forward(as, d, opt);
+        op->destroy_pipeline(opt);
+        delete op;
+    }
+
+    // values in [-1, 1] are quantized with a step of 1/127, the error over k products stays well below 0.1
+    if (CompareMat(c, d, 0.1) != 0)
+    {
+        fprintf(stderr, "test_matmul_int8_float failed a.dims=%d a=(%d %d %d %d) b.dims=%d b=(%d %d %d %d) transB=%d\n", a.dims, a.w, a.h, a.d, a.c, b.dims, b.w, b.h, b.d, b.c, transB);
+        return -1;
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 static int test_matmul_0()
 {
     return 0
@@ -219,6 +310,30 @@ static int test_matmul_15()
            || test_matmul_transb(RandomMat(14, 20, 8, 18), RandomMat(14, 9, 8, 18));
 }
 
+static int test_matmul_16()
+{
+#if NCNN_INT8
+    return 0
+           || test_matmul_int8(RandomMat(124), RandomMat(124), 0)
+           || test_matmul_int8(RandomMat(16), RandomMat(12, 16), 0)
+           || test_matmul_int8(RandomMat(11, 16), RandomMat(11), 0)
+           || test_matmul_int8(RandomMat(14, 10), RandomMat(5, 14), 0)
+           || test_matmul_int8(RandomMat(16, 16), RandomMat(16, 10), 1)
+           || test_matmul_int8(RandomMat(64, 23, 10), RandomMat(64, 35, 10), 1)
+           || test_matmul_int8(RandomMat(32, 22, 9), RandomMat(17, 32), 0)
+           || test_matmul_int8(RandomMat(14, 20, 8, 3), RandomMat(9, 14, 8, 3), 0)
+           || test_matmul_int8(RandomMat(24, 13, 2, 10), RandomMat(24, 7), 1)
+           || test_matmul_int8(RandomMat(14, 10), RandomMat(5, 14), 0, 0.01)
+           || test_matmul_int8(RandomMat(64, 23, 10), RandomMat(64, 35, 10), 1, 0.01)
+           || test_matmul_int8_float(RandomMat(64, 24), RandomMat(32, 64), 0)
+           || test_matmul_int8_float(RandomMat(96, 17), RandomMat(96, 40), 1)
+           || test_matmul_int8_float(RandomMat(48, 20, 6), RandomMat(48, 33, 6), 1)
+           || test_matmul_int8_float(RandomMat(40, 9, 2, 3), RandomMat(16, 40), 0);
+#else
+    return 0;
+#endif
+}
+
 int main()
 {
     SRAND(7767517);
@@ -239,5 +354,6 @@ int main()
            || test_matmul_12()
            || test_matmul_13()
            || test_matmul_14()
-           || test_matmul_15();
+           || test_matmul_15()
+           || test_matmul_16();
 }
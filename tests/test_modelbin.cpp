@@ -0,0 +1,227 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "modelwriter.h"
+
+// 1x4 block sparse weight, 3 of every 4 blocks are zero
+static void fill_block_sparse(float* ptr, int size)
+{
+    for (int i = 0; i < size; i++)
+    {
+        ptr[i] = (i / 4) % 4 == 1 ? RandomFloat() : 0.f;
+    }
+}
+
+static int test_modelbin_block_sparse_0()
+{
+    const int w = 32;
+
+    float dense[w];
+    fill_block_sparse(dense, w);
+
+    // tag block_size nnzb block_index[nnzb] value[nnzb * block_size]
+    std::vector<unsigned char> buffer;
+    {
+        std::vector<unsigned int> words;
+        words.push_back(0x0B5E1D04);
+        words.push_back(4);
+        words.push_back(w / 16);
+        for (int i = 1; i < w / 4; i += 4)
+        {
+            words.push_back(i);
+        }
+        for (int i = 1; i < w / 4; i += 4)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                unsigned int v;
+                memcpy(&v, &dense[i * 4 + j], sizeof(float));
+                words.push_back(v);
+            }
+        }
+
+        buffer.resize(words.size() * sizeof(unsigned int));
+        memcpy(&buffer[0], &words[0], buffer.size());
+    }
+
+    const unsigned char* mem = &buffer[0];
+    ncnn::DataReaderFromMemory dr(mem);
+    ncnn::ModelBinFromDataReader mb(dr);
+
+    ncnn::Mat m = mb.load(w, 0);
+    if (m.empty() || m.w != w)
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_0 load failed\n");
+        return -1;
+    }
+
+    if (memcmp(m.data, dense, w * sizeof(float)) != 0)
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_0 data mismatch\n");
+        return -1;
+    }
+
+    if (mem != &buffer[0] + buffer.size())
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_0 consumed %d bytes, expect %d\n", (int)(mem - &buffer[0]), (int)buffer.size());
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_modelbin_block_sparse_1()
+{
+    // block index out of range
+    const unsigned int words[] = {0x0B5E1D04, 4, 1, 2, 0, 0, 0, 0};
+
+    const unsigned char* mem = (const unsigned char*)words;
+    ncnn::DataReaderFromMemory dr(mem);
+    ncnn::ModelBinFromDataReader mb(dr);
+
+    ncnn::Mat m = mb.load(8, 0);
+    if (!m.empty())
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_1 accepted an out of range block index\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int forward_innerproduct(const char* parampath, const char* binpath, const ncnn::Mat& in, ncnn::Mat& out)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+
+    if (net.load_param(parampath) != 0 || net.load_model(binpath) != 0)
+    {
+        fprintf(stderr, "load %s %s failed\n", parampath, binpath);
+        return -1;
+    }
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+    return ex.extract("fc", out);
+}
+
+static int test_modelbin_block_sparse_2()
+{
+    const int num_input = 64;
+    const int num_output = 16;
+
+    const char* param = "7767517\n"
+                        "2 2\n"
+                        "Input        data 0 1 data 0=64\n"
+                        "InnerProduct fc   1 1 data fc 0=16 1=1 2=1024\n";
+
+    FILE* fp = fopen("test_modelbin_dense.param", "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen test_modelbin_dense.param failed\n");
+        return -1;
+    }
+    fprintf(fp, "%s", param);
+    fclose(fp);
+
+    fp = fopen("test_modelbin_dense.bin", "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen test_modelbin_dense.bin failed\n");
+        return -1;
+    }
+    {
+        std::vector<float> weight(num_input * num_output);
+        fill_block_sparse(&weight[0], num_input * num_output);
+
+        std::vector<float> bias(num_output);
+        for (int i = 0; i < num_output; i++)
+        {
+            bias[i] = RandomFloat();
+        }
+
+        const unsigned int tag = 0; // fp32 tag
+        fwrite(&tag, sizeof(tag), 1, fp);
+        fwrite(&weight[0], sizeof(float), weight.size(), fp);
+        fwrite(&bias[0], sizeof(float), bias.size(), fp);
+    }
+    const long dense_size = ftell(fp);
+    fclose(fp);
+
+    // write the pruned weight back with block sparse encoding
+    {
+        ModelWriter mw;
+        mw.storage_type = 2;
+        if (mw.load_param("test_modelbin_dense.param") != 0 || mw.load_model("test_modelbin_dense.bin") != 0)
+        {
+            fprintf(stderr, "ModelWriter load failed\n");
+            return -1;
+        }
+
+        mw.save("test_modelbin_sparse.param", "test_modelbin_sparse.bin");
+    }
+
+    fp = fopen("test_modelbin_sparse.bin", "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen test_modelbin_sparse.bin failed\n");
+        return -1;
+    }
+    unsigned int tag = 0;
+    size_t nread = fread(&tag, sizeof(tag), 1, fp);
+    fseek(fp, 0, SEEK_END);
+    const long sparse_size = ftell(fp);
+    fclose(fp);
+
+    if (nread != 1 || tag != 0x0B5E1D04 || sparse_size >= dense_size)
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_2 weight not block sparse encoded tag=%08x size=%ld/%ld\n", tag, sparse_size, dense_size);
+        return -1;
+    }
+
+    ncnn::Mat in(num_input);
+    for (int i = 0; i < num_input; i++)
+    {
+        in[i] = RandomFloat();
+    }
+
+    ncnn::Mat a;
+    ncnn::Mat b;
+    if (forward_innerproduct("test_modelbin_dense.param", "test_modelbin_dense.bin", in, a) != 0
+            || forward_innerproduct("test_modelbin_sparse.param", "test_modelbin_sparse.bin", in, b) != 0)
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_2 forward failed\n");
+        return -1;
+    }
+
+    if (a.w != num_output || b.w != num_output)
+    {
+        fprintf(stderr, "test_modelbin_block_sparse_2 output shape mismatch %d %d\n", a.w, b.w);
+        return -1;
+    }
+
+    for (int i = 0; i < num_output; i++)
+    {
+        if (fabs(a[i] - b[i]) > 0.001f)
+        {
+            fprintf(stderr, "test_modelbin_block_sparse_2 value mismatch at %d %f %f\n", i, a[i], b[i]);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_modelbin_block_sparse_0()
+           || test_modelbin_block_sparse_1()
+           || test_modelbin_block_sparse_2();
+}
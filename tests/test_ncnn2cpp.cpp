@@ -0,0 +1,149 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// built twice, with NCNN2CPP_WRITE_MODEL to write the model that ncnn2cpp compiles,
+// then with the generated source to compare it with the same model run by ncnn::Net
+
+#include "net.h"
+#include "testutil.h"
+
+#include <vector>
+
+// clip bounds -1e39 and 3e38 check the literals of infinity and floats out of int range
+static const char* test_model_param = "7767517\n"
+                                      "9 10\n"
+                                      "Input                data    0 1 data 0=24 1=20 2=3\n"
+                                      "Convolution          conv0   1 1 data c0 0=8 1=3 4=1 5=1 6=216 9=1\n"
+                                      "Split                split   1 2 c0 s0 s1\n"
+                                      "Pooling              pool    1 1 s0 p0 0=0 1=2 2=2\n"
+                                      "ConvolutionDepthWise dw      1 1 s1 d0 0=8 1=3 3=2 4=1 5=1 6=72 7=8 9=2 -23310=1,0.1\n"
+                                      "Concat               cat     2 1 p0 d0 cat\n"
+                                      "InnerProduct         fc      1 1 cat fc 0=10 1=1 2=19200\n"
+                                      "Clip                 clip    1 1 fc fcc 0=-1e39 1=3e38\n"
+                                      "Softmax              prob    1 1 fcc prob\n";
+
+#ifdef NCNN2CPP_WRITE_MODEL
+static void write_weight(FILE* fp, int size, bool tagged)
+{
+    if (tagged)
+    {
+        // fp32 tag
+        const unsigned int tag = 0;
+        fwrite(&tag, sizeof(tag), 1, fp);
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        const float v = RandomFloat(-1.f, 1.f);
+        fwrite(&v, sizeof(v), 1, fp);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s [outname]\n", argv[0]);
+        return -1;
+    }
+
+    SRAND(7767517);
+
+    char path[256];
+    sprintf(path, "%s.param", argv[1]);
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+    fprintf(fp, "%s", test_model_param);
+    fclose(fp);
+
+    sprintf(path, "%s.bin", argv[1]);
+    fp = fopen(path, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+    write_weight(fp, 216, true);
+    write_weight(fp, 8, false);
+    write_weight(fp, 72, true);
+    write_weight(fp, 8, false);
+    write_weight(fp, 19200, true);
+    write_weight(fp, 10, false);
+    fclose(fp);
+
+    return 0;
+}
+#else // NCNN2CPP_WRITE_MODEL
+#include "test_ncnn2cpp_model.h"
+
+static int test_ncnn2cpp(int use_packing_layout)
+{
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = use_packing_layout;
+
+    ncnn::Net net;
+    net.opt = opt;
+    if (net.load_param(NCNN2CPP_MODEL ".param") != 0 || net.load_model(NCNN2CPP_MODEL ".bin") != 0)
+    {
+        fprintf(stderr, "load %s failed\n", NCNN2CPP_MODEL);
+        return -1;
+    }
+
+    test_ncnn2cpp_model::Model model;
+    if (model.load(opt) != 0)
+    {
+        fprintf(stderr, "load generated model failed\n");
+        return -1;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat in = RandomMat(24, 20, 3);
+
+        ncnn::Mat a;
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.input("data", in);
+            ex.extract("prob", a);
+        }
+
+        ncnn::Mat b;
+        int ret = model.forward(in, b);
+        if (ret != 0)
+        {
+            fprintf(stderr, "generated model forward failed\n");
+            return -1;
+        }
+
+        if (CompareMat(a, b, 0.001) != 0)
+        {
+            fprintf(stderr, "test_ncnn2cpp failed use_packing_layout=%d\n", use_packing_layout);
+            return -1;
+        }
+    }
+
+    // input shape is fixed at generation time
+    ncnn::Mat b;
+    if (model.forward(RandomMat(20, 24, 3), b) != -1)
+    {
+        fprintf(stderr, "test_ncnn2cpp accepted a wrong input shape\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_ncnn2cpp(0)
+           || test_ncnn2cpp(1);
+}
+#endif // NCNN2CPP_WRITE_MODEL
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <stdio.h>
+#include <string.h>
 
 #include "datareader.h"
 #include "paramdict.h"
@@ -10,6 +11,7 @@ class ParamDictTest : public ncnn::ParamDict
 {
 public:
     int load_param(const char* str);
+    int load_param(const ncnn::DataReader& dr);
     int load_param_bin(const unsigned char* mem);
 };
 
@@ -20,6 +22,11 @@ int ParamDictTest::load_param(const char* str)
     return ncnn::ParamDict::load_param(dr);
 }
 
+int ParamDictTest::load_param(const ncnn::DataReader& dr)
+{
+    return ncnn::ParamDict::load_param(dr);
+}
+
 int ParamDictTest::load_param_bin(const unsigned char* mem)
 {
     ncnn::DataReaderFromMemory dr(mem);
@@ -664,6 +671,47 @@ static int test_paramdict_6()
     return 0;
 }
 
+static int test_paramdict_7()
+{
+    // crlf line ending, explicit sign and trailing text left for the next reader
+    const char* str = "0=+7 1=-2147483647,+3\r\n2=1e1 \nReLU relu";
+    const unsigned char* mem = (const unsigned char*)str;
+    ncnn::DataReaderFromMemory dr(mem);
+
+    ParamDictTest pd;
+    pd.load_param(dr);
+
+    int i = pd.get(0, 0);
+    if (pd.type(0) != 2 || i != 7)
+    {
+        fprintf(stderr, "test_paramdict signed int failed %d != 7\n", i);
+        return -1;
+    }
+
+    ncnn::Mat ai = pd.get(1, ncnn::Mat());
+    if (pd.type(1) != 5 || ai.w != 2 || ((const int*)ai)[0] != -2147483647 || ((const int*)ai)[1] != 3)
+    {
+        fprintf(stderr, "test_paramdict signed int array failed\n");
+        return -1;
+    }
+
+    float f = pd.get(2, 0.f);
+    if (pd.type(2) != 3 || f != 10.f)
+    {
+        fprintf(stderr, "test_paramdict exponent float failed %f != 10\n", f);
+        return -1;
+    }
+
+    char layer_type[256];
+    if (dr.scan("%255s", layer_type) != 1 || strcmp(layer_type, "ReLU") != 0)
+    {
+        fprintf(stderr, "test_paramdict scan next token failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
 int main()
 {
     return 0
@@ -673,5 +721,6 @@ int main()
            || test_paramdict_3()
            || test_paramdict_4()
            || test_paramdict_5()
-           || test_paramdict_6();
+           || test_paramdict_6()
+           || test_paramdict_7();
 }
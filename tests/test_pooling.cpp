@@ -242,6 +242,44 @@ static int test_pooling_4()
            || test_pooling(13, 11, 16, 0, 1, 1, 0, 0, 0, 1, 0, 12);
 }
 
+static int test_pooling_int8(int w, int h, int c, int kernel, int stride, int pad, int global_pooling, int pad_mode)
+{
+    ncnn::Mat a = RandomS8Mat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, 0);              // pooling_type
+    pd.set(1, kernel);         // kernel_w
+    pd.set(2, stride);         // stride_w
+    pd.set(3, pad);            // pad_w
+    pd.set(4, global_pooling); // global_pooling
+    pd.set(5, pad_mode);       // pad_mode
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int flag = TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Pooling", pd, weights, a, 0.001, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_pooling_int8 failed w=%d h=%d c=%d kernel=%d stride=%d pad=%d global_pooling=%d pad_mode=%d\n", w, h, c, kernel, stride, pad, global_pooling, pad_mode);
+    }
+
+    return ret;
+}
+
+static int test_pooling_5()
+{
+    return 0
+           || test_pooling_int8(9, 7, 1, 2, 2, 0, 0, 0)
+           || test_pooling_int8(9, 7, 3, 3, 2, 1, 0, 1)
+           || test_pooling_int8(9, 7, 8, 3, 1, 1, 0, 0)
+           || test_pooling_int8(9, 7, 16, 2, 2, 0, 0, 2)
+           || test_pooling_int8(13, 11, 24, 3, 2, 1, 0, 3)
+           || test_pooling_int8(13, 11, 13, 5, 2, 2, 0, 0)
+           || test_pooling_int8(9, 7, 3, 1, 1, 0, 1, 0)
+           || test_pooling_int8(9, 7, 8, 1, 1, 0, 1, 0)
+           || test_pooling_int8(13, 11, 32, 1, 1, 0, 1, 0);
+}
+
 int main()
 {
     SRAND(7767517);
@@ -251,5 +289,6 @@ int main()
            || test_pooling_1()
            || test_pooling_2()
            || test_pooling_3()
-           || test_pooling_4();
+           || test_pooling_4()
+           || test_pooling_5();
 }
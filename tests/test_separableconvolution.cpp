@@ -0,0 +1,187 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_separableconvolution(int w, int h, int c, int outch, int kernel, int dilation, int stride, int pad, int bias)
+{
+    ncnn::Mat a = RandomMat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);
+    pd.set(1, kernel);
+    pd.set(2, dilation);
+    pd.set(3, stride);
+    pd.set(4, pad);
+    pd.set(5, bias);
+    pd.set(6, c * outch);
+    pd.set(20, bias);
+    pd.set(21, c * kernel * kernel);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    int depthwise_activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat depthwise_activation_params(2);
+    depthwise_activation_params[0] = (depthwise_activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    depthwise_activation_params[1] = RandomFloat(0, 1);                                                         // beta
+    pd.set(22, depthwise_activation_type);
+    pd.set(23, depthwise_activation_params);
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(RandomMat(c * kernel * kernel));
+    if (bias)
+        weights.push_back(RandomMat(c));
+    weights.push_back(RandomMat(c * outch));
+    if (bias)
+        weights.push_back(RandomMat(outch));
+
+    int ret = test_layer("SeparableConvolution", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_separableconvolution failed w=%d h=%d c=%d outch=%d kernel=%d dilation=%d stride=%d pad=%d bias=%d act=%d actparams=[%f,%f] dwact=%d dwactparams=[%f,%f]\n", w, h, c, outch, kernel, dilation, stride, pad, bias, activation_type, activation_params[0], activation_params[1], depthwise_activation_type, depthwise_activation_params[0], depthwise_activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_separableconvolution_0()
+{
+    static const int kdsp[8][4] = {
+        {1, 1, 1, 0},
+        {3, 1, 1, 1},
+        {3, 1, 2, 1},
+        {3, 2, 1, 2},
+        {3, 1, 2, -233},
+        {5, 1, 1, 2},
+        {5, 1, 2, -234},
+        {7, 1, 1, 3},
+    };
+
+    for (int i = 0; i < 8; i++)
+    {
+        const int k = kdsp[i][0];
+        const int d = kdsp[i][1];
+        const int s = kdsp[i][2];
+        const int p = kdsp[i][3];
+
+        int ret = 0
+                  || test_separableconvolution(15, 7, 1, 1, k, d, s, p, 1)
+                  || test_separableconvolution(15, 7, 3, 5, k, d, s, p, 0)
+                  || test_separableconvolution(15, 7, 4, 8, k, d, s, p, 1)
+                  || test_separableconvolution(15, 7, 8, 4, k, d, s, p, 0)
+                  || test_separableconvolution(15, 7, 8, 16, k, d, s, p, 1)
+                  || test_separableconvolution(15, 7, 12, 24, k, d, s, p, 0)
+                  || test_separableconvolution(15, 7, 16, 16, k, d, s, p, 1)
+                  || test_separableconvolution(15, 7, 16, 3, k, d, s, p, 0)
+                  || test_separableconvolution(15, 7, 32, 48, k, d, s, p, 1);
+
+        if (ret != 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+static int test_separableconvolution_1()
+{
+    // several bands per thread
+    return 0
+           || test_separableconvolution(112, 112, 32, 16, 3, 1, 1, 1, 1)
+           || test_separableconvolution(56, 56, 96, 24, 3, 1, 2, 1, 0)
+           || test_separableconvolution(28, 33, 144, 40, 5, 1, 1, 2, 1)
+           || test_separableconvolution(7, 7, 64, 16, 3, 1, 1, 1, 1);
+}
+
+// the output mat is reused across inputs of different shape
+static int test_separableconvolution_reuse(int outch, int kernel, int stride, int pad)
+{
+    const int c = 32;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);
+    pd.set(1, kernel);
+    pd.set(3, stride);
+    pd.set(4, pad);
+    pd.set(5, 1);
+    pd.set(6, c * outch);
+    pd.set(20, 1);
+    pd.set(21, c * kernel * kernel);
+
+    std::vector<ncnn::Mat> weights(4);
+    weights[0] = RandomMat(c * kernel * kernel);
+    weights[1] = RandomMat(c);
+    weights[2] = RandomMat(c * outch);
+    weights[3] = RandomMat(outch);
+
+    // input is fed without packing
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+
+    ncnn::Layer* op_naive = ncnn::create_layer_naive("SeparableConvolution");
+    op_naive->load_param(pd);
+    {
+        ncnn::ModelBinFromMatArray mb(weights.data());
+        op_naive->load_model(mb);
+    }
+    op_naive->create_pipeline(opt);
+
+    ncnn::Layer* op = ncnn::create_layer_cpu("SeparableConvolution");
+    op->load_param(pd);
+    {
+        ncnn::ModelBinFromMatArray mb(weights.data());
+        op->load_model(mb);
+    }
+    op->create_pipeline(opt);
+
+    const int shapes[3][2] = {{112, 96}, {96, 120}, {33, 17}};
+
+    int ret = 0;
+    ncnn::Mat b;
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat a = RandomMat(shapes[i][0], shapes[i][1], c);
+
+        ncnn::Mat ref;
+        op_naive->forward(a, ref, opt);
+
+        op->forward(a, b, opt);
+
+        if (CompareMat(ref, b, 0.001) != 0)
+        {
+            fprintf(stderr, "test_separableconvolution_reuse failed outch=%d kernel=%d stride=%d pad=%d w=%d h=%d\n", outch, kernel, stride, pad, shapes[i][0], shapes[i][1]);
+            ret = -1;
+            break;
+        }
+    }
+
+    op_naive->destroy_pipeline(opt);
+    delete op_naive;
+
+    op->destroy_pipeline(opt);
+    delete op;
+
+    return ret;
+}
+
+static int test_separableconvolution_2()
+{
+    return 0
+           || test_separableconvolution_reuse(16, 3, 1, 1)
+           || test_separableconvolution_reuse(24, 3, 2, 1);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_separableconvolution_0()
+           || test_separableconvolution_1()
+           || test_separableconvolution_2();
+}
@@ -67,7 +67,10 @@ static int test_slice(const ncnn::Mat& a, const std::vector<int>& slices_array,
     std::vector<ncnn::Mat> a0(1);
     a0[0] = a;
 
-    int ret = test_layer("Slice", pd, weights, a0, slices.w);
+    // int8 blobs are passed through as is
+    int flag = a.elembits() == 8 ? TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING : 0;
+
+    int ret = test_layer("Slice", pd, weights, a0, slices.w, 0.001, 0, flag);
     if (ret != 0)
     {
         fprintf(stderr, "test_slice failed a.dims=%d a=(%d %d %d %d)", a.dims, a.w, a.h, a.d, a.c);
@@ -99,7 +102,10 @@ static int test_slice_indices(const ncnn::Mat& a, const std::vector<int>& indice
     std::vector<ncnn::Mat> a0(1);
     a0[0] = a;
 
-    int ret = test_layer("Slice", pd, weights, a0, indices.w);
+    // int8 blobs are passed through as is
+    int flag = a.elembits() == 8 ? TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING : 0;
+
+    int ret = test_layer("Slice", pd, weights, a0, indices.w, 0.001, 0, flag);
     if (ret != 0)
     {
         fprintf(stderr, "test_slice_indices failed a.dims=%d a=(%d %d %d %d)", a.dims, a.w, a.h, a.d, a.c);
@@ -225,6 +231,32 @@ static int test_slice_3()
     return 0;
 }
 
+static int test_slice_4()
+{
+    ncnn::Mat a[] = {
+        RandomS8Mat(17, 36, 48),
+        RandomS8Mat(16, 48, 51),
+        RandomS8Mat(36, 60)
+    };
+
+    for (int i = 0; i < sizeof(a) / sizeof(a[0]); i++)
+    {
+        int ret = 0
+                  || test_slice(a[i], IntArray(-233, -233, -233), 0)
+                  || test_slice(a[i], IntArray(3, 12, 16, -233), 0)
+                  || test_slice(a[i], IntArray(16, 8, -233), 0)
+                  || test_slice(a[i], IntArray(2, 12, 16, -233), 1)
+                  || test_slice(a[i], IntArray(4, -233), -1)
+                  || test_slice_indices(a[i], IntArray(8, -16), 0)
+                  || test_slice_indices(a[i], IntArray(4, 20, 24), 1);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
@@ -233,5 +265,6 @@ int main()
            || test_slice_0()
            || test_slice_1()
            || test_slice_2()
-           || test_slice_3();
+           || test_slice_3()
+           || test_slice_4();
 }
@@ -0,0 +1,179 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "datareader.h"
+#include "net.h"
+#include "streampipeline.h"
+#include "testutil.h"
+
+#include <string.h>
+
+static const char* test_net_param = "7767517\n"
+                                    "4 4\n"
+                                    "Input               data     0 1 data 0=16 1=12 2=3\n"
+                                    "Convolution         conv0    1 1 data c0 0=8 1=3 4=1 5=1 6=216\n"
+                                    "ReLU                relu0    1 1 c0 r0\n"
+                                    "Pooling             gap0     1 1 r0 g0 0=1 4=1\n";
+
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    virtual int scan(const char* /*format*/, void* /*p*/) const
+    {
+        return 0;
+    }
+    virtual size_t read(void* buf, size_t size) const
+    {
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / sizeof(float); i++)
+        {
+            p[i] = RandomFloat(-1.f, 1.f);
+        }
+        return size;
+    }
+};
+
+struct TestFrame
+{
+    ncnn::Mat in;
+    ncnn::Mat r0;
+    ncnn::Mat g0;
+    int postprocessed;
+};
+
+struct TestContext
+{
+    int fail_frame_index;
+};
+
+static int preprocess(int frame_index, void* frame, ncnn::Extractor& ex, void* userdata)
+{
+    const TestContext* ctx = (const TestContext*)userdata;
+    if (frame_index == ctx->fail_frame_index)
+        return -1;
+
+    const TestFrame* f = (const TestFrame*)frame;
+    return ex.input("data", f->in);
+}
+
+static int postprocess(int /*frame_index*/, void* frame, const std::vector<ncnn::Mat>& outputs, void* /*userdata*/)
+{
+    TestFrame* f = (TestFrame*)frame;
+    f->r0 = outputs[0];
+    f->g0 = outputs[1];
+    f->postprocessed += 1;
+    return 0;
+}
+
+static int test_streampipeline(const ncnn::Net& net, int preprocess_workers, int inference_workers, int postprocess_workers, int queue_size, int fail_frame_index)
+{
+    const int frame_count = 13;
+
+    std::vector<TestFrame> frames(frame_count);
+    for (int i = 0; i < frame_count; i++)
+    {
+        frames[i].in = RandomMat(16, 12, 3);
+        frames[i].postprocessed = 0;
+    }
+
+    TestContext ctx;
+    ctx.fail_frame_index = fail_frame_index;
+
+    ncnn::StreamPipeline pipeline(&net, preprocess, postprocess, &ctx);
+
+    std::vector<const char*> output_names(2);
+    output_names[0] = "r0";
+    output_names[1] = "g0";
+    if (pipeline.set_outputs(output_names) != 0)
+    {
+        fprintf(stderr, "set_outputs failed\n");
+        return -1;
+    }
+
+    pipeline.set_workers(preprocess_workers, inference_workers, postprocess_workers);
+    pipeline.set_queue_size(queue_size);
+
+    for (int i = 0; i < frame_count; i++)
+    {
+        int frame_index = pipeline.submit(&frames[i]);
+        if (frame_index != i)
+        {
+            fprintf(stderr, "submit returns %d but expect %d\n", frame_index, i);
+            return -1;
+        }
+    }
+
+    int ret = pipeline.finish();
+    if (ret != (fail_frame_index == -1 ? 0 : -1))
+    {
+        fprintf(stderr, "finish returns %d with fail frame %d\n", ret, fail_frame_index);
+        return -1;
+    }
+
+    for (int i = 0; i < frame_count; i++)
+    {
+        const TestFrame& f = frames[i];
+
+        if (i == fail_frame_index)
+        {
+            if (f.postprocessed != 0)
+            {
+                fprintf(stderr, "failed frame %d should not be postprocessed\n", i);
+                return -1;
+            }
+            continue;
+        }
+
+        if (f.postprocessed != 1)
+        {
+            fprintf(stderr, "frame %d postprocessed %d times\n", i, f.postprocessed);
+            return -1;
+        }
+
+        ncnn::Mat r0;
+        ncnn::Mat g0;
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.input("data", f.in);
+            ex.extract("r0", r0);
+            ex.extract("g0", g0);
+        }
+
+        if (CompareMat(f.r0, r0, 0.001) != 0 || CompareMat(f.g0, g0, 0.001) != 0)
+        {
+            fprintf(stderr, "test_streampipeline failed frame=%d workers=%d,%d,%d queue_size=%d\n", i, preprocess_workers, inference_workers, postprocess_workers, queue_size);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_streampipeline_0()
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+
+    if (net.load_param_mem(test_net_param) != 0)
+    {
+        fprintf(stderr, "load_param_mem failed\n");
+        return -1;
+    }
+
+    DataReaderFromRandom dr;
+    net.load_model(dr);
+
+    return 0
+           || test_streampipeline(net, 1, 1, 1, 2, -1)
+           || test_streampipeline(net, 1, 1, 1, 1, -1)
+           || test_streampipeline(net, 2, 3, 2, 2, -1)
+           || test_streampipeline(net, 1, 2, 1, 4, 5)
+           || test_streampipeline(net, 2, 2, 2, 1, 0);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_streampipeline_0();
+}
@@ -0,0 +1,151 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_topk(const ncnn::Mat& a, int axis, int k, int largest, int sorted, int softmax)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, axis);
+    pd.set(1, k);
+    pd.set(2, largest);
+    pd.set(3, sorted);
+    pd.set(4, softmax);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> as(1);
+    as[0] = a;
+
+    int ret = test_layer("TopK", pd, weights, as, 2);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_topk failed a.dims=%d a=(%d %d %d %d) axis=%d k=%d largest=%d sorted=%d softmax=%d\n", a.dims, a.w, a.h, a.d, a.c, axis, k, largest, sorted, softmax);
+    }
+
+    return ret;
+}
+
+// long rows are split across threads, which test_layer never exercises
+static int test_topk_threads(const ncnn::Mat& a, int k, int largest, int sorted, int softmax)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, -1);
+    pd.set(1, k);
+    pd.set(2, largest);
+    pd.set(3, sorted);
+    pd.set(4, softmax);
+
+    std::vector<ncnn::Mat> weights(0);
+    ncnn::ModelBinFromMatArray mb(weights.data());
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = false;
+
+    std::vector<ncnn::Mat> as(1);
+    as[0] = a;
+
+    std::vector<ncnn::Mat> b(2);
+    {
+        ncnn::Layer* op = ncnn::create_layer_naive("TopK");
+        op->load_param(pd);
+        op->load_model(mb);
+        op->create_pipeline(opt);
+        op->forward(as, b, opt);
+        op->destroy_pipeline(opt);
+        delete op;
+    }
+
+    std::vector<ncnn::Mat> c(2);
+    {
+        opt.num_threads = 4;
+
+        ncnn::Layer* op = ncnn::create_layer_cpu("TopK");
+        op->load_param(pd);
+        op->load_model(mb);
+        op->create_pipeline(opt);
+        op->forward(as, c, opt);
+        op->destroy_pipeline(opt);
+        delete op;
+    }
+
+    if (CompareMat(b, c, 0.001) != 0)
+    {
+        fprintf(stderr, "test_topk_threads failed a.dims=%d a=(%d %d %d %d) k=%d largest=%d sorted=%d softmax=%d\n", a.dims, a.w, a.h, a.d, a.c, k, largest, sorted, softmax);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_topk_0()
+{
+    ncnn::Mat a = RandomMat(1000);
+
+    return 0
+           || test_topk(a, 0, 1, 1, 1, 0)
+           || test_topk(a, 0, 5, 1, 1, 0)
+           || test_topk(a, -1, 5, 0, 1, 0)
+           || test_topk(a, 0, 17, 1, 0, 0)
+           || test_topk(a, 0, 5, 1, 1, 1)
+           || test_topk(a, 0, 600, 0, 1, 1)
+           || test_topk(RandomMat(7), 0, 9, 1, 1, 0)
+           || test_topk(RandomMat(3), 0, 2, 1, 0, 1);
+}
+
+static int test_topk_1()
+{
+    ncnn::Mat a = RandomMat(131, 9);
+
+    return 0
+           || test_topk(a, 0, 3, 1, 1, 0)
+           || test_topk(a, 1, 5, 1, 1, 0)
+           || test_topk(a, -1, 5, 0, 0, 1)
+           || test_topk(a, -2, 9, 0, 1, 1)
+           || test_topk(a, 1, 131, 1, 1, 1);
+}
+
+static int test_topk_2()
+{
+    ncnn::Mat a = RandomMat(19, 15, 16);
+
+    return 0
+           || test_topk(a, 0, 4, 1, 1, 0)
+           || test_topk(a, 1, 4, 1, 0, 0)
+           || test_topk(a, 2, 4, 0, 1, 1)
+           || test_topk(a, -1, 1, 1, 1, 1)
+           || test_topk(a, -3, 16, 1, 1, 1);
+}
+
+static int test_topk_3()
+{
+    ncnn::Mat a = RandomMat(9, 7, 6, 5);
+
+    return 0
+           || test_topk(a, 0, 2, 1, 1, 0)
+           || test_topk(a, 1, 3, 0, 1, 0)
+           || test_topk(a, 2, 3, 1, 0, 1)
+           || test_topk(a, 3, 4, 1, 1, 1);
+}
+
+static int test_topk_4()
+{
+    return 0
+           || test_topk_threads(RandomMat(100000), 5, 1, 1, 0)
+           || test_topk_threads(RandomMat(100000), 100, 0, 1, 1)
+           || test_topk_threads(RandomMat(70001, 2), 20000, 1, 0, 1)
+           || test_topk_threads(RandomMat(65536), 1, 1, 1, 1);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_topk_0()
+           || test_topk_1()
+           || test_topk_2()
+           || test_topk_3()
+           || test_topk_4();
+}
@@ -0,0 +1,106 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "net.h"
+#include "testutil.h"
+
+#include <vector>
+
+static const char* test_net_param = "7767517\n"
+                                    "11 14\n"
+                                    "Input                data   0 1 data\n"
+                                    "Split                splitd 1 3 data d1 d2 d3\n"
+                                    "Convolution          conv1  1 1 d1 c1 0=16 1=3 4=1 5=1 6=432 9=1\n"
+                                    "Split                split1 1 2 c1 c1a c1b\n"
+                                    "Convolution          conv2  1 1 d2 c2 0=16 1=1 5=1 6=48\n"
+                                    "ReLU                 relu2  1 1 c2 r2\n"
+                                    "Convolution          conv3  1 1 c1a c3 0=16 1=3 4=1 5=1 6=2304\n"
+                                    "Concat               cat1   2 1 c3 r2 cat1 0=0\n"
+                                    "Concat               cat2   2 1 cat1 c1b cat2 0=0\n"
+                                    "Concat               cat3   2 1 cat2 d3 cat3 0=0\n"
+                                    "Convolution          conv4  1 1 cat3 out 0=8 1=1 5=1 6=408\n";
+
+static void append_weight(std::vector<float>& model, int size, bool tagged)
+{
+    if (tagged)
+    {
+        // fp32 tag
+        model.push_back(0.f);
+    }
+
+    for (int i = 0; i < size; i++)
+    {
+        model.push_back(RandomFloat(-1.f, 1.f));
+    }
+}
+
+static int test_zero_copy_concat(int use_packing_layout)
+{
+    std::vector<float> model;
+    append_weight(model, 432, true);
+    append_weight(model, 16, false);
+    append_weight(model, 48, true);
+    append_weight(model, 16, false);
+    append_weight(model, 2304, true);
+    append_weight(model, 16, false);
+    append_weight(model, 408, true);
+    append_weight(model, 8, false);
+
+    ncnn::Net net_ref;
+    net_ref.opt.use_packing_layout = use_packing_layout;
+    net_ref.opt.use_zero_copy_concat = false;
+    net_ref.load_param_mem(test_net_param);
+    net_ref.load_model((const unsigned char*)model.data());
+
+    ncnn::Net net;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.opt.use_zero_copy_concat = true;
+    net.load_param_mem(test_net_param);
+    net.load_model((const unsigned char*)model.data());
+
+    // the second forward of each shape runs with the learned concat layout
+    const int shapes[][2] = {{24, 20}, {24, 20}, {17, 31}, {17, 31}, {24, 20}};
+
+    for (int i = 0; i < 5; i++)
+    {
+        ncnn::Mat in = RandomMat(shapes[i][0], shapes[i][1], 3);
+
+        const char* blob_names[] = {"cat1", "cat2", "out"};
+        for (int j = 0; j < 3; j++)
+        {
+            ncnn::Mat a;
+            {
+                ncnn::Extractor ex = net_ref.create_extractor();
+                ex.input("data", in);
+                ex.extract(blob_names[j], a);
+            }
+
+            ncnn::Mat b;
+            {
+                ncnn::Extractor ex = net.create_extractor();
+                ex.input("data", in);
+                int ret = ex.extract(blob_names[j], b);
+                if (ret != 0)
+                {
+                    fprintf(stderr, "extract %s failed\n", blob_names[j]);
+                    return -1;
+                }
+            }
+
+            if (CompareMat(a, b, 0.001) != 0)
+            {
+                fprintf(stderr, "test_zero_copy_concat failed use_packing_layout=%d blob=%s shape=%d %d\n", use_packing_layout, blob_names[j], shapes[i][0], shapes[i][1]);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_zero_copy_concat(1) || test_zero_copy_concat(0);
+}
@@ -93,12 +93,14 @@
 #include "layer/roialign.h"
 #include "layer/roipooling.h"
 #include "layer/scale.h"
+#include "layer/separableconvolution.h"
 #include "layer/shufflechannel.h"
 #include "layer/slice.h"
 #include "layer/softmax.h"
 #include "layer/split.h"
 #include "layer/squeeze.h"
 #include "layer/threshold.h"
+#include "layer/topk.h"
 #include "layer/unaryop.h"
 #include "layer/unfold.h"
 #include "layer/yolodetectionoutput.h"
@@ -215,7 +217,7 @@ public:
     bool has_custom_layer;
 
 public:
-    // 0=fp32 1=fp16
+    // 0=fp32 1=fp16 2=fp32 with block sparse encoding for pruned weight
     int storage_type;
 
     int gen_random_weight;
@@ -235,6 +237,7 @@ public:
     int fprintf_param_float_array(int id, const ncnn::Mat& m, FILE* pp);
 
     int fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a = -1.2f, float b = 1.2f);
+    int fwrite_weight_block_sparse_data(const ncnn::Mat& data, FILE* bp, int block_size = 4);
     int fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a = -1.2f, float b = 1.2f);
 
     int save(const char* parampath, const char* binpath);
@@ -311,7 +314,6 @@ int ModelWriter::shape_inference()
     }
 
     const size_t layer_count = layers.size();
-    const size_t blob_count = blobs.size();
 
     // recreate layer pipeline for param and weight changes
     for (size_t i = 0; i < layer_count; i++)
@@ -328,10 +330,7 @@ int ModelWriter::shape_inference()
         }
     }
 
-    ncnn::Extractor ex = create_extractor();
-    ex.set_light_mode(true);
-
-    // prepare Input blobs
+    // check Input blobs
     for (size_t i = 0; i < layer_count; i++)
     {
         const ncnn::Layer* layer = layers[i];
@@ -343,56 +342,25 @@ int ModelWriter::shape_inference()
 
         ncnn::Input* input = (ncnn::Input*)layer;
 
-        int w = input->w;
-        int h = input->h;
-        int c = input->c;
-
-        int dims = 0;
-        if (w == 0 && h == 0 && c == 0) dims = 0;
-        if (w != 0 && h == 0 && c == 0) dims = 1;
-        if (w != 0 && h != 0 && c == 0) dims = 2;
-        if (w != 0 && h != 0 && c != 0) dims = 3;
-
-        if (dims == 0)
+        if (input->w == 0 && input->h == 0 && input->c == 0)
         {
             fprintf(stderr, "Input layer %s without shape info, shape_inference skipped\n", layer->name.c_str());
             return -1;
         }
-
-        ncnn::Mat m;
-        if (dims == 1) m.create(w);
-        if (dims == 2) m.create(w, h);
-        if (dims == 3) m.create(w, h, c);
-
-        ex.input(layer->tops[0], m);
     }
 
-    // prepare blobs with predefined shape
-    for (size_t i = 0; i < blob_count; i++)
-    {
-        const ncnn::Blob& blob = blobs[i];
-
-        int dims = blob.shape.dims;
-        int w = blob.shape.w;
-        int h = blob.shape.h;
-        int c = blob.shape.c;
-
-        if (dims == 0)
-            continue;
-
-        ncnn::Mat m;
-        if (dims == 1) m.create(w);
-        if (dims == 2) m.create(w, h);
-        if (dims == 3) m.create(w, h, c);
-
-        m.fill(0.f);
+    fprintf(stderr, "shape_inference\n");
 
-        ex.input(int(i), m);
+    // resolve all blob shape from Input layer shape and predefined shape
+    std::vector<ncnn::Mat> input_shapes;
+    std::vector<ncnn::Mat> blob_shapes;
+    int ret = infer_shapes(input_shapes, blob_shapes);
+    if (ret != 0)
+    {
+        fprintf(stderr, "infer_shapes failed\n");
+        return -1;
     }
 
-    fprintf(stderr, "shape_inference\n");
-
-    // resolve all layer output blob shape
     for (size_t i = 0; i < layer_count; i++)
     {
         const ncnn::Layer* layer = layers[i];
@@ -403,10 +371,7 @@ int ModelWriter::shape_inference()
         {
             int top_blob_index = layer->tops[j];
 
-            ncnn::Mat m;
-            ex.extract(top_blob_index, m);
-
-            blobs[top_blob_index].shape = m;
+            blobs[top_blob_index].shape = blob_shapes[top_blob_index];
         }
     }
 
@@ -623,10 +588,14 @@ int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a
         }
         else
         {
-            const int tag = 0; // fp32 magic
-            fwrite(&tag, sizeof(int), 1, bp);
             replace_denormals_with_zero(data_flattened, data_flattened.w);
-            fwrite(data_flattened.data, data_flattened.elemsize, data_flattened.w, bp);
+
+            if (storage_type != 2 || fwrite_weight_block_sparse_data(data_flattened, bp) != 0)
+            {
+                const int tag = 0; // fp32 magic
+                fwrite(&tag, sizeof(int), 1, bp);
+                fwrite(data_flattened.data, data_flattened.elemsize, data_flattened.w, bp);
+            }
         }
     }
     else if (data_flattened.elemsize == 2)
@@ -655,8 +624,56 @@ int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a
     return 0;
 }
 
+int ModelWriter::fwrite_weight_block_sparse_data(const ncnn::Mat& data, FILE* bp, int block_size)
+{
+    // return -1 and write nothing if the block sparse encoding is not smaller than dense fp32
+    const int size = data.w;
+    if (size % block_size != 0)
+        return -1;
+
+    const int nblocks = size / block_size;
+
+    std::vector<unsigned int> block_index;
+    for (int i = 0; i < nblocks; i++)
+    {
+        const float* ptr = (const float*)data + i * block_size;
+
+        for (int j = 0; j < block_size; j++)
+        {
+            if (ptr[j] != 0.f)
+            {
+                block_index.push_back(i);
+                break;
+            }
+        }
+    }
+
+    const int nnzb = (int)block_index.size();
+    if ((size_t)nnzb * (block_size + 1) + 2 >= (size_t)size)
+        return -1;
+
+    const int tag = 0x0B5E1D04; // block sparse magic
+    fwrite(&tag, sizeof(int), 1, bp);
+    fwrite(&block_size, sizeof(int), 1, bp);
+    fwrite(&nnzb, sizeof(int), 1, bp);
+    if (nnzb > 0)
+        fwrite(block_index.data(), sizeof(unsigned int), nnzb, bp);
+
+    for (int i = 0; i < nnzb; i++)
+    {
+        const float* ptr = (const float*)data + block_index[i] * block_size;
+        fwrite(ptr, sizeof(float), block_size, bp);
+    }
+
+    return 0;
+}
+
 int ModelWriter::fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a, float b)
 {
+    // nothing to write, such as top_blob_int8_scales of convolution without requantize
+    if (data.empty())
+        return 0;
+
     int p0 = ftell(bp);
 
     ncnn::Mat data_flattened = data.reshape(data.w * data.h * data.d * data.c);
@@ -2015,6 +2032,7 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             ncnn::MatMul* op_default = (ncnn::MatMul*)layer_default;
 
             fprintf_param_value(" 0=%d", transB)
+            fprintf_param_value(" 18=%d", int8_scale_term)
         }
         else if (layer->type == "MemoryData")
         {
@@ -2415,6 +2433,53 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fwrite_weight_data(op->scale_data, bp);
             fwrite_weight_data(op->bias_data, bp);
         }
+        else if (layer->type == "SeparableConvolution")
+        {
+            ncnn::SeparableConvolution* op = (ncnn::SeparableConvolution*)layer;
+            ncnn::SeparableConvolution* op_default = (ncnn::SeparableConvolution*)layer_default;
+
+            fprintf_param_value(" 0=%d", num_output)
+            fprintf_param_value(" 1=%d", kernel_w)
+            {
+                if (op->kernel_h != op->kernel_w) fprintf(pp, " 11=%d", op->kernel_h);
+            }
+            fprintf_param_value(" 2=%d", dilation_w)
+            {
+                if (op->dilation_h != op->dilation_w) fprintf(pp, " 12=%d", op->dilation_h);
+            }
+            fprintf_param_value(" 3=%d", stride_w)
+            {
+                if (op->stride_h != op->stride_w) fprintf(pp, " 13=%d", op->stride_h);
+            }
+            fprintf_param_value(" 4=%d", pad_left)
+            {
+                if (op->pad_top != op->pad_left) fprintf(pp, " 14=%d", op->pad_top);
+            }
+            {
+                if (op->pad_right != op->pad_left) fprintf(pp, " 15=%d", op->pad_right);
+            }
+            {
+                if (op->pad_bottom != op->pad_top) fprintf(pp, " 16=%d", op->pad_bottom);
+            }
+            fprintf_param_value(" 18=%e", pad_value)
+            fprintf_param_value(" 5=%d", bias_term)
+            fprintf_param_value(" 6=%d", weight_data_size)
+            fprintf_param_value(" 9=%d", activation_type)
+            {
+                if (!op->activation_params.empty()) fprintf_param_float_array(10, op->activation_params, pp);
+            }
+            fprintf_param_value(" 20=%d", depthwise_bias_term)
+            fprintf_param_value(" 21=%d", depthwise_weight_data_size)
+            fprintf_param_value(" 22=%d", depthwise_activation_type)
+            {
+                if (!op->depthwise_activation_params.empty()) fprintf_param_float_array(23, op->depthwise_activation_params, pp);
+            }
+
+            fwrite_weight_tag_data(op->depthwise_weight_data, bp);
+            fwrite_weight_data(op->depthwise_bias_data, bp);
+            fwrite_weight_tag_data(op->weight_data, bp);
+            fwrite_weight_data(op->bias_data, bp);
+        }
         else if (layer->type == "ShuffleChannel")
         {
             ncnn::ShuffleChannel* op = (ncnn::ShuffleChannel*)layer;
@@ -2467,6 +2532,17 @@ int ModelWriter::save(const char* parampath, const char* binpath)
 
             fprintf_param_value(" 0=%e", threshold)
         }
+        else if (layer->type == "TopK")
+        {
+            ncnn::TopK* op = (ncnn::TopK*)layer;
+            ncnn::TopK* op_default = (ncnn::TopK*)layer_default;
+
+            fprintf_param_value(" 0=%d", axis)
+            fprintf_param_value(" 1=%d", k)
+            fprintf_param_value(" 2=%d", largest)
+            fprintf_param_value(" 3=%d", sorted)
+            fprintf_param_value(" 4=%d", softmax)
+        }
         else if (layer->type == "UnaryOp")
         {
             ncnn::UnaryOp* op = (ncnn::UnaryOp*)layer;
@@ -0,0 +1,1019 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// ahead-of-time compile a model with fixed input shapes into c++ source
+// the generated source creates each layer by type index with inline params and weights
+// and runs the layers in a fixed order without parsing or graph traversal at runtime
+
+#include "datareader.h"
+#include "layer.h"
+#include "layer_type.h"
+#include "modelbin.h"
+#include "net.h"
+#include "paramdict.h"
+
+#include <algorithm>
+#include <ctype.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+class ParamDictReader : public ncnn::ParamDict
+{
+public:
+    int load(const ncnn::DataReader& dr)
+    {
+        return load_param(dr);
+    }
+};
+
+// the weights loaded by each ModelBin::load call
+class ModelBinRecorder : public ncnn::ModelBin
+{
+public:
+    ModelBinRecorder(const ncnn::ModelBin& _mb, std::vector<ncnn::Mat>& _weights)
+        : mb(_mb), weights(_weights)
+    {
+    }
+
+    virtual ncnn::Mat load(int w, int type) const
+    {
+        ncnn::Mat m = mb.load(w, type);
+        if (!m.empty())
+            weights.push_back(m);
+
+        return m;
+    }
+
+public:
+    const ncnn::ModelBin& mb;
+    std::vector<ncnn::Mat>& weights;
+};
+
+struct blob_shape
+{
+    int dims;
+    int w;
+    int h;
+    int d;
+    int c;
+};
+
+static int read_file(const char* path, std::vector<unsigned char>& data)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    data.resize(size);
+    if (size > 0 && fread(&data[0], size, 1, fp) != 1)
+    {
+        fprintf(stderr, "fread %s failed\n", path);
+        fclose(fp);
+        return -1;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+static std::string path_to_varname(const char* path)
+{
+    const char* lastslash = strrchr(path, '/');
+    const char* name = lastslash == NULL ? path : lastslash + 1;
+
+    std::string varname = name;
+    for (size_t i = 0; i < varname.size(); i++)
+    {
+        if (!isalnum(varname[i]))
+            varname[i] = '_';
+    }
+
+    if (varname.empty() || isdigit(varname[0]))
+        varname = "_" + varname;
+
+    return varname;
+}
+
+static int parse_shape(const char* s, blob_shape& shape)
+{
+    int v[4] = {0, 0, 0, 0};
+    int n = 0;
+    while (*s && n < 4)
+    {
+        v[n++] = atoi(s);
+        s = strchr(s, ',');
+        if (!s)
+            break;
+        s++;
+    }
+
+    shape.dims = n;
+    shape.w = v[0];
+    shape.h = n >= 2 ? v[1] : 1;
+    shape.d = n == 4 ? v[2] : 1;
+    shape.c = n == 3 ? v[2] : n == 4 ? v[3] : 1;
+
+    for (int i = 0; i < n; i++)
+    {
+        if (v[i] <= 0)
+            return -1;
+    }
+
+    return n == 0 ? -1 : 0;
+}
+
+static ncnn::Mat shape_to_mat(const blob_shape& shape)
+{
+    if (shape.dims == 1)
+        return ncnn::Mat(shape.w);
+    if (shape.dims == 2)
+        return ncnn::Mat(shape.w, shape.h);
+    if (shape.dims == 3)
+        return ncnn::Mat(shape.w, shape.h, shape.c);
+    return ncnn::Mat(shape.w, shape.h, shape.d, shape.c);
+}
+
+static std::string shape_to_string(const blob_shape& shape)
+{
+    char s[128];
+    if (shape.dims == 1)
+        sprintf(s, "%d", shape.w);
+    else if (shape.dims == 2)
+        sprintf(s, "%dx%d", shape.w, shape.h);
+    else if (shape.dims == 3)
+        sprintf(s, "%dx%dx%d", shape.w, shape.h, shape.c);
+    else
+        sprintf(s, "%dx%dx%dx%d", shape.w, shape.h, shape.d, shape.c);
+    return s;
+}
+
+static std::string shape_to_code(const blob_shape& shape)
+{
+    char s[128];
+    if (shape.dims == 1)
+        sprintf(s, "ncnn::Mat(%d, (void*)0, 4u, 1)", shape.w);
+    else if (shape.dims == 2)
+        sprintf(s, "ncnn::Mat(%d, %d, (void*)0, 4u, 1)", shape.w, shape.h);
+    else if (shape.dims == 3)
+        sprintf(s, "ncnn::Mat(%d, %d, %d, (void*)0, 4u, 1)", shape.w, shape.h, shape.c);
+    else
+        sprintf(s, "ncnn::Mat(%d, %d, %d, %d, (void*)0, 4u, 1)", shape.w, shape.h, shape.d, shape.c);
+    return s;
+}
+
+static std::string float_to_code(float v)
+{
+    // non-finite value has no literal form
+    if (v != v)
+        return "std::numeric_limits<float>::quiet_NaN()";
+    if (fabs(v) > FLT_MAX)
+        return v > 0 ? "std::numeric_limits<float>::infinity()" : "-std::numeric_limits<float>::infinity()";
+
+    char s[64];
+    // check the range before the int cast overflows
+    if (fabs(v) < 1e7f && v == (int)v)
+        sprintf(s, "%d.f", (int)v);
+    else
+        sprintf(s, "%.9gf", v);
+    return s;
+}
+
+static std::string layer_type_to_code(const char* type)
+{
+    // layer type names and LayerType enum share the same spelling
+    return std::string("ncnn::LayerType::") + type;
+}
+
+// runtime support shared by all generated models
+// convert_layout and forward_layer mirror Net in lightmode
+static const char* runtime_source = R"ncnnaot(
+static int convert_layout(ncnn::Mat& bottom_blob, const ncnn::Layer* layer, const ncnn::Option& opt)
+{
+    if (bottom_blob.elembits() == 32)
+    {
+        // clang-format off
+        // *INDENT-OFF*
+
+#if NCNN_ARM82
+        if (opt.use_fp16_storage && ncnn::cpu_support_arm_asimdhp() && layer->support_fp16_storage)
+        {
+            ncnn::Mat bottom_blob_fp16;
+            ncnn::cast_float32_to_float16(bottom_blob, bottom_blob_fp16, opt);
+            bottom_blob = bottom_blob_fp16;
+        }
+        else
+#endif // NCNN_ARM82
+#if NCNN_VFPV4
+        if (opt.use_fp16_storage && !opt.use_bf16_storage && ncnn::cpu_support_arm_vfpv4() && layer->support_fp16_storage)
+        {
+            ncnn::Mat bottom_blob_fp16;
+            ncnn::cast_float32_to_float16(bottom_blob, bottom_blob_fp16, opt);
+            bottom_blob = bottom_blob_fp16;
+        }
+        else
+#endif // NCNN_VFPV4
+#if NCNN_ZFH
+        if (opt.use_fp16_storage && (ncnn::cpu_support_riscv_zvfh() || (!ncnn::cpu_support_riscv_v() && ncnn::cpu_support_riscv_zfh())) && layer->support_fp16_storage)
+        {
+            ncnn::Mat bottom_blob_fp16;
+            ncnn::cast_float32_to_float16(bottom_blob, bottom_blob_fp16, opt);
+            bottom_blob = bottom_blob_fp16;
+        }
+        else
+#endif // NCNN_ZFH
+#if NCNN_BF16
+        if (opt.use_bf16_storage && layer->support_bf16_storage)
+        {
+            ncnn::Mat bottom_blob_bf16;
+            ncnn::cast_float32_to_bfloat16(bottom_blob, bottom_blob_bf16, opt);
+            bottom_blob = bottom_blob_bf16;
+        }
+        else
+#endif // NCNN_BF16
+        {
+        }
+
+        // *INDENT-ON*
+        // clang-format on
+
+        if (bottom_blob.empty())
+            return -100;
+    }
+
+    int dst_elempack = 1;
+    if (opt.use_packing_layout && layer->support_packing)
+    {
+        int elemcount = 0;
+        if (bottom_blob.dims == 1) elemcount = bottom_blob.elempack * bottom_blob.w;
+        if (bottom_blob.dims == 2) elemcount = bottom_blob.elempack * bottom_blob.h;
+        if (bottom_blob.dims == 3 || bottom_blob.dims == 4) elemcount = bottom_blob.elempack * bottom_blob.c;
+
+        const int elembits = bottom_blob.elembits();
+
+        if (elembits == 32)
+        {
+#if NCNN_AVX512
+            if (elemcount % 16 == 0 && ncnn::cpu_support_x86_avx512())
+                dst_elempack = 16;
+            else if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+                dst_elempack = 8;
+            else if (elemcount % 4 == 0)
+                dst_elempack = 4;
+#elif NCNN_AVX
+            if (elemcount % 8 == 0 && ncnn::cpu_support_x86_avx())
+                dst_elempack = 8;
+            else if (elemcount % 4 == 0)
+                dst_elempack = 4;
+#elif NCNN_RVV || NCNN_XTHEADVECTOR
+            const int packn = ncnn::cpu_riscv_vlenb() / 4;
+            if (elemcount % packn == 0)
+                dst_elempack = packn;
+#else
+            if (elemcount % 4 == 0)
+                dst_elempack = 4;
+#endif
+        }
+        if (elembits == 16)
+        {
+#if NCNN_ARM82
+            if (elemcount % 8 == 0 && ncnn::cpu_support_arm_asimdhp() && opt.use_fp16_arithmetic && layer->support_fp16_storage)
+                dst_elempack = 8;
+            else if (elemcount % 4 == 0)
+                dst_elempack = 4;
+#elif NCNN_RVV || NCNN_XTHEADVECTOR
+            const int packn = ncnn::cpu_riscv_vlenb() / 2;
+            if (elemcount % packn == 0)
+                dst_elempack = packn;
+#else
+            if (elemcount % 4 == 0)
+                dst_elempack = 4;
+#endif
+        }
+        if (elembits == 8)
+        {
+#if NCNN_RVV || NCNN_XTHEADVECTOR
+            const int packn = ncnn::cpu_riscv_vlenb() / 1;
+            if (elemcount % packn == 0)
+                dst_elempack = packn;
+#else
+            if (elemcount % 8 == 0)
+                dst_elempack = 8;
+#endif
+        }
+    }
+
+    if (bottom_blob.elempack != dst_elempack)
+    {
+        ncnn::Mat bottom_blob_packed;
+        ncnn::convert_packing(bottom_blob, bottom_blob_packed, dst_elempack, opt);
+        bottom_blob = bottom_blob_packed;
+
+        if (bottom_blob.empty())
+            return -100;
+    }
+
+    if (bottom_blob.elembits() == 16)
+    {
+        // clang-format off
+        // *INDENT-OFF*
+
+#if NCNN_ARM82
+        if (opt.use_fp16_storage && ncnn::cpu_support_arm_asimdhp() && !layer->support_fp16_storage)
+        {
+            ncnn::Mat bottom_blob_fp32;
+            ncnn::cast_float16_to_float32(bottom_blob, bottom_blob_fp32, opt);
+            bottom_blob = bottom_blob_fp32;
+        }
+        else
+#endif // NCNN_ARM82
+#if NCNN_VFPV4
+        if (opt.use_fp16_storage && !opt.use_bf16_storage && ncnn::cpu_support_arm_vfpv4() && !layer->support_fp16_storage)
+        {
+            ncnn::Mat bottom_blob_fp32;
+            ncnn::cast_float16_to_float32(bottom_blob, bottom_blob_fp32, opt);
+            bottom_blob = bottom_blob_fp32;
+        }
+        else
+#endif // NCNN_VFPV4
+#if NCNN_ZFH
+        if (opt.use_fp16_storage && (ncnn::cpu_support_riscv_zvfh() || (!ncnn::cpu_support_riscv_v() && ncnn::cpu_support_riscv_zfh())) && !layer->support_fp16_storage)
+        {
+            ncnn::Mat bottom_blob_fp32;
+            ncnn::cast_float16_to_float32(bottom_blob, bottom_blob_fp32, opt);
+            bottom_blob = bottom_blob_fp32;
+        }
+        else
+#endif // NCNN_ZFH
+#if NCNN_BF16
+        if (opt.use_bf16_storage && !layer->support_bf16_storage)
+        {
+            ncnn::Mat bottom_blob_fp32;
+            ncnn::cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt);
+            bottom_blob = bottom_blob_fp32;
+        }
+        else
+#endif // NCNN_BF16
+        {
+        }
+
+        // *INDENT-ON*
+        // clang-format on
+
+        if (bottom_blob.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
+static int take_bottom_blob(ncnn::Mat& bottom_blob_ref, ncnn::Mat& bottom_blob, const ncnn::Layer* layer, const ncnn::Option& opt)
+{
+    // deep copy for inplace forward if data is shared or external
+    if (layer->support_inplace && (!bottom_blob_ref.refcount || *bottom_blob_ref.refcount != 1))
+    {
+        bottom_blob = bottom_blob_ref.clone(opt.blob_allocator);
+        if (bottom_blob.empty())
+            return -100;
+    }
+    else
+    {
+        bottom_blob = bottom_blob_ref;
+    }
+
+    // delete after taken
+    bottom_blob_ref.release();
+
+    return convert_layout(bottom_blob, layer, opt);
+}
+
+static int forward_layer(const ncnn::Layer* layer, ncnn::Mat& bottom_blob_ref, ncnn::Mat& top_blob, const ncnn::Option& opt)
+{
+    ncnn::Mat bottom_blob;
+    int ret = take_bottom_blob(bottom_blob_ref, bottom_blob, layer, opt);
+    if (ret != 0)
+        return ret;
+
+    if (layer->support_inplace)
+    {
+        ret = layer->forward_inplace(bottom_blob, opt);
+        top_blob = bottom_blob;
+    }
+    else
+    {
+        ret = layer->forward(bottom_blob, top_blob, opt);
+    }
+
+    return ret;
+}
+
+static int forward_layer(const ncnn::Layer* layer, ncnn::Mat** bottom_blob_refs, int bottom_count, ncnn::Mat** top_blob_refs, int top_count, const ncnn::Option& opt)
+{
+    std::vector<ncnn::Mat> bottom_blobs(bottom_count);
+    for (int i = 0; i < bottom_count; i++)
+    {
+        int ret = take_bottom_blob(*bottom_blob_refs[i], bottom_blobs[i], layer, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (layer->support_inplace)
+    {
+        int ret = layer->forward_inplace(bottom_blobs, opt);
+        if (ret != 0)
+            return ret;
+
+        for (int i = 0; i < top_count; i++)
+        {
+            *top_blob_refs[i] = bottom_blobs[i];
+        }
+    }
+    else
+    {
+        std::vector<ncnn::Mat> top_blobs(top_count);
+        int ret = layer->forward(bottom_blobs, top_blobs, opt);
+        if (ret != 0)
+            return ret;
+
+        for (int i = 0; i < top_count; i++)
+        {
+            *top_blob_refs[i] = top_blobs[i];
+        }
+    }
+
+    return 0;
+}
+
+static int convert_output(ncnn::Mat& feat, const ncnn::Option& opt)
+{
+    if (feat.empty())
+        return 0;
+
+    if (feat.elempack != 1)
+    {
+        ncnn::Mat feat_unpacked;
+        ncnn::convert_packing(feat, feat_unpacked, 1, opt);
+        feat = feat_unpacked;
+    }
+
+    if (feat.elembits() == 16)
+    {
+        ncnn::Mat feat_fp32;
+#if NCNN_BF16
+        if (opt.use_bf16_storage && !opt.use_fp16_storage)
+            ncnn::cast_bfloat16_to_float32(feat, feat_fp32, opt);
+        else
+#endif // NCNN_BF16
+            ncnn::cast_float16_to_float32(feat, feat_fp32, opt);
+        feat = feat_fp32;
+    }
+    else if (feat.elembits() == 8)
+    {
+        ncnn::Mat feat_fp32;
+        ncnn::cast_int8_to_float32(feat, feat_fp32, opt);
+        feat = feat_fp32;
+    }
+
+    return feat.empty() ? -100 : 0;
+}
+
+static ncnn::Option get_masked_option(const ncnn::Option& opt, int featmask)
+{
+    ncnn::Option opt1 = opt;
+    opt1.use_fp16_arithmetic = opt1.use_fp16_arithmetic && !(featmask & (1 << 0));
+    opt1.use_fp16_storage = opt1.use_fp16_storage && !(featmask & (1 << 1));
+    opt1.use_fp16_packed = opt1.use_fp16_packed && !(featmask & (1 << 1));
+    opt1.use_bf16_storage = opt1.use_bf16_storage && !(featmask & (1 << 2));
+    opt1.use_int8_packed = opt1.use_int8_packed && !(featmask & (1 << 3));
+    opt1.use_int8_storage = opt1.use_int8_storage && !(featmask & (1 << 3));
+    opt1.use_int8_arithmetic = opt1.use_int8_arithmetic && !(featmask & (1 << 3));
+    opt1.use_sgemm_convolution = opt1.use_sgemm_convolution && !(featmask & (1 << 5));
+    opt1.use_winograd_convolution = opt1.use_winograd_convolution && !(featmask & (1 << 6));
+
+    if (featmask & (1 << 7))
+        opt1.num_threads = 1;
+
+    return opt1;
+}
+)ncnnaot";
+
+struct aot_layer
+{
+    int index;
+    std::string type;
+    std::string name;
+    std::vector<int> bottoms;
+    std::vector<int> tops;
+    ncnn::ParamDict pd;
+    std::vector<ncnn::Mat> weights;
+};
+
+static void write_param(FILE* fp, const ncnn::ParamDict& pd)
+{
+    for (int id = 0; id < NCNN_MAX_PARAM_COUNT; id++)
+    {
+        const int type = pd.type(id);
+        if (type == 0)
+            continue;
+
+        if (type == 2)
+        {
+            fprintf(fp, "        pd.set(%d, %d);\n", id, pd.get(id, 0));
+        }
+        if (type == 3)
+        {
+            fprintf(fp, "        pd.set(%d, %s);\n", id, float_to_code(pd.get(id, 0.f)).c_str());
+        }
+        if (type == 5 || type == 6)
+        {
+            const ncnn::Mat v = pd.get(id, ncnn::Mat());
+
+            fprintf(fp, "        {\n");
+            if (type == 5)
+            {
+                fprintf(fp, "            static const int v[] = {");
+                for (int i = 0; i < v.w; i++)
+                {
+                    fprintf(fp, i == 0 ? "%d" : ", %d", ((const int*)v)[i]);
+                }
+            }
+            else
+            {
+                fprintf(fp, "            static const float v[] = {");
+                for (int i = 0; i < v.w; i++)
+                {
+                    fprintf(fp, i == 0 ? "%s" : ", %s", float_to_code(v[i]).c_str());
+                }
+            }
+            fprintf(fp, "};\n");
+            fprintf(fp, "            ncnn::Mat m(%d);\n", v.w);
+            fprintf(fp, "            memcpy(m.data, v, sizeof(v));\n");
+            fprintf(fp, "            pd.set(%d, m);\n", id);
+            fprintf(fp, "        }\n");
+        }
+        if (type == 7)
+        {
+            std::string s = pd.get(id, "");
+            fprintf(fp, "        pd.set(%d, \"", id);
+            for (size_t i = 0; i < s.size(); i++)
+            {
+                if (s[i] == '\"' || s[i] == '\\')
+                    fputc('\\', fp);
+                fputc(s[i], fp);
+            }
+            fprintf(fp, "\");\n");
+        }
+    }
+}
+
+static void write_weight(FILE* fp, const std::string& varname, const ncnn::Mat& m)
+{
+    const size_t size = m.total() * m.elemsize;
+    const size_t wordcount = (size + 3) / 4;
+
+    fprintf(fp, "NCNN_AOT_ALIGN static const unsigned int %s[%d] = {", varname.c_str(), (int)wordcount);
+
+    const unsigned char* ptr = (const unsigned char*)m.data;
+    for (size_t i = 0; i < wordcount; i++)
+    {
+        unsigned int v = 0;
+        memcpy(&v, ptr + i * 4, std::min((size_t)4, size - i * 4));
+
+        if (i % 8 == 0)
+            fprintf(fp, "\n    ");
+        fprintf(fp, "0x%08x,", v);
+    }
+
+    fprintf(fp, "\n};\n");
+}
+
+static int ncnn2cpp(const char* parampath, const char* binpath, const char* outpath, const std::vector<blob_shape>& input_shapes)
+{
+    std::vector<unsigned char> param;
+    std::vector<unsigned char> bin;
+    if (read_file(parampath, param) != 0 || read_file(binpath, bin) != 0)
+        return -1;
+
+    param.push_back('\0');
+
+    ncnn::Net net;
+    net.opt.lightmode = false;
+    net.opt.use_vulkan_compute = false;
+    if (net.load_param_mem((const char*)&param[0]) != 0 || net.load_model(binpath) != 0)
+    {
+        fprintf(stderr, "load %s %s failed\n", parampath, binpath);
+        return -1;
+    }
+
+    const std::vector<ncnn::Layer*>& layers = net.layers();
+    const std::vector<ncnn::Blob>& blobs = net.blobs();
+    const std::vector<int>& input_indexes = net.input_indexes();
+    const std::vector<int>& output_indexes = net.output_indexes();
+
+    if (input_indexes.size() != input_shapes.size())
+    {
+        fprintf(stderr, "model has %d inputs but %d shapes given\n", (int)input_indexes.size(), (int)input_shapes.size());
+        return -1;
+    }
+
+    // run once with the fixed input shapes to resolve all blob shapes
+    std::vector<blob_shape> shapes(blobs.size());
+    memset(&shapes[0], 0, shapes.size() * sizeof(blob_shape));
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        for (size_t i = 0; i < input_indexes.size(); i++)
+        {
+            ncnn::Mat in = shape_to_mat(input_shapes[i]);
+            in.fill(0.5f);
+            ex.input(input_indexes[i], in);
+        }
+
+        for (size_t i = 0; i < blobs.size(); i++)
+        {
+            if (blobs[i].producer == -1)
+                continue;
+
+            ncnn::Mat m;
+            if (ex.extract((int)i, m) != 0)
+            {
+                fprintf(stderr, "resolve shape of blob %s failed\n", blobs[i].name.c_str());
+                return -1;
+            }
+
+            blob_shape& shape = shapes[i];
+            shape.dims = m.dims;
+            shape.w = m.w;
+            shape.h = m.h;
+            shape.d = m.d;
+            shape.c = m.c;
+        }
+    }
+
+    // the layers needed for outputs in topological order, parse each param dict again
+    std::vector<bool> needed(layers.size(), false);
+    for (size_t i = 0; i < output_indexes.size(); i++)
+    {
+        needed[blobs[output_indexes[i]].producer] = true;
+    }
+    for (int i = (int)layers.size() - 1; i >= 0; i--)
+    {
+        if (!needed[i])
+            continue;
+
+        for (size_t j = 0; j < layers[i]->bottoms.size(); j++)
+        {
+            int producer = blobs[layers[i]->bottoms[j]].producer;
+            if (producer != -1)
+                needed[producer] = true;
+        }
+    }
+
+    std::vector<aot_layer> aot_layers;
+    {
+        const unsigned char* mem = &param[0];
+        ncnn::DataReaderFromMemory dr(mem);
+
+        const unsigned char* binmem = &bin[0];
+        ncnn::DataReaderFromMemory bindr(binmem);
+        ncnn::ModelBinFromDataReader mb(bindr);
+
+        int magic = 0;
+        int layer_count = 0;
+        int blob_count = 0;
+        dr.scan("%d", &magic);
+        dr.scan("%d", &layer_count);
+        dr.scan("%d", &blob_count);
+
+        for (int i = 0; i < layer_count; i++)
+        {
+            char token[256];
+            int bottom_count = 0;
+            int top_count = 0;
+            dr.scan("%255s", token);
+            dr.scan("%255s", token);
+            dr.scan("%d", &bottom_count);
+            dr.scan("%d", &top_count);
+            for (int j = 0; j < bottom_count + top_count; j++)
+            {
+                dr.scan("%255s", token);
+            }
+
+            aot_layer l;
+            l.index = i;
+            l.type = layers[i]->type;
+            l.name = layers[i]->name;
+            l.bottoms = layers[i]->bottoms;
+            l.tops = layers[i]->tops;
+
+            ParamDictReader pd;
+            if (pd.load(dr) != 0)
+            {
+                fprintf(stderr, "parse param of layer %s failed\n", l.name.c_str());
+                return -1;
+            }
+            l.pd = pd;
+
+            // load weights with a fresh layer so that pipelines of net are untouched
+            ncnn::Layer* layer = ncnn::create_layer_cpu(l.type.c_str());
+            if (!layer)
+            {
+                fprintf(stderr, "layer type %s is not builtin, custom layer is not supported\n", l.type.c_str());
+                return -1;
+            }
+
+            layer->load_param(pd);
+
+            ModelBinRecorder mbr(mb, l.weights);
+            int ret = layer->load_model(mbr);
+            delete layer;
+            if (ret != 0)
+            {
+                fprintf(stderr, "load weight of layer %s failed\n", l.name.c_str());
+                return -1;
+            }
+
+            if (needed[i] && l.type != "Input")
+                aot_layers.push_back(l);
+        }
+    }
+
+    const std::string name = path_to_varname(outpath);
+    const std::string hpath = std::string(outpath) + ".h";
+    const std::string cpppath = std::string(outpath) + ".cpp";
+    const char* hname = strrchr(hpath.c_str(), '/') ? strrchr(hpath.c_str(), '/') + 1 : hpath.c_str();
+
+    // header
+    {
+        FILE* fp = fopen(hpath.c_str(), "wb");
+        if (!fp)
+        {
+            fprintf(stderr, "fopen %s failed\n", hpath.c_str());
+            return -1;
+        }
+
+        fprintf(fp, "// generated by ncnn2cpp from %s, do not edit\n\n", parampath);
+        fprintf(fp, "#ifndef NCNN_INCLUDE_GUARD_%s_h\n", name.c_str());
+        fprintf(fp, "#define NCNN_INCLUDE_GUARD_%s_h\n\n", name.c_str());
+        fprintf(fp, "#include \"layer.h\"\n");
+        fprintf(fp, "#include \"mat.h\"\n");
+        fprintf(fp, "#include \"option.h\"\n\n");
+        fprintf(fp, "namespace %s {\n\n", name.c_str());
+        fprintf(fp, "class Model\n{\npublic:\n");
+        fprintf(fp, "    Model();\n    ~Model();\n\n");
+        fprintf(fp, "    // create layers with embedded params and weights\n");
+        fprintf(fp, "    // opt.blob_allocator and opt.workspace_allocator are used as is, pass pool allocators for reuse\n");
+        fprintf(fp, "    // return 0 if success\n");
+        fprintf(fp, "    int load(const ncnn::Option& opt);\n\n");
+        fprintf(fp, "    // destroy layers\n");
+        fprintf(fp, "    void clear();\n\n");
+        fprintf(fp, "    // input and output shapes are fixed at generation time\n");
+        for (size_t i = 0; i < input_indexes.size(); i++)
+        {
+            fprintf(fp, "    // in%d  %s  %s\n", (int)i, blobs[input_indexes[i]].name.c_str(), shape_to_string(input_shapes[i]).c_str());
+        }
+        for (size_t i = 0; i < output_indexes.size(); i++)
+        {
+            fprintf(fp, "    // out%d  %s  %s\n", (int)i, blobs[output_indexes[i]].name.c_str(), shape_to_string(shapes[output_indexes[i]]).c_str());
+        }
+        fprintf(fp, "    // return 0 if success, -1 if input shape mismatch\n");
+        fprintf(fp, "    int forward(");
+        for (size_t i = 0; i < input_indexes.size(); i++)
+        {
+            fprintf(fp, "const ncnn::Mat& in%d, ", (int)i);
+        }
+        for (size_t i = 0; i < output_indexes.size(); i++)
+        {
+            fprintf(fp, i + 1 == output_indexes.size() ? "ncnn::Mat& out%d" : "ncnn::Mat& out%d, ", (int)i);
+        }
+        fprintf(fp, ") const;\n\n");
+        fprintf(fp, "private:\n    Model(const Model&);\n    Model& operator=(const Model&);\n\n");
+        fprintf(fp, "private:\n    ncnn::Option opt;\n    ncnn::Layer* layers[%d];\n};\n\n", (int)aot_layers.size());
+        fprintf(fp, "} // namespace %s\n\n", name.c_str());
+        fprintf(fp, "#endif // NCNN_INCLUDE_GUARD_%s_h\n", name.c_str());
+
+        fclose(fp);
+    }
+
+    // source
+    FILE* fp = fopen(cpppath.c_str(), "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", cpppath.c_str());
+        return -1;
+    }
+
+    fprintf(fp, "// generated by ncnn2cpp from %s, do not edit\n\n", parampath);
+    fprintf(fp, "#include \"%s\"\n\n", hname);
+    fprintf(fp, "#include \"cpu.h\"\n");
+    fprintf(fp, "#include \"layer_type.h\"\n");
+    fprintf(fp, "#include \"modelbin.h\"\n");
+    fprintf(fp, "#include \"paramdict.h\"\n\n");
+    fprintf(fp, "#include <limits>\n");
+    fprintf(fp, "#include <string.h>\n");
+    fprintf(fp, "#include <vector>\n\n");
+    fprintf(fp, "#ifdef _MSC_VER\n#define NCNN_AOT_ALIGN __declspec(align(16))\n#else\n#define NCNN_AOT_ALIGN __attribute__((aligned(16)))\n#endif\n\n");
+    fprintf(fp, "namespace %s {\n\n", name.c_str());
+
+    // weights
+    for (size_t i = 0; i < aot_layers.size(); i++)
+    {
+        const aot_layer& l = aot_layers[i];
+        for (size_t j = 0; j < l.weights.size(); j++)
+        {
+            char varname[64];
+            sprintf(varname, "weight_%d_%d", (int)i, (int)j);
+            write_weight(fp, varname, l.weights[j]);
+        }
+    }
+
+    fputs(runtime_source, fp);
+
+    fprintf(fp, "\nModel::Model()\n{\n");
+    fprintf(fp, "    memset(layers, 0, sizeof(layers));\n}\n\n");
+    fprintf(fp, "Model::~Model()\n{\n    clear();\n}\n\n");
+
+    fprintf(fp, "void Model::clear()\n{\n");
+    fprintf(fp, "    for (int i = 0; i < %d; i++)\n    {\n", (int)aot_layers.size());
+    fprintf(fp, "        if (!layers[i])\n            continue;\n\n");
+    fprintf(fp, "        layers[i]->destroy_pipeline(get_masked_option(opt, layers[i]->featmask));\n");
+    fprintf(fp, "        delete layers[i];\n        layers[i] = 0;\n    }\n}\n\n");
+
+    // load
+    fprintf(fp, "int Model::load(const ncnn::Option& _opt)\n{\n");
+    fprintf(fp, "    clear();\n\n");
+    fprintf(fp, "    opt = _opt;\n");
+    fprintf(fp, "    opt.lightmode = true;\n");
+    fprintf(fp, "    opt.use_vulkan_compute = false;\n");
+    fprintf(fp, "    if (!opt.use_fp16_storage)\n        opt.use_fp16_arithmetic = false;\n");
+    for (size_t i = 0; i < aot_layers.size(); i++)
+    {
+        const aot_layer& l = aot_layers[i];
+
+        fprintf(fp, "\n    // %s %s\n", l.type.c_str(), l.name.c_str());
+        fprintf(fp, "    {\n");
+        fprintf(fp, "        ncnn::Layer* layer = ncnn::create_layer_cpu(%s);\n", layer_type_to_code(l.type.c_str()).c_str());
+        fprintf(fp, "        layers[%d] = layer;\n\n", (int)i);
+        fprintf(fp, "        ncnn::ParamDict pd;\n");
+        write_param(fp, l.pd);
+        fprintf(fp, "\n");
+
+        fprintf(fp, "        layer->type = \"%s\";\n", l.type.c_str());
+        fprintf(fp, "        layer->name = \"%s\";\n", l.name.c_str());
+        fprintf(fp, "        layer->featmask = %d;\n", l.pd.get(31, 0));
+        fprintf(fp, "        layer->bottom_shapes.resize(%d);\n", (int)l.bottoms.size());
+        for (size_t j = 0; j < l.bottoms.size(); j++)
+        {
+            fprintf(fp, "        layer->bottom_shapes[%d] = %s;\n", (int)j, shape_to_code(shapes[l.bottoms[j]]).c_str());
+        }
+        fprintf(fp, "        layer->top_shapes.resize(%d);\n", (int)l.tops.size());
+        for (size_t j = 0; j < l.tops.size(); j++)
+        {
+            fprintf(fp, "        layer->top_shapes[%d] = %s;\n", (int)j, shape_to_code(shapes[l.tops[j]]).c_str());
+        }
+        fprintf(fp, "        if (layer->load_param(pd) != 0)\n            return -1;\n\n");
+
+        if (!l.weights.empty())
+        {
+            fprintf(fp, "        ncnn::Mat weights[%d];\n", (int)l.weights.size());
+            for (size_t j = 0; j < l.weights.size(); j++)
+            {
+                const ncnn::Mat& m = l.weights[j];
+                fprintf(fp, "        weights[%d] = ncnn::Mat(%d, (void*)weight_%d_%d, %du);\n", (int)j, (int)m.total(), (int)i, (int)j, (int)m.elemsize);
+            }
+            fprintf(fp, "        if (layer->load_model(ncnn::ModelBinFromMatArray(weights)) != 0)\n            return -1;\n\n");
+        }
+
+        fprintf(fp, "        if (layer->create_pipeline(get_masked_option(opt, layer->featmask)) != 0)\n            return -1;\n");
+        fprintf(fp, "    }\n");
+    }
+    fprintf(fp, "\n    return 0;\n}\n\n");
+
+    // forward
+    fprintf(fp, "int Model::forward(");
+    for (size_t i = 0; i < input_indexes.size(); i++)
+    {
+        fprintf(fp, "const ncnn::Mat& in%d, ", (int)i);
+    }
+    for (size_t i = 0; i < output_indexes.size(); i++)
+    {
+        fprintf(fp, i + 1 == output_indexes.size() ? "ncnn::Mat& out%d" : "ncnn::Mat& out%d, ", (int)i);
+    }
+    fprintf(fp, ") const\n{\n");
+
+    for (size_t i = 0; i < input_indexes.size(); i++)
+    {
+        const blob_shape& s = input_shapes[i];
+        fprintf(fp, "    if (in%d.dims != %d || in%d.w != %d || in%d.h != %d || in%d.d != %d || in%d.c != %d || in%d.elempack != 1)\n        return -1;\n", (int)i, s.dims, (int)i, s.w, (int)i, s.h, (int)i, s.d, (int)i, s.c, (int)i);
+    }
+    fprintf(fp, "\n");
+
+    fprintf(fp, "    int old_blocktime = ncnn::get_kmp_blocktime();\n");
+    fprintf(fp, "    ncnn::set_kmp_blocktime(opt.openmp_blocktime);\n\n");
+    fprintf(fp, "    int old_flush_denormals = ncnn::get_flush_denormals();\n");
+    fprintf(fp, "    ncnn::set_flush_denormals(opt.flush_denormals);\n\n");
+
+    fprintf(fp, "    ncnn::Mat blobs[%d];\n", (int)blobs.size());
+    for (size_t i = 0; i < input_indexes.size(); i++)
+    {
+        fprintf(fp, "    blobs[%d] = in%d;\n", input_indexes[i], (int)i);
+    }
+    fprintf(fp, "\n    int ret = 0;\n");
+
+    for (size_t i = 0; i < aot_layers.size(); i++)
+    {
+        const aot_layer& l = aot_layers[i];
+        const ncnn::Layer* layer = layers[l.index];
+
+        fprintf(fp, "\n    // %s %s", l.type.c_str(), l.name.c_str());
+        for (size_t j = 0; j < l.bottoms.size(); j++)
+        {
+            fprintf(fp, " %s", shape_to_string(shapes[l.bottoms[j]]).c_str());
+        }
+        fprintf(fp, " ->");
+        for (size_t j = 0; j < l.tops.size(); j++)
+        {
+            fprintf(fp, " %s", shape_to_string(shapes[l.tops[j]]).c_str());
+        }
+        fprintf(fp, "\n");
+
+        const char* opt_code = l.pd.get(31, 0) ? "get_masked_option(opt, layers[%d]->featmask)" : "opt";
+        char opt_str[128];
+        sprintf(opt_str, opt_code, (int)i);
+
+        if (layer->one_blob_only)
+        {
+            fprintf(fp, "    if (ret == 0)\n        ret = forward_layer(layers[%d], blobs[%d], blobs[%d], %s);\n", (int)i, l.bottoms[0], l.tops[0], opt_str);
+        }
+        else
+        {
+            fprintf(fp, "    if (ret == 0)\n    {\n");
+            fprintf(fp, "        ncnn::Mat* bottom_blob_refs[%d] = {", (int)std::max(l.bottoms.size(), (size_t)1));
+            for (size_t j = 0; j < l.bottoms.size(); j++)
+            {
+                fprintf(fp, j == 0 ? "&blobs[%d]" : ", &blobs[%d]", l.bottoms[j]);
+            }
+            fprintf(fp, "};\n");
+            fprintf(fp, "        ncnn::Mat* top_blob_refs[%d] = {", (int)std::max(l.tops.size(), (size_t)1));
+            for (size_t j = 0; j < l.tops.size(); j++)
+            {
+                fprintf(fp, j == 0 ? "&blobs[%d]" : ", &blobs[%d]", l.tops[j]);
+            }
+            fprintf(fp, "};\n");
+            fprintf(fp, "        ret = forward_layer(layers[%d], bottom_blob_refs, %d, top_blob_refs, %d, %s);\n", (int)i, (int)l.bottoms.size(), (int)l.tops.size(), opt_str);
+            fprintf(fp, "    }\n");
+        }
+    }
+
+    fprintf(fp, "\n");
+    for (size_t i = 0; i < output_indexes.size(); i++)
+    {
+        fprintf(fp, "    if (ret == 0)\n    {\n");
+        fprintf(fp, "        out%d = blobs[%d];\n", (int)i, output_indexes[i]);
+        fprintf(fp, "        ret = convert_output(out%d, opt);\n", (int)i);
+        fprintf(fp, "    }\n");
+    }
+
+    fprintf(fp, "\n    ncnn::set_kmp_blocktime(old_blocktime);\n");
+    fprintf(fp, "    ncnn::set_flush_denormals(old_flush_denormals);\n\n");
+    fprintf(fp, "    return ret;\n}\n\n");
+    fprintf(fp, "} // namespace %s\n", name.c_str());
+
+    fclose(fp);
+
+    fprintf(stderr, "generated %d layers into %s and %s\n", (int)aot_layers.size(), hpath.c_str(), cpppath.c_str());
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        fprintf(stderr, "Usage: %s [ncnnparam] [ncnnbin] [outname] [inshape]...\n", argv[0]);
+        fprintf(stderr, "       inshape is w[,h[,c]] or w,h,d,c for each input in param order\n");
+        fprintf(stderr, "       writes outname.h and outname.cpp\n");
+        return -1;
+    }
+
+    std::vector<blob_shape> input_shapes(argc - 4);
+    for (int i = 4; i < argc; i++)
+    {
+        if (parse_shape(argv[i], input_shapes[i - 4]) != 0)
+        {
+            fprintf(stderr, "invalid input shape %s\n", argv[i]);
+            return -1;
+        }
+    }
+
+    return ncnn2cpp(argv[1], argv[2], argv[3], input_shapes);
+}
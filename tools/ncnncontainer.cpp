@@ -0,0 +1,371 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "datareader.h"
+#include "layer.h"
+#include "modelbin.h"
+#include "net.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// single-file model container, keep in sync with src/net.cpp
+// see docs/developer-guide/param-and-model-file-structure.md
+struct container_header
+{
+    uint32_t magic; // 0x434E434E "NCNC"
+    uint32_t version;
+    uint32_t graph_type; // 0=plain param 1=binary param
+    uint32_t layer_count;
+    uint32_t weight_count;
+    uint32_t reserved;
+    uint64_t graph_offset;
+    uint64_t graph_size;
+    uint64_t layer_index_offset;
+    uint64_t weight_index_offset;
+    uint64_t file_size;
+};
+
+struct container_layer_entry
+{
+    uint32_t first_weight;
+    uint32_t weight_count;
+};
+
+struct container_weight_entry
+{
+    uint64_t offset; // 64-byte aligned
+    uint64_t size;
+    uint32_t type;     // 0=flagged weight 1=raw float32
+    uint32_t tag;      // storage flag of flagged weight
+    uint32_t checksum; // fnv1a of weight data words
+    uint32_t reserved;
+};
+
+static const size_t container_alignment = 64;
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+// hash 32bit words as weight data is always 32bit aligned, trailing bytes are hashed one by one
+static uint32_t container_checksum(const unsigned char* data, size_t size)
+{
+    uint32_t h = 0x811c9dc5;
+
+    size_t i = 0;
+    for (; i + 3 < size; i += 4)
+    {
+        uint32_t v;
+        memcpy(&v, data + i, 4);
+        h ^= v;
+        h *= 0x01000193;
+    }
+    for (; i < size; i++)
+    {
+        h ^= (uint32_t)data[i];
+        h *= 0x01000193;
+    }
+
+    return h;
+}
+
+static size_t align_offset(size_t offset)
+{
+    return (offset + container_alignment - 1) / container_alignment * container_alignment;
+}
+
+static int read_file(const char* path, std::vector<unsigned char>& data)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", path);
+        return -1;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    data.resize(size);
+    if (size > 0 && fread(&data[0], size, 1, fp) != 1)
+    {
+        fprintf(stderr, "fread %s failed\n", path);
+        fclose(fp);
+        return -1;
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+static void fwrite_padding(FILE* fp, size_t offset)
+{
+    static const unsigned char zeros[container_alignment] = {0};
+
+    size_t padding = align_offset(offset) - offset;
+    if (padding)
+        fwrite(zeros, 1, padding, fp);
+}
+
+// the weight spans consumed by each ModelBin::load call
+struct weight_record
+{
+    uint32_t type;
+    uint32_t tag;
+    size_t offset;
+    size_t size;
+};
+
+class ModelBinRecorder : public ncnn::ModelBin
+{
+public:
+    ModelBinRecorder(const unsigned char*& _mem, const unsigned char* _base, std::vector<weight_record>& _records)
+        : mem(_mem), base(_base), records(_records), dr(_mem), mb(dr)
+    {
+    }
+
+    virtual ncnn::Mat load(int w, int type) const
+    {
+        const unsigned char* start = mem;
+
+        ncnn::Mat m = mb.load(w, type);
+        if (m.empty())
+            return m;
+
+        weight_record r;
+        r.type = type;
+        r.tag = 0;
+        r.offset = start - base;
+        if (type == 0)
+        {
+            memcpy(&r.tag, start, 4);
+            r.offset += 4;
+        }
+        r.size = (mem - base) - r.offset;
+
+        records.push_back(r);
+
+        return m;
+    }
+
+public:
+    const unsigned char*& mem;
+    const unsigned char* base;
+    std::vector<weight_record>& records;
+
+    ncnn::DataReaderFromMemory dr;
+    ncnn::ModelBinFromDataReader mb;
+};
+
+static int pack(const char* parampath, const char* binpath, const char* containerpath)
+{
+    std::vector<unsigned char> param;
+    std::vector<unsigned char> bin;
+    if (read_file(parampath, param) != 0 || read_file(binpath, bin) != 0)
+        return -1;
+
+    // binary param starts with magic number 7767517 in little-endian
+    int magic = 0;
+    if (param.size() >= 4)
+        memcpy(&magic, &param[0], 4);
+
+    const uint32_t graph_type = magic == 7767517 ? 1 : 0;
+    if (graph_type == 0)
+        param.push_back('\0');
+
+    ncnn::Net net;
+    {
+        const unsigned char* mem = &param[0];
+        ncnn::DataReaderFromMemory dr(mem);
+        int ret = graph_type == 1 ? net.load_param_bin(dr) : net.load_param(dr);
+        if (ret != 0)
+        {
+            fprintf(stderr, "load_param %s failed\n", parampath);
+            return -1;
+        }
+    }
+
+    // walk through the model binary layer by layer to find out each weight
+    std::vector<ncnn::Layer*>& layers = net.mutable_layers();
+    std::vector<container_layer_entry> layer_entries(layers.size());
+    std::vector<weight_record> records;
+
+    bin.push_back(0);
+    const unsigned char* base = &bin[0];
+    const unsigned char* mem = base;
+    const size_t bin_size = bin.size() - 1;
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        ncnn::Layer* layer = layers[i];
+
+        layer_entries[i].first_weight = (uint32_t)records.size();
+
+        ModelBinRecorder mb(mem, base, records);
+        int ret = layer->load_model(mb);
+        if (ret != 0 || (size_t)(mem - base) > bin_size)
+        {
+            fprintf(stderr, "layer load_model %d %s failed\n", (int)i, layer->name.c_str());
+            return -1;
+        }
+
+        layer_entries[i].weight_count = (uint32_t)records.size() - layer_entries[i].first_weight;
+    }
+
+    if ((size_t)(mem - base) != bin_size)
+    {
+        fprintf(stderr, "%s has %d unused bytes\n", binpath, (int)(bin_size - (mem - base)));
+        return -1;
+    }
+
+    // layout
+    container_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = 0x434E434E;
+    header.version = 1;
+    header.graph_type = graph_type;
+    header.layer_count = (uint32_t)layer_entries.size();
+    header.weight_count = (uint32_t)records.size();
+
+    size_t offset = align_offset(sizeof(container_header));
+    header.graph_offset = offset;
+    header.graph_size = param.size();
+    offset = align_offset(offset + param.size());
+    header.layer_index_offset = offset;
+    offset = align_offset(offset + layer_entries.size() * sizeof(container_layer_entry));
+    header.weight_index_offset = offset;
+    offset = align_offset(offset + records.size() * sizeof(container_weight_entry));
+
+    std::vector<container_weight_entry> weight_entries(records.size());
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const weight_record& r = records[i];
+        container_weight_entry& e = weight_entries[i];
+
+        memset(&e, 0, sizeof(e));
+        e.offset = offset;
+        e.size = r.size;
+        e.type = r.type;
+        e.tag = r.tag;
+        e.checksum = container_checksum(base + r.offset, r.size);
+
+        offset = align_offset(offset + r.size);
+    }
+
+    header.file_size = offset;
+
+    FILE* fp = fopen(containerpath, "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "fopen %s failed\n", containerpath);
+        return -1;
+    }
+
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite_padding(fp, sizeof(header));
+
+    fwrite(&param[0], 1, param.size(), fp);
+    fwrite_padding(fp, param.size());
+
+    if (!layer_entries.empty())
+        fwrite(&layer_entries[0], sizeof(container_layer_entry), layer_entries.size(), fp);
+    fwrite_padding(fp, layer_entries.size() * sizeof(container_layer_entry));
+
+    if (!weight_entries.empty())
+        fwrite(&weight_entries[0], sizeof(container_weight_entry), weight_entries.size(), fp);
+    fwrite_padding(fp, weight_entries.size() * sizeof(container_weight_entry));
+
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        fwrite(base + records[i].offset, 1, records[i].size, fp);
+        fwrite_padding(fp, records[i].size);
+    }
+
+    fclose(fp);
+
+    fprintf(stderr, "packed %d layers %d weights into %s\n", (int)header.layer_count, (int)header.weight_count, containerpath);
+
+    return 0;
+}
+
+static int unpack(const char* containerpath, const char* parampath, const char* binpath)
+{
+    std::vector<unsigned char> data;
+    if (read_file(containerpath, data) != 0)
+        return -1;
+
+    container_header header;
+    if (data.size() < sizeof(header))
+    {
+        fprintf(stderr, "%s is too small\n", containerpath);
+        return -1;
+    }
+
+    memcpy(&header, &data[0], sizeof(header));
+    if (header.magic != 0x434E434E || header.version != 1 || header.file_size > data.size()
+            || header.graph_offset + header.graph_size > header.file_size
+            || header.weight_index_offset + header.weight_count * sizeof(container_weight_entry) > header.file_size)
+    {
+        fprintf(stderr, "%s is not a valid container\n", containerpath);
+        return -1;
+    }
+
+    FILE* pp = fopen(parampath, "wb");
+    if (!pp)
+    {
+        fprintf(stderr, "fopen %s failed\n", parampath);
+        return -1;
+    }
+
+    // strip the null terminator of plain param
+    size_t graph_size = header.graph_size;
+    if (header.graph_type == 0 && graph_size > 0 && data[header.graph_offset + graph_size - 1] == '\0')
+        graph_size -= 1;
+
+    fwrite(&data[header.graph_offset], 1, graph_size, pp);
+    fclose(pp);
+
+    FILE* bp = fopen(binpath, "wb");
+    if (!bp)
+    {
+        fprintf(stderr, "fopen %s failed\n", binpath);
+        return -1;
+    }
+
+    const container_weight_entry* weight_entries = (const container_weight_entry*)&data[header.weight_index_offset];
+    for (uint32_t i = 0; i < header.weight_count; i++)
+    {
+        const container_weight_entry& e = weight_entries[i];
+        if (e.offset + e.size > header.file_size || container_checksum(&data[e.offset], e.size) != e.checksum)
+        {
+            fprintf(stderr, "weight %u is corrupted\n", i);
+            fclose(bp);
+            return -1;
+        }
+
+        if (e.type == 0)
+            fwrite(&e.tag, 4, 1, bp);
+
+        fwrite(&data[e.offset], 1, e.size, bp);
+    }
+
+    fclose(bp);
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 5 || (strcmp(argv[1], "pack") != 0 && strcmp(argv[1], "unpack") != 0))
+    {
+        fprintf(stderr, "Usage: %s pack [ncnnparam] [ncnnbin] [container]\n", argv[0]);
+        fprintf(stderr, "       %s unpack [container] [ncnnparam] [ncnnbin]\n", argv[0]);
+        return -1;
+    }
+
+    if (strcmp(argv[1], "pack") == 0)
+        return pack(argv[2], argv[3], argv[4]);
+
+    return unpack(argv[2], argv[3], argv[4]);
+}
@@ -60,6 +60,10 @@ public:
     int fuse_innerproduct_activation();
     int fuse_memorydata_binaryop();
     int fuse_binaryop_eltwise();
+    int fuse_permute_gemm();
+    int fuse_gemm_permute();
+    int fuse_permute_matmul();
+    int fuse_softmax_topk();
 
     int eliminate_dropout();
     int eliminate_pooling1x1();
@@ -75,6 +79,7 @@ public:
     int replace_prelu_with_leaky_relu();
     int replace_convolution_with_innerproduct_after_global_pooling();
     int replace_convolution_with_innerproduct_after_innerproduct();
+    int replace_convolutiondepthwise_convolution_with_separableconvolution();
 };
 
 NetOptimize::NetOptimize()
@@ -2036,6 +2041,236 @@ int NetOptimize::fuse_binaryop_eltwise()
     return 0;
 }
 
+int NetOptimize::fuse_permute_gemm()
+{
+    // blob shapes are resolved on the first Permute candidate
+    std::vector<ncnn::Mat> blob_shapes;
+    bool shapes_inferred = false;
+
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "Permute")
+            continue;
+
+        // transpose of matrix
+        ncnn::Permute* permute = (ncnn::Permute*)layers[i];
+        if (permute->order_type != 1)
+            continue;
+
+        if (!shapes_inferred)
+        {
+            std::vector<ncnn::Mat> input_shapes;
+            if (infer_shapes(input_shapes, blob_shapes) != 0)
+                blob_shapes.clear();
+
+            shapes_inferred = true;
+        }
+
+        // order_type 1 is a matrix transpose only for 2-D operand, leave unknown shape alone
+        if (blob_shapes.empty() || blob_shapes[permute->bottoms[0]].dims != 2)
+            continue;
+
+        // Permute - Gemm
+        int top_blob_index = layers[i]->tops[0];
+
+        size_t j = i + 1;
+        int operand = -1;
+        for (; j < layer_count; j++)
+        {
+            if (layers[j]->type != "Gemm")
+                continue;
+
+            ncnn::Gemm* gemm = (ncnn::Gemm*)layers[j];
+
+            // A and B come first among the bottoms, C is left alone
+            int bottom_A = gemm->constantA ? -1 : 0;
+            int bottom_B = gemm->constantB ? -1 : (gemm->constantA ? 0 : 1);
+
+            if (bottom_A != -1 && layers[j]->bottoms[bottom_A] == top_blob_index)
+            {
+                operand = 0;
+                break;
+            }
+            if (bottom_B != -1 && layers[j]->bottoms[bottom_B] == top_blob_index)
+            {
+                operand = 1;
+                break;
+            }
+        }
+
+        if (j == layer_count)
+            continue;
+
+        ncnn::Gemm* gemm = (ncnn::Gemm*)layers[j];
+
+        // the same blob used as both A and B
+        if (gemm->constantA == 0 && gemm->constantB == 0 && gemm->bottoms[0] == gemm->bottoms[1])
+            continue;
+
+        fprintf(stderr, "fuse_permute_gemm %s %s\n", permute->name.c_str(), gemm->name.c_str());
+
+        int bottom_blob_index_final = permute->bottoms[0];
+        if (operand == 0)
+        {
+            gemm->transA = 1 - gemm->transA;
+            gemm->bottoms[0] = bottom_blob_index_final;
+        }
+        else
+        {
+            gemm->transB = 1 - gemm->transB;
+            gemm->bottoms[gemm->constantA ? 0 : 1] = bottom_blob_index_final;
+        }
+        blobs[bottom_blob_index_final].consumer = j;
+        permute->type = "ncnnfused";
+    }
+
+    return 0;
+}
+
+int NetOptimize::fuse_gemm_permute()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "Gemm")
+            continue;
+
+        // output shape N-1-M is not a matrix transpose under Permute
+        ncnn::Gemm* gemm = (ncnn::Gemm*)layers[i];
+        if (gemm->output_N1M || gemm->output_elempack)
+            continue;
+
+        // Gemm - Permute
+        int top_blob_index = layers[i]->tops[0];
+
+        size_t j = i + 1;
+        for (; j < layer_count; j++)
+        {
+            if (layers[j]->type != "Permute")
+                continue;
+
+            if (layers[j]->bottoms.size() != 1)
+                continue;
+
+            if (layers[j]->bottoms[0] == top_blob_index)
+                break;
+        }
+
+        if (j == layer_count)
+            continue;
+
+        ncnn::Permute* permute = (ncnn::Permute*)layers[j];
+        if (permute->order_type != 1)
+            continue;
+
+        fprintf(stderr, "fuse_gemm_permute %s %s\n", gemm->name.c_str(), permute->name.c_str());
+
+        gemm->output_transpose = 1 - gemm->output_transpose;
+
+        int top_blob_index_final = permute->tops[0];
+        gemm->tops[0] = top_blob_index_final;
+        blobs[top_blob_index_final].producer = i;
+        permute->type = "ncnnfused";
+    }
+
+    return 0;
+}
+
+int NetOptimize::fuse_permute_matmul()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "Permute")
+            continue;
+
+        // swap of the two innermost axes, for any rank
+        ncnn::Permute* permute = (ncnn::Permute*)layers[i];
+        if (permute->order_type != 1)
+            continue;
+
+        // Permute - MatMul
+        int top_blob_index = layers[i]->tops[0];
+
+        size_t j = i + 1;
+        for (; j < layer_count; j++)
+        {
+            if (layers[j]->type != "MatMul")
+                continue;
+
+            if (layers[j]->bottoms.size() != 2)
+                continue;
+
+            // MatMul has no transA
+            if (layers[j]->bottoms[1] == top_blob_index && layers[j]->bottoms[0] != top_blob_index)
+                break;
+        }
+
+        if (j == layer_count)
+            continue;
+
+        ncnn::MatMul* matmul = (ncnn::MatMul*)layers[j];
+
+        fprintf(stderr, "fuse_permute_matmul %s %s\n", permute->name.c_str(), matmul->name.c_str());
+
+        int bottom_blob_index_final = permute->bottoms[0];
+        matmul->transB = 1 - matmul->transB;
+        matmul->bottoms[1] = bottom_blob_index_final;
+        blobs[bottom_blob_index_final].consumer = j;
+        permute->type = "ncnnfused";
+    }
+
+    return 0;
+}
+
+int NetOptimize::fuse_softmax_topk()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "Softmax")
+            continue;
+
+        ncnn::Softmax* softmax = (ncnn::Softmax*)layers[i];
+
+        // Softmax - TopK
+        int top_blob_index = layers[i]->tops[0];
+
+        size_t j = i + 1;
+        for (; j < layer_count; j++)
+        {
+            if (layers[j]->type != "TopK")
+                continue;
+
+            if (layers[j]->bottoms.size() != 1)
+                continue;
+
+            if (layers[j]->bottoms[0] == top_blob_index)
+                break;
+        }
+
+        if (j == layer_count)
+            continue;
+
+        ncnn::TopK* topk = (ncnn::TopK*)layers[j];
+
+        // the axis must be the same one without knowing the blob rank
+        if (topk->softmax || topk->axis != softmax->axis)
+            continue;
+
+        fprintf(stderr, "fuse_softmax_topk %s %s\n", softmax->name.c_str(), topk->name.c_str());
+
+        int bottom_blob_index_final = softmax->bottoms[0];
+        topk->softmax = 1;
+        topk->bottoms[0] = bottom_blob_index_final;
+        blobs[bottom_blob_index_final].consumer = j;
+        softmax->type = "ncnnfused";
+    }
+
+    return 0;
+}
+
 int NetOptimize::eliminate_dropout()
 {
     const size_t layer_count = layers.size();
@@ -2748,6 +2983,119 @@ int NetOptimize::replace_convolution_with_innerproduct_after_innerproduct()
     return 0;
 }
 
+int NetOptimize::replace_convolutiondepthwise_convolution_with_separableconvolution()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "ConvolutionDepthWise")
+            continue;
+
+        ncnn::ConvolutionDepthWise* convolutiondepthwise = (ncnn::ConvolutionDepthWise*)layers[i];
+        if (convolutiondepthwise->dynamic_weight || convolutiondepthwise->int8_scale_term)
+            continue;
+
+        // pure depthwise only
+        const int channels = convolutiondepthwise->num_output;
+        if (convolutiondepthwise->group != channels || convolutiondepthwise->weight_data_size != channels * convolutiondepthwise->kernel_w * convolutiondepthwise->kernel_h)
+            continue;
+
+        // ConvolutionDepthWise - Convolution 1x1
+        int top_blob_index = layers[i]->tops[0];
+
+        size_t j = i + 1;
+        for (; j < layer_count; j++)
+        {
+            if (layers[j]->type != "Convolution")
+                continue;
+
+            if (layers[j]->bottoms.size() != 1)
+                continue;
+
+            if (layers[j]->bottoms[0] == top_blob_index)
+                break;
+        }
+
+        if (j == layer_count)
+            continue;
+
+        ncnn::Convolution* convolution = (ncnn::Convolution*)layers[j];
+        if (convolution->kernel_w != 1 || convolution->kernel_h != 1 || convolution->stride_w != 1 || convolution->stride_h != 1)
+            continue;
+
+        if (convolution->pad_left != 0 || convolution->pad_right != 0 || convolution->pad_top != 0 || convolution->pad_bottom != 0)
+            continue;
+
+        if (convolution->dynamic_weight || convolution->int8_scale_term)
+            continue;
+
+        // the depthwise output must not be consumed elsewhere
+        int top_blob_consumers = 0;
+        for (size_t k = i + 1; k < layer_count; k++)
+        {
+            if (layers[k]->type == "ncnnfused")
+                continue;
+
+            for (size_t b = 0; b < layers[k]->bottoms.size(); b++)
+            {
+                if (layers[k]->bottoms[b] == top_blob_index)
+                    top_blob_consumers++;
+            }
+        }
+
+        if (top_blob_consumers != 1)
+            continue;
+
+        fprintf(stderr, "replace_convolutiondepthwise_convolution_with_separableconvolution %s %s\n", convolutiondepthwise->name.c_str(), convolution->name.c_str());
+
+        ncnn::SeparableConvolution* separableconvolution = (ncnn::SeparableConvolution*)ncnn::create_layer_cpu("SeparableConvolution");
+
+        separableconvolution->type = "SeparableConvolution";
+        separableconvolution->name = convolutiondepthwise->name;
+        separableconvolution->bottoms = convolutiondepthwise->bottoms;
+        separableconvolution->tops = convolution->tops;
+
+        ncnn::ParamDict pd;
+        separableconvolution->load_param(pd);
+
+        separableconvolution->num_output = convolution->num_output;
+        separableconvolution->kernel_w = convolutiondepthwise->kernel_w;
+        separableconvolution->kernel_h = convolutiondepthwise->kernel_h;
+        separableconvolution->dilation_w = convolutiondepthwise->dilation_w;
+        separableconvolution->dilation_h = convolutiondepthwise->dilation_h;
+        separableconvolution->stride_w = convolutiondepthwise->stride_w;
+        separableconvolution->stride_h = convolutiondepthwise->stride_h;
+        separableconvolution->pad_left = convolutiondepthwise->pad_left;
+        separableconvolution->pad_right = convolutiondepthwise->pad_right;
+        separableconvolution->pad_top = convolutiondepthwise->pad_top;
+        separableconvolution->pad_bottom = convolutiondepthwise->pad_bottom;
+        separableconvolution->pad_value = convolutiondepthwise->pad_value;
+        separableconvolution->bias_term = convolution->bias_term;
+        separableconvolution->weight_data_size = convolution->weight_data_size;
+        separableconvolution->activation_type = convolution->activation_type;
+        separableconvolution->activation_params = convolution->activation_params;
+
+        separableconvolution->depthwise_bias_term = convolutiondepthwise->bias_term;
+        separableconvolution->depthwise_weight_data_size = convolutiondepthwise->weight_data_size;
+        separableconvolution->depthwise_activation_type = convolutiondepthwise->activation_type;
+        separableconvolution->depthwise_activation_params = convolutiondepthwise->activation_params;
+
+        separableconvolution->depthwise_weight_data = convolutiondepthwise->weight_data;
+        separableconvolution->depthwise_bias_data = convolutiondepthwise->bias_data;
+        separableconvolution->weight_data = convolution->weight_data;
+        separableconvolution->bias_data = convolution->bias_data;
+
+        int top_blob_index_final = convolution->tops[0];
+        blobs[top_blob_index_final].producer = i;
+        convolution->type = "ncnnfused";
+
+        layers[i] = separableconvolution;
+        delete convolutiondepthwise;
+    }
+
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
     if (argc < 6)
@@ -2761,6 +3109,11 @@ int main(int argc, char** argv)
     const char* outparam = argv[3];
     const char* outbin = argv[4];
     int flag = atoi(argv[5]);
+
+    // add 4 to the flag to fuse convolutiondepthwise - convolution 1x1 into separableconvolution
+    // only x86 has an optimized separableconvolution, other backends run the reference code
+    const bool use_separableconvolution = flag & 4;
+    flag &= ~4;
     const char* cutstartname = nullptr;
     const char* cutendname = nullptr;
 
@@ -2780,6 +3133,10 @@ int main(int argc, char** argv)
     {
         optimizer.storage_type = 1;
     }
+    else if (flag == 2)
+    {
+        optimizer.storage_type = 2;
+    }
     else
     {
         optimizer.storage_type = 0;
@@ -2826,6 +3183,10 @@ int main(int argc, char** argv)
     optimizer.fuse_innerproduct_activation();
     optimizer.fuse_memorydata_binaryop();
     optimizer.fuse_binaryop_eltwise();
+    optimizer.fuse_permute_gemm();
+    optimizer.fuse_gemm_permute();
+    optimizer.fuse_permute_matmul();
+    optimizer.fuse_softmax_topk();
 
     optimizer.eliminate_dropout();
     optimizer.eliminate_pooling1x1();
@@ -2837,6 +3198,8 @@ int main(int argc, char** argv)
 
     optimizer.replace_convolution_with_innerproduct_after_global_pooling();
     optimizer.replace_convolution_with_innerproduct_after_innerproduct();
+    if (use_separableconvolution)
+        optimizer.replace_convolutiondepthwise_convolution_with_separableconvolution();
 
     optimizer.eliminate_flatten_after_innerproduct();
     optimizer.eliminate_orphaned_memorydata();
@@ -0,0 +1,58 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pass_ncnn.h"
+
+namespace pnnx {
+
+namespace ncnn {
+
+class torch_topk : public GraphRewriterPass
+{
+public:
+    const char* match_pattern_graph() const
+    {
+        return R"PNNXIR(7767517
+3 3
+pnnx.Input              input       0 1 input
+torch.topk              op_0        1 2 input values indices dim=%dim k=%k largest=%largest sorted=%sorted
+pnnx.Output             output      2 0 values indices
+)PNNXIR";
+    }
+
+    const char* type_str() const
+    {
+        return "TopK";
+    }
+
+    const char* name_str() const
+    {
+        return "topk";
+    }
+
+    void write(Operator* op, const std::map<std::string, Parameter>& captured_params) const
+    {
+        int dim = captured_params.at("dim").i;
+
+        const int batch_index = op->inputs[0]->params["__batch_index"].i;
+
+        if (dim == batch_index)
+        {
+            fprintf(stderr, "topk along batch axis is not supported\n");
+            return;
+        }
+
+        int new_dim = dim > batch_index ? dim - 1 : dim;
+
+        op->params["0"] = new_dim;
+        op->params["1"] = captured_params.at("k");
+        op->params["2"] = captured_params.at("largest").b ? 1 : 0;
+        op->params["3"] = captured_params.at("sorted").b ? 1 : 0;
+    }
+};
+
+REGISTER_GLOBAL_PNNX_NCNN_GRAPH_REWRITER_PASS(torch_topk, 20)
+
+} // namespace ncnn
+
+} // namespace pnnx
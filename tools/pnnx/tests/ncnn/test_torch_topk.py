@@ -0,0 +1,56 @@
+# Copyright 2025 Tencent
+# SPDX-License-Identifier: BSD-3-Clause
+
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+
+class Model(nn.Module):
+    def __init__(self):
+        super(Model, self).__init__()
+
+    def forward(self, x, y):
+        x0, i0 = torch.topk(x, 4, dim=1)
+        x1, i1 = torch.topk(x, 2, dim=2, largest=False)
+        y0, i2 = torch.topk(y, 3, dim=-1, sorted=False)
+        return x0, i0, x1, i1, y0, i2
+
+def test():
+    net = Model()
+    net.eval()
+
+    torch.manual_seed(0)
+    x = torch.rand(1, 12, 16)
+    y = torch.rand(1, 5, 9)
+
+    a = net(x, y)
+
+    # torch gives no order for sorted=False, compare in index order like ncnn does
+    a = list(a)
+    order = torch.argsort(a[5], dim=-1)
+    a[4] = torch.gather(a[4], -1, order)
+    a[5] = torch.gather(a[5], -1, order)
+
+    # export torchscript
+    mod = torch.jit.trace(net, (x, y))
+    mod.save("test_torch_topk.pt")
+
+    # torchscript to pnnx
+    import os
+    os.system("../../src/pnnx test_torch_topk.pt inputshape=[1,12,16],[1,5,9]")
+
+    # ncnn inference
+    import test_torch_topk_ncnn
+    b = test_torch_topk_ncnn.test_inference()
+
+    for a0, b0 in zip(a, b):
+        # ncnn stores the indices as float
+        if not torch.allclose(a0.float(), b0, 1e-4, 1e-4):
+            return False
+    return True
+
+if __name__ == "__main__":
+    if test():
+        exit(0)
+    else:
+        exit(1)
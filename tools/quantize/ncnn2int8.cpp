@@ -125,8 +125,13 @@ public:
     int quantize_embed();
     int quantize_gemm();
     int quantize_multiheadattention();
+    int quantize_matmul();
 
     int fuse_requantize();
+
+protected:
+    bool is_int8_passthrough(const ncnn::Layer* layer) const;
+    int resolve_requantize_scales(int blob_index, ncnn::Mat& scales) const;
 };
 
 NetQuantize::NetQuantize()
@@ -842,6 +847,37 @@ int NetQuantize::quantize_multiheadattention()
     return 0;
 }
 
+int NetQuantize::quantize_matmul()
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->type != "MatMul")
+            continue;
+
+        // MatMul - no weight, A is quantized per row and B per tensor at runtime
+        ncnn::MatMul* matmul = (ncnn::MatMul*)layers[i];
+
+        // only MatMul with a constant operand, one scale per tensor on activations such as
+        // attention QK^T and softmax V loses too much accuracy
+        bool has_constant_operand = false;
+        for (size_t j = 0; j < matmul->bottoms.size(); j++)
+        {
+            const int producer = blobs[matmul->bottoms[j]].producer;
+            if (producer >= 0 && layers[producer]->type == "MemoryData")
+                has_constant_operand = true;
+        }
+
+        if (!has_constant_operand)
+            continue;
+
+        fprintf(stderr, "quantize_matmul %s\n", matmul->name.c_str());
+
+        matmul->int8_scale_term = 2;
+    }
+
+    return 0;
+}
+
 int NetQuantize::fuse_requantize()
 {
     const size_t layer_count = layers.size();
@@ -1042,6 +1078,199 @@ int NetQuantize::fuse_requantize()
         }
     }
 
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "Convolution" && layers[i]->type != "ConvolutionDepthWise")
+            continue;
+
+        // Convolution/ConvolutionDepthWise - ReLU/Pooling/Padding/Split/Slice/Crop ... - Convolution/ConvolutionDepthWise
+        int top_blob_index = layers[i]->tops[0];
+
+        int j = blobs[top_blob_index].consumer;
+        if (j == -1 || !is_int8_passthrough(layers[j]))
+            continue;
+
+        ncnn::Mat top_blob_int8_scales;
+        if (resolve_requantize_scales(top_blob_index, top_blob_int8_scales) != 0)
+            continue;
+
+        if (layers[i]->type == "Convolution")
+        {
+            ncnn::Convolution* convolution = (ncnn::Convolution*)layers[i];
+
+            if (convolution->weight_data.elemsize != 1u || convolution->int8_scale_term > 100)
+                continue;
+
+            fprintf(stderr, "fuse_requantize %s %s\n", layers[i]->name.c_str(), layers[j]->name.c_str());
+
+            convolution->int8_scale_term += 100;
+            convolution->top_blob_int8_scales = top_blob_int8_scales;
+        }
+        if (layers[i]->type == "ConvolutionDepthWise")
+        {
+            ncnn::ConvolutionDepthWise* convolution = (ncnn::ConvolutionDepthWise*)layers[i];
+
+            if (convolution->weight_data.elemsize != 1u || convolution->int8_scale_term > 100)
+                continue;
+
+            fprintf(stderr, "fuse_requantize %s %s\n", layers[i]->name.c_str(), layers[j]->name.c_str());
+
+            convolution->int8_scale_term += 100;
+            convolution->top_blob_int8_scales = top_blob_int8_scales;
+        }
+    }
+
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        if (layers[i]->type != "Concat")
+            continue;
+
+        // Convolution/ConvolutionDepthWise x N - Concat - ReLU/Pooling/Padding/Split/Slice/Crop ... - Convolution/ConvolutionDepthWise
+        // every input must be requantized to the same scale
+        bool all_int8 = true;
+        for (size_t j = 0; j < layers[i]->bottoms.size(); j++)
+        {
+            int k = blobs[layers[i]->bottoms[j]].producer;
+            if (k == -1 || (layers[k]->type != "Convolution" && layers[k]->type != "ConvolutionDepthWise"))
+            {
+                all_int8 = false;
+                break;
+            }
+
+            if (layers[k]->type == "Convolution")
+            {
+                const ncnn::Convolution* convolution = (const ncnn::Convolution*)layers[k];
+                if (convolution->weight_data.elemsize != 1u || convolution->int8_scale_term > 100)
+                    all_int8 = false;
+            }
+            else
+            {
+                const ncnn::ConvolutionDepthWise* convolution = (const ncnn::ConvolutionDepthWise*)layers[k];
+                if (convolution->weight_data.elemsize != 1u || convolution->int8_scale_term > 100)
+                    all_int8 = false;
+            }
+
+            if (!all_int8)
+                break;
+        }
+
+        if (!all_int8)
+            continue;
+
+        ncnn::Mat top_blob_int8_scales;
+        if (resolve_requantize_scales(layers[i]->tops[0], top_blob_int8_scales) != 0)
+            continue;
+
+        for (size_t j = 0; j < layers[i]->bottoms.size(); j++)
+        {
+            int k = blobs[layers[i]->bottoms[j]].producer;
+
+            fprintf(stderr, "fuse_requantize %s %s\n", layers[k]->name.c_str(), layers[i]->name.c_str());
+
+            if (layers[k]->type == "Convolution")
+            {
+                ncnn::Convolution* convolution = (ncnn::Convolution*)layers[k];
+                convolution->int8_scale_term += 100;
+                convolution->top_blob_int8_scales = top_blob_int8_scales;
+            }
+            else
+            {
+                ncnn::ConvolutionDepthWise* convolution = (ncnn::ConvolutionDepthWise*)layers[k];
+                convolution->int8_scale_term += 100;
+                convolution->top_blob_int8_scales = top_blob_int8_scales;
+            }
+        }
+    }
+
+    return 0;
+}
+
+bool NetQuantize::is_int8_passthrough(const ncnn::Layer* layer) const
+{
+    // layers that forward int8 blobs and keep their scale
+    if (layer->type == "Split" || layer->type == "Slice")
+        return true;
+
+    if (layer->bottoms.size() != 1 || layer->tops.size() != 1)
+        return false;
+
+    // crop window from params only, the reference blob variant has two bottoms
+    if (layer->type == "Crop")
+        return true;
+
+    if (layer->type == "ReLU")
+    {
+        const ncnn::ReLU* relu = (const ncnn::ReLU*)layer;
+        return relu->slope == 0.f;
+    }
+
+    if (layer->type == "Pooling")
+    {
+        const ncnn::Pooling* pooling = (const ncnn::Pooling*)layer;
+        return pooling->pooling_type == ncnn::Pooling::PoolMethod_MAX && pooling->adaptive_pooling == 0;
+    }
+
+    if (layer->type == "Padding")
+    {
+        const ncnn::Padding* padding = (const ncnn::Padding*)layer;
+        if (padding->per_channel_pad_data_size != 0)
+            return false;
+
+        // zero is zero under any scale
+        return padding->type != 0 || padding->value == 0.f;
+    }
+
+    return false;
+}
+
+int NetQuantize::resolve_requantize_scales(int blob_index, ncnn::Mat& scales) const
+{
+    // every path from the blob must end in a quantized convolution, with the same input scale
+    int j = blobs[blob_index].consumer;
+    if (j == -1)
+        return -1;
+
+    const ncnn::Layer* layer = layers[j];
+
+    if (layer->type == "Convolution" || layer->type == "ConvolutionDepthWise")
+    {
+        if (layer->bottoms.size() != 1)
+            return -1;
+
+        ncnn::Mat bottom_blob_int8_scales;
+        if (layer->type == "Convolution")
+        {
+            const ncnn::Convolution* convolution = (const ncnn::Convolution*)layer;
+            if (convolution->weight_data.elemsize != 1u)
+                return -1;
+
+            bottom_blob_int8_scales = convolution->bottom_blob_int8_scales;
+        }
+        else
+        {
+            const ncnn::ConvolutionDepthWise* convolution = (const ncnn::ConvolutionDepthWise*)layer;
+            if (convolution->weight_data.elemsize != 1u)
+                return -1;
+
+            bottom_blob_int8_scales = convolution->bottom_blob_int8_scales;
+        }
+
+        if (!scales.empty() && scales[0] != bottom_blob_int8_scales[0])
+            return -1;
+
+        scales = bottom_blob_int8_scales;
+        return 0;
+    }
+
+    if (!is_int8_passthrough(layer))
+        return -1;
+
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        if (resolve_requantize_scales(layer->tops[i], scales) != 0)
+            return -1;
+    }
+
     return 0;
 }
 
@@ -1093,6 +1322,7 @@ int main(int argc, char** argv)
     quantizer.quantize_embed();
     quantizer.quantize_gemm();
     quantizer.quantize_multiheadattention();
+    quantizer.quantize_matmul();
 
     quantizer.fuse_requantize();
 